@@ -45,7 +45,9 @@ static int numTestCases = 0;
 // Prototypes of private functions under test
 extern const int8_t ECC_CODEWORDS_PER_BLOCK[4][41];
 extern const int8_t NUM_ERROR_CORRECTION_BLOCKS[4][41];
+extern const int16_t NUM_DATA_CODEWORDS[4][41];
 void appendBitsToBuffer(unsigned int val, int numBits, uint8_t buffer[], int *bitLen);
+void appendDataToBuffer(const uint8_t data[], int numBits, uint8_t buffer[], int *bitLen);
 void addEccAndInterleave(uint8_t data[], int version, enum qrcodegen_Ecc ecl, uint8_t result[]);
 int getNumDataCodewords(int version, enum qrcodegen_Ecc ecl);
 int getNumRawDataModules(int version);
@@ -57,8 +59,12 @@ int getAlignmentPatternPositions(int version, uint8_t result[7]);
 bool getModuleBounded(const uint8_t qrcode[], int x, int y);
 void setModuleBounded(uint8_t qrcode[], int x, int y, bool isDark);
 void setModuleUnbounded(uint8_t qrcode[], int x, int y, bool isDark);
+size_t numericPrefixLength(const char text[], size_t len);
 int calcSegmentBitLength(enum qrcodegen_Mode mode, size_t numChars);
 int getTotalBits(const struct qrcodegen_Segment segs[], size_t len, int version);
+bool makeTextSegment(const char *text, uint8_t buf[], size_t bufLen, struct qrcodegen_Segment *result);
+void computeCharacterModes(const char *text, size_t len, int version, uint8_t result[]);
+int getTotalBitsForModes(const uint8_t charModes[], size_t len, int version);
 
 
 /*---- Test cases ----*/
@@ -104,6 +110,34 @@ static void testAppendBitsToBuffer(void) {
 }
 
 
+static void testAppendDataToBuffer(void) {
+	for (int i = 0; i < 300; i++) {
+		uint8_t data[20];
+		for (size_t j = 0; j < sizeof(data); j++)
+			data[j] = (uint8_t)rand();
+		int startBits = rand() % 24;
+		int numBits = rand() % (int)(sizeof(data) * 8 + 1);
+		
+		uint8_t expect[24] = {0};
+		uint8_t actual[24] = {0};
+		for (int j = 0; j < startBits; j++) {
+			if (rand() % 2 == 0) {
+				expect[j >> 3] |= 1 << (7 - (j & 7));
+				actual[j >> 3] |= 1 << (7 - (j & 7));
+			}
+		}
+		int expectLen = startBits;
+		for (int j = 0; j < numBits; j++)
+			appendBitsToBuffer((unsigned int)(data[j >> 3] >> (7 - (j & 7))) & 1, 1, expect, &expectLen);
+		int actualLen = startBits;
+		appendDataToBuffer(data, numBits, actual, &actualLen);
+		assert(actualLen == expectLen);
+		assert(memcmp(actual, expect, ((size_t)actualLen + 7) / 8) == 0);
+		numTestCases++;
+	}
+}
+
+
 // Ported from the Java version of the code.
 static uint8_t *addEccAndInterleaveReference(const uint8_t *data, int version, enum qrcodegen_Ecc ecl) {
 	// Calculate parameter numbers
@@ -235,6 +269,19 @@ static void testGetNumDataCodewords(void) {
 }
 
 
+static void testNumDataCodewordsTable(void) {
+	for (int ecl = 0; ecl < 4; ecl++) {
+		for (int ver = qrcodegen_VERSION_MIN; ver <= qrcodegen_VERSION_MAX; ver++) {
+			assert(NUM_DATA_CODEWORDS[ecl][ver] == getNumDataCodewords(ver, (enum qrcodegen_Ecc)ecl));
+			assert(qrcodegen_getDataCapacityBits(ver, (enum qrcodegen_Ecc)ecl) == NUM_DATA_CODEWORDS[ecl][ver] * 8);
+			if (ver > qrcodegen_VERSION_MIN)
+				assert(NUM_DATA_CODEWORDS[ecl][ver] > NUM_DATA_CODEWORDS[ecl][ver - 1]);
+			numTestCases++;
+		}
+	}
+}
+
+
 static void testGetNumRawDataModules(void) {
 	const int cases[][2] = {
 		{ 1,   208},
@@ -546,6 +593,10 @@ static void testIsAlphanumeric(void) {
 		{false, "XYZ!"},
 		{true, "79068"},
 		{true, "+123 ABC$"},
+		{true, "HTTPS://EXAMPLE.COM/T/%20-42"},
+		{false, "HTTPS://EXAMPLE.COM/T/?ID=42"},
+		{false, ";"},
+		{false, "^"},
 		{false, "\x01"},
 		{false, "\x7F"},
 		{false, "\x80"},
@@ -584,6 +635,12 @@ static void testIsNumeric(void) {
 		{false, "\x80"},
 		{false, "\xC0"},
 		{false, "\xFF"},
+		{true, "0123456789012345678"},
+		{false, "01234567/9012345678"},
+		{false, "0123456789:12345678"},
+		{false, "012345678901234567\xB0"},
+		{false, "0123456789012345\x3A"},
+		{false, "\xFA\xFA\xFA\xFA\xFA\xFA\xFA" "9"},
 	};
 	for (size_t i = 0; i < ARRAY_LENGTH(cases); i++) {
 		assert(qrcodegen_isNumeric(cases[i].text) == cases[i].answer);
@@ -592,6 +649,20 @@ static void testIsNumeric(void) {
 }
 
 
+static void testNumericPrefixLength(void) {
+	const char *text = "1234567890123456789012345";
+	size_t len = strlen(text);
+	for (size_t i = 0; i <= len; i++) {
+		char buf[32];
+		memcpy(buf, text, len + 1);
+		if (i < len)
+			buf[i] = (char)(i % 2 == 0 ? '/' : ':');
+		assert(numericPrefixLength(buf, len) == i);
+		numTestCases++;
+	}
+}
+
+
 static void testCalcSegmentBufferSize(void) {
 	{
 		const size_t cases[][2] = {
@@ -919,6 +990,15 @@ static void testMakeNumeric(void) {
 		assert(seg.data[4] == 0xC0);
 		numTestCases++;
 	}
+	{
+		uint8_t buf[11];
+		struct qrcodegen_Segment seg = qrcodegen_makeNumeric("31415926535897932384626433", buf);
+		assert(seg.numChars == 26);
+		assert(seg.bitLength == 87);
+		const uint8_t expect[] = {0x4E, 0x89, 0xF4, 0x25, 0x66, 0xF4, 0xD4, 0x3D, 0x39, 0x08, 0x42};
+		assert(memcmp(seg.data, expect, sizeof(expect)) == 0);
+		numTestCases++;
+	}
 }
 
 
@@ -1073,14 +1153,575 @@ static void testGetTotalBits(void) {
 }
 
 
+static void testPlanSegments(void) {
+	for (int i = 0; i < 3000; i++) {
+		static const enum qrcodegen_Mode MODES[] = {qrcodegen_Mode_NUMERIC, qrcodegen_Mode_ALPHANUMERIC, qrcodegen_Mode_BYTE};
+		struct qrcodegen_Segment segs[3];
+		size_t len = (size_t)rand() % (ARRAY_LENGTH(segs) + 1);
+		for (size_t j = 0; j < len; j++) {
+			segs[j].mode = MODES[rand() % 3];
+			segs[j].numChars = rand() % (rand() % 5 == 0 ? 3000 : 200);
+			segs[j].data = NULL;  // Not read when planning
+			segs[j].bitLength = calcSegmentBitLength(segs[j].mode, (size_t)segs[j].numChars);
+		}
+		enum qrcodegen_Ecc ecl = (enum qrcodegen_Ecc)(rand() % 4);
+		int minVersion = rand() % qrcodegen_VERSION_MAX + 1;
+		int maxVersion = minVersion + rand() % (qrcodegen_VERSION_MAX - minVersion + 1);
+		bool boostEcl = rand() % 2 == 0;
+		
+		// Reference: try every version in order
+		int version, dataUsedBits = -1;
+		for (version = minVersion; version <= maxVersion; version++) {
+			dataUsedBits = getTotalBits(segs, len, version);
+			if (dataUsedBits != -1 && dataUsedBits <= getNumDataCodewords(version, ecl) * 8)
+				break;
+		}
+		struct qrcodegen_Plan plan;
+		bool ok = qrcodegen_planSegments(segs, len, ecl, minVersion, maxVersion, boostEcl, &plan);
+		assert(ok == (version <= maxVersion));
+		if (ok) {
+			enum qrcodegen_Ecc finalEcl = ecl;
+			for (int e = (int)ecl + 1; boostEcl && e <= (int)qrcodegen_Ecc_HIGH; e++) {
+				if (dataUsedBits <= getNumDataCodewords(version, (enum qrcodegen_Ecc)e) * 8)
+					finalEcl = (enum qrcodegen_Ecc)e;
+			}
+			assert(plan.version == version);
+			assert(plan.ecl == finalEcl);
+			assert(plan.dataUsedBits == dataUsedBits);
+			assert(plan.dataCapacityBits == getNumDataCodewords(version, finalEcl) * 8);
+		}
+		numTestCases++;
+	}
+}
+
+
+static void testEncodeSegmentsWithPrefix(void) {
+	static uint8_t segBufs[4][1500];
+	static uint8_t prefixBuf[qrcodegen_PREFIX_BUFFER_LEN_MAX];
+	static uint8_t expect[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t actual[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+	static char text[1501];
+	for (int i = 0; i < 300; i++) {
+		// Make random numeric, alphanumeric, or byte segments; the first numPrefix of them form the prefix
+		struct qrcodegen_Segment segs[4];
+		size_t len = (size_t)(rand() % 5);
+		size_t numPrefix = len > 0 ? (size_t)rand() % (len + 1) : 0;
+		for (size_t j = 0; j < len; j++) {
+			size_t n = (size_t)rand() % (rand() % 8 == 0 ? sizeof(text) : 40);
+			int kind = rand() % 3;
+			for (size_t k = 0; k < n; k++)
+				text[k] = kind == 0 ? (char)('0' + rand() % 10) : (char)('A' + rand() % 26);
+			text[n] = '\0';
+			if (kind == 0)
+				segs[j] = qrcodegen_makeNumeric(text, segBufs[j]);
+			else if (kind == 1)
+				segs[j] = qrcodegen_makeAlphanumeric(text, segBufs[j]);
+			else
+				segs[j] = qrcodegen_makeBytes((const uint8_t *)text, n, segBufs[j]);
+		}
+		enum qrcodegen_Ecc ecl = (enum qrcodegen_Ecc)(rand() % 4);
+		enum qrcodegen_Mask mask = (enum qrcodegen_Mask)(rand() % 9 - 1);
+		int minVersion = rand() % qrcodegen_VERSION_MAX + 1;
+		int maxVersion = minVersion + rand() % (qrcodegen_VERSION_MAX - minVersion + 1);
+		bool boostEcl = rand() % 2 == 0;
+		
+		struct qrcodegen_Prefix prefix;
+		bool prefixOk = qrcodegen_makePrefix(segs, numPrefix, prefixBuf, sizeof(prefixBuf), &prefix);
+		bool expectOk = qrcodegen_encodeSegmentsAdvanced(segs, len, ecl,
+			minVersion, maxVersion, mask, boostEcl, tempBuffer, expect);
+		if (!prefixOk) {
+			assert(!expectOk);
+			numTestCases++;
+			continue;
+		}
+		bool actualOk = qrcodegen_encodeSegmentsWithPrefix(&prefix, &segs[numPrefix], len - numPrefix, ecl,
+			minVersion, maxVersion, mask, boostEcl, tempBuffer, actual);
+		assert(actualOk == expectOk);
+		if (expectOk) {
+			int size = qrcodegen_getSize(expect);
+			assert(memcmp(expect, actual, (size_t)(size * size + 7) / 8 + 1) == 0);
+		}
+		numTestCases++;
+	}
+	{  // Buffer too small
+		uint8_t buf[20];
+		struct qrcodegen_Segment seg = qrcodegen_makeAlphanumeric("HTTPS://EXAMPLE.COM/T/", buf);
+		struct qrcodegen_Prefix prefix;
+		assert(qrcodegen_makePrefix(&seg, 1, prefixBuf, 17 + 17 + 18, &prefix));
+		assert(prefix.bitLength[0] == 4 + 9 + 11 * 11);
+		assert(prefix.bitLength[1] == 4 + 11 + 11 * 11);
+		assert(prefix.bitLength[2] == 4 + 13 + 11 * 11);
+		assert(!qrcodegen_makePrefix(&seg, 1, prefixBuf, 17 + 17 + 17, &prefix));
+		numTestCases++;
+	}
+}
+
+
+static void testEncodeBinaryFragments(void) {
+	static uint8_t dataAndTemp[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t pieces[3000];
+	static uint8_t expect[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t actual[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+	for (int i = 0; i < 300; i++) {
+		// Cut a random payload into random fragments, some of them empty
+		size_t dataLen = (size_t)rand() % (rand() % 8 == 0 ? sizeof(pieces) : 100);
+		for (size_t j = 0; j < dataLen; j++)
+			pieces[j] = (uint8_t)rand();
+		struct qrcodegen_ByteFragment fragments[6];
+		size_t count = (size_t)rand() % (ARRAY_LENGTH(fragments) + 1);
+		size_t start = 0;
+		for (size_t j = 0; j < count; j++) {
+			size_t end = j + 1 == count ? dataLen : start + (size_t)rand() % (dataLen - start + 1);
+			fragments[j].data = end > start ? &pieces[start] : NULL;
+			fragments[j].len = end - start;
+			start = end;
+		}
+		if (count == 0)
+			dataLen = 0;
+		
+		enum qrcodegen_Ecc ecl = (enum qrcodegen_Ecc)(rand() % 4);
+		enum qrcodegen_Mask mask = (enum qrcodegen_Mask)(rand() % 9 - 1);
+		int minVersion = rand() % qrcodegen_VERSION_MAX + 1;
+		int maxVersion = minVersion + rand() % (qrcodegen_VERSION_MAX - minVersion + 1);
+		bool boostEcl = rand() % 2 == 0;
+		memcpy(dataAndTemp, pieces, dataLen * sizeof(pieces[0]));
+		bool expectOk = qrcodegen_encodeBinary(dataAndTemp, dataLen, expect,
+			ecl, minVersion, maxVersion, mask, boostEcl);
+		bool actualOk = qrcodegen_encodeBinaryFragments(fragments, count, tempBuffer, actual,
+			ecl, minVersion, maxVersion, mask, boostEcl);
+		assert(actualOk == expectOk);
+		if (expectOk) {
+			int size = qrcodegen_getSize(expect);
+			assert(memcmp(expect, actual, (size_t)(size * size + 7) / 8 + 1) == 0);
+		} else
+			assert(actual[0] == 0);
+		numTestCases++;
+	}
+}
+
+
+static void testEncodeTextCached(void) {
+	static struct qrcodegen_CacheSlot slots[8];
+	static uint8_t data[qrcodegen_CACHE_DATA_LEN(ARRAY_LENGTH(slots), 40, 5)];
+	static uint8_t qrcode[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t expect[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+	struct qrcodegen_Cache cache;
+	qrcodegen_initCache(&cache, slots, ARRAY_LENGTH(slots), data, 40, 5);
+	
+	// Random lookups from a small pool always match qrcodegen_encodeText(), and the counters add up
+	char texts[12][60];
+	for (size_t i = 0; i < ARRAY_LENGTH(texts); i++) {
+		size_t n = (size_t)rand() % (i % 4 == 0 ? sizeof(texts[i]) : 20);
+		for (size_t j = 0; j < n; j++)
+			texts[i][j] = "0123456789ABC abc"[rand() % 17];
+		texts[i][n] = '\0';
+	}
+	unsigned long lookups = 0;
+	for (int i = 0; i < 300; i++) {
+		const char *text = texts[(size_t)rand() % ARRAY_LENGTH(texts)];
+		enum qrcodegen_Ecc ecl = (enum qrcodegen_Ecc)(rand() % 2);
+		enum qrcodegen_Mask mask = (enum qrcodegen_Mask)(rand() % 3 - 1);
+		bool ok = qrcodegen_encodeTextCached(&cache, text, tempBuffer, qrcode, ecl, 1, 10, mask, true);
+		assert(ok == qrcodegen_encodeText(text, tempBuffer, expect, ecl, 1, 10, mask, true));
+		if (ok) {
+			int size = qrcodegen_getSize(expect);
+			assert(memcmp(qrcode, expect, (size_t)(size * size + 7) / 8 + 1) == 0);
+		}
+		lookups++;
+		numTestCases++;
+	}
+	assert(cache.hits + cache.misses == lookups);
+	assert(cache.hits > 0 && cache.evictions > 0);
+	
+	// The least recently used entry is the one replaced
+	qrcodegen_initCache(&cache, slots, 2, data, 40, 5);
+	qrcodegen_encodeTextCached(&cache, "A", tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_0, false);
+	qrcodegen_encodeTextCached(&cache, "B", tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_0, false);
+	qrcodegen_encodeTextCached(&cache, "A", tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_0, false);
+	qrcodegen_encodeTextCached(&cache, "C", tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_0, false);
+	assert(cache.hits == 1 && cache.misses == 3 && cache.evictions == 1);
+	qrcodegen_encodeTextCached(&cache, "A", tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_0, false);
+	assert(cache.hits == 2);
+	qrcodegen_encodeTextCached(&cache, "B", tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_0, false);
+	assert(cache.misses == 4 && cache.evictions == 2);
+	numTestCases++;
+	
+	// Differing parameters are separate entries, and oversized results are not stored
+	qrcodegen_encodeTextCached(&cache, "A", tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_1, false);
+	assert(cache.misses == 5);
+	qrcodegen_initCache(&cache, slots, 2, data, 40, 1);
+	const char *big = "THIS TEXT NEEDS VERSION 2 OR MORE";
+	qrcodegen_encodeTextCached(&cache, big, tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_0, false);
+	assert(qrcodegen_getSize(qrcode) == 25);
+	qrcodegen_encodeTextCached(&cache, big, tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 10, qrcodegen_Mask_0, false);
+	assert(cache.hits == 0 && cache.misses == 2);
+	numTestCases++;
+}
+
+
+static void testEncodeTextBatch(void) {
+	static char texts[50][300];
+	static uint8_t arena[50 * qrcodegen_BUFFER_LEN_FOR_VERSION(10)];
+	static uint8_t expect[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+	const char *textPtrs[ARRAY_LENGTH(texts)];
+	for (size_t i = 0; i < ARRAY_LENGTH(texts); i++) {
+		size_t n = (size_t)rand() % (i % 10 == 0 ? sizeof(texts[i]) : 60);
+		for (size_t j = 0; j < n; j++)
+			texts[i][j] = "0123456789ABC abc"[rand() % (i % 3 == 0 ? 10 : 17)];
+		texts[i][n] = '\0';
+		textPtrs[i] = texts[i];
+	}
+	
+	// Every result matches qrcodegen_encodeText(), and is packed right after the previous one
+	struct qrcodegen_BatchItem items[ARRAY_LENGTH(texts)];
+	size_t used = qrcodegen_encodeTextBatch(textPtrs, ARRAY_LENGTH(texts), tempBuffer, arena, sizeof(arena), items,
+		qrcodegen_Ecc_HIGH, 1, 10, qrcodegen_Mask_AUTO, false);
+	size_t offset = 0;
+	for (size_t i = 0; i < ARRAY_LENGTH(texts); i++) {
+		bool ok = qrcodegen_encodeText(texts[i], tempBuffer, expect, qrcodegen_Ecc_HIGH, 1, 10, qrcodegen_Mask_AUTO, false);
+		assert(items[i].status == (ok ? qrcodegen_BatchStatus_OK : qrcodegen_BatchStatus_DATA_TOO_LONG));
+		if (ok) {
+			assert(items[i].offset == offset);
+			int size = qrcodegen_getSize(expect);
+			size_t len = (size_t)(size * size + 7) / 8 + 1;
+			assert(memcmp(&arena[offset], expect, len) == 0);
+			offset += len;
+		}
+		numTestCases++;
+	}
+	assert(used == offset);
+	
+	// A small arena only holds the first few, but later small texts can still fit. A text that needs
+	// a larger buffer than the whole arena, or doesn't fit in any version at all, is too long instead.
+	static char medium[101], huge[4001];
+	memset(medium, 'B', sizeof(medium) - 1);  // Version 8 at HIGH ECC
+	memset(huge, 'C', sizeof(huge) - 1);
+	const char *small[] = {"HELLO", "WORLD", "THIS TEXT IS TOO LONG FOR A VERSION 1 QR CODE AT HIGH ECC", "12345", medium, huge};
+	size_t v1 = (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(1);
+	struct qrcodegen_BatchItem smallItems[ARRAY_LENGTH(small)];
+	used = qrcodegen_encodeTextBatch(small, ARRAY_LENGTH(small), tempBuffer, arena, v1 * 3 + 5, smallItems,
+		qrcodegen_Ecc_HIGH, 1, 40, qrcodegen_Mask_0, false);
+	assert(used == v1 * 3);
+	assert(smallItems[0].status == qrcodegen_BatchStatus_OK && smallItems[0].offset == 0);
+	assert(smallItems[1].status == qrcodegen_BatchStatus_OK && smallItems[1].offset == v1);
+	assert(smallItems[2].status == qrcodegen_BatchStatus_ARENA_FULL);  // Version 5 fits in the whole arena
+	assert(smallItems[3].status == qrcodegen_BatchStatus_OK && smallItems[3].offset == v1 * 2);
+	assert(smallItems[4].status == qrcodegen_BatchStatus_DATA_TOO_LONG);
+	assert(smallItems[5].status == qrcodegen_BatchStatus_DATA_TOO_LONG);
+	assert(qrcodegen_getSize(&arena[v1 * 2]) == 21);
+	numTestCases++;
+}
+
+
+static void testMakeTextSegment(void) {
+	for (int i = 0; i < 1000; i++) {
+		// Mostly digits, sometimes alphanumeric, sometimes other bytes
+		static const char CHARSETS[][16] = {"0123456789", "0123456789AZ $:", "0123456789az,\xC3\xA9"};
+		const char *charset = CHARSETS[rand() % 3];
+		char text[60];
+		size_t len = (size_t)rand() % sizeof(text);
+		for (size_t j = 0; j < len; j++)
+			text[j] = charset[(size_t)rand() % strlen(charset)];
+		text[len] = '\0';
+		
+		uint8_t expectBuf[60], actualBuf[60];
+		struct qrcodegen_Segment expect, actual;
+		if (qrcodegen_isNumeric(text))
+			expect = qrcodegen_makeNumeric(text, expectBuf);
+		else if (qrcodegen_isAlphanumeric(text))
+			expect = qrcodegen_makeAlphanumeric(text, expectBuf);
+		else
+			expect = qrcodegen_makeBytes((const uint8_t *)text, len, expectBuf);
+		bool ok = makeTextSegment(text, actualBuf, sizeof(actualBuf), &actual);
+		assert(ok);
+		assert(actual.mode == expect.mode);
+		assert(actual.numChars == expect.numChars);
+		assert(actual.bitLength == expect.bitLength);
+		assert(actual.data == actualBuf);
+		assert(memcmp(actual.data, expect.data, ((size_t)expect.bitLength + 7) / 8) == 0);
+		numTestCases++;
+	}
+	{
+		uint8_t buf[5];
+		struct qrcodegen_Segment seg;
+		assert(makeTextSegment("123456789012", buf, sizeof(buf), &seg));  // 40 bits
+		assert(seg.mode == qrcodegen_Mode_NUMERIC && seg.bitLength == 40);
+		numTestCases++;
+		assert(!makeTextSegment("1234567890123", buf, sizeof(buf), &seg));  // 44 bits
+		numTestCases++;
+		uint8_t buf11[11];
+		assert(makeTextSegment("1234567890123ABC", buf11, sizeof(buf11), &seg));
+		assert(seg.mode == qrcodegen_Mode_ALPHANUMERIC && seg.bitLength == 88);
+		numTestCases++;
+		assert(!makeTextSegment("abcdef", buf, sizeof(buf), &seg));
+		numTestCases++;
+	}
+}
+
+
+static void testComputeCharacterModes(void) {
+	const char *MODE_NAMES = "BAN";
+	struct TestCase {
+		const char *text;
+		int version;
+		const char *modes;
+		int totalBits;
+	};
+	const struct TestCase cases[] = {
+		{"a1", 1, "BB", 28},
+		{"HELLO WORLD", 1, "AAAAAAAAAAA", 74},
+		{"a0123456b", 1, "BNNNNNNNB", 78},
+		{"a0123456b", 10, "BBBBBBBBB", 92},
+		{"abcDEFGHIJ1234567", 1, "BBBAAAAAAANNNNNNN", 126},
+		{"abcDEFGHIJ1234567", 27, "BBBAAAAAAAAAAAAAA", 138},
+		{"1234567ABCDEFGHIJKL", 1, "NNNNNNNAAAAAAAAAAAA", 117},
+		{"1234567ABCDEFGHIJKL", 10, "AAAAAAAAAAAAAAAAAAA", 120},
+		{"ORDER-1234567890123 shipped", 1, "AAAAAANNNNNNNNNNNNNBBBBBBBB", 180},
+	};
+	for (size_t i = 0; i < ARRAY_LENGTH(cases); i++) {
+		const struct TestCase *tc = &cases[i];
+		size_t len = strlen(tc->text);
+		uint8_t charModes[8];
+		computeCharacterModes(tc->text, len, tc->version, charModes);
+		for (size_t j = 0; j < len; j++)
+			assert(MODE_NAMES[(charModes[j >> 2] >> (j & 3) * 2) & 3] == tc->modes[j]);
+		assert(getTotalBitsForModes(charModes, len, tc->version) == tc->totalBits);
+		numTestCases++;
+	}
+	{  // Long enough to span several blocks of characters
+		const char *PERIOD = "ABCDEF12345678abc";
+		char text[17 * 20 + 1] = {0};
+		for (int i = 0; i < 20; i++)
+			strcat(text, PERIOD);
+		size_t len = strlen(text);
+		uint8_t charModes[(sizeof(text) + 3) / 4];
+		computeCharacterModes(text, len, 1, charModes);
+		for (size_t j = 0; j < len; j++)
+			assert(MODE_NAMES[(charModes[j >> 2] >> (j & 3) * 2) & 3] == "AAAAAANNNNNNNNBBB"[j % 17]);
+		numTestCases++;
+		computeCharacterModes(text, len, 27, charModes);
+		for (size_t j = 0; j < len; j++)
+			assert(MODE_NAMES[(charModes[j >> 2] >> (j & 3) * 2) & 3] == (j < 14 ? 'A' : 'B'));
+		numTestCases++;
+	}
+	{
+		char text[1024];
+		memset(text, '1', sizeof(text));
+		uint8_t charModes[sizeof(text) / 4];
+		computeCharacterModes(text, sizeof(text) - 1, 1, charModes);
+		assert(getTotalBitsForModes(charModes, sizeof(text) - 1, 1) == 14 + 3410);
+		numTestCases++;
+		computeCharacterModes(text, sizeof(text), 1, charModes);
+		assert(getTotalBitsForModes(charModes, sizeof(text), 1) == -1);  // Character count overflows 10 bits
+		numTestCases++;
+	}
+}
+
+
+static void testEncodeTextOptimally(void) {
+	{  // Same symbol as the hand-made segments
+		uint8_t buf0[25], buf1[25], buf2[25];
+		struct qrcodegen_Segment segs[] = {
+			qrcodegen_makeAlphanumeric("ORDER-", buf0),
+			qrcodegen_makeNumeric("1234567890123", buf1),
+			qrcodegen_makeBytes((const uint8_t *)" shipped", 8, buf2),
+		};
+		uint8_t expect[qrcodegen_BUFFER_LEN_MAX];
+		uint8_t actual[qrcodegen_BUFFER_LEN_MAX];
+		uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+		bool ok = qrcodegen_encodeSegmentsAdvanced(segs, ARRAY_LENGTH(segs), qrcodegen_Ecc_MEDIUM,
+			qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX, qrcodegen_Mask_AUTO, true, tempBuffer, expect);
+		assert(ok);
+		ok = qrcodegen_encodeTextOptimally("ORDER-1234567890123 shipped", tempBuffer, actual, qrcodegen_Ecc_MEDIUM,
+			qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX, qrcodegen_Mask_AUTO, true);
+		assert(ok);
+		assert(qrcodegen_getSize(actual) == 25);
+		assert(memcmp(expect, actual, (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(2)) == 0);
+		numTestCases++;
+	}
+	{  // Same symbol as encodeText() when a single mode is optimal
+		uint8_t expect[qrcodegen_BUFFER_LEN_MAX];
+		uint8_t actual[qrcodegen_BUFFER_LEN_MAX];
+		uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+		const char *texts[] = {"", "314159265358979323846264338327950288419716939937510", "HELLO WORLD", "Hello, world!"};
+		for (size_t i = 0; i < ARRAY_LENGTH(texts); i++) {
+			bool ok = qrcodegen_encodeText(texts[i], tempBuffer, expect, qrcodegen_Ecc_LOW,
+				qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX, qrcodegen_Mask_3, false);
+			assert(ok);
+			ok = qrcodegen_encodeTextOptimally(texts[i], tempBuffer, actual, qrcodegen_Ecc_LOW,
+				qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX, qrcodegen_Mask_3, false);
+			assert(ok);
+			int size = qrcodegen_getSize(actual);
+			assert(memcmp(expect, actual, (size_t)(size * size + 7) / 8 + 1) == 0);
+			numTestCases++;
+		}
+	}
+	{  // Too long
+		char text[7091];
+		memset(text, '7', sizeof(text) - 1);
+		text[sizeof(text) - 1] = '\0';
+		uint8_t qrcode[qrcodegen_BUFFER_LEN_MAX];
+		uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+		bool ok = qrcodegen_encodeTextOptimally(text, tempBuffer, qrcode, qrcodegen_Ecc_LOW,
+			qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX, qrcodegen_Mask_AUTO, false);
+		assert(!ok);
+		numTestCases++;
+		text[7089] = '\0';
+		ok = qrcodegen_encodeTextOptimally(text, tempBuffer, qrcode, qrcodegen_Ecc_LOW,
+			qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX, qrcodegen_Mask_0, false);
+		assert(ok && qrcodegen_getSize(qrcode) == 177);
+		numTestCases++;
+	}
+}
+
+
+static void testSerialize(void) {
+	static uint8_t qrcode[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t copy[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t data[qrcodegen_SERIALIZED_LEN_MAX];
+	
+	// Both layouts read back to the same QR Code, and the full layout can be viewed in place
+	for (int i = 0; i < 200; i++) {
+		char text[400];
+		size_t n = (size_t)rand() % (i % 10 == 0 ? sizeof(text) : 40);
+		for (size_t j = 0; j < n; j++)
+			text[j] = (char)(' ' + rand() % 95);
+		text[n] = '\0';
+		enum qrcodegen_Ecc ecl = (enum qrcodegen_Ecc)(rand() % 4);
+		enum qrcodegen_Mask mask = (enum qrcodegen_Mask)(rand() % 9 - 1);
+		bool ok = qrcodegen_encodeText(text, tempBuffer, qrcode, ecl, 1, 40, mask, false);
+		assert(ok);
+		int size = qrcodegen_getSize(qrcode);
+		int version = (size - 17) / 4;
+		size_t qrcodeLen = (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(version);
+		assert(qrcodegen_getErrorCorrectionLevel(qrcode) == ecl);
+		assert(mask == qrcodegen_Mask_AUTO || qrcodegen_getMask(qrcode) == mask);
+		
+		size_t fullLen = qrcodegen_serialize(qrcode, false, data, sizeof(data));
+		assert(fullLen == (size_t)qrcodegen_SERIALIZED_LEN_FOR_VERSION(version));
+		assert(data[0] == 'Q' && data[1] == 1 && data[3] == size);
+		const uint8_t *view = qrcodegen_viewSerialized(data, fullLen);
+		assert(view == &data[3] && memcmp(view, qrcode, qrcodeLen) == 0);
+		memset(copy, 0xFF, sizeof(copy));
+		assert(qrcodegen_deserialize(data, fullLen, copy, version));
+		assert(memcmp(copy, qrcode, qrcodeLen) == 0);
+		assert(!qrcodegen_deserialize(data, fullLen - 1, copy, version));
+		assert(version == 1 || !qrcodegen_deserialize(data, fullLen, copy, version - 1));
+		
+		size_t dataLen = qrcodegen_serialize(qrcode, true, data, sizeof(data));
+		assert(dataLen == (size_t)(4 + (getNumRawDataModules(version) + 7) / 8) && (data[2] & 0x80) != 0);
+		assert(qrcodegen_viewSerialized(data, dataLen) == NULL);
+		memset(copy, 0xFF, sizeof(copy));
+		assert(qrcodegen_deserialize(data, dataLen, copy, qrcodegen_VERSION_MAX));
+		assert(memcmp(copy, qrcode, qrcodeLen) == 0);
+		numTestCases++;
+	}
+	
+	// Malformed headers, a short output array, and format bits that disagree with the header are rejected
+	qrcodegen_encodeText("HELLO", tempBuffer, qrcode, qrcodegen_Ecc_LOW, 1, 1, qrcodegen_Mask_3, false);
+	size_t len = qrcodegen_serialize(qrcode, false, data, sizeof(data));
+	assert(len == 60 && qrcodegen_serialize(qrcode, false, data, len - 1) == 0);
+	for (int i = 0; i < 4; i++) {
+		uint8_t bad[60];
+		memcpy(bad, data, len);
+		bad[i] ^= (uint8_t)(i == 2 ? 0x20 : 0x01);
+		assert(qrcodegen_viewSerialized(bad, len) == NULL && !qrcodegen_deserialize(bad, len, copy, 40));
+		memcpy(bad, data, len);
+		bad[2] ^= (uint8_t)(1 << i);  // Another mask or ECC level than the format bits
+		assert(qrcodegen_viewSerialized(bad, len) == NULL);
+		numTestCases++;
+	}
+	
+	// A damaged first copy of the format bits is reported, and such a symbol isn't serialized
+	static const int FORMAT_COORDS[][2] = {{8, 0}, {8, 5}, {8, 7}, {8, 8}, {7, 8}, {5, 8}, {0, 8}};
+	for (size_t i = 0; i < sizeof(FORMAT_COORDS) / sizeof(FORMAT_COORDS[0]); i++) {
+		uint8_t damaged[qrcodegen_BUFFER_LEN_FOR_VERSION(1)];
+		memcpy(damaged, qrcode, sizeof(damaged));
+		int x = FORMAT_COORDS[i][0], y = FORMAT_COORDS[i][1];
+		setModuleBounded(damaged, x, y, !getModuleBounded(damaged, x, y));
+		assert(qrcodegen_getMask(damaged) == qrcodegen_Mask_AUTO);
+		assert(qrcodegen_getErrorCorrectionLevel(damaged) == qrcodegen_Ecc_LOW);
+		memset(data, 0xAA, len);
+		assert(qrcodegen_serialize(damaged, false, data, sizeof(data)) == 0);
+		assert(qrcodegen_serialize(damaged, true, data, sizeof(data)) == 0);
+		assert(data[0] == 0xAA && data[len - 1] == 0xAA);  // Nothing written
+		numTestCases++;
+	}
+}
+
+
+static void testEncodeAligned(void) {
+	static uint8_t qrcode[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t tempBuffer[qrcodegen_BUFFER_LEN_MAX];
+	static uint8_t aligned[qrcodegen_ALIGNED_BUFFER_LEN_MAX];
+	
+	// The row-aligned layout holds the same modules as the packed layout, with light padding after each row
+	for (int i = 0; i < 200; i++) {
+		char text[400];
+		size_t n = (size_t)rand() % (i % 10 == 0 ? sizeof(text) : 40);
+		for (size_t j = 0; j < n; j++)
+			text[j] = (char)(' ' + rand() % 95);
+		text[n] = '\0';
+		enum qrcodegen_Ecc ecl = (enum qrcodegen_Ecc)(rand() % 4);
+		enum qrcodegen_Mask mask = (enum qrcodegen_Mask)(rand() % 9 - 1);
+		bool ok = qrcodegen_encodeText(text, tempBuffer, qrcode, ecl, 1, 40, mask, true);
+		assert(ok);
+		memset(aligned, 0xFF, sizeof(aligned));
+		ok = qrcodegen_encodeTextAligned(text, tempBuffer, aligned, ecl, 1, 40, mask, true);
+		assert(ok);
+		int size = qrcodegen_getSize(qrcode);
+		int version = (size - 17) / 4;
+		int rowBytes = qrcodegen_ALIGNED_ROW_BYTES_FOR_VERSION(version);
+		assert(qrcodegen_getSizeAligned(aligned) == size && rowBytes % 8 == 0 && rowBytes * 8 >= size);
+		for (int j = 2; j < 8; j++)
+			assert(aligned[j] == 0);
+		for (int y = 0; y < size; y++) {
+			const uint8_t *row = qrcodegen_getRowAligned(aligned, y);
+			assert(row == &aligned[8 + y * rowBytes]);
+			for (int x = 0; x < rowBytes * 8; x++) {
+				bool dark = ((row[x >> 3] >> (x & 7)) & 1) != 0;
+				assert(dark == qrcodegen_getModule(qrcode, x, y));
+				assert(dark == qrcodegen_getModuleAligned(aligned, x, y));
+			}
+		}
+		assert(!qrcodegen_getModuleAligned(aligned, -1, 0) && !qrcodegen_getModuleAligned(aligned, 0, size));
+		numTestCases++;
+	}
+	
+	// Segments encode the same way, and a failure leaves an invalid size
+	uint8_t segBuf[qrcodegen_BUFFER_LEN_FOR_VERSION(2)];
+	struct qrcodegen_Segment seg = qrcodegen_makeNumeric("31415926535897932384626433832795", segBuf);
+	bool ok = qrcodegen_encodeSegmentsAligned(&seg, 1, qrcodegen_Ecc_HIGH, 2, 2, qrcodegen_Mask_5, false, tempBuffer, aligned);
+	assert(ok && qrcodegen_getSizeAligned(aligned) == 25);
+	ok = qrcodegen_encodeSegmentsAdvanced(&seg, 1, qrcodegen_Ecc_HIGH, 2, 2, qrcodegen_Mask_5, false, tempBuffer, qrcode);
+	assert(ok);
+	for (int y = 0; y < 25; y++) {
+		for (int x = 0; x < 25; x++)
+			assert(qrcodegen_getModuleAligned(aligned, x, y) == qrcodegen_getModule(qrcode, x, y));
+	}
+	numTestCases++;
+	ok = qrcodegen_encodeTextAligned("This text is too long for version 1", tempBuffer, aligned,
+		qrcodegen_Ecc_HIGH, 1, 1, qrcodegen_Mask_AUTO, false);
+	assert(!ok && aligned[0] == 0 && aligned[1] == 0);
+	numTestCases++;
+}
+
+
 /*---- Main runner ----*/
 
 int main(void) {
 	srand((unsigned int)time(NULL));
 	testAppendBitsToBuffer();
+	testAppendDataToBuffer();
 	testAddEccAndInterleave();
 	testGetNumDataCodewords();
 	testGetNumRawDataModules();
+	testNumDataCodewordsTable();
 	testReedSolomonComputeDivisor();
 	testReedSolomonComputeRemainder();
 	testReedSolomonMultiply();
@@ -1090,6 +1731,7 @@ int main(void) {
 	testGetSetModuleRandomly();
 	testIsAlphanumeric();
 	testIsNumeric();
+	testNumericPrefixLength();
 	testCalcSegmentBufferSize();
 	testCalcSegmentBitLength();
 	testMakeBytes();
@@ -1097,6 +1739,16 @@ int main(void) {
 	testMakeAlphanumeric();
 	testMakeEci();
 	testGetTotalBits();
+	testPlanSegments();
+	testEncodeSegmentsWithPrefix();
+	testEncodeBinaryFragments();
+	testEncodeTextBatch();
+	testEncodeTextCached();
+	testMakeTextSegment();
+	testComputeCharacterModes();
+	testEncodeTextOptimally();
+	testSerialize();
+	testEncodeAligned();
 	printf("All %d test cases passed\n", numTestCases);
 	return EXIT_SUCCESS;
 }
@@ -53,6 +53,27 @@
 //   same writable buffer to concurrent calls to these functions.
 
 testable void appendBitsToBuffer(unsigned int val, int numBits, uint8_t buffer[], int *bitLen);
+testable bool makeTextSegment(const char *text, uint8_t buf[], size_t bufLen, struct qrcodegen_Segment *result);
+static void writeBitsToBuffer(unsigned int val, int numBits, uint8_t buffer[], int *bitLen);
+testable void appendDataToBuffer(const uint8_t data[], int numBits, uint8_t buffer[], int *bitLen);
+static bool encodeTextWithLayout(const char *text, uint8_t tempBuffer[], uint8_t qrcode[], enum qrcodegen_Ecc ecl,
+	int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl, bool rowAligned);
+static bool encodeSegmentsWithLayout(const struct qrcodegen_Prefix *prefix,
+	const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl, int minVersion, int maxVersion,
+	enum qrcodegen_Mask mask, bool boostEcl, bool rowAligned, uint8_t tempBuffer[], uint8_t qrcode[]);
+static bool planWithPrefix(const struct qrcodegen_Prefix *prefix, const struct qrcodegen_Segment segs[], size_t len,
+	enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, bool boostEcl, struct qrcodegen_Plan *result);
+static int getBandIndex(int version);
+static uint32_t hashCacheKey(const char *text, size_t len, const struct qrcodegen_CacheSlot *params);
+static void finishEncoding(int bitLen, int version, enum qrcodegen_Ecc ecl, enum qrcodegen_Mask mask,
+	bool boostEcl, bool rowAligned, uint8_t tempBuffer[], uint8_t qrcode[]);
+
+testable void computeCharacterModes(const char *text, size_t len, int version, uint8_t result[]);
+static int characterModesStep(char c, const long headCosts[3], long costs[3]);
+testable int getTotalBitsForModes(const uint8_t charModes[], size_t len, int version);
+static void appendSegmentsForModes(const char *text, size_t len, const uint8_t charModes[],
+	int version, uint8_t buffer[], int *bitLen);
+static size_t nextModeRun(const uint8_t charModes[], size_t start, size_t len);
 
 testable void addEccAndInterleave(uint8_t data[], int version, enum qrcodegen_Ecc ecl, uint8_t result[]);
 testable int getNumDataCodewords(int version, enum qrcodegen_Ecc ecl);
@@ -64,6 +85,8 @@ testable void reedSolomonComputeRemainder(const uint8_t data[], int dataLen,
 testable uint8_t reedSolomonMultiply(uint8_t x, uint8_t y);
 
 testable void initializeFunctionModules(int version, uint8_t qrcode[]);
+static void initializeFunctionModulesAligned(int version, uint8_t qrcode[]);
+static void fillFunctionModules(int version, uint8_t qrcode[]);
 static void drawLightFunctionModules(uint8_t qrcode[], int version);
 static void drawFormatBits(enum qrcodegen_Ecc ecl, enum qrcodegen_Mask mask, uint8_t qrcode[]);
 testable int getAlignmentPatternPositions(int version, uint8_t result[7]);
@@ -79,8 +102,15 @@ static void finderPenaltyAddHistory(int currentRunLength, int runHistory[7], int
 testable bool getModuleBounded(const uint8_t qrcode[], int x, int y);
 testable void setModuleBounded(uint8_t qrcode[], int x, int y, bool isDark);
 testable void setModuleUnbounded(uint8_t qrcode[], int x, int y, bool isDark);
+static int getGridSize(const uint8_t qrcode[]);
+static int getModuleBitIndex(const uint8_t qrcode[], int x, int y);
 static bool getBit(int x, int i);
+static int readFormatBits(const uint8_t qrcode[]);
+static int getFormatData(enum qrcodegen_Ecc ecl, enum qrcodegen_Mask mask);
+static bool parseSerializedHeader(const uint8_t data[], size_t dataLen,
+	int *version, enum qrcodegen_Ecc *ecl, enum qrcodegen_Mask *mask, bool *dataRegionOnly);
 
+testable size_t numericPrefixLength(const char text[], size_t len);
 testable int calcSegmentBitLength(enum qrcodegen_Mode mode, size_t numChars);
 testable int getTotalBits(const struct qrcodegen_Segment segs[], size_t len, int version);
 static int numCharCountBits(enum qrcodegen_Mode mode, int version);
@@ -89,9 +119,29 @@ static int numCharCountBits(enum qrcodegen_Mode mode, int version);
 
 /*---- Private tables of constants ----*/
 
-// The set of all legal characters in alphanumeric mode, where each character
-// value maps to the index in the string. For checking text and encoding segments.
-static const char *ALPHANUMERIC_CHARSET = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+// Maps each byte value to its index in the alphanumeric character set
+// "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:", or -1 if it is not a legal character.
+// For checking text and encoding segments.
+static const int8_t ALPHANUMERIC_MAP[256] = {
+	// Low nibble: (-1 marks a byte value that is not in the alphanumeric character set)
+	//0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  A,  B,  C,  D,  E,  F    High nibble
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x00
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x10
+	36, -1, -1, -1, 37, 38, -1, -1, -1, -1, 39, 40, -1, 41, 42, 43,  // 0x20
+	 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 44, -1, -1, -1, -1, -1,  // 0x30
+	-1, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,  // 0x40
+	25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, -1, -1, -1, -1, -1,  // 0x50
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x60
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x70
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x80
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x90
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xA0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xB0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xC0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xD0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xE0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xF0
+};
 
 // For generating error correction codes.
 testable const int8_t ECC_CODEWORDS_PER_BLOCK[4][41] = {
@@ -115,12 +165,27 @@ testable const int8_t NUM_ERROR_CORRECTION_BLOCKS[4][41] = {
 	{-1, 1, 1, 2, 4, 4, 4, 5, 6, 8, 8, 11, 11, 16, 16, 18, 16, 19, 21, 25, 25, 25, 34, 30, 32, 35, 37, 40, 42, 45, 48, 51, 54, 57, 60, 63, 66, 70, 74, 77, 81},  // High
 };
 
+// Equal to getNumDataCodewords() for each ECC level and version, which increases strictly with the version.
+// For planning versions by binary search.
+testable const int16_t NUM_DATA_CODEWORDS[4][41] = {
+	// Version: (note that index 0 is for padding, and is set to an illegal value)
+	//   0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,   15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25,   26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40    Error correction level
+	{  -1,   19,   34,   55,   80,  108,  136,  156,  194,  232,  274,  324,  370,  428,  461,  523,  589,  647,  721,  795,  861,  932, 1006, 1094, 1174, 1276, 1370, 1468, 1531, 1631, 1735, 1843, 1955, 2071, 2191, 2306, 2434, 2566, 2702, 2812, 2956},  // Low
+	{  -1,   16,   28,   44,   64,   86,  108,  124,  154,  182,  216,  254,  290,  334,  365,  415,  453,  507,  563,  627,  669,  714,  782,  860,  914, 1000, 1062, 1128, 1193, 1267, 1373, 1455, 1541, 1631, 1725, 1812, 1914, 1992, 2102, 2216, 2334},  // Medium
+	{  -1,   13,   22,   34,   48,   62,   76,   88,  110,  132,  154,  180,  206,  244,  261,  295,  325,  367,  397,  445,  485,  512,  568,  614,  664,  718,  754,  808,  871,  911,  985, 1033, 1115, 1171, 1231, 1286, 1354, 1426, 1502, 1582, 1666},  // Quartile
+	{  -1,    9,   16,   26,   36,   46,   60,   66,   86,  100,  122,  140,  158,  180,  197,  223,  253,  283,  313,  341,  385,  406,  442,  464,  514,  538,  596,  628,  661,  701,  745,  793,  845,  901,  961,  986, 1054, 1096, 1142, 1222, 1276},  // High
+};
+
 // For automatic mask pattern selection.
 static const int PENALTY_N1 =  3;
 static const int PENALTY_N2 =  3;
 static const int PENALTY_N3 = 40;
 static const int PENALTY_N4 = 10;
 
+// The first two bytes of every serialized QR Code: the magic byte, then the format version.
+static const uint8_t SERIALIZED_MAGIC = 0x51;  // 'Q'
+static const uint8_t SERIALIZED_FORMAT_VERSION = 1;
+
 
 
 /*---- High-level QR Code encoding functions ----*/
@@ -128,38 +193,100 @@ static const int PENALTY_N4 = 10;
 // Public function - see documentation comment in header file.
 bool qrcodegen_encodeText(const char *text, uint8_t tempBuffer[], uint8_t qrcode[],
 		enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl) {
+	return encodeTextWithLayout(text, tempBuffer, qrcode, ecl, minVersion, maxVersion, mask, boostEcl, false);
+}
+
+
+// Implements qrcodegen_encodeText() and qrcodegen_encodeTextAligned(), writing
+// the result in the row-aligned layout iff rowAligned is true.
+static bool encodeTextWithLayout(const char *text, uint8_t tempBuffer[], uint8_t qrcode[], enum qrcodegen_Ecc ecl,
+		int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl, bool rowAligned) {
 	
-	size_t textLen = strlen(text);
-	if (textLen == 0)
-		return qrcodegen_encodeSegmentsAdvanced(NULL, 0, ecl, minVersion, maxVersion, mask, boostEcl, tempBuffer, qrcode);
+	if (text[0] == '\0')
+		return encodeSegmentsWithLayout(NULL, NULL, 0, ecl, minVersion, maxVersion, mask, boostEcl, rowAligned, tempBuffer, qrcode);
 	size_t bufLen = (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(maxVersion);
 	
 	struct qrcodegen_Segment seg;
-	if (qrcodegen_isNumeric(text)) {
-		if (qrcodegen_calcSegmentBufferSize(qrcodegen_Mode_NUMERIC, textLen) > bufLen)
-			goto fail;
-		seg = qrcodegen_makeNumeric(text, tempBuffer);
-	} else if (qrcodegen_isAlphanumeric(text)) {
-		if (qrcodegen_calcSegmentBufferSize(qrcodegen_Mode_ALPHANUMERIC, textLen) > bufLen)
-			goto fail;
-		seg = qrcodegen_makeAlphanumeric(text, tempBuffer);
-	} else {
-		if (textLen > bufLen)
-			goto fail;
-		for (size_t i = 0; i < textLen; i++)
-			tempBuffer[i] = (uint8_t)text[i];
-		seg.mode = qrcodegen_Mode_BYTE;
-		seg.bitLength = calcSegmentBitLength(seg.mode, textLen);
-		if (seg.bitLength == -1)
-			goto fail;
-		seg.numChars = (int)textLen;
-		seg.data = tempBuffer;
+	if (!makeTextSegment(text, tempBuffer, bufLen, &seg)) {
+		qrcode[0] = 0;  // Set size to invalid value for safety
+		qrcode[1] = 0;
+		return false;
 	}
-	return qrcodegen_encodeSegmentsAdvanced(&seg, 1, ecl, minVersion, maxVersion, mask, boostEcl, tempBuffer, qrcode);
+	return encodeSegmentsWithLayout(NULL, &seg, 1, ecl, minVersion, maxVersion, mask, boostEcl, rowAligned, tempBuffer, qrcode);
+}
+
+
+// Encodes the given NUL-terminated text as one segment in the densest mode that can hold all of it,
+// storing the data in buf[0 : bufLen] and the segment in *result. The text is read in a single pass
+// without strlen(): digits are packed speculatively in numeric mode, and the segment is demoted to
+// alphanumeric mode at the first non-digit and to byte mode at the first character outside that set,
+// re-encoding only the prefix already seen. Returns false if the data would need more than bufLen bytes.
+// Requires bufLen <= qrcodegen_BUFFER_LEN_MAX, so that every bit length fits in an int16.
+testable bool makeTextSegment(const char *text, uint8_t buf[], size_t bufLen, struct qrcodegen_Segment *result) {
+	assert(text != NULL && bufLen <= qrcodegen_BUFFER_LEN_MAX);
+	int maxBits = (int)bufLen * 8;
+	int bitLen = 0;
 	
-fail:
-	qrcode[0] = 0;  // Set size to invalid value for safety
-	return false;
+	// Numeric mode: every 3 digits become 10 bits
+	size_t i = 0;
+	unsigned int accumData = 0;
+	for (; '0' <= text[i] && text[i] <= '9'; i++) {
+		accumData = accumData * 10 + (unsigned int)(text[i] - '0');
+		if (i % 3 == 2) {
+			if (bitLen + 10 > maxBits)
+				return false;
+			writeBitsToBuffer(accumData, 10, buf, &bitLen);
+			accumData = 0;
+		}
+	}
+	if (text[i] == '\0') {
+		if (i % 3 > 0) {  // 1 or 2 digits remaining
+			int numBits = (int)(i % 3) * 3 + 1;
+			if (bitLen + numBits > maxBits)
+				return false;
+			writeBitsToBuffer(accumData, numBits, buf, &bitLen);
+		}
+		result->mode = qrcodegen_Mode_NUMERIC;
+		goto done;
+	}
+	
+	// Alphanumeric mode: re-pack the digits seen so far, then continue (the NUL terminator maps to -1)
+	bitLen = 0;
+	for (i = 0; ALPHANUMERIC_MAP[(unsigned char)text[i]] != -1; i++) {
+		unsigned int val = (unsigned int)ALPHANUMERIC_MAP[(unsigned char)text[i]];
+		if (i % 2 == 0)
+			accumData = val;
+		else {  // Each pair of characters becomes 11 bits
+			if (bitLen + 11 > maxBits)
+				return false;
+			writeBitsToBuffer(accumData * 45 + val, 11, buf, &bitLen);
+		}
+	}
+	if (text[i] == '\0') {
+		if (i % 2 == 1) {  // 1 character remaining
+			if (bitLen + 6 > maxBits)
+				return false;
+			writeBitsToBuffer(accumData, 6, buf, &bitLen);
+		}
+		result->mode = qrcodegen_Mode_ALPHANUMERIC;
+		goto done;
+	}
+	
+	// Byte mode: copy the characters seen so far, then the rest
+	for (i = 0; text[i] != '\0'; i++) {
+		if (i >= bufLen)
+			return false;
+		buf[i] = (uint8_t)text[i];
+	}
+	bitLen = (int)i * 8;
+	result->mode = qrcodegen_Mode_BYTE;
+	
+done:
+	result->numChars = (int)i;
+	result->bitLength = bitLen;
+	result->data = buf;
+	assert(bitLen == calcSegmentBitLength(result->mode, i));
+	return true;
 }
 
 
@@ -180,6 +307,224 @@ bool qrcodegen_encodeBinary(uint8_t dataAndTemp[], size_t dataLen, uint8_t qrcod
 }
 
 
+// Public function - see documentation comment in header file.
+size_t qrcodegen_encodeTextBatch(const char *const texts[], size_t count, uint8_t tempBuffer[],
+		uint8_t arena[], size_t arenaLen, struct qrcodegen_BatchItem items[],
+		enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl) {
+	assert((texts != NULL && items != NULL) || count == 0);
+	assert(qrcodegen_VERSION_MIN <= minVersion && minVersion <= maxVersion && maxVersion <= qrcodegen_VERSION_MAX);
+	
+	size_t bufLen = (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(maxVersion);
+	size_t used = 0;
+	for (size_t i = 0; i < count; i++) {
+		struct qrcodegen_BatchItem *item = &items[i];
+		item->offset = 0;
+		
+		// Plan the version before looking at the arena, so that a text that can never be stored
+		// is told apart from one that only lacks the space left by the earlier texts
+		struct qrcodegen_Segment seg;
+		size_t numSegs = texts[i][0] == '\0' ? 0 : 1;  // An empty text has no segments, as in qrcodegen_encodeText()
+		struct qrcodegen_Plan plan;
+		if ((numSegs > 0 && !makeTextSegment(texts[i], tempBuffer, bufLen, &seg))
+				|| !qrcodegen_planSegments(&seg, numSegs, ecl, minVersion, maxVersion, boostEcl, &plan)
+				|| (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(plan.version) > arenaLen) {
+			item->status = qrcodegen_BatchStatus_DATA_TOO_LONG;
+			continue;
+		}
+		size_t qrcodeLen = (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(plan.version);
+		if (qrcodeLen > arenaLen - used) {
+			item->status = qrcodegen_BatchStatus_ARENA_FULL;
+			continue;
+		}
+		
+		// The planned version is the smallest that fits, so encoding at it alone gives the same QR Code
+		uint8_t *qrcode = &arena[used];
+		bool ok = qrcodegen_encodeSegmentsAdvanced(&seg, numSegs, ecl, plan.version, plan.version,
+			mask, boostEcl, tempBuffer, qrcode);
+		assert(ok);  (void)ok;
+		item->status = qrcodegen_BatchStatus_OK;
+		item->offset = used;
+		used += qrcodeLen;
+	}
+	return used;
+}
+
+
+// Public function - see documentation comment in header file.
+void qrcodegen_initCache(struct qrcodegen_Cache *cache, struct qrcodegen_CacheSlot slots[], size_t numSlots,
+		uint8_t data[], size_t maxTextLen, int maxVersion) {
+	assert(cache != NULL && ((slots != NULL && data != NULL) || numSlots == 0));
+	assert(qrcodegen_VERSION_MIN <= maxVersion && maxVersion <= qrcodegen_VERSION_MAX);
+	for (size_t i = 0; i < numSlots; i++)
+		slots[i].lastUse = 0;
+	cache->slots = slots;
+	cache->data = data;
+	cache->numSlots = numSlots;
+	cache->maxTextLen = maxTextLen;
+	cache->qrcodeLen = (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(maxVersion);
+	cache->clock = 0;
+	cache->hits = 0;
+	cache->misses = 0;
+	cache->evictions = 0;
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_encodeTextCached(struct qrcodegen_Cache *cache, const char *text, uint8_t tempBuffer[], uint8_t qrcode[],
+		enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl) {
+	assert(cache != NULL && text != NULL);
+	assert(qrcodegen_VERSION_MIN <= minVersion && minVersion <= maxVersion && maxVersion <= qrcodegen_VERSION_MAX);
+	assert(0 <= (int)ecl && (int)ecl <= 3 && -1 <= (int)mask && (int)mask <= 7);
+	
+	struct qrcodegen_CacheSlot key;
+	key.textLen = strlen(text);
+	key.ecl = (int8_t)ecl;
+	key.minVersion = (int8_t)minVersion;
+	key.maxVersion = (int8_t)maxVersion;
+	key.mask = (int8_t)mask;
+	key.boostEcl = boostEcl;
+	key.hash = hashCacheKey(text, key.textLen, &key);
+	size_t stride = cache->maxTextLen + cache->qrcodeLen;
+	
+	// Look for the entry, and remember the least recently used slot in case it's absent
+	size_t victim = 0;
+	for (size_t i = 0; i < cache->numSlots; i++) {
+		struct qrcodegen_CacheSlot *slot = &cache->slots[i];
+		const uint8_t *entry = &cache->data[i * stride];
+		if (slot->lastUse != 0 && slot->hash == key.hash && slot->textLen == key.textLen
+				&& slot->ecl == key.ecl && slot->minVersion == key.minVersion && slot->maxVersion == key.maxVersion
+				&& slot->mask == key.mask && slot->boostEcl == key.boostEcl
+				&& memcmp(entry, text, key.textLen * sizeof(char)) == 0) {
+			cache->hits++;
+			slot->lastUse = ++cache->clock;
+			const uint8_t *stored = &entry[cache->maxTextLen];
+			int size = qrcodegen_getSize(stored);
+			memcpy(qrcode, stored, (size_t)(size * size + 7) / 8 + 1);
+			return true;
+		}
+		if (slot->lastUse < cache->slots[victim].lastUse)
+			victim = i;
+	}
+	
+	cache->misses++;
+	if (!qrcodegen_encodeText(text, tempBuffer, qrcode, ecl, minVersion, maxVersion, mask, boostEcl))
+		return false;
+	int size = qrcodegen_getSize(qrcode);
+	size_t qrcodeLen = (size_t)(size * size + 7) / 8 + 1;
+	if (cache->numSlots == 0 || key.textLen > cache->maxTextLen || qrcodeLen > cache->qrcodeLen)
+		return true;
+	
+	// Store the text and QR Code in the victim slot
+	struct qrcodegen_CacheSlot *slot = &cache->slots[victim];
+	if (slot->lastUse != 0)
+		cache->evictions++;
+	*slot = key;
+	slot->lastUse = ++cache->clock;
+	uint8_t *entry = &cache->data[victim * stride];
+	memcpy(entry, text, key.textLen * sizeof(char));
+	memcpy(&entry[cache->maxTextLen], qrcode, qrcodeLen);
+	return true;
+}
+
+
+// Returns a 32-bit FNV-1a hash of the given text bytes and the encoding parameters in the given slot.
+static uint32_t hashCacheKey(const char *text, size_t len, const struct qrcodegen_CacheSlot *params) {
+	uint32_t result = UINT32_C(2166136261);
+	for (size_t i = 0; i < len; i++)
+		result = (result ^ (uint8_t)text[i]) * UINT32_C(16777619);
+	int8_t fields[] = {params->ecl, params->minVersion, params->maxVersion, params->mask, (int8_t)params->boostEcl};
+	for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++)
+		result = (result ^ (uint8_t)fields[i]) * UINT32_C(16777619);
+	return result;
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_encodeBinaryFragments(const struct qrcodegen_ByteFragment fragments[], size_t count,
+		uint8_t tempBuffer[], uint8_t qrcode[],
+		enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl) {
+	assert(fragments != NULL || count == 0);
+	assert(qrcodegen_VERSION_MIN <= minVersion && minVersion <= maxVersion && maxVersion <= qrcodegen_VERSION_MAX);
+	assert(0 <= (int)ecl && (int)ecl <= 3 && -1 <= (int)mask && (int)mask <= 7);
+	
+	// Describe the whole byte segment without its data, which the planner doesn't read
+	size_t dataLen = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (fragments[i].len > (size_t)INT16_MAX - dataLen) {
+			qrcode[0] = 0;  // Set size to invalid value for safety
+			return false;
+		}
+		dataLen += fragments[i].len;
+	}
+	struct qrcodegen_Segment seg;
+	seg.mode = qrcodegen_Mode_BYTE;
+	seg.bitLength = calcSegmentBitLength(seg.mode, dataLen);
+	seg.numChars = (int)dataLen;
+	seg.data = NULL;
+	struct qrcodegen_Plan plan;
+	if (seg.bitLength == -1 || !qrcodegen_planSegments(&seg, 1, ecl, minVersion, maxVersion, false, &plan)) {
+		qrcode[0] = 0;  // Set size to invalid value for safety
+		return false;
+	}
+	int version = plan.version;
+	
+	// Write the segment header, then copy each fragment into the data bit string
+	memset(qrcode, 0, (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(version) * sizeof(qrcode[0]));
+	int bitLen = 0;
+	appendBitsToBuffer((unsigned int)seg.mode, 4, qrcode, &bitLen);
+	appendBitsToBuffer((unsigned int)seg.numChars, numCharCountBits(seg.mode, version), qrcode, &bitLen);
+	for (size_t i = 0; i < count; i++)
+		appendDataToBuffer(fragments[i].data, (int)fragments[i].len * 8, qrcode, &bitLen);
+	assert(bitLen == plan.dataUsedBits);
+	finishEncoding(bitLen, version, ecl, mask, boostEcl, false, tempBuffer, qrcode);
+	return true;
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_encodeTextOptimally(const char *text, uint8_t tempBuffer[], uint8_t qrcode[],
+		enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl) {
+	assert(text != NULL);
+	assert(qrcodegen_VERSION_MIN <= minVersion && minVersion <= maxVersion && maxVersion <= qrcodegen_VERSION_MAX);
+	assert(0 <= (int)ecl && (int)ecl <= 3 && -1 <= (int)mask && (int)mask <= 7);
+	
+	size_t textLen = strlen(text);
+	if (textLen == 0)
+		return qrcodegen_encodeSegmentsAdvanced(NULL, 0, ecl, minVersion, maxVersion, mask, boostEcl, tempBuffer, qrcode);
+	// Every character costs at least 10/3 bits, so a longer text can't fit. This
+	// also bounds the work area needed by computeCharacterModes() and in tempBuffer.
+	if (textLen > (size_t)getNumDataCodewords(maxVersion, ecl) * 8 * 3 / 10)
+		goto fail;
+	
+	// Iterate through version numbers, and find the optimal
+	// character modes whenever the segment header sizes change
+	int version, dataUsedBits = -1;
+	for (version = minVersion; ; version++) {
+		if (version == minVersion || version == 10 || version == 27) {
+			computeCharacterModes(text, textLen, version, tempBuffer);
+			dataUsedBits = getTotalBitsForModes(tempBuffer, textLen, version);
+		}
+		int dataCapacityBits = qrcodegen_getDataCapacityBits(version, ecl);  // Number of data bits available
+		if (dataUsedBits != -1 && dataUsedBits <= dataCapacityBits)
+			break;  // This version number is found to be suitable
+		if (version >= maxVersion)  // All versions in the range could not fit the given text
+			goto fail;
+	}
+	
+	// Write the segments straight into the data area
+	memset(qrcode, 0, (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(version) * sizeof(qrcode[0]));
+	int bitLen = 0;
+	appendSegmentsForModes(text, textLen, tempBuffer, version, qrcode, &bitLen);
+	assert(bitLen == dataUsedBits);
+	finishEncoding(bitLen, version, ecl, mask, boostEcl, false, tempBuffer, qrcode);
+	return true;
+	
+fail:
+	qrcode[0] = 0;  // Set size to invalid value for safety
+	return false;
+}
+
+
 // Appends the given number of low-order bits of the given value to the given byte-based
 // bit buffer, increasing the bit length. Requires 0 <= numBits <= 16 and val < 2^numBits.
 testable void appendBitsToBuffer(unsigned int val, int numBits, uint8_t buffer[], int *bitLen) {
@@ -189,6 +534,43 @@ testable void appendBitsToBuffer(unsigned int val, int numBits, uint8_t buffer[]
 }
 
 
+// Appends the first numBits bits of the given big-endian bit string to the given byte-based bit buffer,
+// like appendBitsToBuffer(). The buffer must be zero from byte *bitLen / 8 onward. Data that starts on
+// a byte boundary is copied with memcpy(); otherwise each whole data byte is shifted across two buffer bytes.
+testable void appendDataToBuffer(const uint8_t data[], int numBits, uint8_t buffer[], int *bitLen) {
+	assert(0 <= numBits && (data != NULL || numBits == 0));
+	int numBytes = numBits / 8;
+	int shift = *bitLen % 8;
+	uint8_t *p = &buffer[*bitLen / 8];
+	if (shift == 0) {
+		if (numBytes > 0)
+			memcpy(p, data, (size_t)numBytes * sizeof(data[0]));
+	} else {
+		for (int i = 0; i < numBytes; i++) {
+			unsigned int word = (unsigned int)data[i] << (8 - shift);  // 16-bit window over p[i : i + 2]
+			p[i] |= (uint8_t)(word >> 8);
+			p[i + 1] = (uint8_t)word;
+		}
+	}
+	*bitLen += numBytes * 8;
+	int remainder = numBits % 8;
+	if (remainder > 0)
+		appendBitsToBuffer((unsigned int)data[numBytes] >> (8 - remainder), remainder, buffer, bitLen);
+}
+
+
+// Same as appendBitsToBuffer(), except that the buffer need not be zeroed beyond the current
+// bit length, because each byte is cleared when the first bit is written into it.
+static void writeBitsToBuffer(unsigned int val, int numBits, uint8_t buffer[], int *bitLen) {
+	assert(0 <= numBits && numBits <= 16 && (unsigned long)val >> numBits == 0);
+	for (int i = numBits - 1; i >= 0; i--, (*bitLen)++) {
+		if ((*bitLen & 7) == 0)
+			buffer[*bitLen >> 3] = 0;
+		buffer[*bitLen >> 3] |= ((val >> i) & 1) << (7 - (*bitLen & 7));
+	}
+}
+
+
 
 /*---- Low-level QR Code encoding functions ----*/
 
@@ -203,61 +585,200 @@ bool qrcodegen_encodeSegments(const struct qrcodegen_Segment segs[], size_t len,
 // Public function - see documentation comment in header file.
 bool qrcodegen_encodeSegmentsAdvanced(const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl,
 		int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl, uint8_t tempBuffer[], uint8_t qrcode[]) {
+	return qrcodegen_encodeSegmentsWithPrefix(NULL, segs, len, ecl,
+		minVersion, maxVersion, mask, boostEcl, tempBuffer, qrcode);
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_encodeSegmentsWithPrefix(const struct qrcodegen_Prefix *prefix,
+		const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl, int minVersion, int maxVersion,
+		enum qrcodegen_Mask mask, bool boostEcl, uint8_t tempBuffer[], uint8_t qrcode[]) {
+	return encodeSegmentsWithLayout(prefix, segs, len, ecl,
+		minVersion, maxVersion, mask, boostEcl, false, tempBuffer, qrcode);
+}
+
+
+// Implements qrcodegen_encodeSegmentsWithPrefix() and qrcodegen_encodeSegmentsAligned(),
+// writing the result in the row-aligned layout iff rowAligned is true.
+static bool encodeSegmentsWithLayout(const struct qrcodegen_Prefix *prefix,
+		const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl, int minVersion, int maxVersion,
+		enum qrcodegen_Mask mask, bool boostEcl, bool rowAligned, uint8_t tempBuffer[], uint8_t qrcode[]) {
 	assert(segs != NULL || len == 0);
 	assert(qrcodegen_VERSION_MIN <= minVersion && minVersion <= maxVersion && maxVersion <= qrcodegen_VERSION_MAX);
 	assert(0 <= (int)ecl && (int)ecl <= 3 && -1 <= (int)mask && (int)mask <= 7);
 	
 	// Find the minimal version number to use
-	int version, dataUsedBits;
-	for (version = minVersion; ; version++) {
-		int dataCapacityBits = getNumDataCodewords(version, ecl) * 8;  // Number of data bits available
-		dataUsedBits = getTotalBits(segs, len, version);
-		if (dataUsedBits != -1 && dataUsedBits <= dataCapacityBits)
-			break;  // This version number is found to be suitable
-		if (version >= maxVersion) {  // All versions in the range could not fit the given data
-			qrcode[0] = 0;  // Set size to invalid value for safety
-			return false;
-		}
-	}
-	assert(dataUsedBits != -1);
-	
-	// Increase the error correction level while the data still fits in the current version number
-	for (int i = (int)qrcodegen_Ecc_MEDIUM; i <= (int)qrcodegen_Ecc_HIGH; i++) {  // From low to high
-		if (boostEcl && dataUsedBits <= getNumDataCodewords(version, (enum qrcodegen_Ecc)i) * 8)
-			ecl = (enum qrcodegen_Ecc)i;
+	struct qrcodegen_Plan plan;
+	if (!planWithPrefix(prefix, segs, len, ecl, minVersion, maxVersion, false, &plan)) {
+		qrcode[0] = 0;  // Set size to invalid value for safety
+		qrcode[1] = 0;
+		return false;
 	}
+	int version = plan.version;
 	
-	// Concatenate all segments to create the data bit string
+	// Copy the prefix's bytes, then concatenate all segments to create the data bit string
 	memset(qrcode, 0, (size_t)qrcodegen_BUFFER_LEN_FOR_VERSION(version) * sizeof(qrcode[0]));
 	int bitLen = 0;
+	if (prefix != NULL) {
+		int band = getBandIndex(version);
+		bitLen = prefix->bitLength[band];
+		memcpy(qrcode, prefix->data[band], (size_t)(bitLen + 7) / 8 * sizeof(qrcode[0]));
+	}
 	for (size_t i = 0; i < len; i++) {
 		const struct qrcodegen_Segment *seg = &segs[i];
 		appendBitsToBuffer((unsigned int)seg->mode, 4, qrcode, &bitLen);
 		appendBitsToBuffer((unsigned int)seg->numChars, numCharCountBits(seg->mode, version), qrcode, &bitLen);
-		for (int j = 0; j < seg->bitLength; j++) {
-			int bit = (seg->data[j >> 3] >> (7 - (j & 7))) & 1;
-			appendBitsToBuffer((unsigned int)bit, 1, qrcode, &bitLen);
+		appendDataToBuffer(seg->data, seg->bitLength, qrcode, &bitLen);
+	}
+	assert(bitLen == plan.dataUsedBits);
+	finishEncoding(bitLen, version, ecl, mask, boostEcl, rowAligned, tempBuffer, qrcode);
+	return true;
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_planSegments(const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl,
+		int minVersion, int maxVersion, bool boostEcl, struct qrcodegen_Plan *result) {
+	return planWithPrefix(NULL, segs, len, ecl, minVersion, maxVersion, boostEcl, result);
+}
+
+
+// Computes the plan for the given prefix (which can be NULL) followed by the given segments.
+// This implements qrcodegen_planSegments() and qrcodegen_encodeSegmentsWithPrefix().
+static bool planWithPrefix(const struct qrcodegen_Prefix *prefix, const struct qrcodegen_Segment segs[], size_t len,
+		enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, bool boostEcl, struct qrcodegen_Plan *result) {
+	assert(segs != NULL || len == 0);
+	assert(qrcodegen_VERSION_MIN <= minVersion && minVersion <= maxVersion && maxVersion <= qrcodegen_VERSION_MAX);
+	assert(0 <= (int)ecl && (int)ecl <= 3 && result != NULL);
+	
+	// Find the minimal version number to use, summing the segments only once per version band
+	static const int BAND_STARTS[] = {1, 10, 27, 41};
+	const int16_t *capacities = NUM_DATA_CODEWORDS[(int)ecl];
+	for (int i = 0; i < 3; i++) {
+		int lo = BAND_STARTS[i] > minVersion ? BAND_STARTS[i] : minVersion;
+		int hi = BAND_STARTS[i + 1] - 1 < maxVersion ? BAND_STARTS[i + 1] - 1 : maxVersion;
+		if (lo > hi)
+			continue;
+		int dataUsedBits = getTotalBits(segs, len, lo);
+		if (prefix != NULL && dataUsedBits != -1) {  // Add the prefix's cached length
+			int prefixBits = prefix->bitLength[i];
+			dataUsedBits = prefixBits == -1 ? -1 : dataUsedBits + prefixBits;
+		}
+		if (dataUsedBits == -1 || dataUsedBits > capacities[hi] * 8)
+			continue;
+		
+		// Binary search for the first version in [lo, hi] whose capacity fits
+		while (lo < hi) {
+			int mid = (lo + hi) / 2;
+			if (dataUsedBits <= capacities[mid] * 8)
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+		result->version = lo;
+		result->ecl = ecl;
+		result->dataUsedBits = dataUsedBits;
+		
+		// Increase the error correction level while the data still fits in the current version number
+		for (int j = (int)qrcodegen_Ecc_MEDIUM; j <= (int)qrcodegen_Ecc_HIGH; j++) {  // From low to high
+			if (boostEcl && dataUsedBits <= NUM_DATA_CODEWORDS[j][lo] * 8)
+				result->ecl = (enum qrcodegen_Ecc)j;
 		}
+		result->dataCapacityBits = NUM_DATA_CODEWORDS[(int)result->ecl][lo] * 8;
+		return true;
+	}
+	return false;  // All versions in the range could not fit the given data
+}
+
+
+// Public function - see documentation comment in header file.
+int qrcodegen_getDataCapacityBits(int version, enum qrcodegen_Ecc ecl) {
+	assert(qrcodegen_VERSION_MIN <= version && version <= qrcodegen_VERSION_MAX);
+	assert(0 <= (int)ecl && (int)ecl <= 3);
+	return NUM_DATA_CODEWORDS[(int)ecl][version] * 8;
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_makePrefix(const struct qrcodegen_Segment segs[], size_t len,
+		uint8_t buf[], size_t bufLen, struct qrcodegen_Prefix *result) {
+	assert(segs != NULL || len == 0);
+	assert(buf != NULL && result != NULL);
+	
+	static const int BAND_LAST_VERSIONS[] = {9, 26, 40};
+	bool fitsAny = false;
+	size_t offset = 0;
+	for (int i = 0; i < 3; i++) {
+		// The character count widths are the same within a band, so encode at its largest version
+		int version = BAND_LAST_VERSIONS[i];
+		int bits = getTotalBits(segs, len, version);
+		result->bitLength[i] = -1;
+		result->data[i] = NULL;
+		if (bits == -1 || bits > NUM_DATA_CODEWORDS[(int)qrcodegen_Ecc_LOW][version] * 8)
+			continue;
+		size_t numBytes = (size_t)(bits + 7) / 8;
+		if (numBytes > bufLen - offset)
+			return false;
+		uint8_t *data = &buf[offset];
+		memset(data, 0, numBytes * sizeof(data[0]));
+		int bitLen = 0;
+		for (size_t j = 0; j < len; j++) {
+			const struct qrcodegen_Segment *seg = &segs[j];
+			appendBitsToBuffer((unsigned int)seg->mode, 4, data, &bitLen);
+			appendBitsToBuffer((unsigned int)seg->numChars, numCharCountBits(seg->mode, version), data, &bitLen);
+			appendDataToBuffer(seg->data, seg->bitLength, data, &bitLen);
+		}
+		assert(bitLen == bits);
+		result->bitLength[i] = bits;
+		result->data[i] = data;
+		offset += numBytes;
+		fitsAny = true;
+	}
+	return fitsAny;
+}
+
+
+// Returns the index of the version band that has the same character count widths as the given version.
+static int getBandIndex(int version) {
+	assert(qrcodegen_VERSION_MIN <= version && version <= qrcodegen_VERSION_MAX);
+	return version < 10 ? 0 : (version < 27 ? 1 : 2);
+}
+
+
+// Given the data bit string qrcode[0 : bitLen] of a QR Code at the given version (with the rest of
+// the buffer zeroed), optionally boosts the error correction level, adds the terminator and padding,
+// computes ECC, draws all modules, and applies the given mask or the automatically chosen one.
+// The modules are drawn in the row-aligned layout iff rowAligned is true; the function
+// modules map in tempBuffer always uses the packed layout, which is shorter.
+static void finishEncoding(int bitLen, int version, enum qrcodegen_Ecc ecl, enum qrcodegen_Mask mask,
+		bool boostEcl, bool rowAligned, uint8_t tempBuffer[], uint8_t qrcode[]) {
+	// Increase the error correction level while the data still fits in the current version number
+	for (int i = (int)qrcodegen_Ecc_MEDIUM; i <= (int)qrcodegen_Ecc_HIGH; i++) {  // From low to high
+		if (boostEcl && bitLen <= qrcodegen_getDataCapacityBits(version, (enum qrcodegen_Ecc)i))
+			ecl = (enum qrcodegen_Ecc)i;
 	}
-	assert(bitLen == dataUsedBits);
 	
 	// Add terminator and pad up to a byte if applicable
-	int dataCapacityBits = getNumDataCodewords(version, ecl) * 8;
+	int dataCapacityBits = qrcodegen_getDataCapacityBits(version, ecl);
 	assert(bitLen <= dataCapacityBits);
 	int terminatorBits = dataCapacityBits - bitLen;
 	if (terminatorBits > 4)
 		terminatorBits = 4;
-	appendBitsToBuffer(0, terminatorBits, qrcode, &bitLen);
-	appendBitsToBuffer(0, (8 - bitLen % 8) % 8, qrcode, &bitLen);
-	assert(bitLen % 8 == 0);
+	bitLen += terminatorBits;  // The buffer is already zero here
+	bitLen = (bitLen + 7) / 8 * 8;
 	
 	// Pad with alternating bytes until data capacity is reached
-	for (uint8_t padByte = 0xEC; bitLen < dataCapacityBits; padByte ^= 0xEC ^ 0x11)
-		appendBitsToBuffer(padByte, 8, qrcode, &bitLen);
+	uint8_t padByte = 0xEC;
+	for (int i = bitLen / 8; i < dataCapacityBits / 8; i++, padByte ^= 0xEC ^ 0x11)
+		qrcode[i] = padByte;
 	
 	// Compute ECC, draw modules
 	addEccAndInterleave(qrcode, version, ecl, tempBuffer);
-	initializeFunctionModules(version, qrcode);
+	if (rowAligned)
+		initializeFunctionModulesAligned(version, qrcode);
+	else
+		initializeFunctionModules(version, qrcode);
 	drawCodewords(tempBuffer, getNumRawDataModules(version) / 8, qrcode);
 	drawLightFunctionModules(qrcode, version);
 	initializeFunctionModules(version, tempBuffer);
@@ -280,7 +801,175 @@ bool qrcodegen_encodeSegmentsAdvanced(const struct qrcodegen_Segment segs[], siz
 	assert(0 <= (int)mask && (int)mask <= 7);
 	applyMask(tempBuffer, qrcode, mask);  // Apply the final choice of mask
 	drawFormatBits(ecl, mask, qrcode);  // Overwrite old format bits
-	return true;
+}
+
+
+
+/*---- Optimal segmentation functions ----*/
+
+// Computing optimal modes saves the costs at the start of every block of this many characters
+#define qrcodegen_MODES_BLOCK_LEN 128
+// The longest text that qrcodegen_encodeTextOptimally() accepts is 23648 * 3 / 10 = 7094 characters
+#define qrcodegen_MODES_MAX_BLOCKS ((7094 + qrcodegen_MODES_BLOCK_LEN - 1) / qrcodegen_MODES_BLOCK_LEN)
+
+// Calculates the optimal mode for each character of text[0 : len] at the given version number, and stores
+// them in result[0 : ceil(len / 4)], packed as 2 bits per character in little endian (where 0 = byte,
+// 1 = alphanumeric, 2 = numeric). Instead of keeping the choices for every character, the forward pass
+// saves the costs at the start of each block, and the backward trace recomputes one block at a time.
+// Requires 1 <= len <= 7094.
+testable void computeCharacterModes(const char *text, size_t len, int version, uint8_t result[]) {
+	assert(1 <= len && len <= (size_t)qrcodegen_MODES_MAX_BLOCKS * qrcodegen_MODES_BLOCK_LEN);
+	static const enum qrcodegen_Mode modeTypes[] = {
+		qrcodegen_Mode_BYTE, qrcodegen_Mode_ALPHANUMERIC, qrcodegen_Mode_NUMERIC};  // Do not modify
+	
+	// Segment header sizes, measured in 1/6 bits
+	long headCosts[3];
+	for (int i = 0; i < 3; i++)
+		headCosts[i] = (4L + numCharCountBits(modeTypes[i], version)) * 6;
+	
+	// Calculate costs using dynamic programming, saving them at the start of every block
+	long blockCosts[qrcodegen_MODES_MAX_BLOCKS][3];
+	long costs[3];
+	memcpy(costs, headCosts, sizeof(costs));
+	for (size_t i = 0; i < len; i++) {
+		if (i % qrcodegen_MODES_BLOCK_LEN == 0)
+			memcpy(blockCosts[i / qrcodegen_MODES_BLOCK_LEN], costs, sizeof(costs));
+		characterModesStep(text[i], headCosts, costs);
+	}
+	
+	// Find optimal ending mode
+	int curMode = 0;
+	for (int i = 1; i < 3; i++) {
+		if (costs[i] < costs[curMode])
+			curMode = i;
+	}
+	
+	// Get optimal mode for each character by tracing backwards, one block at a time
+	memset(result, 0, (len + 3) / 4 * sizeof(result[0]));
+	for (size_t start = (len - 1) / qrcodegen_MODES_BLOCK_LEN * qrcodegen_MODES_BLOCK_LEN; ;
+			start -= qrcodegen_MODES_BLOCK_LEN) {
+		uint8_t choices[qrcodegen_MODES_BLOCK_LEN];
+		size_t blockLen = len - start;
+		if (blockLen > qrcodegen_MODES_BLOCK_LEN)
+			blockLen = qrcodegen_MODES_BLOCK_LEN;
+		memcpy(costs, blockCosts[start / qrcodegen_MODES_BLOCK_LEN], sizeof(costs));
+		for (size_t i = 0; i < blockLen; i++)
+			choices[i] = (uint8_t)characterModesStep(text[start + i], headCosts, costs);
+		for (size_t i = blockLen; i-- > 0; ) {
+			curMode = (choices[i] >> (curMode * 2)) & 3;
+			result[(start + i) >> 2] |= (uint8_t)(curMode << ((start + i) & 3) * 2);
+		}
+		if (start == 0)
+			break;
+	}
+}
+
+#undef qrcodegen_MODES_MAX_BLOCKS
+#undef qrcodegen_MODES_BLOCK_LEN
+
+
+// Extends the minimum costs (in 1/6 bits) of encoding a text prefix and ending in each of the
+// modes {byte, alphanumeric, numeric} by the given next character. Returns the mode chosen for
+// the character for each ending mode, packed as 2 bits per ending mode in little endian.
+static int characterModesStep(char c, const long headCosts[3], long costs[3]) {
+	long curCosts[3];
+	int charModes[3] = {-1, -1, -1};
+	{  // Always extend a byte mode segment
+		curCosts[0] = costs[0] + 8 * 6;
+		charModes[0] = 0;
+	}
+	// Extend a segment if possible
+	if (ALPHANUMERIC_MAP[(unsigned char)c] != -1) {  // Is alphanumeric
+		curCosts[1] = costs[1] + 33;  // 5.5 bits per alphanumeric char
+		charModes[1] = 1;
+	}
+	if ('0' <= c && c <= '9') {  // Is numeric
+		curCosts[2] = costs[2] + 20;  // 3.33 bits per digit
+		charModes[2] = 2;
+	}
+	
+	// Start new segment at the end to switch modes
+	for (int j = 0; j < 3; j++) {  // To mode
+		for (int k = 0; k < 3; k++) {  // From mode
+			long newCost = (curCosts[k] + 5) / 6 * 6 + headCosts[j];
+			if (charModes[k] != -1 && (charModes[j] == -1 || newCost < curCosts[j])) {
+				curCosts[j] = newCost;
+				charModes[j] = k;
+			}
+		}
+	}
+	memcpy(costs, curCosts, sizeof(curCosts));
+	return charModes[0] | charModes[1] << 2 | charModes[2] << 4;
+}
+
+
+// Returns the number of bits needed to encode a text of the given length at the given version as segments that
+// each cover a run of equal modes in the given packed array (see computeCharacterModes()). Returns -1 if a segment has
+// too many characters to fit its length field, or the total bits exceeds INT16_MAX.
+testable int getTotalBitsForModes(const uint8_t charModes[], size_t len, int version) {
+	static const enum qrcodegen_Mode modeTypes[] = {
+		qrcodegen_Mode_BYTE, qrcodegen_Mode_ALPHANUMERIC, qrcodegen_Mode_NUMERIC};
+	long result = 0;
+	for (size_t start = 0, end; start < len; start = end) {
+		end = nextModeRun(charModes, start, len);
+		enum qrcodegen_Mode mode = modeTypes[(charModes[start >> 2] >> (start & 3) * 2) & 3];
+		int ccbits = numCharCountBits(mode, version);
+		int dataBits = calcSegmentBitLength(mode, end - start);
+		if (dataBits == -1 || end - start >= (1UL << ccbits))
+			return -1;  // The segment's length doesn't fit the field's bit width
+		result += 4L + ccbits + dataBits;
+		if (result > INT16_MAX)
+			return -1;  // The sum might overflow an int type
+	}
+	return (int)result;
+}
+
+
+// Appends the segments for text[0 : len] at the given version to the given bit buffer, where each
+// segment covers a run of equal modes in the given packed array (see computeCharacterModes()).
+// Requires the segments to fit, as checked by getTotalBitsForModes().
+static void appendSegmentsForModes(const char *text, size_t len, const uint8_t charModes[],
+		int version, uint8_t buffer[], int *bitLen) {
+	static const enum qrcodegen_Mode modeTypes[] = {
+		qrcodegen_Mode_BYTE, qrcodegen_Mode_ALPHANUMERIC, qrcodegen_Mode_NUMERIC};
+	for (size_t start = 0, end; start < len; start = end) {
+		end = nextModeRun(charModes, start, len);
+		enum qrcodegen_Mode mode = modeTypes[(charModes[start >> 2] >> (start & 3) * 2) & 3];
+		appendBitsToBuffer((unsigned int)mode, 4, buffer, bitLen);
+		appendBitsToBuffer((unsigned int)(end - start), numCharCountBits(mode, version), buffer, bitLen);
+		if (mode == qrcodegen_Mode_NUMERIC) {
+			size_t i = start;
+			for (; end - i >= 3; i += 3) {
+				unsigned int group = ((unsigned int)(text[i] - '0') * 10
+					+ (unsigned int)(text[i + 1] - '0')) * 10 + (unsigned int)(text[i + 2] - '0');
+				appendBitsToBuffer(group, 10, buffer, bitLen);
+			}
+			if (end - i == 2)
+				appendBitsToBuffer((unsigned int)(text[i] - '0') * 10 + (unsigned int)(text[i + 1] - '0'), 7, buffer, bitLen);
+			else if (end - i == 1)
+				appendBitsToBuffer((unsigned int)(text[i] - '0'), 4, buffer, bitLen);
+		} else if (mode == qrcodegen_Mode_ALPHANUMERIC) {
+			size_t i = start;
+			for (; end - i >= 2; i += 2) {
+				unsigned int pair = (unsigned int)ALPHANUMERIC_MAP[(unsigned char)text[i]] * 45
+					+ (unsigned int)ALPHANUMERIC_MAP[(unsigned char)text[i + 1]];
+				appendBitsToBuffer(pair, 11, buffer, bitLen);
+			}
+			if (i < end)  // 1 character remaining
+				appendBitsToBuffer((unsigned int)ALPHANUMERIC_MAP[(unsigned char)text[i]], 6, buffer, bitLen);
+		} else
+			appendDataToBuffer((const uint8_t *)&text[start], (int)(end - start) * 8, buffer, bitLen);
+	}
+}
+
+
+// Returns the end index of the run of equal modes that begins at the given start index.
+static size_t nextModeRun(const uint8_t charModes[], size_t start, size_t len) {
+	int mode = (charModes[start >> 2] >> (start & 3) * 2) & 3;
+	size_t end = start + 1;
+	while (end < len && ((charModes[end >> 2] >> (end & 3) * 2) & 3) == mode)
+		end++;
+	return end;
 }
 
 
@@ -416,10 +1105,25 @@ testable uint8_t reedSolomonMultiply(uint8_t x, uint8_t y) {
 // Clears the given QR Code grid with light modules for the given
 // version's size, then marks every function module as dark.
 testable void initializeFunctionModules(int version, uint8_t qrcode[]) {
-	// Initialize QR Code
 	int qrsize = version * 4 + 17;
 	memset(qrcode, 0, (size_t)((qrsize * qrsize + 7) / 8 + 1) * sizeof(qrcode[0]));
 	qrcode[0] = (uint8_t)qrsize;
+	fillFunctionModules(version, qrcode);
+}
+
+
+// Clears the given QR Code grid with light modules in the row-aligned layout
+// for the given version's size, then marks every function module as dark.
+static void initializeFunctionModulesAligned(int version, uint8_t qrcode[]) {
+	memset(qrcode, 0, (size_t)qrcodegen_ALIGNED_BUFFER_LEN_FOR_VERSION(version) * sizeof(qrcode[0]));
+	qrcode[1] = (uint8_t)(version * 4 + 17);  // Leaving qrcode[0] as 0 marks the layout
+	fillFunctionModules(version, qrcode);
+}
+
+
+// Marks every function module of the given version as dark, in a grid that is already initialized.
+static void fillFunctionModules(int version, uint8_t qrcode[]) {
+	int qrsize = version * 4 + 17;
 	
 	// Fill horizontal and vertical timing patterns
 	fillRectangle(6, 0, 1, qrsize, qrcode);
@@ -454,7 +1158,7 @@ testable void initializeFunctionModules(int version, uint8_t qrcode[]) {
 // marked dark (namely by initializeFunctionModules()), because this may skip redrawing dark function modules.
 static void drawLightFunctionModules(uint8_t qrcode[], int version) {
 	// Draw horizontal and vertical timing patterns
-	int qrsize = qrcodegen_getSize(qrcode);
+	int qrsize = getGridSize(qrcode);
 	for (int i = 7; i < qrsize - 7; i += 2) {
 		setModuleBounded(qrcode, 6, i, false);
 		setModuleBounded(qrcode, i, 6, false);
@@ -516,8 +1220,7 @@ static void drawLightFunctionModules(uint8_t qrcode[], int version) {
 static void drawFormatBits(enum qrcodegen_Ecc ecl, enum qrcodegen_Mask mask, uint8_t qrcode[]) {
 	// Calculate error correction code and pack bits
 	assert(0 <= (int)mask && (int)mask <= 7);
-	static const int table[] = {1, 0, 3, 2};
-	int data = table[(int)ecl] << 3 | (int)mask;  // errCorrLvl is uint2, mask is uint3
+	int data = getFormatData(ecl, mask);
 	int rem = data;
 	for (int i = 0; i < 10; i++)
 		rem = (rem << 1) ^ ((rem >> 9) * 0x537);
@@ -534,7 +1237,7 @@ static void drawFormatBits(enum qrcodegen_Ecc ecl, enum qrcodegen_Mask mask, uin
 		setModuleBounded(qrcode, 14 - i, 8, getBit(bits, i));
 	
 	// Draw second copy
-	int qrsize = qrcodegen_getSize(qrcode);
+	int qrsize = getGridSize(qrcode);
 	for (int i = 0; i < 8; i++)
 		setModuleBounded(qrcode, qrsize - 1 - i, 8, getBit(bits, i));
 	for (int i = 8; i < 15; i++)
@@ -575,7 +1278,7 @@ static void fillRectangle(int left, int top, int width, int height, uint8_t qrco
 // Draws the raw codewords (including data and ECC) onto the given QR Code. This requires the initial state of
 // the QR Code to be dark at function modules and light at codeword modules (including unused remainder bits).
 static void drawCodewords(const uint8_t data[], int dataLen, uint8_t qrcode[]) {
-	int qrsize = qrcodegen_getSize(qrcode);
+	int qrsize = getGridSize(qrcode);
 	int i = 0;  // Bit index into the data
 	// Do the funny zigzag scan
 	for (int right = qrsize - 1; right >= 1; right -= 2) {  // Index of right column in each column pair
@@ -607,7 +1310,7 @@ static void drawCodewords(const uint8_t data[], int dataLen, uint8_t qrcode[]) {
 // QR Code needs exactly one (not zero, two, etc.) mask applied.
 static void applyMask(const uint8_t functionModules[], uint8_t qrcode[], enum qrcodegen_Mask mask) {
 	assert(0 <= (int)mask && (int)mask <= 7);  // Disallows qrcodegen_Mask_AUTO
-	int qrsize = qrcodegen_getSize(qrcode);
+	int qrsize = getGridSize(qrcode);
 	for (int y = 0; y < qrsize; y++) {
 		for (int x = 0; x < qrsize; x++) {
 			if (getModuleBounded(functionModules, x, y))
@@ -624,8 +1327,8 @@ static void applyMask(const uint8_t functionModules[], uint8_t qrcode[], enum qr
 				case 7:  invert = ((x + y) % 2 + x * y % 3) % 2 == 0;  break;
 				default:  assert(false);  return;
 			}
-			bool val = getModuleBounded(qrcode, x, y);
-			setModuleBounded(qrcode, x, y, val ^ invert);
+			int index = getModuleBitIndex(qrcode, x, y);
+			qrcode[index >> 3] ^= (uint8_t)((invert ? 1 : 0) << (index & 7));
 		}
 	}
 }
@@ -634,7 +1337,7 @@ static void applyMask(const uint8_t functionModules[], uint8_t qrcode[], enum qr
 // Calculates and returns the penalty score based on state of the given QR Code's current modules.
 // This is used by the automatic mask choice algorithm to find the mask pattern that yields the lowest score.
 static long getPenaltyScore(const uint8_t qrcode[]) {
-	int qrsize = qrcodegen_getSize(qrcode);
+	int qrsize = getGridSize(qrcode);
 	long result = 0;
 	
 	// Adjacent modules in row having same color, and finder-like patterns
@@ -766,22 +1469,41 @@ bool qrcodegen_getModule(const uint8_t qrcode[], int x, int y) {
 }
 
 
+// Public function - see documentation comment in header file.
+enum qrcodegen_Ecc qrcodegen_getErrorCorrectionLevel(const uint8_t qrcode[]) {
+	assert(qrcode != NULL);
+	int data = readFormatBits(qrcode);
+	if (data == -1)
+		return qrcodegen_Ecc_LOW;  // Damaged format bits, which qrcodegen_getMask() reports
+	static const enum qrcodegen_Ecc table[] = {qrcodegen_Ecc_MEDIUM, qrcodegen_Ecc_LOW, qrcodegen_Ecc_HIGH, qrcodegen_Ecc_QUARTILE};
+	return table[data >> 3];
+}
+
+
+// Public function - see documentation comment in header file.
+enum qrcodegen_Mask qrcodegen_getMask(const uint8_t qrcode[]) {
+	assert(qrcode != NULL);
+	int data = readFormatBits(qrcode);
+	if (data == -1)
+		return qrcodegen_Mask_AUTO;  // Damaged format bits
+	return (enum qrcodegen_Mask)(data & 7);
+}
+
+
 // Returns the color of the module at the given coordinates, which must be in bounds.
+// The grid can be in either the packed or the row-aligned layout.
 testable bool getModuleBounded(const uint8_t qrcode[], int x, int y) {
-	int qrsize = qrcode[0];
-	assert(21 <= qrsize && qrsize <= 177 && 0 <= x && x < qrsize && 0 <= y && y < qrsize);
-	int index = y * qrsize + x;
-	return getBit(qrcode[(index >> 3) + 1], index & 7);
+	int index = getModuleBitIndex(qrcode, x, y);
+	return getBit(qrcode[index >> 3], index & 7);
 }
 
 
 // Sets the color of the module at the given coordinates, which must be in bounds.
+// The grid can be in either the packed or the row-aligned layout.
 testable void setModuleBounded(uint8_t qrcode[], int x, int y, bool isDark) {
-	int qrsize = qrcode[0];
-	assert(21 <= qrsize && qrsize <= 177 && 0 <= x && x < qrsize && 0 <= y && y < qrsize);
-	int index = y * qrsize + x;
+	int index = getModuleBitIndex(qrcode, x, y);
 	int bitIndex = index & 7;
-	int byteIndex = (index >> 3) + 1;
+	int byteIndex = index >> 3;
 	if (isDark)
 		qrcode[byteIndex] |= 1 << bitIndex;
 	else
@@ -791,29 +1513,236 @@ testable void setModuleBounded(uint8_t qrcode[], int x, int y, bool isDark) {
 
 // Sets the color of the module at the given coordinates, doing nothing if out of bounds.
 testable void setModuleUnbounded(uint8_t qrcode[], int x, int y, bool isDark) {
-	int qrsize = qrcode[0];
+	int qrsize = getGridSize(qrcode);
 	if (0 <= x && x < qrsize && 0 <= y && y < qrsize)
 		setModuleBounded(qrcode, x, y, isDark);
 }
 
 
+// Returns the side length of the given QR Code grid in either layout. A zero first
+// byte (which is never a valid size) marks the row-aligned layout.
+static int getGridSize(const uint8_t qrcode[]) {
+	return qrcode[0] != 0 ? qrcode[0] : qrcode[1];
+}
+
+
+// Returns the index of the bit that holds the module at the given coordinates (which must be in bounds),
+// counting from the start of the buffer, for a grid in either the packed or the row-aligned layout.
+static int getModuleBitIndex(const uint8_t qrcode[], int x, int y) {
+	int qrsize = qrcode[0];
+	if (qrsize != 0) {  // Packed: the modules follow the size byte without gaps
+		assert(21 <= qrsize && qrsize <= 177 && 0 <= x && x < qrsize && 0 <= y && y < qrsize);
+		return 8 + y * qrsize + x;
+	}
+	qrsize = qrcode[1];  // Row-aligned: each row starts on a 64-bit boundary after the 8-byte header
+	assert(21 <= qrsize && qrsize <= 177 && 0 <= x && x < qrsize && 0 <= y && y < qrsize);
+	return 64 + y * ((qrsize + 63) >> 6 << 6) + x;
+}
+
+
 // Returns true iff the i'th bit of x is set to 1. Requires x >= 0 and 0 <= i <= 14.
 static bool getBit(int x, int i) {
 	return ((x >> i) & 1) != 0;
 }
 
 
+// Returns the 5 data bits (error correction level and mask) of the first copy of the format bits
+// of the given QR Code, or -1 if those 15 modules aren't a valid format codeword.
+static int readFormatBits(const uint8_t qrcode[]) {
+	int bits = 0;
+	for (int i = 0; i <= 5; i++)
+		bits |= getModuleBounded(qrcode, 8, i) << i;
+	bits |= getModuleBounded(qrcode, 8, 7) << 6;
+	bits |= getModuleBounded(qrcode, 8, 8) << 7;
+	bits |= getModuleBounded(qrcode, 7, 8) << 8;
+	for (int i = 9; i < 15; i++)
+		bits |= getModuleBounded(qrcode, 14 - i, 8) << i;
+	bits ^= 0x5412;
+	
+	// Recompute the error correction code of the data bits and compare
+	int data = bits >> 10;
+	int rem = data;
+	for (int i = 0; i < 10; i++)
+		rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+	return (data << 10 | rem) == bits ? data : -1;
+}
+
+
+// Returns the 5 data bits of the format bits for the given error correction level and mask.
+static int getFormatData(enum qrcodegen_Ecc ecl, enum qrcodegen_Mask mask) {
+	static const int table[] = {1, 0, 3, 2};
+	return table[(int)ecl] << 3 | (int)mask;  // errCorrLvl is uint2, mask is uint3
+}
+
+
+
+/*---- Row-aligned buffer layout ----*/
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_encodeTextAligned(const char *text, uint8_t tempBuffer[], uint8_t qrcode[],
+		enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl) {
+	return encodeTextWithLayout(text, tempBuffer, qrcode, ecl, minVersion, maxVersion, mask, boostEcl, true);
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_encodeSegmentsAligned(const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl,
+		int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl, uint8_t tempBuffer[], uint8_t qrcode[]) {
+	return encodeSegmentsWithLayout(NULL, segs, len, ecl,
+		minVersion, maxVersion, mask, boostEcl, true, tempBuffer, qrcode);
+}
+
+
+// Public function - see documentation comment in header file.
+int qrcodegen_getSizeAligned(const uint8_t qrcode[]) {
+	assert(qrcode != NULL && qrcode[0] == 0);
+	int result = qrcode[1];
+	assert((qrcodegen_VERSION_MIN * 4 + 17) <= result
+		&& result <= (qrcodegen_VERSION_MAX * 4 + 17));
+	return result;
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_getModuleAligned(const uint8_t qrcode[], int x, int y) {
+	assert(qrcode != NULL && qrcode[0] == 0);
+	int qrsize = qrcode[1];
+	return (0 <= x && x < qrsize && 0 <= y && y < qrsize) && getModuleBounded(qrcode, x, y);
+}
+
+
+// Public function - see documentation comment in header file.
+const uint8_t *qrcodegen_getRowAligned(const uint8_t qrcode[], int y) {
+	int qrsize = qrcodegen_getSizeAligned(qrcode);
+	assert(0 <= y && y < qrsize);  (void)qrsize;
+	return &qrcode[getModuleBitIndex(qrcode, 0, y) >> 3];
+}
+
+
+
+/*---- Serialization ----*/
+
+// Public function - see documentation comment in header file.
+size_t qrcodegen_serialize(const uint8_t qrcode[], bool dataRegionOnly, uint8_t result[], size_t resultLen) {
+	assert(qrcode != NULL && result != NULL);
+	int qrsize = qrcodegen_getSize(qrcode);
+	int version = (qrsize - 17) / 4;
+	size_t fullLen = (size_t)qrcodegen_SERIALIZED_LEN_FOR_VERSION(version);
+	if (resultLen < fullLen)
+		return 0;
+	enum qrcodegen_Mask mask = qrcodegen_getMask(qrcode);
+	if (mask == qrcodegen_Mask_AUTO)
+		return 0;  // The header can't describe a symbol whose format bits are damaged
+	result[0] = SERIALIZED_MAGIC;
+	result[1] = SERIALIZED_FORMAT_VERSION;
+	result[2] = (uint8_t)((dataRegionOnly ? 0x80 : 0) | (int)qrcodegen_getErrorCorrectionLevel(qrcode) << 3
+		| (int)mask);
+	if (!dataRegionOnly) {
+		memcpy(&result[3], qrcode, fullLen - 3);  // Includes the size byte
+		return fullLen;
+	}
+	
+	// Mark the function modules in the body, then pack the other modules over the marks in row-major order.
+	// This is safe because the k'th module outside the function patterns is never before the k'th module.
+	initializeFunctionModules(version, &result[3]);  // Also writes the size byte
+	uint8_t *body = &result[4];
+	int k = 0;
+	for (int y = 0; y < qrsize; y++) {
+		for (int x = 0; x < qrsize; x++) {
+			if (getModuleBounded(&result[3], x, y))
+				continue;
+			if (getModuleBounded(qrcode, x, y))
+				body[k >> 3] |= 1 << (k & 7);
+			else
+				body[k >> 3] &= (1 << (k & 7)) ^ 0xFF;
+			k++;
+		}
+	}
+	assert(k == getNumRawDataModules(version));
+	if ((k & 7) != 0)
+		body[k >> 3] &= (uint8_t)((1 << (k & 7)) - 1);  // Clear the marks after the last module
+	return (size_t)(4 + (k + 7) / 8);
+}
+
+
+// Public function - see documentation comment in header file.
+bool qrcodegen_deserialize(const uint8_t data[], size_t dataLen, uint8_t qrcode[], int maxVersion) {
+	assert(data != NULL && qrcode != NULL);
+	assert(qrcodegen_VERSION_MIN <= maxVersion && maxVersion <= qrcodegen_VERSION_MAX);
+	int version;
+	enum qrcodegen_Ecc ecl;
+	enum qrcodegen_Mask mask;
+	bool dataRegionOnly;
+	if (!parseSerializedHeader(data, dataLen, &version, &ecl, &mask, &dataRegionOnly) || version > maxVersion)
+		return false;
+	if (!dataRegionOnly) {
+		memcpy(qrcode, &data[3], dataLen - 3);
+		return true;
+	}
+	
+	// Same steps as finishing an encoding, with the modules outside the function patterns read in row-major order
+	initializeFunctionModules(version, qrcode);
+	int qrsize = qrcodegen_getSize(qrcode);
+	const uint8_t *body = &data[4];
+	int k = 0;
+	for (int y = 0; y < qrsize; y++) {
+		for (int x = 0; x < qrsize; x++) {
+			if (getModuleBounded(qrcode, x, y))
+				continue;  // Function module, which is dark for now
+			if (getBit(body[k >> 3], k & 7))
+				setModuleBounded(qrcode, x, y, true);
+			k++;
+		}
+	}
+	drawLightFunctionModules(qrcode, version);
+	drawFormatBits(ecl, mask, qrcode);
+	return true;
+}
+
+
+// Public function - see documentation comment in header file.
+const uint8_t *qrcodegen_viewSerialized(const uint8_t data[], size_t dataLen) {
+	assert(data != NULL);
+	int version;
+	enum qrcodegen_Ecc ecl;
+	enum qrcodegen_Mask mask;
+	bool dataRegionOnly;
+	if (!parseSerializedHeader(data, dataLen, &version, &ecl, &mask, &dataRegionOnly) || dataRegionOnly)
+		return NULL;
+	return &data[3];
+}
+
+
+// Checks the header and length of the given serialized QR Code and returns its fields, or returns false if they
+// are malformed. In the full layout, this also checks that the format bits of the modules match the header.
+static bool parseSerializedHeader(const uint8_t data[], size_t dataLen,
+		int *version, enum qrcodegen_Ecc *ecl, enum qrcodegen_Mask *mask, bool *dataRegionOnly) {
+	if (dataLen < 4 || data[0] != SERIALIZED_MAGIC || data[1] != SERIALIZED_FORMAT_VERSION || (data[2] & 0x60) != 0)
+		return false;
+	int qrsize = data[3];
+	if (qrsize < qrcodegen_VERSION_MIN * 4 + 17 || qrsize > qrcodegen_VERSION_MAX * 4 + 17 || (qrsize - 17) % 4 != 0)
+		return false;
+	*version = (qrsize - 17) / 4;
+	*ecl = (enum qrcodegen_Ecc)(data[2] >> 3 & 3);
+	*mask = (enum qrcodegen_Mask)(data[2] & 7);
+	*dataRegionOnly = (data[2] & 0x80) != 0;
+	if (*dataRegionOnly)
+		return dataLen == (size_t)(4 + (getNumRawDataModules(*version) + 7) / 8);
+	else {
+		return dataLen == (size_t)qrcodegen_SERIALIZED_LEN_FOR_VERSION(*version)
+			&& readFormatBits(&data[3]) == getFormatData(*ecl, *mask);
+	}
+}
+
+
 
 /*---- Segment handling ----*/
 
 // Public function - see documentation comment in header file.
 bool qrcodegen_isNumeric(const char *text) {
 	assert(text != NULL);
-	for (; *text != '\0'; text++) {
-		if (*text < '0' || *text > '9')
-			return false;
-	}
-	return true;
+	size_t len = strlen(text);
+	return numericPrefixLength(text, len) == len;
 }
 
 
@@ -821,13 +1750,32 @@ bool qrcodegen_isNumeric(const char *text) {
 bool qrcodegen_isAlphanumeric(const char *text) {
 	assert(text != NULL);
 	for (; *text != '\0'; text++) {
-		if (strchr(ALPHANUMERIC_CHARSET, *text) == NULL)
+		if (ALPHANUMERIC_MAP[(unsigned char)*text] == -1)
 			return false;
 	}
 	return true;
 }
 
 
+// Returns the number of leading characters in text[0 : len] that are in the range 0 to 9.
+// Whole 8-byte words are checked at once, and the scalar loop finds the exact stopping point.
+testable size_t numericPrefixLength(const char text[], size_t len) {
+	size_t i = 0;
+	for (; len - i >= 8; i += 8) {
+		uint64_t word;
+		memcpy(&word, &text[i], sizeof(word));
+		// A byte is a digit iff its high nibble is 3 and adding 6 does not carry out of its low nibble.
+		// (A carry between bytes can only come from a byte that already fails the first test.)
+		uint64_t bad = ((word & UINT64_C(0xF0F0F0F0F0F0F0F0)) ^ UINT64_C(0x3030303030303030))
+			| (((word + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0)) ^ UINT64_C(0x3030303030303030));
+		if (bad != 0)
+			break;
+	}
+	for (; i < len && '0' <= text[i] && text[i] <= '9'; i++);
+	return i;
+}
+
+
 // Public function - see documentation comment in header file.
 size_t qrcodegen_calcSegmentBufferSize(enum qrcodegen_Mode mode, size_t numChars) {
 	int temp = calcSegmentBitLength(mode, numChars);
@@ -900,12 +1848,28 @@ struct qrcodegen_Segment qrcodegen_makeNumeric(const char *digits, uint8_t buf[]
 		memset(buf, 0, ((size_t)bitLen + 7) / 8 * sizeof(buf[0]));
 	result.bitLength = 0;
 	
+	assert(numericPrefixLength(digits, len) == len);
+	
+	// Pack every 12 digits into 40 bits, which keeps the output aligned to whole bytes
+	size_t i = 0;
+	for (; len - i >= 12; i += 12, digits += 12) {
+		uint64_t accumData = 0;
+		for (int j = 0; j < 12; j += 3) {
+			unsigned int group = ((unsigned int)(digits[j] - '0') * 10
+				+ (unsigned int)(digits[j + 1] - '0')) * 10 + (unsigned int)(digits[j + 2] - '0');
+			accumData = accumData << 10 | group;
+		}
+		uint8_t *p = &buf[result.bitLength >> 3];
+		for (int j = 4; j >= 0; j--, accumData >>= 8)
+			p[j] = (uint8_t)accumData;
+		result.bitLength += 40;
+	}
+	
+	// Encode the remaining 0 to 11 digits
 	unsigned int accumData = 0;
 	int accumCount = 0;
 	for (; *digits != '\0'; digits++) {
-		char c = *digits;
-		assert('0' <= c && c <= '9');
-		accumData = accumData * 10 + (unsigned int)(c - '0');
+		accumData = accumData * 10 + (unsigned int)(*digits - '0');
 		accumCount++;
 		if (accumCount == 3) {
 			appendBitsToBuffer(accumData, 10, buf, &result.bitLength);
@@ -935,19 +1899,15 @@ struct qrcodegen_Segment qrcodegen_makeAlphanumeric(const char *text, uint8_t bu
 	result.bitLength = 0;
 	
 	unsigned int accumData = 0;
-	int accumCount = 0;
-	for (; *text != '\0'; text++) {
-		const char *temp = strchr(ALPHANUMERIC_CHARSET, *text);
-		assert(temp != NULL);
-		accumData = accumData * 45 + (unsigned int)(temp - ALPHANUMERIC_CHARSET);
-		accumCount++;
-		if (accumCount == 2) {
-			appendBitsToBuffer(accumData, 11, buf, &result.bitLength);
-			accumData = 0;
-			accumCount = 0;
-		}
+	for (size_t i = 0; i < len; i++) {
+		int val = ALPHANUMERIC_MAP[(unsigned char)text[i]];
+		assert(val != -1);
+		if (i % 2 == 0)
+			accumData = (unsigned int)val;
+		else  // Each pair of characters becomes 11 bits
+			appendBitsToBuffer(accumData * 45 + (unsigned int)val, 11, buf, &result.bitLength);
 	}
-	if (accumCount > 0)  // 1 character remaining
+	if (len % 2 == 1)  // 1 character remaining
 		appendBitsToBuffer(accumData, 6, buf, &result.bitLength);
 	assert(result.bitLength == bitLen);
 	result.data = buf;
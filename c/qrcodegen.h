@@ -42,7 +42,8 @@ extern "C" {
  * from 1 to 40, all 4 error correction levels, and 4 character encoding modes.
  * 
  * Ways to create a QR Code object:
- * - High level: Take the payload data and call qrcodegen_encodeText() or qrcodegen_encodeBinary().
+ * - High level: Take the payload data and call qrcodegen_encodeText(),
+ *   qrcodegen_encodeTextOptimally(), or qrcodegen_encodeBinary().
  * - Low level: Custom-make the list of segments and call
  *   qrcodegen_encodeSegments() or qrcodegen_encodeSegmentsAdvanced().
  * (Note that all ways require supplying the desired error correction level and various byte buffers.)
@@ -126,6 +127,122 @@ struct qrcodegen_Segment {
 };
 
 
+/* 
+ * The outcome of encoding one text of a batch with qrcodegen_encodeTextBatch().
+ */
+enum qrcodegen_BatchStatus {
+	// The QR Code was written to the arena at the item's offset
+	qrcodegen_BatchStatus_OK = 0,
+	// The text doesn't fit in any version in the requested range whose buffer fits in the whole arena
+	qrcodegen_BatchStatus_DATA_TOO_LONG,
+	// The text would fit in an empty arena, but not in the space left after the earlier texts
+	qrcodegen_BatchStatus_ARENA_FULL,
+};
+
+
+/* 
+ * Where one text's QR Code was placed by qrcodegen_encodeTextBatch().
+ */
+struct qrcodegen_BatchItem {
+	// The offset in the arena of this item's QR Code, which can be passed into
+	// qrcodegen_getSize() and qrcodegen_getModule(). Only valid if status is OK.
+	size_t offset;
+	
+	// Whether this text was encoded, and if not, why.
+	enum qrcodegen_BatchStatus status;
+};
+
+
+/* 
+ * The bookkeeping for one entry of a qrcodegen_Cache. The fields are private to the library.
+ */
+struct qrcodegen_CacheSlot {
+	uint64_t lastUse;  // The cache's clock value when this entry was last used, or 0 if empty
+	uint32_t hash;
+	size_t textLen;
+	int8_t ecl;
+	int8_t minVersion;
+	int8_t maxVersion;
+	int8_t mask;
+	bool boostEcl;
+};
+
+
+/* 
+ * A memo of recently encoded texts and their QR Codes, held in caller-provided arrays and
+ * set up by qrcodegen_initCache(). When full, the least recently used entry is replaced.
+ * A cache is not thread-safe; a multithreaded caller can give each thread its own cache,
+ * or guard a cache with a lock. The counters may be read and reset by the caller.
+ */
+struct qrcodegen_Cache {
+	// Private fields, set by qrcodegen_initCache().
+	struct qrcodegen_CacheSlot *slots;
+	uint8_t *data;
+	size_t numSlots;
+	size_t maxTextLen;
+	size_t qrcodeLen;
+	uint64_t clock;
+	
+	// The number of lookups that were found in the cache.
+	unsigned long hits;
+	
+	// The number of lookups that had to encode the text.
+	unsigned long misses;
+	
+	// The number of entries that were replaced to make room for another.
+	unsigned long evictions;
+};
+
+
+/* 
+ * One piece of a byte sequence that is stored in several separate buffers,
+ * in the manner of a POSIX iovec. Used by qrcodegen_encodeBinaryFragments().
+ */
+struct qrcodegen_ByteFragment {
+	// The bytes of this piece, which can be NULL if len is zero.
+	const uint8_t *data;
+	
+	// The number of bytes in this piece.
+	size_t len;
+};
+
+
+/* 
+ * The encoding parameters that qrcodegen_encodeSegmentsAdvanced() chooses
+ * for some data, as computed by qrcodegen_planSegments().
+ */
+struct qrcodegen_Plan {
+	// The chosen version number, in the range [1, 40].
+	int version;
+	
+	// The final error correction level, after any boost.
+	enum qrcodegen_Ecc ecl;
+	
+	// The number of bits used by the segment headers and data, excluding terminator and padding.
+	int dataUsedBits;
+	
+	// The number of data bits available at the chosen version and error correction level.
+	int dataCapacityBits;
+};
+
+
+/* 
+ * A sequence of segments that begins the data of many QR Codes, encoded ahead of time by
+ * qrcodegen_makePrefix() for each band of versions that uses the same character count widths
+ * (1-9, 10-26, 27-40). A prefix is only read when encoding, so one prefix (and its buffer)
+ * can be shared by any number of threads once it has been made.
+ */
+struct qrcodegen_Prefix {
+	// The number of bits that the segments take in each version band, including their
+	// headers, or -1 if the segments can't be used at the versions of that band.
+	int bitLength[3];
+	
+	// The encoded bits for each version band, packed in big endian and padded with zeros to
+	// a whole byte. These point into the caller's buffer. NULL where bitLength is -1.
+	const uint8_t *data[3];
+};
+
+
 
 /*---- Macro constants and functions ----*/
 
@@ -143,6 +260,35 @@ struct qrcodegen_Segment {
 // Use this more convenient value to avoid calculating tighter memory bounds for buffers.
 #define qrcodegen_BUFFER_LEN_MAX  qrcodegen_BUFFER_LEN_FOR_VERSION(qrcodegen_VERSION_MAX)
 
+// The worst-case number of bytes needed by qrcodegen_makePrefix() to store any prefix, which is
+// the sum of the low-ECC data capacities of versions 9, 26, and 40 (230 + 1370 + 2956 = 4556).
+#define qrcodegen_PREFIX_BUFFER_LEN_MAX  4556
+
+// Calculates the number of bytes needed for the data array of a qrcodegen_Cache with the given number
+// of slots, longest cacheable text length in bytes, and largest cacheable version, as a compile-time constant.
+#define qrcodegen_CACHE_DATA_LEN(numSlots, maxTextLen, maxVersion)  \
+	((numSlots) * ((maxTextLen) + qrcodegen_BUFFER_LEN_FOR_VERSION(maxVersion)))
+
+// Calculates the number of bytes in the serialized form of any QR Code up to and including the given version
+// number in the full layout, which is the larger layout, as a compile-time constant. This equals the header
+// length of 4 plus the packed modules, which is qrcodegen_BUFFER_LEN_FOR_VERSION(n) + 3.
+#define qrcodegen_SERIALIZED_LEN_FOR_VERSION(n)  (qrcodegen_BUFFER_LEN_FOR_VERSION(n) + 3)
+
+// The worst-case number of bytes in the serialized form of one QR Code, which equals 3921.
+#define qrcodegen_SERIALIZED_LEN_MAX  qrcodegen_SERIALIZED_LEN_FOR_VERSION(qrcodegen_VERSION_MAX)
+
+// Calculates the number of bytes in each row of a QR Code of the given version number in the row-aligned
+// buffer layout, which is the side length rounded up to a multiple of 64 bits, as a compile-time constant.
+#define qrcodegen_ALIGNED_ROW_BYTES_FOR_VERSION(n)  ((((n) * 4 + 17) + 63) / 64 * 8)
+
+// Calculates the number of bytes needed to store any QR Code up to and including the given version
+// number in the row-aligned buffer layout, as a compile-time constant. This is the 8-byte header
+// plus one padded row for each module row. Requires qrcodegen_VERSION_MIN <= n <= qrcodegen_VERSION_MAX.
+#define qrcodegen_ALIGNED_BUFFER_LEN_FOR_VERSION(n)  (8 + ((n) * 4 + 17) * qrcodegen_ALIGNED_ROW_BYTES_FOR_VERSION(n))
+
+// The worst-case number of bytes needed to store one QR Code in the row-aligned layout, which equals 4256.
+#define qrcodegen_ALIGNED_BUFFER_LEN_MAX  qrcodegen_ALIGNED_BUFFER_LEN_FOR_VERSION(qrcodegen_VERSION_MAX)
+
 
 
 /*---- Functions (high level) to generate QR Codes ----*/
@@ -188,6 +334,62 @@ bool qrcodegen_encodeText(const char *text, uint8_t tempBuffer[], uint8_t qrcode
 	enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl);
 
 
+/* 
+ * Encodes the given text string to a QR Code using an optimal sequence of segments,
+ * returning true if successful. If the data is too long to fit in any version
+ * in the given range at the given ECC level, then false is returned.
+ * 
+ * The input text must contain no NULs. Each byte is classified on its own, so that
+ * runs of digits and runs of alphanumeric characters can get their own segments while
+ * all other bytes (such as multi-byte UTF-8 sequences) are encoded in byte mode.
+ * The mode switches are chosen to minimize the total bit length, which can allow a
+ * smaller version than qrcodegen_encodeText() when the text mixes character classes.
+ * This can be considered as a sophisticated but slower replacement for qrcodegen_encodeText().
+ * 
+ * The parameters and the requirements on the arrays are the
+ * same as for qrcodegen_encodeText(), and so are the guarantees after the function returns.
+ * This function uses only a small and constant amount of stack memory beyond the given arrays.
+ */
+bool qrcodegen_encodeTextOptimally(const char *text, uint8_t tempBuffer[], uint8_t qrcode[],
+	enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl);
+
+
+/* 
+ * Encodes each of the given NUL-terminated texts like qrcodegen_encodeText() with the given parameters,
+ * packing the QR Codes back to back into arena[0 : arenaLen], and fills in items[i] for each texts[i].
+ * Each QR Code takes qrcodegen_BUFFER_LEN_FOR_VERSION() of its own version, not of maxVersion, and
+ * a text that can't be encoded is reported in its item without stopping the batch. Returns the
+ * number of arena bytes used. The tempBuffer must have a length of at least
+ * qrcodegen_BUFFER_LEN_FOR_VERSION(maxVersion), and must not overlap with the arena.
+ * 
+ * This function is single-threaded and keeps no state, so a caller with many threads can
+ * split the texts among them, giving each thread its own tempBuffer, arena, and items.
+ */
+size_t qrcodegen_encodeTextBatch(const char *const texts[], size_t count, uint8_t tempBuffer[],
+	uint8_t arena[], size_t arenaLen, struct qrcodegen_BatchItem items[],
+	enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl);
+
+
+/* 
+ * Sets up the given cache to keep its entries in slots[0 : numSlots] and in data, which must have
+ * a length of at least qrcodegen_CACHE_DATA_LEN(numSlots, maxTextLen, maxVersion). The cache
+ * is empty and its counters are zero afterward. The total memory used is bounded by these arrays.
+ */
+void qrcodegen_initCache(struct qrcodegen_Cache *cache, struct qrcodegen_CacheSlot slots[], size_t numSlots,
+	uint8_t data[], size_t maxTextLen, int maxVersion);
+
+
+/* 
+ * Encodes the given text like qrcodegen_encodeText() with the same parameters, requirements, and
+ * result, but first looks for the same text and parameters in the given cache. On a hit, the stored
+ * QR Code is copied into qrcode[] without encoding. On a miss, the text is encoded and then stored if
+ * its length is at most the cache's maxTextLen and its version is at most the cache's maxVersion.
+ * Texts that don't fit in the version range are not stored, and false is returned.
+ */
+bool qrcodegen_encodeTextCached(struct qrcodegen_Cache *cache, const char *text, uint8_t tempBuffer[], uint8_t qrcode[],
+	enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl);
+
+
 /* 
  * Encodes the given binary data to a QR Code, returning true if successful.
  * If the data is too long to fit in any version in the given range
@@ -227,6 +429,18 @@ bool qrcodegen_encodeBinary(uint8_t dataAndTemp[], size_t dataLen, uint8_t qrcod
 	enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl);
 
 
+/* 
+ * Encodes the concatenation of the given byte fragments as a single byte mode segment, and returns
+ * the same result as qrcodegen_encodeBinary() would for that concatenated data. Each fragment is
+ * copied straight into the data codewords in qrcode, so the caller doesn't need to assemble the
+ * payload in one contiguous buffer. The arrays tempBuffer and qrcode follow the same rules as
+ * qrcodegen_encodeText(); the fragments are only read and must not overlap with either array.
+ */
+bool qrcodegen_encodeBinaryFragments(const struct qrcodegen_ByteFragment fragments[], size_t count,
+	uint8_t tempBuffer[], uint8_t qrcode[],
+	enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl);
+
+
 /*---- Functions (low level) to generate QR Codes ----*/
 
 /* 
@@ -303,6 +517,50 @@ bool qrcodegen_encodeSegmentsAdvanced(const struct qrcodegen_Segment segs[], siz
 	int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl, uint8_t tempBuffer[], uint8_t qrcode[]);
 
 
+/* 
+ * Computes the version number and error correction level that qrcodegen_encodeSegmentsAdvanced()
+ * would choose for the given arguments, along with the data bits used and available, without
+ * touching any QR Code buffer. Returns true and fills in *result if the data fits in some version
+ * in the range, otherwise returns false. The segments are summed once for each version band that
+ * uses the same character count widths (1-9, 10-26, 27-40), and each band's smallest fitting version
+ * is found by binary search over a capacity table. This is a cheap way to reject oversized payloads.
+ * Requires 1 <= minVersion <= maxVersion <= 40, and segments that are valid for encoding.
+ */
+bool qrcodegen_planSegments(const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl,
+	int minVersion, int maxVersion, bool boostEcl, struct qrcodegen_Plan *result);
+
+
+/* 
+ * Returns the number of data bits that a QR Code of the given version number and error correction
+ * level can hold, which is the capacity for segment headers and data (not error correction).
+ * Requires 1 <= version <= 40. The result is in the range [72, 23648].
+ */
+int qrcodegen_getDataCapacityBits(int version, enum qrcodegen_Ecc ecl);
+
+
+/* 
+ * Encodes the given segments once for each version band into buf[0 : bufLen] and describes the result
+ * in *result, so that qrcodegen_encodeSegmentsWithPrefix() can copy the bits instead of encoding them.
+ * Returns true if successful. Returns false if the segments don't fit in a QR Code of any version, or
+ * if bufLen is too small; qrcodegen_PREFIX_BUFFER_LEN_MAX bytes are always enough. The segments' data
+ * buffers are no longer needed afterward, but buf must stay unchanged while the prefix is in use.
+ */
+bool qrcodegen_makePrefix(const struct qrcodegen_Segment segs[], size_t len,
+	uint8_t buf[], size_t bufLen, struct qrcodegen_Prefix *result);
+
+
+/* 
+ * Renders a QR Code representing the given prefix followed by the given suffix segments, with
+ * the same parameters, buffer rules, and result as qrcodegen_encodeSegmentsAdvanced(). The output
+ * is identical to encoding the concatenation of both segment lists, but the prefix bits are copied
+ * as whole bytes instead of being encoded again. The prefix may be NULL, which means no prefix.
+ * The prefix's buffer must not overlap with tempBuffer or qrcode.
+ */
+bool qrcodegen_encodeSegmentsWithPrefix(const struct qrcodegen_Prefix *prefix,
+	const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl, int minVersion, int maxVersion,
+	enum qrcodegen_Mask mask, bool boostEcl, uint8_t tempBuffer[], uint8_t qrcode[]);
+
+
 /* 
  * Tests whether the given string can be encoded as a segment in numeric mode.
  * A string is encodable iff each character is in the range 0 to 9.
@@ -380,6 +638,127 @@ int qrcodegen_getSize(const uint8_t qrcode[]);
 bool qrcodegen_getModule(const uint8_t qrcode[], int x, int y);
 
 
+/* 
+ * Returns the error correction level of the given QR Code, which is read from its format bits.
+ * If the first copy of the format bits isn't a valid codeword, then this returns qrcodegen_Ecc_LOW,
+ * and qrcodegen_getMask() tells such a damaged symbol apart by returning qrcodegen_Mask_AUTO.
+ */
+enum qrcodegen_Ecc qrcodegen_getErrorCorrectionLevel(const uint8_t qrcode[]);
+
+
+/* 
+ * Returns the mask pattern of the given QR Code, in the range [0, 7], which is read from its format bits.
+ * Returns qrcodegen_Mask_AUTO if the first copy of the format bits isn't a valid codeword.
+ */
+enum qrcodegen_Mask qrcodegen_getMask(const uint8_t qrcode[]);
+
+
+
+/*---- Functions for the row-aligned buffer layout ----*/
+
+/* 
+ * The row-aligned layout is a second format for the 'uint8_t qrcode[]' buffer, meant for code
+ * that processes whole rows of modules at a time. It has an 8-byte header, where byte 0 is
+ * always 0 (which tells it apart from the packed layout), byte 1 is the side length, and the
+ * other bytes are 0. Row y then starts at byte 8 + y * qrcodegen_ALIGNED_ROW_BYTES_FOR_VERSION(version),
+ * and the module at column x is bit (x % 8) of byte (x / 8) within that row. Each row is padded
+ * with light modules to a multiple of 64 bits, so a little-endian 64-bit load of row bytes
+ * [8*k : 8*k+8] yields modules [64*k : 64*k+64] with module x in bit (x % 64). If the array
+ * starts at an 8-byte aligned address, then every row does too.
+ * 
+ * The functions on the packed layout (such as qrcodegen_getSize(), qrcodegen_getModule(),
+ * and qrcodegen_serialize()) must not be given a buffer in this layout, and vice versa.
+ */
+
+
+/* 
+ * Encodes the given text string like qrcodegen_encodeText() with the same arguments, but
+ * writes the result directly in the row-aligned layout. The tempBuffer needs the same length
+ * as for qrcodegen_encodeText(), namely qrcodegen_BUFFER_LEN_FOR_VERSION(maxVersion), while qrcode
+ * needs a length of at least qrcodegen_ALIGNED_BUFFER_LEN_FOR_VERSION(maxVersion). The modules
+ * are identical to those that qrcodegen_encodeText() produces.
+ */
+bool qrcodegen_encodeTextAligned(const char *text, uint8_t tempBuffer[], uint8_t qrcode[],
+	enum qrcodegen_Ecc ecl, int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl);
+
+
+/* 
+ * Encodes the given segments like qrcodegen_encodeSegmentsAdvanced() with the same arguments,
+ * but writes the result directly in the row-aligned layout. The tempBuffer needs a length of at
+ * least qrcodegen_BUFFER_LEN_FOR_VERSION(maxVersion), and qrcode needs a length of at least
+ * qrcodegen_ALIGNED_BUFFER_LEN_FOR_VERSION(maxVersion).
+ */
+bool qrcodegen_encodeSegmentsAligned(const struct qrcodegen_Segment segs[], size_t len, enum qrcodegen_Ecc ecl,
+	int minVersion, int maxVersion, enum qrcodegen_Mask mask, bool boostEcl, uint8_t tempBuffer[], uint8_t qrcode[]);
+
+
+/* 
+ * Returns the side length of the given QR Code in the row-aligned layout, assuming that
+ * encoding succeeded. The result is in the range [21, 177].
+ */
+int qrcodegen_getSizeAligned(const uint8_t qrcode[]);
+
+
+/* 
+ * Returns the color of the module at the given coordinates of the given QR Code in the row-aligned
+ * layout, which is false for light or true for dark. If the given coordinates are out of bounds,
+ * then false (light) is returned.
+ */
+bool qrcodegen_getModuleAligned(const uint8_t qrcode[], int x, int y);
+
+
+/* 
+ * Returns a pointer to the first byte of row y of the given QR Code in the row-aligned layout, which
+ * is followed by the rest of the row's qrcodegen_ALIGNED_ROW_BYTES_FOR_VERSION(version) bytes.
+ * Requires 0 <= y < size.
+ */
+const uint8_t *qrcodegen_getRowAligned(const uint8_t qrcode[], int y);
+
+
+
+/*---- Functions to serialize QR Codes ----*/
+
+/* 
+ * The serialized form of a QR Code is a compact and stable binary format, which is the same in
+ * this library and the C++ library. It is a 4-byte header followed by packed module bits:
+ * - Byte 0 is 'Q' (0x51), and byte 1 is the format version, which is 1.
+ * - Byte 2 holds the mask in bits 0 to 2, the error correction level in bits 3 and 4 (as
+ *   the value of enum qrcodegen_Ecc), and in bit 7 whether only the data region is stored.
+ *   Bits 5 and 6 are 0.
+ * - Byte 3 is the size, so that in the full layout the bytes from byte 3 onward are a qrcode[] array.
+ * - In the full layout, the body holds all modules in the bit order of qrcode[]: module (x, y)
+ *   is bit (i % 8) of byte (i / 8) for i = y * size + x. In the data region layout, it holds only
+ *   the modules outside the function patterns, in the same order and bit packing, and a reader
+ *   redraws the function patterns and format bits from the header. Unused bits at the end are 0.
+ */
+
+
+/* 
+ * Writes the serialized form of the given QR Code to the given array and returns its length in bytes, in the
+ * data region layout if dataRegionOnly is true or else in the full layout. The array must have length at least
+ * qrcodegen_SERIALIZED_LEN_FOR_VERSION(version) even for the data region layout, which uses it as scratch space.
+ * Returns 0 and writes nothing if resultLen is smaller than that, or if the QR Code's format bits are damaged
+ * (see qrcodegen_getMask()).
+ */
+size_t qrcodegen_serialize(const uint8_t qrcode[], bool dataRegionOnly, uint8_t result[], size_t resultLen);
+
+
+/* 
+ * Reads the given serialized form of a QR Code in either layout into the given qrcode array, which must
+ * have length at least qrcodegen_BUFFER_LEN_FOR_VERSION(maxVersion). Returns false and writes nothing if the
+ * data is malformed, has the wrong length, or has a version above maxVersion.
+ */
+bool qrcodegen_deserialize(const uint8_t data[], size_t dataLen, uint8_t qrcode[], int maxVersion);
+
+
+/* 
+ * Returns a pointer into the given serialized form of a QR Code in the full layout, which can be passed as
+ * a qrcode[] array to qrcodegen_getSize(), qrcodegen_getModule(), and the other read-only functions without
+ * copying anything. Returns NULL if the data is malformed, has the wrong length, or is in the data region layout.
+ */
+const uint8_t *qrcodegen_viewSerialized(const uint8_t data[], size_t dataLen);
+
+
 #ifdef __cplusplus
 }
 #endif
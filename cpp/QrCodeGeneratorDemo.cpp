@@ -145,20 +145,8 @@ static void doSegmentDemo() {
 	const QrCode qr4 = QrCode::encodeText(madoka, QrCode::Ecc::LOW);
 	printQr(qr4);
 	
-	const std::vector<int> kanjiChars{  // Kanji mode encoding (13 bits per character)
-		0x0035, 0x1002, 0x0FC0, 0x0AED, 0x0AD7,
-		0x015C, 0x0147, 0x0129, 0x0059, 0x01BD,
-		0x018D, 0x018A, 0x0036, 0x0141, 0x0144,
-		0x0001, 0x0000, 0x0249, 0x0240, 0x0249,
-		0x0000, 0x0104, 0x0105, 0x0113, 0x0115,
-		0x0000, 0x0208, 0x01FF, 0x0008,
-	};
-	qrcodegen::BitBuffer bb;
-	for (int c : kanjiChars)
-		bb.appendBits(static_cast<std::uint32_t>(c), 13);
 	const QrCode qr5 = QrCode::encodeSegments(
-		{QrSegment(QrSegment::Mode::KANJI, static_cast<int>(kanjiChars.size()), bb)},
-		QrCode::Ecc::LOW);
+		{qrcodegen::QrSegmentAdvanced::makeKanji(madoka)}, QrCode::Ecc::LOW);
 	printQr(qr5);
 }
 
@@ -0,0 +1,1489 @@
+/* 
+ * QR Code generator test suite (C++)
+ * 
+ * Run this command-line program with no arguments. Each test case checks the public API against
+ * a simpler way of computing the same result. A failure stops the program with an assertion.
+ * 
+ * Copyright (c) Project Nayuki. (MIT License)
+ * https://www.nayuki.io/page/qr-code-generator-library
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * - The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ * - The Software is provided "as is", without warranty of any kind, express or
+ *   implied, including but not limited to the warranties of merchantability,
+ *   fitness for a particular purpose and noninfringement. In no event shall the
+ *   authors or copyright holders be liable for any claim, damages or other
+ *   liability, whether in an action of contract, tort or otherwise, arising from,
+ *   out of or in connection with the Software or the use or other dealings in the
+ *   Software.
+ */
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#if __cplusplus > 201703L
+	#include <future>
+#endif
+#include <exception>
+#include <mutex>
+#ifdef QRCODEGEN_USE_PMR
+	#include <memory_resource>
+#endif
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "qrcodegen.hpp"
+#include "qrcodegen-concurrent.hpp"
+#ifdef QRCODEGEN_HAS_DISK_CACHE
+	#include <dirent.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#include <utime.h>
+#endif
+
+using std::uint8_t;
+using qrcodegen::LazyQrCode;
+using qrcodegen::QrBatch;
+using qrcodegen::QrCache;
+using qrcodegen::QrCode;
+using qrcodegen::QrCodeResult;
+using qrcodegen::QrCodeView;
+#ifdef QRCODEGEN_HAS_DISK_CACHE
+	using qrcodegen::QrDiskCache;
+#endif
+using qrcodegen::QrEncoder;
+#ifdef QRCODEGEN_HAS_COROUTINES
+	using qrcodegen::QrEncodeTask;
+#endif
+using qrcodegen::QrPipeline;
+using qrcodegen::QrPrefix;
+using qrcodegen::QrScheduler;
+using qrcodegen::QrSegment;
+using qrcodegen::QrSegmentAdvanced;
+using qrcodegen::StaticQrCode;
+
+
+// Global variables
+static int numTestCases = 0;
+
+
+// Returns whether the two given QR Codes have the same parameters and modules.
+static bool isSameQrCode(const QrCode &a, const QrCode &b) {
+	if (a.getVersion() != b.getVersion() || a.getErrorCorrectionLevel() != b.getErrorCorrectionLevel()
+			|| a.getMask() != b.getMask())
+		return false;
+	for (int y = 0; y < a.getSize(); y++) {
+		for (int x = 0; x < a.getSize(); x++) {
+			if (a.getModule(x, y) != b.getModule(x, y))
+				return false;
+		}
+	}
+	return true;
+}
+
+
+// Returns whether the two given segments have the same mode, character count and data bits.
+static bool isSameSegment(const QrSegment &a, const QrSegment &b) {
+	return &a.getMode() == &b.getMode() && a.getNumChars() == b.getNumChars() && a.getData() == b.getData();
+}
+
+
+// Returns a random text of up to maxLen characters, which mixes all three
+// makeSegments() modes so that it spans many versions.
+static std::string makeRandomText(int maxLen) {
+	std::string result(static_cast<std::size_t>(std::rand() % (maxLen + 1)), ' ');
+	for (char &c : result)
+		c = "0123456789ABC $abc"[std::rand() % 18];
+	return result;
+}
+
+
+#ifdef QRCODEGEN_HAS_DISK_CACHE
+
+// Returns the names of all files in the given directory.
+static std::vector<std::string> listFiles(const std::string &dir) {
+	std::vector<std::string> result;
+	DIR *d = opendir(dir.c_str());
+	assert(d != nullptr);
+	for (struct dirent *ent; (ent = readdir(d)) != nullptr; ) {
+		std::string name(ent->d_name);
+		if (name != "." && name != "..")
+			result.push_back(name);
+	}
+	closedir(d);
+	return result;
+}
+
+#endif
+
+
+#ifdef QRCODEGEN_HAS_COROUTINES
+
+// A coroutine that starts at once and frees itself when it finishes, for awaiting tasks from tests.
+struct DetachedCoroutine final {
+	struct promise_type final {
+		DetachedCoroutine get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+
+// Awaits the given task and delivers its QR Code or exception to the given promise.
+static DetachedCoroutine awaitTask(QrEncodeTask task, std::promise<QrCode> &result) {
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+	result.set_value(co_await task);
+#else
+	try {
+		result.set_value(co_await task);
+	} catch (...) {
+		result.set_exception(std::current_exception());
+	}
+#endif
+}
+
+#endif
+
+
+/*---- Test cases ----*/
+
+static void testMakeSegmentsOptimally() {
+	{  // Each run gets its cheapest mode, with the same bits as the segment made directly
+		const std::vector<QrSegment> actual = QrSegmentAdvanced::makeSegmentsOptimally(
+			"ORDER-1234567890123 shipped", QrCode::Ecc::MEDIUM);
+		const std::string bytes = " shipped";
+		const QrSegment expect[] = {
+			QrSegment::makeAlphanumeric("ORDER-"),
+			QrSegment::makeNumeric("1234567890123"),
+			QrSegment::makeBytes(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()),
+		};
+		assert(actual.size() == 3);
+		for (std::size_t i = 0; i < actual.size(); i++)
+			assert(isSameSegment(actual[i], expect[i]));
+		// Headers 13 + 14 + 12 bits, data 33 + 44 + 64 bits
+		assert(QrSegment::getTotalBits(actual, 1) == 180);
+		numTestCases++;
+	}
+	{  // Text that needs a single mode gives the same segment as makeSegments()
+		const char *texts[] = {"", "314159265358979323846264338327950288419716939937510", "HELLO WORLD", "Hello, world!"};
+		for (const char *text : texts) {
+			const std::vector<QrSegment> actual = QrSegmentAdvanced::makeSegmentsOptimally(text, QrCode::Ecc::LOW);
+			const std::vector<QrSegment> expect = QrSegment::makeSegments(text);
+			assert(actual.size() == expect.size());
+			for (std::size_t i = 0; i < actual.size(); i++)
+				assert(isSameSegment(actual[i], expect[i]));
+			numTestCases++;
+		}
+	}
+	
+	// Never more bits than makeSegments() at the version that the optimal segments get
+	for (int i = 0; i < 300; i++) {
+		const std::string text = makeRandomText(800);
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		const std::vector<QrSegment> optimal = QrSegmentAdvanced::makeSegmentsOptimally(text.data(), text.size(), ecl);
+		const std::vector<QrSegment> simple = QrSegment::makeSegments(text.data(), text.size());
+		int version = QrCode::encodeSegments(optimal, ecl, 1, 40, -1, false).getVersion();
+		assert(QrSegment::getTotalBits(optimal, version) <= QrSegment::getTotalBits(simple, version));
+		assert(version <= QrCode::encodeSegments(simple, ecl, 1, 40, -1, false).getVersion());
+		numTestCases++;
+	}
+	
+	// 7089 digits are the most that version 40 holds at the lowest level
+	const std::string digits(7090, '7');
+	assert(QrCode::encodeSegments(QrSegmentAdvanced::makeSegmentsOptimally(
+		digits.data(), 7089, QrCode::Ecc::LOW), QrCode::Ecc::LOW).getVersion() == 40);
+	numTestCases++;
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// Too long for the version range, or not well-formed UTF-8
+	struct BadInput { const char *text; std::size_t len; QrCode::Ecc ecl; int maxVersion; bool tooLong; };
+	const BadInput badInputs[] = {
+		{digits.data(), digits.size(), QrCode::Ecc::LOW, 40, true},
+		{"HELLO WORLD", 11, QrCode::Ecc::HIGH, 1, true},  // Needs 74 bits, and version 1-H holds 72
+		{"A\xC3", 2, QrCode::Ecc::LOW, 40, false},
+	};
+	for (const BadInput &bad : badInputs) {
+		bool caught = false;
+		try {
+			QrSegmentAdvanced::makeSegmentsOptimally(bad.text, bad.len, bad.ecl, 1, bad.maxVersion);
+		} catch (const qrcodegen::data_too_long &) {
+			caught = bad.tooLong;
+		} catch (const std::domain_error &) {
+			caught = !bad.tooLong;
+		}
+		assert(caught);
+		numTestCases++;
+	}
+	assert(QrSegmentAdvanced::makeSegmentsOptimally("HELLO WORLD", QrCode::Ecc::HIGH, 1, 2).size() == 1);
+	numTestCases++;
+#endif
+}
+
+
+static void testKanji() {
+	// U+6F22 and U+5B57 are 0x8ABF and 0x8E9A in Shift JIS, so their 13-bit values are 0x073F and 0x0A1A
+	const char *utf8 = "\xE6\xBC\xA2\xE5\xAD\x97";
+	const std::u16string utf16 = u"\u6F22\u5B57";
+	const QrSegment seg = QrSegmentAdvanced::makeKanji(utf8);
+	const char *bits = "0011100111111" "0101000011010";
+	assert(&seg.getMode() == &QrSegment::Mode::KANJI && seg.getNumChars() == 2);
+	assert(seg.getData().size() == std::strlen(bits));
+	for (std::size_t i = 0; i < seg.getData().size(); i++)
+		assert(seg.getData()[i] == (bits[i] == '1'));
+	assert(QrSegment::getTotalBits(std::vector<QrSegment>{seg}, 1) == 4 + 8 + 26);
+	assert(isSameSegment(QrSegmentAdvanced::makeKanji(utf16), seg));
+	assert(isSameSegment(QrSegmentAdvanced::makeKanji(std::string(utf8).append("X").c_str(), 6), seg));
+	assert(QrSegmentAdvanced::makeKanji("").getNumChars() == 0);
+	numTestCases++;
+	
+	// Kanji, kana and full-width ASCII are encodable; ASCII, half-width kana, broken UTF-8 and lone surrogates aren't
+	const char *encodable[] = {"", utf8, "\xE3\x83\x86\xE3\x82\xB9\xE3\x83\x88", "\xEF\xBC\xA1"};
+	const char *notEncodable[] = {"A", "\xEF\xBD\xB1", "\xE6\xBC", "\xE6\xBC\xA2" "A"};
+	const std::u16string encodable16[] = {u"", utf16, u"\u30C6\u30B9\u30C8", u"\uFF21"};
+	const std::u16string notEncodable16[] = {u"A", u"\uFF71", std::u16string(1, static_cast<char16_t>(0xD800)), u"\u6F22A"};
+	for (int i = 0; i < 4; i++) {
+		assert(QrSegmentAdvanced::isEncodableAsKanji(encodable[i]));
+		assert(QrSegmentAdvanced::isEncodableAsKanji(encodable16[i]));
+		assert(isSameSegment(QrSegmentAdvanced::makeKanji(encodable[i]), QrSegmentAdvanced::makeKanji(encodable16[i])));
+		assert(!QrSegmentAdvanced::isEncodableAsKanji(notEncodable[i]));
+		assert(!QrSegmentAdvanced::isEncodableAsKanji(notEncodable16[i]));
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+		bool caught = false;
+		try {
+			QrSegmentAdvanced::makeKanji(notEncodable[i]);
+		} catch (const std::domain_error &) {
+			caught = true;
+		}
+		assert(caught);
+		caught = false;
+		try {
+			QrSegmentAdvanced::makeKanji(notEncodable16[i]);
+		} catch (const std::domain_error &) {
+			caught = true;
+		}
+		assert(caught);
+#endif
+		numTestCases++;
+	}
+	
+	// makeSegmentsOptimally() puts the kanji in kanji mode and the digits after them in numeric mode
+	const char *text = "\xE6\xBC\xA2\xE5\xAD\x97" "0123456789";
+	const std::vector<QrSegment> segs = QrSegmentAdvanced::makeSegmentsOptimally(text, QrCode::Ecc::LOW);
+	assert(segs.size() == 2);
+	assert(isSameSegment(segs[0], seg));
+	assert(isSameSegment(segs[1], QrSegment::makeNumeric("0123456789")));
+	assert(QrSegment::getTotalBits(segs, 1) == 4 + 8 + 26 + 4 + 10 + 34);
+	numTestCases++;
+}
+
+
+static void testMakeSegments() {
+	for (int i = 0; i < 3000; i++) {
+		// A run of digits, then a run of alphanumeric characters, then anything,
+		// so that makeSegments() demotes the mode at every possible position
+		static const char *CHARSETS[] = {"0123456789", "0123456789AZ $%*+-./:", "0123456789az,\xC3\xA9"};
+		std::string text;
+		std::size_t len = static_cast<std::size_t>(std::rand() % 60);
+		std::size_t numDigits = static_cast<std::size_t>(std::rand()) % (len + 1);
+		std::size_t numAlnum = numDigits + static_cast<std::size_t>(std::rand()) % (len - numDigits + 1);
+		for (std::size_t j = 0; j < len; j++) {
+			const char *charset = CHARSETS[j < numDigits ? 0 : j < numAlnum ? 1 : std::rand() % 3];
+			text += charset[static_cast<std::size_t>(std::rand()) % std::strlen(charset)];
+		}
+		
+		std::vector<QrSegment> actual = QrSegment::makeSegments(text.data(), text.size());
+		if (text.empty())
+			assert(actual.empty());
+		else {
+			QrSegment expect = QrSegment::isNumeric(text.data(), text.size()) ?
+				QrSegment::makeNumeric(text.data(), text.size()) :
+				QrSegment::isAlphanumeric(text.data(), text.size()) ?
+				QrSegment::makeAlphanumeric(text.data(), text.size()) :
+				QrSegment::makeBytes(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+			assert(actual.size() == 1);
+			assert(&actual[0].getMode() == &expect.getMode());
+			assert(actual[0].getNumChars() == expect.getNumChars());
+			assert(actual[0].getData() == expect.getData());
+		}
+		numTestCases++;
+	}
+}
+
+
+static void testPlanSegments() {
+	// Known capacities at the corners of the table
+	assert(QrCode::getDataCapacityBits(1, QrCode::Ecc::LOW) == 152);
+	assert(QrCode::getDataCapacityBits(1, QrCode::Ecc::HIGH) == 72);
+	assert(QrCode::getDataCapacityBits(10, QrCode::Ecc::MEDIUM) == 1728);
+	assert(QrCode::getDataCapacityBits(40, QrCode::Ecc::LOW) == 23648);
+	assert(QrCode::getDataCapacityBits(40, QrCode::Ecc::HIGH) == 10208);
+	numTestCases++;
+	
+	// The most bytes that fit a version exactly fill it, and one more byte needs a larger version
+	for (int ver = 1; ver <= 40; ver++) {
+		for (int i = 0; i < 4; i++) {
+			QrCode::Ecc ecl = static_cast<QrCode::Ecc>(i);
+			int capacity = QrCode::getDataCapacityBits(ver, ecl);
+			int headerBits = 4 + QrSegment::Mode::BYTE.numCharCountBits(ver);
+			std::vector<uint8_t> data(static_cast<std::size_t>((capacity - headerBits) / 8), 0xA5);
+			std::vector<QrSegment> segs{QrSegment::makeBytes(data)};
+			QrCode::Plan plan = QrCode::planSegments(segs, ecl, ver, ver, false);
+			assert(plan.version == ver && plan.errorCorrectionLevel == ecl);
+			assert(plan.dataUsedBits == headerBits + static_cast<int>(data.size()) * 8 && plan.dataUsedBits > capacity - 8);
+			assert(plan.dataCapacityBits == capacity);
+			
+			data.push_back(0x5A);
+			segs[0] = QrSegment::makeBytes(data);
+			if (ver < 40) {
+				plan = QrCode::planSegments(segs, ecl, ver, 40, false);
+				assert(plan.version > ver && plan.dataUsedBits == QrSegment::getTotalBits(segs, plan.version));
+				assert(plan.version == QrCode::encodeSegments(segs, ecl, ver, 40, 0, false).getVersion());
+			}
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+			bool caught = false;
+			try {
+				QrCode::planSegments(segs, ecl, 1, ver, false);
+			} catch (const qrcodegen::data_too_long &) {
+				caught = true;
+			}
+			assert(caught);
+#endif
+			numTestCases++;
+		}
+	}
+	
+	// Same version and level as encodeSegments(), with or without boosting
+	for (int i = 0; i < 300; i++) {
+		const std::vector<QrSegment> segs = QrSegment::makeSegments(makeRandomText(800).c_str());
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int minVersion = std::rand() % 40 + 1;
+		bool boost = std::rand() % 2 == 0;
+		QrCode::Plan plan = QrCode::planSegments(segs, ecl, minVersion, 40, boost);
+		const QrCode qr = QrCode::encodeSegments(segs, ecl, minVersion, 40, 0, boost);
+		assert(plan.version == qr.getVersion() && plan.errorCorrectionLevel == qr.getErrorCorrectionLevel());
+		assert(plan.dataUsedBits == QrSegment::getTotalBits(segs, plan.version));
+		assert(plan.dataCapacityBits == QrCode::getDataCapacityBits(plan.version, plan.errorCorrectionLevel));
+		numTestCases++;
+	}
+}
+
+
+static void testPrefix() {
+	// Module for module the same as encoding the concatenated segments, at any version and level
+	for (int i = 0; i < 500; i++) {
+		std::vector<QrSegment> head = QrSegment::makeSegments(makeRandomText(i % 10 == 0 ? 700 : 100).c_str());
+		if (std::rand() % 4 == 0)
+			head.insert(head.begin(), QrSegment::makeEci(26));
+		const std::vector<QrSegment> tail = QrSegment::makeSegments(makeRandomText(500).c_str());
+		std::vector<QrSegment> all = head;
+		all.insert(all.end(), tail.cbegin(), tail.cend());
+		
+		const QrPrefix prefix(head);
+		assert(prefix.getSegments().size() == head.size());
+		for (int ver = 1; ver <= 40; ver++) {
+			// A band is skipped if the head doesn't fit even its largest version
+			int bandLast = ver <= 9 ? 9 : ver <= 26 ? 26 : 40;
+			int bits = QrSegment::getTotalBits(head, ver);
+			bool usable = bits != -1 && bits <= QrCode::getDataCapacityBits(bandLast, QrCode::Ecc::LOW);
+			assert(prefix.getBitLength(ver) == (usable ? bits : -1));
+		}
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int minVersion = std::rand() % 40 + 1;
+		int mask = std::rand() % 9 - 1;
+		bool boost = std::rand() % 2 == 0;
+		const QrCode expect = QrCode::encodeSegments(all, ecl, minVersion, 40, mask, boost);
+		assert(isSameQrCode(QrCode::encodeSegments(prefix, tail, ecl, minVersion, 40, mask, boost), expect));
+		QrCode::Plan plan = QrCode::planSegments(prefix, tail, ecl, minVersion, 40, boost);
+		assert(plan.version == expect.getVersion() && plan.errorCorrectionLevel == expect.getErrorCorrectionLevel());
+		assert(plan.dataUsedBits == QrSegment::getTotalBits(all, plan.version));
+		numTestCases++;
+	}
+	
+	{  // A short payload is boosted to the highest level that fits, like the concatenation
+		const std::vector<QrSegment> head = QrSegment::makeSegments("HTTPS://EXAMPLE.COM/");
+		const std::vector<QrSegment> tail = QrSegment::makeSegments("12345");
+		std::vector<QrSegment> all = head;
+		all.insert(all.end(), tail.cbegin(), tail.cend());
+		const QrCode qr = QrCode::encodeSegments(QrPrefix(head), tail, QrCode::Ecc::LOW);
+		assert(qr.getErrorCorrectionLevel() == QrCode::Ecc::QUARTILE);
+		assert(isSameQrCode(qr, QrCode::encodeSegments(all, QrCode::Ecc::LOW)));
+		numTestCases++;
+	}
+	{  // A head too long for versions 1 to 9 (1938 bits, and version 9 holds 1856) starts at version 10
+		const std::vector<QrSegment> head{QrSegment::makeAlphanumeric(std::string(350, 'A').c_str())};
+		const QrPrefix prefix(head);
+		assert(prefix.getBitLength(9) == -1 && prefix.getBitLength(10) == QrSegment::getTotalBits(head, 10));
+		const std::vector<QrSegment> tail = QrSegment::makeSegments("tail");
+		std::vector<QrSegment> all = head;
+		all.insert(all.end(), tail.cbegin(), tail.cend());
+		const QrCode qr = QrCode::encodeSegments(prefix, tail, QrCode::Ecc::LOW, 1, 40, 3);
+		assert(qr.getVersion() == 10 && isSameQrCode(qr, QrCode::encodeSegments(all, QrCode::Ecc::LOW, 1, 40, 3)));
+		numTestCases++;
+	}
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// A suffix that doesn't fit after the head is rejected, and so is a head that fits in no version
+	const QrPrefix prefix(QrSegment::makeSegments(std::string(5000, '7').c_str()));
+	int freeBits = QrCode::getDataCapacityBits(39, QrCode::Ecc::LOW) - prefix.getBitLength(39) - 4 - 16;
+	const std::vector<QrSegment> tails[] = {
+		{QrSegment::makeBytes(std::vector<uint8_t>(1000, 0x41))},  // Too long at version 40
+		{QrSegment::makeBytes(std::vector<uint8_t>(static_cast<std::size_t>(freeBits / 8 + 1), 0x41))},  // Too long at version 39
+	};
+	assert(QrCode::encodeSegments(prefix, tails[1], QrCode::Ecc::LOW).getVersion() == 40);
+	for (int i = 0; i < 2; i++) {
+		int maxVersion = 40 - i;
+		bool caught = false;
+		try {
+			QrCode::encodeSegments(prefix, tails[i], QrCode::Ecc::LOW, 1, maxVersion);
+		} catch (const qrcodegen::data_too_long &) {
+			caught = true;
+		}
+		assert(caught);
+		caught = false;
+		try {
+			QrCode::planSegments(prefix, tails[i], QrCode::Ecc::LOW, 1, maxVersion);
+		} catch (const qrcodegen::data_too_long &) {
+			caught = true;
+		}
+		assert(caught);
+		numTestCases++;
+	}
+	bool caught = false;
+	try {
+		QrPrefix tooLong(QrSegment::makeSegments(std::string(8000, '7').c_str()));
+	} catch (const qrcodegen::data_too_long &) {
+		caught = true;
+	}
+	assert(caught);
+	numTestCases++;
+#endif
+}
+
+
+static void testMakeBytesOverloads() {
+	for (int i = 0; i < 100; i++) {
+		std::vector<uint8_t> data(static_cast<std::size_t>(std::rand() % 300));
+		for (uint8_t &b : data)
+			b = static_cast<uint8_t>(std::rand());
+		std::size_t split = data.empty() ? 0 : static_cast<std::size_t>(std::rand()) % data.size();
+		const QrSegment::ByteFragment fragments[] = {{data.data(), split}, {nullptr, 0}, {data.data() + split, data.size() - split}};
+		QrSegment expect = QrSegment::makeBytes(data);
+		QrSegment fromPointer = QrSegment::makeBytes(data.data(), data.size());
+		QrSegment fromFragments = QrSegment::makeBytes(fragments, 3);
+		assert(fromPointer.getNumChars() == expect.getNumChars() && fromPointer.getData() == expect.getData());
+		assert(fromFragments.getNumChars() == expect.getNumChars() && fromFragments.getData() == expect.getData());
+		assert(isSameQrCode(QrCode::encodeBinary(fragments, 3, QrCode::Ecc::MEDIUM),
+			QrCode::encodeBinary(data, QrCode::Ecc::MEDIUM)));
+		numTestCases++;
+	}
+	
+	// A null pointer is an empty payload, and doesn't make the call ambiguous
+	QrSegment empty = QrSegment::makeBytes(nullptr, 0);
+	assert(&empty.getMode() == &QrSegment::Mode::BYTE && empty.getNumChars() == 0 && empty.getData().empty());
+	assert(isSameQrCode(QrCode::encodeBinary(nullptr, 0, QrCode::Ecc::LOW),
+		QrCode::encodeBinary(std::vector<uint8_t>(), QrCode::Ecc::LOW)));
+	numTestCases++;
+}
+
+
+static void testBatchEncode() {
+	std::vector<std::string> texts;
+	std::vector<std::vector<uint8_t> > datas;
+	for (int i = 0; i < 60; i++) {
+		std::string text = makeRandomText(400);
+		texts.push_back(text);
+		datas.push_back(std::vector<uint8_t>(text.begin(), text.end()));
+	}
+	texts.push_back(std::string(8000, 'a'));  // Too long for any version
+	datas.push_back(std::vector<uint8_t>(3000, 0xFF));
+	
+	QrScheduler scheduler(3);
+	int numParallel = 0;  // Symbols whose blocks and masks were split across the scheduler
+	for (int config = 0; config < 4; config++) {
+		QrBatch::Options opts;
+		opts.errorCorrectionLevel = static_cast<QrCode::Ecc>(std::rand() % 4);
+		opts.mask = std::rand() % 9 - 1;
+		opts.numThreads = config == 0 ? 1 : 4;
+		opts.scheduler = config >= 2 ? &scheduler : nullptr;
+		if (config == 3)  // One task per item, so several workers race to build each template
+			opts.priority = QrScheduler::Priority::INTERACTIVE;
+		QrBatch textBatch = QrBatch::encodeText(texts, opts);
+		QrBatch binaryBatch = QrBatch::encodeBinary(datas, opts);
+		assert(textBatch.getCount() == texts.size() && binaryBatch.getCount() == datas.size());
+		
+		for (std::size_t i = 0; i < texts.size(); i++) {
+			for (int kind = 0; kind < 2; kind++) {
+				const QrBatch &batch = kind == 0 ? textBatch : binaryBatch;
+				const QrBatch::Item &item = batch.getItem(i);
+				std::vector<QrSegment> segs = kind == 0 ? QrSegment::makeSegments(texts[i].c_str())
+					: std::vector<QrSegment>{QrSegment::makeBytes(datas[i])};
+				if (i + 1 == texts.size()) {
+					assert(!item.error.empty() && item.version == 0 && item.mask == -1);
+				} else {
+					QrCode expect = QrCode::encodeSegments(segs, opts.errorCorrectionLevel,
+						opts.minVersion, opts.maxVersion, opts.mask, opts.boostEcl);
+					assert(item.error.empty());
+					assert(item.version == expect.getVersion() && item.size == expect.getSize());
+					assert(item.errorCorrectionLevel == expect.getErrorCorrectionLevel() && item.mask == expect.getMask());
+					for (int y = 0; y < item.size; y++) {
+						for (int x = 0; x < item.size; x++)
+							assert(batch.getModule(i, x, y) == expect.getModule(x, y));
+					}
+					if (opts.scheduler != nullptr && item.version >= QrCode::PARALLEL_MIN_VERSION)
+						numParallel++;
+				}
+				numTestCases++;
+			}
+		}
+	}
+	assert(numParallel > 0);
+	
+	// From inside a task of a one-worker scheduler, whose only worker is then busy
+	QrScheduler single(1);
+	for (int i = 0; i < 4; i++) {
+		QrBatch::Options opts;
+		opts.numThreads = 1;
+		const QrBatch expect = QrBatch::encodeText(texts, opts);
+		opts.scheduler = &single;
+		opts.priority = i % 2 == 0 ? QrScheduler::Priority::BULK : QrScheduler::Priority::INTERACTIVE;
+		std::atomic<bool> done(false);
+		std::vector<QrBatch> result;
+		single.submit(QrScheduler::Priority::BULK, 1, [&]() {
+			result.push_back(QrBatch::encodeText(texts, opts));
+			done = true;
+		});
+		while (!done)
+			std::this_thread::yield();
+		assert(result.size() == 1 && result[0].getCount() == expect.getCount());
+		for (std::size_t j = 0; j < texts.size(); j++) {
+			const QrBatch::Item &item = result[0].getItem(j);
+			assert(item.error == expect.getItem(j).error && item.size == expect.getItem(j).size);
+			assert(item.mask == expect.getItem(j).mask);
+		}
+		assert(result[0].getArena() == expect.getArena());
+		numTestCases++;
+	}
+}
+
+
+static void testSchedulerPriority() {
+	for (int i = 0; i < 20; i++) {
+		std::mutex lock;
+		std::condition_variable gateCondition;
+		bool gateOpen = false;
+		std::vector<int> order;
+		{
+			// With one worker held up by the first task, everything else is queued when the gate opens
+			QrScheduler scheduler(1);
+			scheduler.submit(QrScheduler::Priority::INTERACTIVE, 1, [&]() {
+				std::unique_lock<std::mutex> guard(lock);
+				gateCondition.wait(guard, [&]() { return gateOpen; });
+			});
+			for (int j = 0; j < 20; j++) {
+				bool interactive = std::rand() % 2 == 0;
+				int label = (interactive ? 0 : 100) + j;
+				scheduler.submit(interactive ? QrScheduler::Priority::INTERACTIVE : QrScheduler::Priority::BULK,
+					std::rand() % 10 + 1, [&, label]() {
+						std::lock_guard<std::mutex> guard(lock);
+						order.push_back(label);
+					});
+			}
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				gateOpen = true;
+			}
+			gateCondition.notify_all();
+		}  // The destructor waits for every queued task
+		
+		// Every interactive task ran before any bulk task, and each class ran in submission order
+		assert(order.size() == 20);
+		for (std::size_t j = 1; j < order.size(); j++)
+			assert(order[j - 1] < order[j]);
+		numTestCases++;
+	}
+}
+
+
+static void testSchedulerParallelFor() {
+	QrScheduler scheduler(4);
+	for (int i = 0; i < 100; i++) {
+		std::size_t count = static_cast<std::size_t>(std::rand() % 500);
+		std::vector<std::atomic<int> > calls(count);
+		for (std::atomic<int> &c : calls)
+			c = 0;
+		auto work = [&](std::size_t j) { calls.at(j)++; };
+		if (i % 2 == 0)
+			scheduler.parallelFor(QrScheduler::Priority::BULK, 1, count, work);
+		else {
+			// Called from inside a task, where the caller's own worker is busy
+			std::atomic<bool> done(false);
+			scheduler.submit(QrScheduler::Priority::INTERACTIVE, 1, [&]() {
+				scheduler.parallelFor(QrScheduler::Priority::INTERACTIVE, 1, count, work);
+				done = true;
+			});
+			while (!done)
+				std::this_thread::yield();
+		}
+		for (const std::atomic<int> &c : calls)
+			assert(c == 1);
+		numTestCases++;
+	}
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// A throwing call doesn't stop the other indexes, and its exception reaches the caller
+	std::vector<std::atomic<int> > calls(100);
+	for (std::atomic<int> &c : calls)
+		c = 0;
+	bool caught = false;
+	try {
+		scheduler.parallelFor(QrScheduler::Priority::BULK, 1, calls.size(), [&](std::size_t j) {
+			calls[j]++;
+			if (j == 37)
+				throw std::runtime_error("Test");
+		});
+	} catch (const std::runtime_error &) {
+		caught = true;
+	}
+	assert(caught);
+	for (const std::atomic<int> &c : calls)
+		assert(c == 1);
+	numTestCases++;
+#endif
+}
+
+
+static void testPipeline() {
+	for (int i = 0; i < 10; i++) {
+		QrPipeline::Options opts;
+		opts.errorCorrectionLevel = static_cast<QrCode::Ecc>(std::rand() % 4);
+		opts.mask = std::rand() % 9 - 1;
+		for (int &n : opts.numThreads)
+			n = std::rand() % 3 + 1;
+		opts.queueCapacity = static_cast<std::size_t>(std::rand() % 4 + 1);  // Small, so that push() waits
+		
+		std::vector<std::string> texts;
+		for (int j = 0; j < 50; j++) {
+			texts.push_back(makeRandomText(300));
+		}
+		texts.push_back(std::string(8000, 'a'));  // Too long for any version
+		
+		std::mutex lock;
+		std::vector<int> numResults(texts.size(), 0);
+		std::vector<bool> isCorrect(texts.size(), false);
+		QrPipeline pipeline(opts, [&](std::uint64_t seq, const QrCode *qr, const std::string &error) {
+			// The sink runs on the output threads, so it only records what it saw
+			std::size_t k = static_cast<std::size_t>(seq);
+			bool correct;
+			if (k + 1 == texts.size())
+				correct = qr == nullptr && !error.empty();
+			else {
+				correct = qr != nullptr && error.empty() && isSameQrCode(*qr, QrCode::encodeSegments(
+					QrSegment::makeSegments(texts.at(k).c_str()), opts.errorCorrectionLevel,
+					opts.minVersion, opts.maxVersion, opts.mask, opts.boostEcl));
+			}
+			std::lock_guard<std::mutex> guard(lock);
+			numResults.at(k)++;
+			isCorrect.at(k) = correct;
+		});
+		for (std::size_t j = 0; j < texts.size(); j++)
+			assert(pipeline.push(texts[j]) == j);
+		
+		// Every payload reaches the sink exactly once before close() returns
+		pipeline.close();
+		for (std::size_t j = 0; j < texts.size(); j++)
+			assert(numResults[j] == 1 && isCorrect[j]);
+		for (int st = 0; st < 5; st++) {
+			QrPipeline::StageStats stats = pipeline.getStats(static_cast<QrPipeline::Stage>(st));
+			assert(stats.queueDepth == 0);
+		}
+		assert(pipeline.getStats(QrPipeline::Stage::OUTPUT).processed == texts.size());
+		
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+		bool caught = false;
+		try {
+			pipeline.push("A");
+		} catch (const std::logic_error &) {
+			caught = true;
+		}
+		assert(caught);
+#endif
+		pipeline.close();  // No effect
+		numTestCases++;
+	}
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// Invalid options are rejected
+	QrPipeline::Options opts;
+	opts.numThreads[2] = 0;
+	bool caught = false;
+	try {
+		QrPipeline pipeline(opts, [](std::uint64_t, const QrCode *, const std::string &) {});
+	} catch (const std::invalid_argument &) {
+		caught = true;
+	}
+	assert(caught);
+	numTestCases++;
+#endif
+}
+
+
+static void testEncodeOnScheduler() {
+	QrScheduler pool(3);
+	for (int i = 0; i < 60; i++) {
+		const std::vector<QrSegment> segs = QrSegment::makeSegments(makeRandomText(1200).c_str());
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		const QrCode expect = QrCode::encodeSegments(segs, ecl, 1, 40, mask);
+		assert(isSameQrCode(QrCode::encodeSegments(segs, ecl, pool, 1, 40, mask), expect));
+		
+		// Also from inside a task of the same pool, whose own worker is then busy
+		std::atomic<bool> done(false);
+		bool isSame = false;
+		pool.submit(QrScheduler::Priority::BULK, 1, [&]() {
+			isSame = isSameQrCode(QrCode::encodeSegments(segs, ecl, pool, 1, 40, mask), expect);
+			done = true;
+		});
+		while (!done)
+			std::this_thread::yield();
+		assert(isSame);
+		numTestCases++;
+	}
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// Errors are the same as for the ordinary overload
+	const std::vector<QrSegment> tooLong = QrSegment::makeSegments(std::string(8000, 'a').c_str());
+	const std::vector<QrSegment> segs = QrSegment::makeSegments("Hello");
+	for (int i = 0; i < 4; i++) {
+		bool caught = false;
+		try {
+			if (i == 0)
+				QrCode::encodeSegments(tooLong, QrCode::Ecc::LOW, pool);
+			else
+				QrCode::encodeSegments(segs, QrCode::Ecc::LOW, pool, i == 1 ? 0 : 1, i == 2 ? 41 : 40, i == 3 ? 8 : -1);
+		} catch (const qrcodegen::data_too_long &) {
+			caught = i == 0;
+		} catch (const std::invalid_argument &) {
+			caught = i > 0;
+		}
+		assert(caught);
+		numTestCases++;
+	}
+#endif
+}
+
+
+static void testCache() {
+	QrCache cache(1 << 20, 4);
+	for (int i = 0; i < 100; i++) {
+		std::string text = makeRandomText(200);
+		std::vector<uint8_t> data(text.begin(), text.end());
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		QrCache::Stats before = cache.getStats();
+		
+		// A text and binary payload with the same bytes, and the same text with other parameters,
+		// have their own entries, so each lookup gives the symbol for its own arguments
+		for (int j = 0; j < 2; j++) {
+			assert(isSameQrCode(cache.encodeText(text.c_str(), ecl, 1, 40, mask),
+				QrCode::encodeSegments(QrSegment::makeSegments(text.c_str()), ecl, 1, 40, mask)));
+			assert(isSameQrCode(cache.encodeBinary(data, ecl, 1, 40, mask),
+				QrCode::encodeSegments(std::vector<QrSegment>{QrSegment::makeBytes(data)}, ecl, 1, 40, mask)));
+			assert(isSameQrCode(cache.encodeText(text.c_str(), ecl, 1, 40, (mask + 2) % 9 - 1),
+				QrCode::encodeSegments(QrSegment::makeSegments(text.c_str()), ecl, 1, 40, (mask + 2) % 9 - 1)));
+		}
+		QrCache::Stats after = cache.getStats();
+		assert(after.hits - before.hits >= 3 && after.hits + after.misses - before.hits - before.misses == 6);
+		numTestCases++;
+	}
+	
+	// Rejected payloads are not cached
+	QrCache::Stats before = cache.getStats();
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	bool caught = false;
+	try {
+		cache.encodeText(std::string(8000, 'a').c_str(), QrCode::Ecc::LOW);
+	} catch (const qrcodegen::data_too_long &) {
+		caught = true;
+	}
+	assert(caught && cache.getStats().entries == before.entries);
+#endif
+	cache.clear();
+	assert(cache.getStats().entries == 0 && cache.getStats().bytes == 0 && cache.getStats().hits == before.hits);
+	numTestCases++;
+	
+	// A small cache evicts its least recently used entries to stay within its budget
+	QrCache small(2000, 1);
+	for (int i = 0; i < 100; i++)
+		small.encodeText(std::to_string(i).c_str(), QrCode::Ecc::LOW);
+	QrCache::Stats stats = small.getStats();
+	assert(stats.evictions > 0 && stats.entries + stats.evictions == 100 && stats.bytes <= 2000);
+	small.encodeText("99", QrCode::Ecc::LOW);  // Most recent
+	assert(small.getStats().hits == 1);
+	small.encodeText("0", QrCode::Ecc::LOW);  // Evicted long ago
+	assert(small.getStats().misses == 101);
+	numTestCases++;
+}
+
+
+static void testEncoderReuse() {
+	QrEncoder encoder;
+	for (int i = 0; i < 300; i++) {
+		// Random sizes, so that the result's grids grow and shrink between calls
+		const std::string text = makeRandomText(1200);
+		const std::vector<QrSegment> segs = QrSegment::makeSegments(text.c_str());
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		int minVersion = std::rand() % 40 + 1;
+		const QrCode expect = QrCode::encodeSegments(segs, ecl, minVersion, 40, mask);
+		const QrCode &actual = encoder.encodeSegments(segs, ecl, minVersion, 40, mask);
+		assert(isSameQrCode(actual, expect));
+		const QrCode copy = actual;
+		assert(isSameQrCode(copy, expect));
+		if (i % 10 == 0)
+			assert(isSameQrCode(encoder.encodeText(text.c_str(), ecl), QrCode::encodeText(text.c_str(), ecl)));
+		assert(encoder.getRetainedBytes() <= encoder.getHighWaterMark());
+		numTestCases++;
+	}
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// Errors are the same as for QrCode::encodeSegments(), and leave the encoder usable
+	const std::vector<QrSegment> tooLong = QrSegment::makeSegments(std::string(8000, 'a').c_str());
+	const std::vector<QrSegment> segs = QrSegment::makeSegments("Hello");
+	for (int i = 0; i < 4; i++) {
+		bool caught = false;
+		try {
+			if (i == 0)
+				encoder.encodeSegments(tooLong, QrCode::Ecc::LOW);
+			else
+				encoder.encodeSegments(segs, QrCode::Ecc::LOW, i == 1 ? 0 : 1, i == 2 ? 41 : 40, i == 3 ? 8 : -1);
+		} catch (const qrcodegen::data_too_long &) {
+			caught = i == 0;
+		} catch (const std::invalid_argument &) {
+			caught = i > 0;
+		}
+		assert(caught);
+		assert(isSameQrCode(encoder.encodeSegments(segs, QrCode::Ecc::LOW), QrCode::encodeSegments(segs, QrCode::Ecc::LOW)));
+		numTestCases++;
+	}
+#endif
+	
+	// Once a symbol has been encoded, encoding it again retains no more storage
+	const std::vector<QrSegment> large = QrSegment::makeSegments(std::string(2000, '7').c_str());
+	encoder.encodeSegments(large, QrCode::Ecc::HIGH);
+	std::size_t retained = encoder.getRetainedBytes();
+	for (int i = 0; i < 3; i++) {
+		assert(isSameQrCode(encoder.encodeSegments(large, QrCode::Ecc::HIGH), QrCode::encodeSegments(large, QrCode::Ecc::HIGH)));
+		assert(encoder.getRetainedBytes() == retained);
+	}
+	numTestCases++;
+}
+
+
+static void testStaticQrCode() {
+	// Every version, error correction level, and mask, with and without boosting
+	static StaticQrCode<40> qr;
+	const char *texts[] = {"31415926535", "HELLO $%", "Hello!"};  // Each fits in version 1 at HIGH
+	for (int ver = 1; ver <= 40; ver++) {
+		const char *text = texts[ver % 3];
+		const std::vector<QrSegment> segs = QrSegment::makeSegments(text);
+		for (int e = 0; e < 4; e++) {
+			QrCode::Ecc ecl = static_cast<QrCode::Ecc>(e);
+			for (int mask = -1; mask < 8; mask++) {
+				bool boost = (ver + mask) % 2 == 0;
+				assert(qr.encodeText(text, ecl, ver, ver, mask, boost));
+				const QrCode expect = QrCode::encodeSegments(segs, ecl, ver, ver, mask, boost);
+				assert(isSameQrCode(qr.toQrCode(), expect));
+				for (int y = 0; y < expect.getSize(); y++) {
+					for (int x = 0; x < expect.getSize(); x++)
+						assert(qr.getModule(x, y) == expect.getModule(x, y));
+				}
+				numTestCases++;
+			}
+		}
+	}
+	
+	// Random texts and bytes in a smaller capacity, where the ones that don't fit are rejected like QrCode does
+	StaticQrCode<10> small;
+	for (int i = 0; i < 300; i++) {
+		const std::string text = makeRandomText(400);
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		bool fits;
+		std::vector<QrSegment> segs;
+		if (i % 2 == 0) {
+			fits = small.encodeText(text.c_str(), ecl, 1, 10, mask);
+			segs = QrSegment::makeSegments(text.c_str());
+		} else {
+			const std::vector<uint8_t> bytes(text.cbegin(), text.cend());
+			fits = small.encodeBinary(bytes.data(), bytes.size(), ecl, 1, 10, mask);
+			segs = {QrSegment::makeBytes(bytes)};
+		}
+		const QrCodeResult expect = QrCode::tryEncodeSegments(segs, ecl, 1, 10, mask);
+		assert(fits == expect.isOk());
+		assert(!fits || isSameQrCode(small.toQrCode(), expect.getQrCode()));
+		numTestCases++;
+	}
+	
+	// Invalid parameters throw, and a text that doesn't fit leaves the previous symbol unchanged
+	assert(small.encodeText("Hello", QrCode::Ecc::LOW));
+	const QrCode before = small.toQrCode();
+	assert(!small.encodeText(std::string(1000, '7').c_str(), QrCode::Ecc::LOW));
+	assert(isSameQrCode(small.toQrCode(), before));
+	numTestCases++;
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	for (int i = 0; i < 3; i++) {
+		bool caught = false;
+		try {
+			small.encodeText("Hello", QrCode::Ecc::LOW, i == 0 ? 0 : 1, i == 1 ? 11 : 10, i == 2 ? 8 : -1);
+		} catch (const std::invalid_argument &) {
+			caught = true;
+		}
+		assert(caught);
+		assert(isSameQrCode(small.toQrCode(), before));
+		numTestCases++;
+	}
+#endif
+}
+
+
+static void testTryEncode() {
+	for (int i = 0; i < 300; i++) {
+		const std::string text = makeRandomText(1200);
+		const std::vector<QrSegment> segs = QrSegment::makeSegments(text.c_str());
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		int minVersion = std::rand() % 40 + 1;
+		bool boost = std::rand() % 2 == 0;
+		const QrCodeResult result = QrCode::tryEncodeSegments(segs, ecl, minVersion, 40, mask, boost);
+		assert(result.isOk() && result.getStatus() == QrCode::Status::OK);
+		assert(isSameQrCode(result.getQrCode(), QrCode::encodeSegments(segs, ecl, minVersion, 40, mask, boost)));
+		
+		const QrCodeResult fromText = QrCode::tryEncodeText(text.data(), text.size(), ecl);
+		assert(fromText.isOk() && isSameQrCode(fromText.getQrCode(), QrCode::encodeText(text.data(), text.size(), ecl)));
+		const std::vector<uint8_t> bytes(text.cbegin(), text.cend());
+		const QrCodeResult fromBytes = QrCode::tryEncodeBinary(bytes.data(), bytes.size(), ecl);
+		assert(fromBytes.isOk() && isSameQrCode(fromBytes.getQrCode(), QrCode::encodeBinary(bytes.data(), bytes.size(), ecl)));
+		numTestCases++;
+	}
+	
+	// Each rejected input has the status that matches the exception of the throwing function
+	const std::vector<QrSegment> tooLong = QrSegment::makeSegments(std::string(8000, 'a').c_str());
+	const std::vector<QrSegment> segs = QrSegment::makeSegments("Hello");
+	for (int i = 0; i < 5; i++) {
+		int minVersion = i == 1 ? 0 : i == 4 ? 10 : 1;
+		int maxVersion = i == 2 ? 41 : i == 4 ? 9 : 40;
+		int mask = i == 3 ? 8 : -1;
+		const std::vector<QrSegment> &input = i == 0 ? tooLong : segs;
+		const QrCodeResult result = QrCode::tryEncodeSegments(input, QrCode::Ecc::LOW, minVersion, maxVersion, mask);
+		assert(!result.isOk());
+		assert(result.getStatus() == (i == 0 ? QrCode::Status::DATA_TOO_LONG : QrCode::Status::INVALID_ARGUMENT));
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+		bool caught = false;
+		try {
+			QrCode::encodeSegments(input, QrCode::Ecc::LOW, minVersion, maxVersion, mask);
+		} catch (const qrcodegen::data_too_long &) {
+			caught = i == 0;
+		} catch (const std::invalid_argument &) {
+			caught = i > 0;
+		}
+		assert(caught);
+#endif
+		numTestCases++;
+	}
+	const std::string longText(3000, 'a');
+	assert(QrCode::tryEncodeText(longText.data(), longText.size(), QrCode::Ecc::LOW).getStatus() == QrCode::Status::DATA_TOO_LONG);
+	const std::vector<uint8_t> longBytes(3000, 0xA5);
+	assert(QrCode::tryEncodeBinary(longBytes.data(), longBytes.size(), QrCode::Ecc::LOW).getStatus() == QrCode::Status::DATA_TOO_LONG);
+	numTestCases++;
+	
+	// Copying, moving, and assigning between successful and failed results
+	const QrCode expect = QrCode::encodeText("Hello", QrCode::Ecc::MEDIUM);
+	QrCodeResult ok = QrCode::tryEncodeText("Hello", 5, QrCode::Ecc::MEDIUM);
+	QrCodeResult failed(QrCode::Status::DATA_TOO_LONG);
+	QrCodeResult copy(ok);
+	assert(copy.isOk() && isSameQrCode(copy.getQrCode(), expect));
+	QrCodeResult moved(std::move(copy));
+	assert(moved.isOk() && isSameQrCode(moved.getQrCode(), expect));
+	copy = failed;
+	assert(!copy.isOk() && copy.getStatus() == QrCode::Status::DATA_TOO_LONG);
+	copy = ok;
+	assert(copy.isOk() && isSameQrCode(copy.getQrCode(), expect));
+	moved = QrCodeResult(QrCode::Status::INVALID_ARGUMENT);
+	assert(!moved.isOk() && moved.getStatus() == QrCode::Status::INVALID_ARGUMENT);
+	failed = std::move(copy);
+	assert(failed.isOk() && isSameQrCode(failed.getQrCode(), expect));
+	const QrCode taken = std::move(ok.getQrCode());
+	assert(isSameQrCode(taken, expect));
+	QrCodeResult wrapped(QrCode::encodeText("Hello", QrCode::Ecc::MEDIUM));
+	assert(wrapped.isOk() && isSameQrCode(wrapped.getQrCode(), expect));
+	numTestCases++;
+}
+
+
+static void testLazyQrCode() {
+	for (int i = 0; i < 200; i++) {
+		const std::vector<QrSegment> segs = QrSegment::makeSegments(makeRandomText(1200).c_str());
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		int minVersion = std::rand() % 40 + 1;
+		bool boost = std::rand() % 2 == 0;
+		const QrCode expect = QrCode::encodeSegments(segs, ecl, minVersion, 40, mask, boost);
+		const LazyQrCode lazy = LazyQrCode::encodeSegments(segs, ecl, minVersion, 40, mask, boost);
+		
+		// The parameters and a fixed mask are known without realizing
+		assert(!lazy.isRealized());
+		assert(lazy.getVersion() == expect.getVersion() && lazy.getSize() == expect.getSize());
+		assert(lazy.getErrorCorrectionLevel() == expect.getErrorCorrectionLevel());
+		if (mask != -1)
+			assert(lazy.getMask() == mask);
+		const LazyQrCode copy = lazy;
+		assert(!lazy.isRealized() && !copy.isRealized());
+		
+		// Realizing through either copy realizes both, once
+		bool dark = i % 2 == 0 ? copy.getModule(0, 0) : lazy.getQrCode().getModule(0, 0);
+		assert(dark && lazy.isRealized() && copy.isRealized());
+		assert(&lazy.getQrCode() == &copy.getQrCode());
+		assert(isSameQrCode(lazy.getQrCode(), expect) && lazy.getMask() == expect.getMask());
+		for (int y = -1; y <= expect.getSize(); y++) {
+			for (int x = -1; x <= expect.getSize(); x++)
+				assert(lazy.getModule(x, y) == expect.getModule(x, y));
+		}
+		
+		// The low-level constructor realizes to the same symbol as QrCode's
+		const LazyQrCode fromCodewords(lazy.getVersion(), lazy.getErrorCorrectionLevel(), lazy.getDataCodewords(), mask);
+		assert(!fromCodewords.isRealized());
+		assert(isSameQrCode(fromCodewords.getQrCode(), QrCode(lazy.getVersion(), lazy.getErrorCorrectionLevel(), lazy.getDataCodewords(), mask)));
+		numTestCases++;
+	}
+	
+	// The convenience functions match QrCode's, and copies realized on several threads share one QR Code
+	const std::string text = "Lazy QR Code " + makeRandomText(300);
+	const std::vector<uint8_t> bytes(text.cbegin(), text.cend());
+	assert(isSameQrCode(LazyQrCode::encodeText(text.c_str(), QrCode::Ecc::HIGH).getQrCode(), QrCode::encodeText(text.c_str(), QrCode::Ecc::HIGH)));
+	assert(isSameQrCode(LazyQrCode::encodeBinary(bytes, QrCode::Ecc::LOW).getQrCode(), QrCode::encodeBinary(bytes, QrCode::Ecc::LOW)));
+	const LazyQrCode shared = LazyQrCode::encodeText(text.c_str(), QrCode::Ecc::MEDIUM);
+	std::vector<const QrCode*> realized(4);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < realized.size(); i++) {
+		threads.emplace_back([&realized, shared, i]() {
+			realized[i] = &shared.getQrCode();
+		});
+	}
+	for (std::thread &th : threads)
+		th.join();
+	for (const QrCode *qr : realized)
+		assert(qr == &shared.getQrCode());
+	assert(isSameQrCode(shared.getQrCode(), QrCode::encodeText(text.c_str(), QrCode::Ecc::MEDIUM)));
+	numTestCases++;
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// Errors are thrown right away, like QrCode's
+	const std::vector<QrSegment> tooLong = QrSegment::makeSegments(std::string(8000, 'a').c_str());
+	const std::vector<QrSegment> segs = QrSegment::makeSegments("Hello");
+	for (int i = 0; i < 4; i++) {
+		bool caught = false;
+		try {
+			if (i == 0)
+				LazyQrCode::encodeSegments(tooLong, QrCode::Ecc::LOW);
+			else
+				LazyQrCode::encodeSegments(segs, QrCode::Ecc::LOW, i == 1 ? 0 : 1, i == 2 ? 41 : 40, i == 3 ? 8 : -1);
+		} catch (const qrcodegen::data_too_long &) {
+			caught = i == 0;
+		} catch (const std::invalid_argument &) {
+			caught = i > 0;
+		}
+		assert(caught);
+		numTestCases++;
+	}
+	const std::vector<uint8_t> &dataCodewords = shared.getDataCodewords();
+	for (int i = 0; i < 4; i++) {
+		bool caught = false;
+		try {
+			if (i == 3)
+				LazyQrCode(shared.getVersion(), QrCode::Ecc::MEDIUM, std::vector<uint8_t>(dataCodewords.size() + 1), -1);
+			else
+				LazyQrCode(i == 0 ? 0 : i == 1 ? 41 : shared.getVersion(), QrCode::Ecc::MEDIUM, dataCodewords, i == 2 ? 8 : -1);
+		} catch (const std::domain_error &) {
+			caught = i < 3;
+		} catch (const std::invalid_argument &) {
+			caught = i == 3;
+		}
+		assert(caught);
+		numTestCases++;
+	}
+#endif
+}
+
+
+#ifdef QRCODEGEN_USE_PMR
+
+static void testEncodeWithMemoryResource() {
+	for (int i = 0; i < 100; i++) {
+		const std::vector<QrSegment> segs = QrSegment::makeSegments(makeRandomText(1200).c_str());
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		int minVersion = std::rand() % 40 + 1;
+		std::pmr::monotonic_buffer_resource resource;
+		const QrCode actual = QrCode::encodeSegments(segs, ecl, &resource, minVersion, 40, mask);
+		assert(isSameQrCode(actual, QrCode::encodeSegments(segs, ecl, minVersion, 40, mask)));
+		numTestCases++;
+	}
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// Errors are the same as for the ordinary overload, plus a null resource
+	std::pmr::monotonic_buffer_resource resource;
+	const std::vector<QrSegment> tooLong = QrSegment::makeSegments(std::string(8000, 'a').c_str());
+	const std::vector<QrSegment> segs = QrSegment::makeSegments("Hello");
+	for (int i = 0; i < 5; i++) {
+		bool caught = false;
+		try {
+			if (i == 0)
+				QrCode::encodeSegments(tooLong, QrCode::Ecc::LOW, &resource);
+			else if (i == 4)
+				QrCode::encodeSegments(segs, QrCode::Ecc::LOW, static_cast<std::pmr::memory_resource*>(nullptr));
+			else
+				QrCode::encodeSegments(segs, QrCode::Ecc::LOW, &resource, i == 1 ? 0 : 1, i == 2 ? 41 : 40, i == 3 ? 8 : -1);
+		} catch (const qrcodegen::data_too_long &) {
+			caught = i == 0;
+		} catch (const std::invalid_argument &) {
+			caught = i > 0;
+		}
+		assert(caught);
+		numTestCases++;
+	}
+#endif
+}
+
+#endif
+
+
+#ifdef QRCODEGEN_HAS_DISK_CACHE
+
+static void testDiskCache() {
+	char dirTemplate[] = "/tmp/qrcodegen-test-XXXXXX";
+	assert(mkdtemp(dirTemplate) != nullptr);
+	const std::string dir(dirTemplate);
+	std::vector<std::string> texts;
+	for (int i = 0; i < 20; i++)
+		texts.push_back(std::to_string(i) + makeRandomText(200));  // All different
+	auto encode = [](const std::string &text) {
+		return QrCode::encodeSegments(QrSegment::makeSegments(text.c_str()), QrCode::Ecc::MEDIUM);
+	};
+	auto render = [](const QrCode &qr) {
+		std::string result;
+		for (int y = 0; y < qr.getSize(); y++) {
+			for (int x = 0; x < qr.getSize(); x++)
+				result.push_back(qr.getModule(x, y) ? '#' : ' ');
+		}
+		return result;
+	};
+	// Looks up every text's symbol and rendered output, and checks them against fresh encodings
+	auto lookUpAll = [&](QrDiskCache &cache) {
+		for (const std::string &text : texts) {
+			assert(isSameQrCode(cache.encodeText(text.c_str(), QrCode::Ecc::MEDIUM), encode(text)));
+			QrDiskCache::Blob blob = cache.renderText(text.c_str(), QrCode::Ecc::MEDIUM, "ascii", render);
+			assert(std::string(reinterpret_cast<const char *>(blob.data()), blob.size()) == render(encode(text)));
+			numTestCases++;
+		}
+	};
+	
+	// Every lookup misses once and then hits, and a miss of a rendered output is counted once
+	{
+		QrDiskCache cache(dir, 1 << 20);
+		lookUpAll(cache);
+		lookUpAll(cache);
+		QrDiskCache::Stats stats = cache.getStats();
+		assert(stats.misses == texts.size() * 2 && stats.hits == texts.size() * 2 && stats.writeFailures == 0);
+		assert(listFiles(dir).size() == texts.size() * 2);  // No temporary files are left
+	}
+	
+	// The entries outlive the object
+	{
+		QrDiskCache cache(dir, 1 << 20);
+		assert(cache.getStats().bytes > 0);
+		lookUpAll(cache);
+		assert(cache.getStats().hits == texts.size() * 2 && cache.getStats().misses == 0);
+	}
+	
+	// Truncated and overwritten files are misses, and are replaced
+	std::vector<std::string> names = listFiles(dir);
+	for (std::size_t i = 0; i < names.size(); i++) {
+		std::string path = dir + "/" + names[i];
+		if (i % 2 == 0)
+			assert(truncate(path.c_str(), static_cast<off_t>(i % 3 * 8)) == 0);
+		else {
+			std::FILE *f = std::fopen(path.c_str(), "r+b");
+			assert(f != nullptr);
+			std::fputc('X', f);
+			std::fclose(f);
+		}
+	}
+	{
+		QrDiskCache cache(dir, 1 << 20);
+		lookUpAll(cache);
+		assert(cache.getStats().misses == texts.size() * 2 && cache.getStats().hits == 0);
+		lookUpAll(cache);
+		assert(cache.getStats().hits == texts.size() * 2);
+	}
+	
+	// Opening the cache deletes stale temporary files but not fresh ones
+	const std::string staleTemp = dir + "/.tmp.1.0", freshTemp = dir + "/.tmp.2.0";
+	std::fclose(std::fopen(staleTemp.c_str(), "wb"));
+	std::fclose(std::fopen(freshTemp.c_str(), "wb"));
+	struct utimbuf times;
+	times.actime = times.modtime = std::time(nullptr) - 7200;
+	assert(utime(staleTemp.c_str(), &times) == 0);
+	{
+		QrDiskCache cache(dir, 4000);
+		struct stat st;
+		assert(stat(staleTemp.c_str(), &st) != 0 && stat(freshTemp.c_str(), &st) == 0);
+		
+		// Over the cap, the next write evicts entries
+		cache.encodeText("Hello", QrCode::Ecc::LOW);
+		assert(cache.getStats().evictions > 0 && cache.getStats().bytes <= 4000);
+	}
+	numTestCases++;
+	
+	for (const std::string &name : listFiles(dir))
+		unlink((dir + "/" + name).c_str());
+	rmdir(dir.c_str());
+}
+
+#endif
+
+
+#ifdef QRCODEGEN_HAS_COROUTINES
+
+static void testEncodeAsync() {
+	QrScheduler pool(2);
+	std::atomic<int> numPosts(0);
+	QrCode::Executor exec = [&](std::function<void()> work) {
+		numPosts++;
+		pool.submit(QrScheduler::Priority::INTERACTIVE, 1, std::move(work));
+	};
+	for (int i = 0; i < 40; i++) {
+		const std::vector<QrSegment> segs = QrSegment::makeSegments(makeRandomText(1200).c_str());
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		const QrCode expect = QrCode::encodeSegments(segs, ecl, 1, 40, mask);
+		
+		// Waited on, using the library's own pool
+		assert(isSameQrCode(QrCode::encodeAsync(segs, ecl, QrCode::Executor(), 1, 40, mask).get(), expect));
+		
+		// Awaited by a coroutine, on the caller's executor
+		numPosts = 0;
+		std::promise<QrCode> result;
+		std::future<QrCode> future = result.get_future();
+		awaitTask(QrCode::encodeAsync(segs, ecl, exec, 1, 40, mask), result);
+		assert(isSameQrCode(future.get(), expect));
+		
+		// Only large symbols go back to the executor between steps
+		if (expect.getVersion() < QrCode::ASYNC_YIELD_MIN_VERSION)
+			assert(numPosts == 1);
+		else
+			assert(numPosts > 1 + (mask == -1 ? 8 : 0));
+		numTestCases++;
+	}
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// Errors are thrown from get() and from co_await
+	const std::vector<QrSegment> tooLong = QrSegment::makeSegments(std::string(8000, 'a').c_str());
+	const std::vector<QrSegment> segs = QrSegment::makeSegments("Hello");
+	for (int i = 0; i < 4; i++) {
+		QrEncodeTask task = i == 0 ? QrCode::encodeAsync(tooLong, QrCode::Ecc::LOW) :
+			QrCode::encodeAsync(segs, QrCode::Ecc::LOW, QrCode::Executor(),
+				i == 1 ? 0 : 1, i == 2 ? 41 : 40, i == 3 ? 8 : -1);
+		bool caught = false;
+		try {
+			task.get();
+		} catch (const qrcodegen::data_too_long &) {
+			caught = i == 0;
+		} catch (const std::invalid_argument &) {
+			caught = i > 0;
+		}
+		assert(caught);
+		numTestCases++;
+	}
+	std::promise<QrCode> result;
+	std::future<QrCode> future = result.get_future();
+	awaitTask(QrCode::encodeAsync(tooLong, QrCode::Ecc::LOW, exec), result);
+	bool caught = false;
+	try {
+		future.get();
+	} catch (const qrcodegen::data_too_long &) {
+		caught = true;
+	}
+	assert(caught);
+	
+	// A task runs only once
+	QrEncodeTask task = QrCode::encodeAsync(segs, QrCode::Ecc::LOW, exec);
+	task.get();
+	caught = false;
+	try {
+		task.get();
+	} catch (const std::logic_error &) {
+		caught = true;
+	}
+	assert(caught);
+	numTestCases++;
+#endif
+}
+
+#endif
+
+
+static void testSerialize() {
+	// Both layouts read back to the same QR Code, and the full layout can be viewed in place
+	for (int i = 0; i < 200; i++) {
+		const std::string text = makeRandomText(i % 10 == 0 ? 400 : 40);
+		QrCode::Ecc ecl = static_cast<QrCode::Ecc>(std::rand() % 4);
+		int mask = std::rand() % 9 - 1;
+		const QrCode qr = QrCode::encodeSegments(QrSegment::makeSegments(text.c_str()), ecl, 1, 40, mask, false);
+		int version = qr.getVersion();
+		int size = qr.getSize();
+		
+		const std::vector<uint8_t> full = qr.serialize();
+		std::size_t numModules = static_cast<std::size_t>(size) * static_cast<std::size_t>(size);
+		assert(full.size() == QrCode::getSerializedLength(version, false) && full.size() == 4 + (numModules + 7) / 8);
+		assert(full[0] == 'Q' && full[1] == 1 && full[3] == size);
+		assert(full[2] == (qr.getMask() | static_cast<int>(ecl) << 3));
+		assert(isSameQrCode(QrCode::deserialize(full), qr));
+		const QrCodeView view(full.data(), full.size());
+		assert(view.getVersion() == version && view.getSize() == size);
+		assert(view.getErrorCorrectionLevel() == ecl && view.getMask() == qr.getMask());
+		for (int y = -1; y <= size; y++) {
+			for (int x = -1; x <= size; x++)
+				assert(view.getModule(x, y) == qr.getModule(x, y));
+		}
+		assert(isSameQrCode(view.toQrCode(), qr));
+		
+		const std::vector<uint8_t> region = qr.serialize(true);
+		assert(region.size() == QrCode::getSerializedLength(version, true) && region.size() < full.size());
+		assert(region[0] == 'Q' && region[1] == 1 && region[2] == (full[2] | 0x80) && region[3] == size);
+		assert(isSameQrCode(QrCode::deserialize(region.data(), region.size()), qr));
+		numTestCases++;
+	}
+	
+	// The same bytes as the C library's qrcodegen_serialize(), for "HELLO" at version 1, low ECC, and mask 3
+	static const uint8_t FULL[] = {
+		0x51, 0x01, 0x03, 0x15, 0x7F, 0xD3, 0x3F, 0x48, 0x0A, 0x76, 0x55, 0xDD, 0xAE, 0xA4, 0xDB, 0x75,
+		0x74, 0x83, 0x80, 0xE0, 0x5F, 0xF5, 0x07, 0x30, 0x00, 0x4F, 0x25, 0xB7, 0x04, 0xD2, 0xB7, 0xD1,
+		0x97, 0x12, 0x19, 0x66, 0xF6, 0x52, 0x00, 0x42, 0xD9, 0x9F, 0x58, 0x0E, 0xF2, 0x93, 0x5D, 0x4A,
+		0xB2, 0x6B, 0x24, 0x75, 0xA5, 0x94, 0xA0, 0xAF, 0xF1, 0xF7, 0x89, 0x00,
+	};
+	static const uint8_t REGION[] = {
+		0x51, 0x01, 0x83, 0x15, 0x99, 0x4A, 0x03, 0x23, 0x25, 0x48, 0xDF, 0xA2, 0x2F, 0x25, 0x19, 0x66,
+		0x7A, 0x29, 0x50, 0x16, 0xCB, 0x3F, 0x59, 0x92, 0x91, 0x44, 0x29, 0xAF, 0xF1, 0x44,
+	};
+	const std::vector<uint8_t> full(FULL, FULL + sizeof(FULL));
+	const std::vector<uint8_t> region(REGION, REGION + sizeof(REGION));
+	const QrCode hello = QrCode::encodeSegments(QrSegment::makeSegments("HELLO"), QrCode::Ecc::LOW, 1, 1, 3, false);
+	assert(hello.serialize() == full && hello.serialize(true) == region);
+	assert(isSameQrCode(QrCode::deserialize(full), hello) && isSameQrCode(QrCode::deserialize(region), hello));
+	assert(QrCode::getSerializedLength(1, false) == 60 && QrCode::getSerializedLength(1, true) == 30);
+	assert(QrCode::getSerializedLength(40, false) == 3921);
+	numTestCases++;
+	
+#ifndef QRCODEGEN_NO_EXCEPTIONS
+	// Truncated, extended, and corrupt input is rejected
+	std::vector<std::vector<uint8_t> > bads;
+	for (const std::vector<uint8_t> &good : {full, region}) {
+		for (std::size_t len : {static_cast<std::size_t>(0), static_cast<std::size_t>(3), good.size() - 1})
+			bads.push_back(std::vector<uint8_t>(good.begin(), good.begin() + static_cast<std::ptrdiff_t>(len)));
+		bads.push_back(good);
+		bads.back().push_back(0);
+		for (int i = 0; i < 4; i++) {  // Wrong magic, format version, reserved bit, or size
+			bads.push_back(good);
+			bads.back()[static_cast<std::size_t>(i)] ^= i == 2 ? 0x20 : 0x01;
+		}
+		bads.push_back(good);
+		bads.back()[3] = 25;  // A valid size for another length
+	}
+	for (int i = 0; i < 5; i++) {  // Another mask or ECC level than the format bits
+		bads.push_back(full);
+		bads.back()[2] ^= static_cast<uint8_t>(1 << i);
+	}
+	for (const std::vector<uint8_t> &bad : bads) {
+		for (int kind = 0; kind < 2; kind++) {
+			bool caught = false;
+			try {
+				if (kind == 0)
+					QrCode::deserialize(bad);
+				else
+					QrCodeView(bad.data(), bad.size());
+			} catch (const std::invalid_argument &) {
+				caught = true;
+			}
+			assert(caught);
+			numTestCases++;
+		}
+	}
+	
+	// A view needs the full layout, and lengths need a valid version
+	for (int i = 0; i < 4; i++) {
+		bool caught = false;
+		try {
+			if (i == 0)
+				QrCodeView(region.data(), region.size());
+			else if (i == 1)
+				QrCode::deserialize(nullptr, 0);
+			else
+				QrCode::getSerializedLength(i == 2 ? 0 : 41, false);
+		} catch (const std::invalid_argument &) {
+			caught = i < 2;
+		} catch (const std::domain_error &) {
+			caught = i >= 2;
+		}
+		assert(caught);
+		numTestCases++;
+	}
+#endif
+}
+
+
+/*---- Main runner ----*/
+
+int main() {
+	std::srand(static_cast<unsigned int>(std::time(nullptr)));
+	testMakeSegmentsOptimally();
+	testKanji();
+	testMakeSegments();
+	testPlanSegments();
+	testPrefix();
+	testMakeBytesOverloads();
+	testBatchEncode();
+	testSchedulerPriority();
+	testSchedulerParallelFor();
+	testPipeline();
+	testEncodeOnScheduler();
+	testCache();
+	testEncoderReuse();
+	testStaticQrCode();
+	testTryEncode();
+	testLazyQrCode();
+#ifdef QRCODEGEN_USE_PMR
+	testEncodeWithMemoryResource();
+#endif
+#ifdef QRCODEGEN_HAS_DISK_CACHE
+	testDiskCache();
+#endif
+#ifdef QRCODEGEN_HAS_COROUTINES
+	testEncodeAsync();
+#endif
+	testSerialize();
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,1538 @@
+/* 
+ * QR Code generator library (C++), concurrent classes
+ * 
+ * Copyright (c) Project Nayuki. (MIT License)
+ * https://www.nayuki.io/page/qr-code-generator-library
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * - The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ * - The Software is provided "as is", without warranty of any kind, express or
+ *   implied, including but not limited to the warranties of merchantability,
+ *   fitness for a particular purpose and noninfringement. In no event shall the
+ *   authors or copyright holders be liable for any claim, damages or other
+ *   liability, whether in an action of contract, tort or otherwise, arising from,
+ *   out of or in connection with the Software or the use or other dealings in the
+ *   Software.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <list>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include "qrcodegen-concurrent.hpp"
+
+#ifdef QRCODEGEN_HAS_DISK_CACHE
+	#include <cerrno>
+	#include <ctime>
+	#include <dirent.h>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#include <utime.h>
+#endif
+
+using std::uint8_t;
+using std::size_t;
+using std::vector;
+
+// Throws the given exception, or aborts the program if the build has no exception support.
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+	#define QRCODEGEN_THROW(e)  std::abort()
+#else
+	#define QRCODEGEN_THROW(e)  throw e
+#endif
+
+
+namespace qrcodegen {
+
+#ifdef QRCODEGEN_USE_PMR
+inline namespace pmr_grid {  // As declared in qrcodegen.hpp
+#endif
+
+/*---- Class QrCode (functions that run on the concurrent classes) ----*/
+
+QrCode QrCode::encodeSegments(const vector<QrSegment> &segs, Ecc ecl, QrScheduler &pool,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	if (!(MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= MAX_VERSION) || mask < -1 || mask > 7)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	const Plan plan = planSegments(nullptr, segs, ecl, minVersion, maxVersion, boostEcl);
+	QrCode result(plan.version, plan.errorCorrectionLevel);
+	result.drawCodewordsAndMask(makeDataCodewords(nullptr, segs, plan),
+		reedSolomonComputeDivisor(ECC_CODEWORDS_PER_BLOCK[static_cast<int>(plan.errorCorrectionLevel)][plan.version]),
+		mask, pool, static_cast<int>(QrScheduler::Priority::INTERACTIVE));
+	return result;
+}
+
+
+void QrCode::drawCodewordsAndMask(const vector<uint8_t> &dataCodewords, const vector<uint8_t> &rsDiv,
+		int msk, QrScheduler &pool, int pri) {
+	if (version < PARALLEL_MIN_VERSION) {
+		drawCodewordsAndMask(dataCodewords, rsDiv, msk);
+		return;
+	}
+	
+	// Compute the blocks independently, then interleave them in order
+	const QrScheduler::Priority priority = static_cast<QrScheduler::Priority>(pri);
+	const long cost = getNumRawDataModules(version);
+	vector<vector<uint8_t> > blocks(static_cast<size_t>(getNumEccBlocks()));
+	pool.parallelFor(priority, cost, blocks.size(), [&](size_t i) {
+		blocks[i] = makeEccBlock(dataCodewords, rsDiv, static_cast<int>(i));
+	});
+	drawCodewords(interleaveBlocks(blocks));
+	
+	if (msk == -1) {  // Score each mask on its own copy, then take the first minimum as finishMask() does
+		long penalties[8];
+		pool.parallelFor(priority, cost, 8, [&](size_t i) {
+			QrCode trial(*this);
+			penalties[i] = trial.evaluateMask(static_cast<int>(i));
+		});
+		msk = static_cast<int>(std::min_element(penalties, penalties + 8) - penalties);
+	}
+	finishMask(msk);
+}
+
+
+#ifdef QRCODEGEN_HAS_COROUTINES
+
+QrEncodeTask QrCode::encodeAsync(vector<QrSegment> segs, Ecc ecl, Executor exec,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	if (!exec) {
+		// The library's own pool, which is started on first use and drained at program exit
+		static QrScheduler pool;
+		exec = [](std::function<void()> work) {
+			pool.submit(QrScheduler::Priority::INTERACTIVE, 1, std::move(work));
+		};
+	}
+	co_await QrEncodeTask::Reschedule{exec};
+	if (!(MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= MAX_VERSION) || mask < -1 || mask > 7)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	
+	// Same steps as encodeSegments(), split at the points where the task may yield
+	const Plan plan = planSegments(nullptr, segs, ecl, minVersion, maxVersion, boostEcl);
+	const vector<uint8_t> dataCodewords = makeDataCodewords(nullptr, segs, plan);
+	const Template tmpl = makeTemplate(plan.version, plan.errorCorrectionLevel);
+	QrCode result(tmpl);
+	bool yields = plan.version >= ASYNC_YIELD_MIN_VERSION;
+	
+	int numBlocks = result.getNumEccBlocks();
+	vector<vector<uint8_t> > blocks;
+	blocks.reserve(static_cast<size_t>(numBlocks));
+	for (int i = 0; i < numBlocks; i++) {
+		if (yields && i > 0)
+			co_await QrEncodeTask::Reschedule{exec};
+		blocks.push_back(result.makeEccBlock(dataCodewords, tmpl.rsDivisor, i));
+	}
+	result.drawCodewords(result.interleaveBlocks(blocks));
+	
+	if (mask == -1) {  // Automatically choose best mask
+		long minPenalty = LONG_MAX;
+		for (int i = 0; i < 8; i++) {
+			if (yields)
+				co_await QrEncodeTask::Reschedule{exec};
+			long penalty = result.evaluateMask(i);
+			if (penalty < minPenalty) {
+				mask = i;
+				minPenalty = penalty;
+			}
+		}
+	}
+	result.finishMask(mask);
+	co_return std::move(result);
+}
+
+#endif
+
+
+
+/*---- Class QrScheduler ----*/
+
+QrScheduler::QrScheduler(int numThreads) :
+		numQueued(0),
+		stopping(false) {
+	if (numThreads < 0)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	size_t n = numThreads > 0 ? static_cast<size_t>(numThreads) : std::thread::hardware_concurrency();
+	n = std::max(n, static_cast<size_t>(1));
+	for (size_t i = 0; i < n; i++)
+		workers.emplace_back(new Worker);
+	threads.reserve(n);
+	auto startThreads = [&]() {
+		for (size_t i = 0; i < n; i++)
+			threads.emplace_back(&QrScheduler::run, this, i);
+	};
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+	startThreads();
+#else
+	try {
+		startThreads();
+	} catch (...) {
+		// The destructor won't run, so stop the threads already started here
+		{
+			std::lock_guard<std::mutex> guard(sleepLock);
+			stopping = true;
+		}
+		wakeCondition.notify_all();
+		for (std::thread &th : threads)
+			th.join();
+		throw;
+	}
+#endif
+}
+
+
+QrScheduler::~QrScheduler() {
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		stopping = true;
+	}
+	wakeCondition.notify_all();
+	for (std::thread &th : threads)
+		th.join();
+}
+
+
+void QrScheduler::submit(Priority pri, long cost, std::function<void()> task) {
+	// Queue the task at the worker with the least outstanding cost
+	Worker *target = workers.at(0).get();
+	for (const std::unique_ptr<Worker> &w : workers) {
+		if (w->queuedCost.load(std::memory_order_relaxed) < target->queuedCost.load(std::memory_order_relaxed))
+			target = w.get();
+	}
+	
+	// Count the task before publishing it, so that take() never decrements numQueued below zero.
+	// A worker that wakes up in between just retries take() until the task appears.
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		numQueued++;
+	}
+	auto publish = [&]() {
+		std::lock_guard<std::mutex> guard(target->lock);
+		target->queues[static_cast<int>(pri)].emplace_back(cost, std::move(task));
+		target->queuedCost += cost;
+	};
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+	publish();
+#else
+	try {
+		publish();
+	} catch (...) {
+		std::lock_guard<std::mutex> guard(sleepLock);
+		numQueued--;
+		throw;
+	}
+#endif
+	wakeCondition.notify_one();
+}
+
+
+void QrScheduler::parallelFor(Priority pri, long cost, size_t count, const std::function<void(size_t)> &work) {
+	// Shared with the helper tasks, which may start after this call has returned
+	struct State final {
+		std::atomic<size_t> nextIndex;
+		std::mutex lock;
+		std::condition_variable doneCondition;
+		size_t numFinished = 0;
+		std::exception_ptr error;
+		State() : nextIndex(0) {}
+	};
+	std::shared_ptr<State> state = std::make_shared<State>();
+	
+	// A helper only touches work after claiming an index, and this call waits for every claimed index
+	auto loop = [state, count, &work]() {
+		for (size_t i; (i = state->nextIndex.fetch_add(1)) < count; ) {
+			std::exception_ptr err;
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+			work(i);
+#else
+			try {
+				work(i);
+			} catch (...) {
+				err = std::current_exception();
+			}
+#endif
+			std::lock_guard<std::mutex> guard(state->lock);
+			if (err && !state->error)
+				state->error = err;
+			if (++state->numFinished == count)
+				state->doneCondition.notify_all();
+		}
+	};
+	size_t numHelpers = std::min(count, threads.size() + 1) - (count > 0 ? 1 : 0);
+	for (size_t i = 0; i < numHelpers; i++)
+		submit(pri, cost, loop);
+	loop();
+	
+	std::unique_lock<std::mutex> guard(state->lock);
+	state->doneCondition.wait(guard, [&]() { return state->numFinished == count; });
+	if (state->error)
+		std::rethrow_exception(state->error);
+}
+
+
+int QrScheduler::getNumThreads() const {
+	return static_cast<int>(threads.size());
+}
+
+
+void QrScheduler::run(size_t self) {
+	std::function<void()> task;
+	while (true) {
+		if (take(self, task)) {
+			task();
+			task = nullptr;  // Release captured state before sleeping
+			continue;
+		}
+		std::unique_lock<std::mutex> guard(sleepLock);
+		wakeCondition.wait(guard, [this]() { return numQueued > 0 || stopping; });
+		if (numQueued == 0 && stopping)
+			return;
+	}
+}
+
+
+bool QrScheduler::take(size_t self, std::function<void()> &result) {
+	for (int pri = 0; pri < 2; pri++) {  // From most to least urgent
+		for (size_t i = 0; i < workers.size(); i++) {
+			// The own queue is checked first and used in FIFO order; thieves take from the back
+			Worker &w = *workers[(self + i) % workers.size()];
+			std::lock_guard<std::mutex> guard(w.lock);
+			std::deque<std::pair<long,std::function<void()> > > &queue = w.queues[pri];
+			if (queue.empty())
+				continue;
+			std::pair<long,std::function<void()> > &entry = i == 0 ? queue.front() : queue.back();
+			w.queuedCost -= entry.first;
+			result = std::move(entry.second);
+			if (i == 0)
+				queue.pop_front();
+			else
+				queue.pop_back();
+			std::lock_guard<std::mutex> sleepGuard(sleepLock);
+			numQueued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+QrScheduler::Worker::Worker() :
+	queuedCost(0) {}
+
+
+
+/*---- Class QrBatch ----*/
+
+QrBatch QrBatch::encodeText(const vector<std::string> &texts, const Options &opts) {
+	return encode(&texts, texts.size(), opts, [](const void *payloads, size_t index) {
+		return (*static_cast<const vector<std::string>*>(payloads))[index].size();
+	}, [](const void *payloads, size_t index) {
+		const std::string &text = (*static_cast<const vector<std::string>*>(payloads))[index];
+		return QrSegment::makeSegments(text.data(), text.size());
+	});
+}
+
+
+QrBatch QrBatch::encodeBinary(const vector<vector<uint8_t> > &datas, const Options &opts) {
+	return encode(&datas, datas.size(), opts, [](const void *payloads, size_t index) {
+		return (*static_cast<const vector<vector<uint8_t> >*>(payloads))[index].size();
+	}, [](const void *payloads, size_t index) {
+		return vector<QrSegment>{QrSegment::makeBytes((*static_cast<const vector<vector<uint8_t> >*>(payloads))[index])};
+	});
+}
+
+
+QrBatch QrBatch::encode(const void *payloads, size_t count, const Options &opts,
+		size_t (*getLength)(const void *payloads, size_t index),
+		vector<QrSegment> (*makeSegments)(const void *payloads, size_t index)) {
+	if (!(QrCode::MIN_VERSION <= opts.minVersion && opts.minVersion <= opts.maxVersion && opts.maxVersion <= QrCode::MAX_VERSION)
+			|| opts.mask < -1 || opts.mask > 7 || opts.numThreads < 0)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	vector<Item> items(count);
+	auto fail = [&](size_t i, const std::string &message) {
+		Item &item = items[i];
+		item = Item();
+		item.error = message;
+		item.errorCorrectionLevel = opts.errorCorrectionLevel;
+		item.mask = -1;
+	};
+	
+	// First pass: plan every payload and write its data codewords
+	vector<long> costs(count);
+	for (size_t i = 0; i < count; i++)
+		costs[i] = estimateCost(getLength(payloads, i), opts);
+	vector<vector<uint8_t> > dataCodewords(count);
+	auto planItem = [&](size_t i) {
+		const vector<QrSegment> segs = makeSegments(payloads, i);
+		QrCode::Plan plan;
+		QrCode::Status st = QrCode::tryPlanSegments(segs, opts.errorCorrectionLevel, plan,
+			opts.minVersion, opts.maxVersion, opts.boostEcl);
+		if (st != QrCode::Status::OK) {  // Rejected without throwing
+			fail(i, st == QrCode::Status::DATA_TOO_LONG ? QrCode::getDataTooLongMessage(plan.dataUsedBits,
+				opts.maxVersion, opts.errorCorrectionLevel) : std::string("Invalid value"));
+			return;
+		}
+		dataCodewords[i] = QrCode::makeDataCodewords(nullptr, segs, plan);
+		items[i].version = plan.version;
+		items[i].errorCorrectionLevel = plan.errorCorrectionLevel;
+	};
+	runParallel(count, costs, opts, [&](size_t i, size_t) {
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+		planItem(i);
+#else
+		try {
+			planItem(i);
+		} catch (const std::exception &e) {
+			fail(i, e.what());
+		}
+#endif
+	});
+	
+	// Bucket the successful items by (version, ECC level), keeping input order within each bucket
+	vector<size_t> order;
+	order.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		if (items[i].error.empty())
+			order.push_back(i);
+	}
+	auto bucketOf = [&](size_t i) {
+		return static_cast<int>(items[i].errorCorrectionLevel) * (QrCode::MAX_VERSION + 1) + items[i].version;
+	};
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return bucketOf(a) < bucketOf(b); });
+	
+	// Second pass: build the symbols in bucket order, packing each grid into its owner's scratch buffer.
+	// Whichever worker first reaches a bucket builds its template, and the others wait for it.
+	const size_t numBuckets = 4 * (QrCode::MAX_VERSION + 1);
+	vector<std::unique_ptr<QrCode::Template> > templates(numBuckets);
+	std::unique_ptr<std::once_flag[]> templateFlags(new std::once_flag[numBuckets]);
+	vector<long> sortedCosts(order.size());
+	for (size_t k = 0; k < order.size(); k++)
+		sortedCosts[k] = QrCode::getNumRawDataModules(items[order[k]].version);
+	vector<size_t> owners(count);
+	vector<vector<uint8_t> > scratches(getNumOwners(order.size(), sortedCosts, opts));
+	runParallel(order.size(), sortedCosts, opts, [&](size_t k, size_t owner) {
+		size_t i = order[k];
+		Item &item = items[i];
+		vector<uint8_t> &scratch = scratches[owner];
+		owners[i] = owner;
+		auto buildItem = [&]() {
+			size_t bucket = static_cast<size_t>(bucketOf(i));
+			std::call_once(templateFlags[bucket], [&]() {
+				templates[bucket].reset(new QrCode::Template(QrCode::makeTemplate(item.version, item.errorCorrectionLevel)));
+			});
+			QrCode qr(*templates[bucket]);
+			if (opts.scheduler != nullptr) {  // Large symbols also split their blocks and masks across the scheduler
+				qr.drawCodewordsAndMask(dataCodewords[i], templates[bucket]->rsDivisor, opts.mask,
+					*opts.scheduler, static_cast<int>(opts.priority));
+			} else
+				qr.drawCodewordsAndMask(dataCodewords[i], templates[bucket]->rsDivisor, opts.mask);
+			vector<uint8_t>().swap(dataCodewords[i]);  // Free memory early
+			item.offset = scratch.size();
+			item.size = qr.getSize();
+			item.mask = qr.getMask();
+			size_t numModules = static_cast<size_t>(item.size) * static_cast<size_t>(item.size);
+			scratch.resize(scratch.size() + (numModules + 7) / 8);
+			qr.packModules(&scratch[item.offset]);
+		};
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+		buildItem();
+#else
+		try {
+			buildItem();
+		} catch (const std::exception &e) {
+			fail(i, e.what());
+		}
+#endif
+	});
+	
+	// Gather the packed grids into one arena in input order
+	size_t arenaLen = 0;
+	for (const vector<uint8_t> &scratch : scratches)
+		arenaLen += scratch.size();
+	vector<uint8_t> arena;
+	arena.reserve(arenaLen);
+	for (size_t i = 0; i < count; i++) {
+		Item &item = items[i];
+		if (!item.error.empty())
+			continue;
+		const uint8_t *grid = scratches[owners[i]].data() + item.offset;
+		item.offset = arena.size();
+		size_t numModules = static_cast<size_t>(item.size) * static_cast<size_t>(item.size);
+		arena.insert(arena.end(), grid, grid + (numModules + 7) / 8);
+	}
+	return QrBatch(std::move(arena), std::move(items));
+}
+
+
+size_t QrBatch::getNumOwners(size_t count, const vector<long> &costs, const Options &opts) {
+	if (opts.scheduler != nullptr)
+		return splitTasks(count, costs, opts).size() - 1;
+	size_t numThreads = opts.numThreads > 0 ? static_cast<size_t>(opts.numThreads) : std::thread::hardware_concurrency();
+	return std::max(std::min(numThreads, count), static_cast<size_t>(1));
+}
+
+
+void QrBatch::runParallel(size_t count, const vector<long> &costs, const Options &opts,
+		const std::function<void(size_t, size_t)> &work) {
+	if (opts.scheduler == nullptr) {
+		// Each thread claims the next unprocessed index, and the calling thread is owner 0
+		size_t numThreads = getNumOwners(count, costs, opts);
+		std::atomic<size_t> nextIndex(0);
+		auto loop = [&](size_t owner) {
+			for (size_t i; (i = nextIndex.fetch_add(1)) < count; )
+				work(i, owner);
+		};
+		vector<std::thread> threads;
+		threads.reserve(numThreads - 1);
+		auto startThreads = [&]() {
+			for (size_t i = 1; i < numThreads; i++)
+				threads.emplace_back(loop, i);
+		};
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+		startThreads();
+#else
+		try {
+			startThreads();
+		} catch (...) {
+			nextIndex = count;  // The threads already started stop after their current index
+			for (std::thread &th : threads)
+				th.join();
+			throw;
+		}
+#endif
+		loop(0);
+		for (std::thread &th : threads)
+			th.join();
+		return;
+	}
+	
+	// Submit every task. The calling thread then runs each task that no worker has started yet,
+	// so this can be called from inside a task of the same scheduler without deadlocking.
+	const vector<size_t> taskStarts = splitTasks(count, costs, opts);
+	const size_t numTasks = taskStarts.size() - 1;
+	vector<long> taskCosts(numTasks, 0);
+	for (size_t t = 0; t < numTasks; t++) {
+		for (size_t i = taskStarts[t]; i < taskStarts[t + 1]; i++)
+			taskCosts[t] += costs[i];
+	}
+	
+	// Shared with the queued tasks, which may be dequeued after this call has returned
+	struct State final {
+		std::unique_ptr<std::atomic<bool>[]> claimed;
+		std::mutex lock;
+		std::condition_variable doneCondition;
+		size_t numPending;
+	};
+	std::shared_ptr<State> state = std::make_shared<State>();
+	state->claimed.reset(new std::atomic<bool>[numTasks]);
+	for (size_t t = 0; t < numTasks; t++)
+		state->claimed[t] = false;
+	state->numPending = numTasks;
+	
+	// A task only touches this frame after claiming its index, and this call waits for every claimed task
+	auto runTask = [state, &taskStarts, &work](size_t t) {
+		if (state->claimed[t].exchange(true))
+			return;
+		for (size_t i = taskStarts[t]; i < taskStarts[t + 1]; i++)
+			work(i, t);
+		std::lock_guard<std::mutex> guard(state->lock);
+		if (--state->numPending == 0)
+			state->doneCondition.notify_all();
+	};
+	auto submitTasks = [&]() {
+		for (size_t t = 0; t < numTasks; t++)
+			opts.scheduler->submit(opts.priority, taskCosts[t], [runTask, t]() { runTask(t); });
+	};
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+	submitTasks();
+#else
+	try {
+		submitTasks();
+	} catch (...) {}  // The calling thread runs the tasks that couldn't be submitted
+#endif
+	for (size_t t = 0; t < numTasks; t++)
+		runTask(t);
+	
+	std::unique_lock<std::mutex> guard(state->lock);
+	state->doneCondition.wait(guard, [&]() { return state->numPending == 0; });
+}
+
+
+vector<size_t> QrBatch::splitTasks(size_t count, const vector<long> &costs, const Options &opts) {
+	// Cut the range into runs of consecutive indexes whose cost reaches the grain, so that
+	// a bulk batch yields to interactive work between tasks. Interactive items each get their own task.
+	const long grain = opts.priority == QrScheduler::Priority::INTERACTIVE ? 0 : BULK_TASK_COST;
+	vector<size_t> result;
+	long runCost = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (result.empty() || runCost >= grain) {
+			result.push_back(i);
+			runCost = 0;
+		}
+		runCost += costs[i];
+	}
+	result.push_back(count);
+	return result;
+}
+
+
+const long QrBatch::BULK_TASK_COST = 1L << 15;
+
+
+long QrBatch::estimateCost(size_t numBytes, const Options &opts) {
+	for (int ver = opts.minVersion; ver <= opts.maxVersion; ver++) {
+		int ccbits = QrSegment::Mode::BYTE.numCharCountBits(ver);
+		if (numBytes < (static_cast<size_t>(1) << ccbits)
+				&& static_cast<size_t>(4 + ccbits) + numBytes * 8 <= static_cast<size_t>(QrCode::getDataCapacityBits(ver, opts.errorCorrectionLevel)))
+			return QrCode::getNumRawDataModules(ver);
+	}
+	return QrCode::getNumRawDataModules(opts.minVersion);  // Fails quickly with data_too_long
+}
+
+
+QrBatch::QrBatch(vector<uint8_t> &&arna, vector<Item> &&itms) :
+	arena(std::move(arna)),
+	items(std::move(itms)) {}
+
+
+size_t QrBatch::getCount() const {
+	return items.size();
+}
+
+
+const QrBatch::Item &QrBatch::getItem(size_t index) const {
+	return items.at(index);
+}
+
+
+bool QrBatch::getModule(size_t index, int x, int y) const {
+	const Item &item = items.at(index);
+	if (!item.error.empty() || x < 0 || x >= item.size || y < 0 || y >= item.size)
+		return false;
+	size_t i = static_cast<size_t>(y) * static_cast<size_t>(item.size) + static_cast<size_t>(x);
+	return ((arena[item.offset + (i >> 3)] >> (i & 7)) & 1) != 0;
+}
+
+
+const vector<uint8_t> &QrBatch::getArena() const {
+	return arena;
+}
+
+
+
+/*---- Class QrPipeline ----*/
+
+struct QrPipeline::Job final {
+	std::uint64_t sequence;
+	std::string text;
+	std::string error;  // If not empty, the remaining stages up to OUTPUT skip this job
+	QrCode::Plan plan;
+	vector<uint8_t> codewords;  // The data codewords after PLAN, then all codewords after ECC
+	std::unique_ptr<QrCode> qr;  // Made by ECC, finished by MASK
+};
+
+
+// A bounded queue of jobs. A producer waits while it is full, which is what turns a slow stage
+// into backpressure on the stages before it, and a consumer waits while it is empty.
+class QrPipeline::Queue final {
+	
+	private: mutable std::mutex lock;
+	private: std::condition_variable notEmpty;
+	private: std::condition_variable notFull;
+	private: std::deque<Job*> jobs;
+	private: size_t capacity;
+	
+	// The number of threads that can still push. Once this is zero,
+	// push() fails, and pop() fails as soon as the queue is empty.
+	private: int numProducers;
+	
+	
+	public: Queue(size_t cap, int producers) :
+		capacity(cap),
+		numProducers(producers) {}
+	
+	
+	// Blocks while the queue is full, then appends the given job and returns true,
+	// or returns false if every producer has finished.
+	public: bool push(Job *job) {
+		std::unique_lock<std::mutex> guard(lock);
+		notFull.wait(guard, [this]() { return jobs.size() < capacity || numProducers == 0; });
+		if (numProducers == 0)
+			return false;
+		jobs.push_back(job);
+		guard.unlock();
+		notEmpty.notify_one();
+		return true;
+	}
+	
+	
+	// Blocks until a job is available and returns true, or returns false if the queue
+	// is empty and every producer has finished.
+	public: bool pop(Job *&job) {
+		std::unique_lock<std::mutex> guard(lock);
+		notEmpty.wait(guard, [this]() { return !jobs.empty() || numProducers == 0; });
+		if (jobs.empty())
+			return false;
+		job = jobs.front();
+		jobs.pop_front();
+		guard.unlock();
+		notFull.notify_one();
+		return true;
+	}
+	
+	
+	// Records that one producer has finished, and wakes every waiting thread after the last one.
+	public: void finishProducer() {
+		std::lock_guard<std::mutex> guard(lock);
+		if (--numProducers == 0) {
+			notEmpty.notify_all();
+			notFull.notify_all();
+		}
+	}
+	
+	
+	public: size_t size() const {
+		std::lock_guard<std::mutex> guard(lock);
+		return jobs.size();
+	}
+	
+};
+
+
+QrPipeline::QrPipeline(const Options &opts, Sink snk) :
+		options(opts),
+		sink(std::move(snk)),
+		nextSequence(0),
+		closed(false) {
+	if (!(QrCode::MIN_VERSION <= opts.minVersion && opts.minVersion <= opts.maxVersion && opts.maxVersion <= QrCode::MAX_VERSION)
+			|| opts.mask < -1 || opts.mask > 7 || opts.queueCapacity == 0 || !sink)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	for (int n : opts.numThreads) {
+		if (n < 1)
+			QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	}
+	for (size_t i = 0; i < 5; i++)  // The first queue's only producer is the input side
+		queues[i].reset(new Queue(opts.queueCapacity, i == 0 ? 1 : opts.numThreads[i - 1]));
+	
+	int numStarted[5] = {};
+	auto startThreads = [&]() {
+		for (size_t i = 0; i < 5; i++) {
+			for (; numStarted[i] < opts.numThreads[i]; numStarted[i]++)
+				threads.emplace_back(&QrPipeline::run, this, static_cast<Stage>(i));
+		}
+	};
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+	startThreads();
+#else
+	try {
+		startThreads();
+	} catch (...) {
+		// Shut down like close(), counting the threads that never started as finished producers
+		queues[0]->finishProducer();
+		for (size_t i = 1; i < 5; i++) {
+			for (int j = numStarted[i - 1]; j < opts.numThreads[i - 1]; j++)
+				queues[i]->finishProducer();
+		}
+		for (std::thread &th : threads)
+			th.join();
+		throw;
+	}
+#endif
+}
+
+
+QrPipeline::~QrPipeline() {
+	close();
+}
+
+
+std::uint64_t QrPipeline::push(std::string text) {
+	std::unique_ptr<Job> job(new Job);
+	job->text = std::move(text);
+	{
+		std::lock_guard<std::mutex> guard(inputLock);
+		if (closed)
+			QRCODEGEN_THROW(std::logic_error("Pipeline closed"));
+		job->sequence = nextSequence++;
+	}
+	// Waits for room without holding inputLock, so that close() can interrupt the wait
+	std::uint64_t result = job->sequence;
+	if (!queues[0]->push(job.get()))
+		QRCODEGEN_THROW(std::logic_error("Pipeline closed"));
+	job.release();
+	return result;
+}
+
+
+void QrPipeline::close() {
+	{
+		std::lock_guard<std::mutex> guard(inputLock);
+		if (closed)
+			return;
+		closed = true;
+		queues[0]->finishProducer();
+	}
+	for (std::thread &th : threads)
+		th.join();
+}
+
+
+QrPipeline::StageStats QrPipeline::getStats(Stage st) const {
+	size_t i = static_cast<size_t>(st);
+	StageStats result;
+	result.queueDepth = queues[i]->size();
+	result.processed = counters[i].processed.load(std::memory_order_relaxed);
+	result.busyNanoseconds = counters[i].busyNanoseconds.load(std::memory_order_relaxed);
+	return result;
+}
+
+
+void QrPipeline::run(Stage st) {
+	size_t i = static_cast<size_t>(st);
+	Job *job;
+	while (queues[i]->pop(job)) {
+		auto start = std::chrono::steady_clock::now();
+		process(st, *job);
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		counters[i].busyNanoseconds.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+		counters[i].processed.fetch_add(1, std::memory_order_relaxed);
+		if (st == Stage::OUTPUT)
+			delete job;
+		else if (!queues[i + 1]->push(job))  // Unreachable, because this thread is still a producer
+			delete job;
+	}
+	if (st != Stage::OUTPUT)
+		queues[i + 1]->finishProducer();
+}
+
+
+void QrPipeline::process(Stage st, Job &job) {
+	if (st == Stage::OUTPUT) {
+		sink(job.sequence, job.error.empty() ? job.qr.get() : nullptr, job.error);
+		return;
+	}
+	if (!job.error.empty())
+		return;
+	auto runStage = [&]() {
+		switch (st) {
+			case Stage::PLAN: {
+				const vector<QrSegment> segs = QrSegment::makeSegments(job.text.data(), job.text.size());
+				QrCode::Status status = QrCode::tryPlanSegments(segs, options.errorCorrectionLevel, job.plan,
+					options.minVersion, options.maxVersion, options.boostEcl);
+				if (status != QrCode::Status::OK) {  // Rejected without throwing
+					job.error = status == QrCode::Status::DATA_TOO_LONG ? QrCode::getDataTooLongMessage(
+						job.plan.dataUsedBits, options.maxVersion, options.errorCorrectionLevel) : "Invalid value";
+					break;
+				}
+				job.codewords = QrCode::makeDataCodewords(nullptr, segs, job.plan);
+				std::string().swap(job.text);
+				break;
+			}
+			case Stage::ECC: {
+				const QrCode::Template &tmpl = getTemplate(job.plan.version, job.plan.errorCorrectionLevel);
+				job.qr.reset(new QrCode(tmpl));
+				job.codewords = job.qr->addEccAndInterleave(job.codewords, tmpl.rsDivisor);
+				break;
+			}
+			case Stage::PLACE:
+				job.qr->drawCodewords(job.codewords);
+				vector<uint8_t>().swap(job.codewords);
+				break;
+			case Stage::MASK:
+				job.qr->finishMask(options.mask);
+				break;
+			default:
+				QRCODEGEN_THROW(std::logic_error("Unreachable"));
+		}
+	};
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+	runStage();
+#else
+	try {
+		runStage();
+	} catch (const std::exception &e) {
+		job.error = e.what();
+		job.qr.reset();
+	}
+#endif
+}
+
+
+const QrCode::Template &QrPipeline::getTemplate(int ver, QrCode::Ecc ecl) {
+	size_t i = static_cast<size_t>(static_cast<int>(ecl) * 41 + ver);
+	std::call_once(templateFlags[i], [&]() {
+		templates[i].reset(new QrCode::Template(QrCode::makeTemplate(ver, ecl)));
+	});
+	return *templates[i];
+}
+
+
+QrPipeline::Counters::Counters() :
+	processed(0),
+	busyNanoseconds(0) {}
+
+
+
+/*---- Class QrCache ----*/
+
+struct QrCache::Shard final {
+	
+	struct Entry final {
+		std::string key;
+		int version;
+		QrCode::Ecc errorCorrectionLevel;
+		int mask;
+		vector<uint8_t> grid;
+		size_t bytes;  // Charged against the budget
+	};
+	
+	std::mutex lock;
+	std::list<Entry> entries;  // Most recently used first
+	std::unordered_map<std::string,std::list<Entry>::iterator> index;
+	size_t bytes = 0;
+	std::uint64_t hits = 0;
+	std::uint64_t misses = 0;
+	std::uint64_t evictions = 0;
+	
+};
+
+
+QrCache::QrCache(size_t maxBytes, int numShards) {
+	if (numShards <= 0)
+		QRCODEGEN_THROW(std::invalid_argument("Number of shards must be positive"));
+	for (int i = 0; i < numShards; i++)
+		shards.emplace_back(new Shard);
+	shardMaxBytes = maxBytes / static_cast<size_t>(numShards);
+}
+
+
+QrCache::~QrCache() {}
+
+
+QrCode QrCache::encodeText(const char *text, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	return lookup(makeKey('T', ecl, minVersion, maxVersion, mask, boostEcl, text, std::strlen(text)), [&]() {
+		return QrCode::encodeSegments(QrSegment::makeSegments(text), ecl, minVersion, maxVersion, mask, boostEcl);
+	});
+}
+
+
+QrCode QrCache::encodeBinary(const vector<uint8_t> &data, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	return lookup(makeKey('B', ecl, minVersion, maxVersion, mask, boostEcl,
+			reinterpret_cast<const char *>(data.data()), data.size()), [&]() {
+		vector<QrSegment> segs{QrSegment::makeBytes(data)};
+		return QrCode::encodeSegments(segs, ecl, minVersion, maxVersion, mask, boostEcl);
+	});
+}
+
+
+QrCache::Stats QrCache::getStats() const {
+	Stats result = {0, 0, 0, 0, 0};
+	for (const std::unique_ptr<Shard> &sh : shards) {
+		std::lock_guard<std::mutex> guard(sh->lock);
+		result.hits      += sh->hits;
+		result.misses    += sh->misses;
+		result.evictions += sh->evictions;
+		result.entries   += sh->entries.size();
+		result.bytes     += sh->bytes;
+	}
+	return result;
+}
+
+
+void QrCache::clear() {
+	for (const std::unique_ptr<Shard> &sh : shards) {
+		std::lock_guard<std::mutex> guard(sh->lock);
+		sh->index.clear();
+		sh->entries.clear();
+		sh->bytes = 0;
+	}
+}
+
+
+QrCode QrCache::lookup(std::string &&key, const std::function<QrCode()> &encode) {
+	Shard &sh = *shards[std::hash<std::string>()(key) % shards.size()];
+	{
+		std::lock_guard<std::mutex> guard(sh.lock);
+		auto it = sh.index.find(key);
+		if (it != sh.index.end()) {
+			sh.hits++;
+			sh.entries.splice(sh.entries.begin(), sh.entries, it->second);
+			const Shard::Entry &e = *it->second;
+			return QrCode(e.version, e.errorCorrectionLevel, e.mask, e.grid.data());
+		}
+		sh.misses++;
+	}
+	
+	// Encode without holding the lock, so other lookups in this shard can proceed
+	QrCode result = encode();
+	size_t size = static_cast<size_t>(result.getSize());
+	Shard::Entry entry;
+	entry.bytes = key.size() * 2 + (size * size + 7) / 8 + sizeof(Shard::Entry) + 4 * sizeof(void*);  // Key is held twice
+	if (entry.bytes > shardMaxBytes)
+		return result;
+	entry.version = result.getVersion();
+	entry.errorCorrectionLevel = result.getErrorCorrectionLevel();
+	entry.mask = result.getMask();
+	entry.grid.resize((size * size + 7) / 8);
+	result.packModules(entry.grid.data());
+	entry.key = key;
+	
+	std::lock_guard<std::mutex> guard(sh.lock);
+	if (sh.index.count(key) > 0)  // Another thread stored it first
+		return result;
+	while (sh.bytes + entry.bytes > shardMaxBytes) {
+		const Shard::Entry &oldest = sh.entries.back();
+		sh.bytes -= oldest.bytes;
+		sh.index.erase(oldest.key);
+		sh.entries.pop_back();
+		sh.evictions++;
+	}
+	sh.bytes += entry.bytes;
+	sh.entries.push_front(std::move(entry));
+	sh.index.emplace(std::move(key), sh.entries.begin());
+	return result;
+}
+
+
+std::string QrCache::makeKey(char kind, QrCode::Ecc ecl, int minVersion, int maxVersion,
+		int mask, bool boostEcl, const char *data, size_t len) {
+	std::string result;
+	result.reserve(6 + len);
+	result.push_back(kind);
+	result.push_back(static_cast<char>(ecl));
+	result.push_back(static_cast<char>(minVersion));
+	result.push_back(static_cast<char>(maxVersion));
+	result.push_back(static_cast<char>(mask));
+	result.push_back(boostEcl ? '1' : '0');
+	result.append(data, len);
+	return result;
+}
+
+
+
+/*---- Class LazyQrCode ----*/
+
+LazyQrCode LazyQrCode::encodeText(const char *text, QrCode::Ecc ecl) {
+	return encodeSegments(QrSegment::makeSegments(text), ecl);
+}
+
+
+LazyQrCode LazyQrCode::encodeBinary(const vector<uint8_t> &data, QrCode::Ecc ecl) {
+	return encodeSegments(vector<QrSegment>{QrSegment::makeBytes(data)}, ecl);
+}
+
+
+LazyQrCode LazyQrCode::encodeSegments(const vector<QrSegment> &segs, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	if (!(QrCode::MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= QrCode::MAX_VERSION)
+			|| mask < -1 || mask > 7)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	const QrCode::Plan plan = QrCode::planSegments(segs, ecl, minVersion, maxVersion, boostEcl);
+	return LazyQrCode(plan.version, plan.errorCorrectionLevel, QrCode::makeDataCodewords(nullptr, segs, plan), mask);
+}
+
+
+LazyQrCode::LazyQrCode(int ver, QrCode::Ecc ecl, vector<uint8_t> dataCodewords, int msk) :
+		version(ver),
+		errorCorrectionLevel(ecl),
+		mask(msk) {
+	if (ver < QrCode::MIN_VERSION || ver > QrCode::MAX_VERSION)
+		QRCODEGEN_THROW(std::domain_error("Version value out of range"));
+	if (msk < -1 || msk > 7)
+		QRCODEGEN_THROW(std::domain_error("Mask value out of range"));
+	if (dataCodewords.size() * 8 != static_cast<unsigned int>(QrCode::getDataCapacityBits(ver, ecl)))
+		QRCODEGEN_THROW(std::invalid_argument("Invalid argument"));
+	state = std::make_shared<State>(std::move(dataCodewords));
+}
+
+
+LazyQrCode::State::State(vector<uint8_t> &&data) :
+	dataCodewords(std::move(data)),
+	realized(false) {}
+
+
+int LazyQrCode::getVersion() const {
+	return version;
+}
+
+
+int LazyQrCode::getSize() const {
+	return version * 4 + 17;
+}
+
+
+QrCode::Ecc LazyQrCode::getErrorCorrectionLevel() const {
+	return errorCorrectionLevel;
+}
+
+
+const vector<uint8_t> &LazyQrCode::getDataCodewords() const {
+	return state->dataCodewords;
+}
+
+
+bool LazyQrCode::isRealized() const {
+	return state->realized.load(std::memory_order_acquire);
+}
+
+
+int LazyQrCode::getMask() const {
+	return mask != -1 ? mask : getQrCode().getMask();
+}
+
+
+bool LazyQrCode::getModule(int x, int y) const {
+	return getQrCode().getModule(x, y);
+}
+
+
+const QrCode &LazyQrCode::getQrCode() const {
+	State &st = *state;
+	if (!st.realized.load(std::memory_order_acquire)) {
+		std::call_once(st.flag, [&]() {
+			st.qrCode.reset(new QrCode(version, errorCorrectionLevel, st.dataCodewords, mask));
+			st.realized.store(true, std::memory_order_release);
+		});
+	}
+	return *st.qrCode;
+}
+
+
+
+#ifdef QRCODEGEN_HAS_DISK_CACHE
+
+/*---- Class QrDiskCache ----*/
+
+// Every cache file starts with this magic, then the key length as 4 bytes in little endian, then the key.
+static const char DISK_CACHE_MAGIC[4] = {'Q', 'R', 'C', '2'};
+
+// The age in seconds after which a temporary file is taken to be left by a writer that died.
+static const long long DISK_CACHE_TEMP_MAX_AGE = 3600;
+
+
+QrDiskCache::QrDiskCache(const std::string &dir, std::uint64_t maxSize) :
+		directory(dir),
+		maxBytes(maxSize),
+		stats(Stats{0, 0, 0, 0, 0}),
+		nextTempId(0) {
+	if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST)
+		QRCODEGEN_THROW(std::runtime_error("Cannot create cache directory"));
+	DIR *d = ::opendir(directory.c_str());
+	if (d == nullptr)
+		QRCODEGEN_THROW(std::runtime_error("Cannot read cache directory"));
+	long long now = static_cast<long long>(std::time(nullptr));
+	for (struct dirent *ent; (ent = ::readdir(d)) != nullptr; ) {
+		std::string name(ent->d_name);
+		std::string path = directory + "/" + name;
+		struct stat st;
+		if (name.compare(0, 5, ".tmp.") == 0) {
+			if (::stat(path.c_str(), &st) == 0 && now - static_cast<long long>(st.st_mtime) >= DISK_CACHE_TEMP_MAX_AGE)
+				::unlink(path.c_str());
+			continue;
+		}
+		if (name.size() != 20 || name.compare(16, 4, ".qrc") != 0 || ::stat(path.c_str(), &st) != 0)
+			continue;
+		files[name] = FileInfo{static_cast<std::uint64_t>(st.st_size), static_cast<long long>(st.st_mtime)};
+		stats.bytes += static_cast<std::uint64_t>(st.st_size);
+	}
+	::closedir(d);
+}
+
+
+QrCode QrDiskCache::encodeText(const char *text, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	return lookupSymbol("S" + QrCache::makeKey('T', ecl, minVersion, maxVersion, mask, boostEcl, text, std::strlen(text)), [&]() {
+		return QrCode::encodeSegments(QrSegment::makeSegments(text), ecl, minVersion, maxVersion, mask, boostEcl);
+	});
+}
+
+
+QrCode QrDiskCache::encodeBinary(const vector<uint8_t> &data, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	return lookupSymbol("S" + QrCache::makeKey('B', ecl, minVersion, maxVersion, mask, boostEcl,
+			reinterpret_cast<const char *>(data.data()), data.size()), [&]() {
+		vector<QrSegment> segs{QrSegment::makeBytes(data)};
+		return QrCode::encodeSegments(segs, ecl, minVersion, maxVersion, mask, boostEcl);
+	});
+}
+
+
+QrDiskCache::Blob QrDiskCache::renderText(const char *text, QrCode::Ecc ecl, const std::string &renderOptions,
+		const std::function<std::string(const QrCode &)> &render,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	// The render options come first with their length, so that no two keys can run together
+	std::string key = "R";
+	for (int i = 0; i < 4; i++)
+		key.push_back(static_cast<char>(renderOptions.size() >> (i * 8)));
+	key += renderOptions;
+	key += QrCache::makeKey('T', ecl, minVersion, maxVersion, mask, boostEcl, text, std::strlen(text));
+	
+	Blob result(std::string{});
+	if (read(key, result)) {
+		std::lock_guard<std::mutex> guard(lock);
+		stats.hits++;
+		return result;
+	}
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stats.misses++;
+	}
+	// Encode directly, because a lookup of the symbol's own entry would count a second miss
+	std::string output = render(QrCode::encodeSegments(QrSegment::makeSegments(text), ecl, minVersion, maxVersion, mask, boostEcl));
+	write(key, output);
+	return Blob(std::move(output));
+}
+
+
+QrDiskCache::Stats QrDiskCache::getStats() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return stats;
+}
+
+
+QrCode QrDiskCache::lookupSymbol(const std::string &key, const std::function<QrCode()> &encode) {
+	// The entry holds the symbol serialized in the full layout
+	Blob blob(std::string{});
+	int ver;
+	QrCode::Ecc ecl;
+	int msk;
+	bool dataRegionOnly;
+	if (read(key, blob) && QrCode::parseSerialized(blob.data(), blob.size(), ver, ecl, msk, dataRegionOnly)) {
+		QrCode result = QrCode::deserialize(blob.data(), blob.size());  // Doesn't throw after the check
+		std::lock_guard<std::mutex> guard(lock);
+		stats.hits++;
+		return result;
+	}  // A corrupt entry counts as a miss
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stats.misses++;
+	}
+	
+	QrCode result = encode();
+	const vector<uint8_t> bytes = result.serialize();
+	write(key, std::string(bytes.cbegin(), bytes.cend()));
+	return result;
+}
+
+
+bool QrDiskCache::read(const std::string &key, Blob &result) {
+	const std::string name = getFileName(key);
+	const std::string path = directory + "/" + name;
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return false;
+	struct stat st;
+	size_t headerLen = sizeof(DISK_CACHE_MAGIC) + 4 + key.size();
+	void *map = MAP_FAILED;
+	if (::fstat(fd, &st) == 0 && static_cast<std::uint64_t>(st.st_size) >= headerLen)
+		map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED)
+		return false;
+	
+	// The blob unmaps the file if it doesn't hold this key
+	Blob blob(map, static_cast<size_t>(st.st_size), headerLen);
+	const char *p = static_cast<const char *>(map);
+	uint32_t keyLen = 0;
+	for (size_t i = 0; i < 4; i++)
+		keyLen |= static_cast<uint32_t>(static_cast<uint8_t>(p[sizeof(DISK_CACHE_MAGIC) + i])) << (i * 8);
+	if (std::memcmp(p, DISK_CACHE_MAGIC, sizeof(DISK_CACHE_MAGIC)) != 0 || keyLen != key.size()
+			|| std::memcmp(p + sizeof(DISK_CACHE_MAGIC) + 4, key.data(), key.size()) != 0)
+		return false;
+	result = std::move(blob);
+	
+	// Refresh the recency, touching the file only if its time is stale, so that most hits write nothing
+	long long now = static_cast<long long>(std::time(nullptr));
+	std::lock_guard<std::mutex> guard(lock);
+	auto it = files.find(name);
+	if (it == files.end()) {  // Written by another process
+		it = files.emplace(name, FileInfo{static_cast<std::uint64_t>(st.st_size), static_cast<long long>(st.st_mtime)}).first;
+		stats.bytes += it->second.size;
+	}
+	if (now - it->second.lastUse >= 60) {
+		it->second.lastUse = now;
+		::utime(path.c_str(), nullptr);
+	}
+	return true;
+}
+
+
+void QrDiskCache::write(const std::string &key, const std::string &bytes) {
+	const std::string name = getFileName(key);
+	std::string header(DISK_CACHE_MAGIC, sizeof(DISK_CACHE_MAGIC));
+	for (int i = 0; i < 4; i++)
+		header.push_back(static_cast<char>(key.size() >> (i * 8)));
+	header += key;
+	
+	// Write a temporary file, then rename it over any existing entry
+	std::string tempPath;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		tempPath = directory + "/.tmp." + std::to_string(::getpid()) + "." + std::to_string(nextTempId++);
+	}
+	auto writeAll = [](int f, const std::string &str) {
+		for (size_t off = 0; off < str.size(); ) {
+			ssize_t n = ::write(f, str.data() + off, str.size() - off);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				return false;
+			off += static_cast<size_t>(n);
+		}
+		return true;
+	};
+	// On every failure after the file is created, it is unlinked here; if the process dies
+	// before the rename, the constructor of a later cache deletes the file once it is stale
+	const std::string path = directory + "/" + name;
+	int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+	bool ok = fd != -1 && writeAll(fd, header) && writeAll(fd, bytes);
+	if (fd != -1 && ::close(fd) != 0)
+		ok = false;
+	if (ok && std::rename(tempPath.c_str(), path.c_str()) != 0)
+		ok = false;
+	if (!ok && fd != -1)
+		::unlink(tempPath.c_str());
+	
+	std::lock_guard<std::mutex> guard(lock);
+	if (!ok) {
+		stats.writeFailures++;
+		return;
+	}
+	FileInfo &info = files[name];
+	stats.bytes -= info.size;  // Zero if the entry is new
+	info.size = header.size() + bytes.size();
+	info.lastUse = static_cast<long long>(std::time(nullptr));
+	stats.bytes += info.size;
+	if (stats.bytes <= maxBytes)
+		return;
+	
+	// Delete the least recently used entries until well under the cap, so that eviction is infrequent
+	vector<std::pair<long long,std::string> > order;
+	order.reserve(files.size());
+	for (const auto &entry : files)
+		order.emplace_back(entry.second.lastUse, entry.first);
+	std::sort(order.begin(), order.end());
+	for (const auto &entry : order) {
+		if (stats.bytes <= maxBytes / 8 * 7)
+			break;
+		::unlink((directory + "/" + entry.second).c_str());
+		stats.bytes -= files[entry.second].size;
+		files.erase(entry.second);
+		stats.evictions++;
+	}
+}
+
+
+std::string QrDiskCache::getFileName(const std::string &key) {
+	// 64-bit FNV-1a, in 16 hexadecimal digits
+	std::uint64_t hash = UINT64_C(14695981039346656037);
+	for (char c : key)
+		hash = (hash ^ static_cast<uint8_t>(c)) * UINT64_C(1099511628211);
+	std::string result;
+	for (int i = 60; i >= 0; i -= 4)
+		result.push_back("0123456789abcdef"[(hash >> i) & 0xF]);
+	return result + ".qrc";
+}
+
+
+QrDiskCache::Blob::Blob(std::string &&bytes) :
+	mapping(nullptr),
+	mappingLen(0),
+	offset(0),
+	owned(std::move(bytes)) {}
+
+
+QrDiskCache::Blob::Blob(void *map, size_t mapLen, size_t off) :
+	mapping(map),
+	mappingLen(mapLen),
+	offset(off) {}
+
+
+QrDiskCache::Blob::Blob(Blob &&other) noexcept :
+		mapping(other.mapping),
+		mappingLen(other.mappingLen),
+		offset(other.offset),
+		owned(std::move(other.owned)) {
+	other.mapping = nullptr;
+}
+
+
+QrDiskCache::Blob &QrDiskCache::Blob::operator=(Blob &&other) noexcept {
+	if (this != &other) {
+		if (mapping != nullptr)
+			::munmap(mapping, mappingLen);
+		mapping = other.mapping;
+		mappingLen = other.mappingLen;
+		offset = other.offset;
+		owned = std::move(other.owned);
+		other.mapping = nullptr;
+	}
+	return *this;
+}
+
+
+QrDiskCache::Blob::~Blob() {
+	if (mapping != nullptr)
+		::munmap(mapping, mappingLen);
+}
+
+
+const uint8_t *QrDiskCache::Blob::data() const {
+	if (mapping != nullptr)
+		return static_cast<const uint8_t *>(mapping) + offset;
+	return reinterpret_cast<const uint8_t *>(owned.data());
+}
+
+
+size_t QrDiskCache::Blob::size() const {
+	return mapping != nullptr ? mappingLen - offset : owned.size();
+}
+
+#endif
+
+
+
+#ifdef QRCODEGEN_HAS_COROUTINES
+
+/*---- Class QrEncodeTask ----*/
+
+QrEncodeTask::QrEncodeTask(std::coroutine_handle<promise_type> h) :
+	handle(h) {}
+
+
+QrEncodeTask::QrEncodeTask(QrEncodeTask &&other) noexcept :
+	handle(std::exchange(other.handle, nullptr)) {}
+
+
+QrEncodeTask &QrEncodeTask::operator=(QrEncodeTask &&other) noexcept {
+	if (this != &other) {
+		if (handle)
+			handle.destroy();
+		handle = std::exchange(other.handle, nullptr);
+	}
+	return *this;
+}
+
+
+QrEncodeTask::~QrEncodeTask() {
+	if (handle)
+		handle.destroy();
+}
+
+
+QrCode QrEncodeTask::get() {
+	if (!handle || handle.promise().continuation || handle.done())
+		QRCODEGEN_THROW(std::logic_error("Task already started"));
+	handle.resume();
+	promise_type &prom = handle.promise();
+	{
+		std::unique_lock<std::mutex> lock(prom.mutex);
+		prom.finished.wait(lock, [&]() { return prom.isDone; });
+	}
+	return await_resume();
+}
+
+
+bool QrEncodeTask::await_ready() const noexcept {
+	return false;
+}
+
+
+std::coroutine_handle<> QrEncodeTask::await_suspend(std::coroutine_handle<> awaiting) {
+	if (!handle || handle.promise().continuation || handle.done())
+		QRCODEGEN_THROW(std::logic_error("Task already started"));
+	handle.promise().continuation = awaiting;
+	return handle;  // Start the task, which resumes the awaiting coroutine when it finishes
+}
+
+
+QrCode QrEncodeTask::await_resume() {
+	promise_type &prom = handle.promise();
+	if (prom.error)
+		std::rethrow_exception(prom.error);
+	return std::move(*prom.result);
+}
+
+
+QrEncodeTask QrEncodeTask::promise_type::get_return_object() {
+	return QrEncodeTask(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+
+std::suspend_always QrEncodeTask::promise_type::initial_suspend() noexcept {
+	return {};
+}
+
+
+QrEncodeTask::FinalAwaiter QrEncodeTask::promise_type::final_suspend() noexcept {
+	return {};
+}
+
+
+void QrEncodeTask::promise_type::return_value(QrCode &&qr) {
+	result.emplace(std::move(qr));
+}
+
+
+void QrEncodeTask::promise_type::unhandled_exception() noexcept {
+	error = std::current_exception();
+}
+
+
+bool QrEncodeTask::FinalAwaiter::await_ready() noexcept {
+	return false;
+}
+
+
+std::coroutine_handle<> QrEncodeTask::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+	promise_type &prom = h.promise();
+	if (prom.continuation)
+		return prom.continuation;  // Symmetric transfer, so deep chains of tasks do not grow the stack
+	// Notify while holding the lock, because get() may destroy the task as soon as it sees isDone
+	std::lock_guard<std::mutex> lock(prom.mutex);
+	prom.isDone = true;
+	prom.finished.notify_all();
+	return std::noop_coroutine();
+}
+
+
+void QrEncodeTask::FinalAwaiter::await_resume() noexcept {}
+
+
+bool QrEncodeTask::Reschedule::await_ready() noexcept {
+	return false;
+}
+
+
+void QrEncodeTask::Reschedule::await_suspend(std::coroutine_handle<> h) {
+	executor([h]() { h.resume(); });
+}
+
+
+void QrEncodeTask::Reschedule::await_resume() noexcept {}
+
+#endif
+
+#ifdef QRCODEGEN_USE_PMR
+}
+#endif
+
+}
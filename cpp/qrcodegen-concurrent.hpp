@@ -0,0 +1,977 @@
+/* 
+ * QR Code generator library (C++), concurrent classes
+ * 
+ * Copyright (c) Project Nayuki. (MIT License)
+ * https://www.nayuki.io/page/qr-code-generator-library
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * - The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ * - The Software is provided "as is", without warranty of any kind, express or
+ *   implied, including but not limited to the warranties of merchantability,
+ *   fitness for a particular purpose and noninfringement. In no event shall the
+ *   authors or copyright holders be liable for any claim, damages or other
+ *   liability, whether in an action of contract, tort or otherwise, arising from,
+ *   out of or in connection with the Software or the use or other dealings in the
+ *   Software.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "qrcodegen.hpp"
+#ifdef QRCODEGEN_HAS_COROUTINES
+	#include <exception>
+	#include <optional>
+#endif
+
+
+namespace qrcodegen {
+
+#ifdef QRCODEGEN_USE_PMR
+inline namespace pmr_grid {  // As declared in qrcodegen.hpp
+#endif
+
+/* 
+ * A pool of worker threads that runs encoding tasks by priority class, for services that mix
+ * latency-sensitive requests with bulk jobs. Each worker has one queue per class. Idle workers
+ * steal from the others' queues, and every worker runs any queued INTERACTIVE task before any
+ * BULK task, so a large bulk job delays an interactive request by at most one task. A submitted
+ * task goes to the worker with the least queued cost. QrBatch uses a scheduler when one is given
+ * in its options, and it splits bulk batches into tasks costed from each payload's planned version.
+ * Instances are thread-safe but not copyable. The destructor runs all queued tasks before returning.
+ */
+class QrScheduler final {
+	
+	/*---- Public helper enumeration ----*/
+	
+	/* 
+	 * The priority classes of tasks, from most to least urgent.
+	 */
+	public: enum class Priority {
+		INTERACTIVE = 0,  // Small requests that someone is waiting for
+		BULK,             // Large jobs that only need throughput
+	};
+	
+	
+	
+	/*---- Constructor and destructor ----*/
+	
+	/* 
+	 * Starts the given number of worker threads, where 0 means one per hardware thread.
+	 * Throws invalid_argument if numThreads is negative.
+	 */
+	public: explicit QrScheduler(int numThreads=0);
+	
+	
+	/* 
+	 * Waits for every queued task to finish, then stops the worker threads.
+	 */
+	public: ~QrScheduler();
+	
+	
+	public: QrScheduler(const QrScheduler &) = delete;
+	public: QrScheduler &operator=(const QrScheduler &) = delete;
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	/* 
+	 * Queues the given task in the given priority class, with the given estimate of its cost
+	 * in arbitrary units that are only compared with other tasks' costs. The task runs on some
+	 * worker thread at a later time, and must not throw an exception.
+	 */
+	public: void submit(Priority pri, long cost, std::function<void()> task);
+	
+	
+	/* 
+	 * Calls work(i) for every i in [0, count) and returns when all calls have finished. The calling
+	 * thread claims indexes too, and helper tasks with the given cost each are submitted for the rest,
+	 * so this can be called from inside a task without deadlocking. If any call throws an exception,
+	 * the remaining indexes are still run and then the first exception is rethrown to the caller.
+	 */
+	public: void parallelFor(Priority pri, long cost, std::size_t count, const std::function<void(std::size_t)> &work);
+	
+	
+	/* 
+	 * Returns the number of worker threads, which is at least 1.
+	 */
+	public: int getNumThreads() const;
+	
+	
+	
+	/*---- Private helper structure ----*/
+	
+	// The queues of one worker, guarded by its own lock so that thieves rarely contend with the owner.
+	private: struct Worker final {
+		std::mutex lock;
+		std::deque<std::pair<long,std::function<void()> > > queues[2];  // Indexed by Priority
+		std::atomic<long> queuedCost;  // Sum of the costs of all tasks in the queues
+		Worker();
+	};
+	
+	
+	
+	/*---- Private fields ----*/
+	
+	private: std::vector<std::unique_ptr<Worker> > workers;
+	
+	private: std::vector<std::thread> threads;
+	
+	// Guards the two fields below, and is used with the condition variable to put idle workers to sleep.
+	private: std::mutex sleepLock;
+	
+	private: std::condition_variable wakeCondition;
+	
+	// The number of tasks in all queues.
+	private: std::size_t numQueued;
+	
+	// Whether the destructor has been called.
+	private: bool stopping;
+	
+	
+	
+	/*---- Private helper methods ----*/
+	
+	// The main loop of the worker with the given index.
+	private: void run(std::size_t self);
+	
+	
+	// Removes the most urgent task from the given worker's own queues, or else steals one from the
+	// other workers in the same class, checking every worker for INTERACTIVE before any for BULK.
+	// Returns false if all queues are empty.
+	private: bool take(std::size_t self, std::function<void()> &result);
+	
+};
+
+
+
+/* 
+ * The QR Codes for many payloads that were encoded in one call, packed into one contiguous byte arena.
+ * Create instances with QrBatch::encodeText() or QrBatch::encodeBinary(), which spread the payloads
+ * across a pool of worker threads. Each packed grid stores the module at (x, y) as bit number
+ * i = y * size + x, at byte i / 8 of the grid and bit i % 8 of that byte (least significant first);
+ * this is the layout of the C library's buffers without their leading size byte.
+ * Instances of this class are immutable.
+ */
+class QrBatch final {
+	
+	/*---- Public helper structures ----*/
+	
+	/* 
+	 * The encoding parameters for every payload in a batch, which have the same meaning
+	 * as for QrCode::encodeSegments(), and the number of worker threads to use.
+	 */
+	public: struct Options final {
+		QrCode::Ecc errorCorrectionLevel = QrCode::Ecc::LOW;
+		int minVersion = 1;
+		int maxVersion = 40;
+		int mask = -1;
+		bool boostEcl = true;
+		int numThreads = 0;  // 0 means one thread per hardware thread; ignored if scheduler is set
+		QrScheduler *scheduler = nullptr;  // If set, the batch runs on this shared pool instead of its own threads
+		QrScheduler::Priority priority = QrScheduler::Priority::BULK;  // Only used with a scheduler
+	};
+	
+	
+	/* 
+	 * The outcome of encoding one payload of a batch.
+	 */
+	public: struct Item final {
+		std::string error;  // Empty if successful, otherwise the message of the exception thrown for this payload
+		std::size_t offset;  // The byte offset of the packed grid in the arena; 0 if unsuccessful
+		int version;  // The version number, or 0 if unsuccessful
+		int size;  // The width and height in modules, or 0 if unsuccessful
+		QrCode::Ecc errorCorrectionLevel;  // The final error correction level, after any boost
+		int mask;  // The mask pattern that was applied, or -1 if unsuccessful
+	};
+	
+	
+	
+	/*---- Static factory functions ----*/
+	
+	/* 
+	 * Encodes each of the given Unicode text strings (in UTF-8) like QrCode::encodeText(),
+	 * but with the given options, and returns all the results in input order. A payload that
+	 * can't be encoded (such as one that is too long) is reported in its item's error field
+	 * without affecting the others. Throws invalid_argument if the options are invalid.
+	 */
+	public: static QrBatch encodeText(const std::vector<std::string> &texts, const Options &opts);
+	
+	
+	/* 
+	 * Encodes each of the given binary payloads in byte mode like QrCode::encodeBinary(), but with
+	 * the given options, and returns all the results in input order. Failures are reported per item
+	 * as in encodeText(). Throws invalid_argument if the options are invalid.
+	 */
+	public: static QrBatch encodeBinary(const std::vector<std::vector<std::uint8_t> > &datas, const Options &opts);
+	
+	
+	
+	/*---- Instance fields ----*/
+	
+	// All packed grids back to back, in input order.
+	private: std::vector<std::uint8_t> arena;
+	
+	// One entry per payload, in input order.
+	private: std::vector<Item> items;
+	
+	
+	
+	/*---- Constructor (private) ----*/
+	
+	private: QrBatch(std::vector<std::uint8_t> &&arna, std::vector<Item> &&itms);
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	/* 
+	 * Returns the number of payloads in this batch, including unsuccessful ones.
+	 */
+	public: std::size_t getCount() const;
+	
+	
+	/* 
+	 * Returns the outcome of the payload at the given index. Throws out_of_range if the index is invalid.
+	 */
+	public: const Item &getItem(std::size_t index) const;
+	
+	
+	/* 
+	 * Returns the color of the module (pixel) at the given coordinates in the QR Code at the
+	 * given index, which is false for light or true for dark. The top left corner has the
+	 * coordinates (x=0, y=0). If the given coordinates are out of bounds, or the payload at
+	 * the index was unsuccessful, then false (light) is returned.
+	 */
+	public: bool getModule(std::size_t index, int x, int y) const;
+	
+	
+	/* 
+	 * Returns the arena that holds every packed grid. Use each item's offset and
+	 * size to locate its grid, which is (size * size + 7) / 8 bytes long.
+	 */
+	public: const std::vector<std::uint8_t> &getArena() const;
+	
+	
+	
+	/*---- Private helper functions ----*/
+	
+	// Encodes payloads 0 to count - 1 in two passes. The first pass makes each payload's segments, plans
+	// them, and writes its data codewords. The items are then sorted by (version, ECC level), and the
+	// second pass builds the symbols bucket by bucket, sharing one QrCode::Template per bucket so that
+	// its function modules and divisor are computed once and stay in cache. The first worker to reach a
+	// bucket builds its template. With a scheduler, symbols of at least QrCode::PARALLEL_MIN_VERSION also
+	// split their blocks and masks across it. Each worker or task of the second pass packs its grids into
+	// its own scratch buffer, and these are gathered in input order.
+	private: static QrBatch encode(const void *payloads, std::size_t count, const Options &opts,
+		std::size_t (*getLength)(const void *payloads, std::size_t index),
+		std::vector<QrSegment> (*makeSegments)(const void *payloads, std::size_t index));
+	
+	
+	// Calls work(i, owner) for every i in [0, count), either on a pool of threads that claim indexes in
+	// order or as tasks of the options' scheduler. Bulk tasks take runs of consecutive indexes whose costs
+	// add up to BULK_TASK_COST. The calling thread runs the tasks that no worker has started, so a batch
+	// can be encoded from inside a task of its own scheduler. Each thread or task has a distinct owner
+	// number below getNumOwners().
+	private: static void runParallel(std::size_t count, const std::vector<long> &costs, const Options &opts,
+		const std::function<void(std::size_t, std::size_t)> &work);
+	
+	
+	// Returns the number of threads or scheduler tasks that runParallel() uses for the same
+	// arguments, so that per-owner buffers can be made before it runs.
+	private: static std::size_t getNumOwners(std::size_t count, const std::vector<long> &costs, const Options &opts);
+	
+	
+	// Returns the first index of each scheduler task for the given range, followed by count.
+	private: static std::vector<std::size_t> splitTasks(std::size_t count, const std::vector<long> &costs, const Options &opts);
+	
+	
+	// Returns the number of raw data modules of the smallest version in the options' range that could
+	// hold the given number of bytes in byte mode, which bounds the work of encoding a payload of that
+	// length. Returns the count for the minimum version if no version can hold the data.
+	private: static long estimateCost(std::size_t numBytes, const Options &opts);
+	
+	
+	/*---- Private constant ----*/
+	
+	// The estimated cost (in raw data modules) at which a bulk batch is cut into another scheduler task,
+	// which is a handful of version 20 symbols or dozens of small ones.
+	private: static const long BULK_TASK_COST;
+	
+};
+
+
+
+/* 
+ * A streaming encoder that runs the steps of QR Code construction as stages, each on its own
+ * threads: segmenting and planning, error correction, codeword placement, mask selection,
+ * and a caller-supplied output stage such as rendering or compression. Adjacent stages are
+ * connected by bounded queues, so a slow stage makes the stages before it
+ * wait (and finally push() itself) instead of letting work pile up in memory.
+ * Results reach the sink in completion order, tagged with the sequence number that push()
+ * returned. All public methods are thread-safe. Instances are not copyable.
+ */
+class QrPipeline final {
+	
+	/*---- Public helper types ----*/
+	
+	/* 
+	 * The stages of the pipeline, in the order that every payload passes through them.
+	 */
+	public: enum class Stage {
+		PLAN = 0,  // Makes the segments, chooses the version, and writes the data codewords
+		ECC,       // Computes and interleaves the error correction codewords
+		PLACE,     // Draws all codewords onto a copy of the version's function modules
+		MASK,      // Evaluates the masks, applies the best one, and draws the format bits
+		OUTPUT,    // Calls the sink
+	};
+	
+	
+	/* 
+	 * The encoding parameters for every payload, which have the same meaning as for
+	 * QrCode::encodeSegments(), and the sizes of the stages and queues.
+	 */
+	public: struct Options final {
+		QrCode::Ecc errorCorrectionLevel = QrCode::Ecc::LOW;
+		int minVersion = 1;
+		int maxVersion = 40;
+		int mask = -1;
+		bool boostEcl = true;
+		std::array<int,5> numThreads = {{1, 1, 1, 1, 1}};  // Per stage, indexed by Stage; each at least 1
+		std::size_t queueCapacity = 64;  // Payloads that can wait in front of each stage; at least 1
+	};
+	
+	
+	/* 
+	 * Receives each finished payload: its sequence number, and either the QR Code with
+	 * an empty error, or null with the message of the exception that stopped the payload
+	 * (such as data_too_long). It runs on the OUTPUT stage's threads and must not throw.
+	 */
+	public: typedef std::function<void(std::uint64_t sequence, const QrCode *qr, const std::string &error)> Sink;
+	
+	
+	/* 
+	 * A snapshot of the counters of one stage.
+	 */
+	public: struct StageStats final {
+		std::size_t queueDepth;  // Payloads waiting in the queue in front of the stage
+		std::uint64_t processed;  // Payloads that the stage has finished
+		std::uint64_t busyNanoseconds;  // Time spent processing, summed over the stage's threads
+	};
+	
+	
+	
+	/*---- Constructor and destructor ----*/
+	
+	/* 
+	 * Starts the threads of every stage. Throws invalid_argument if an option is invalid.
+	 */
+	public: QrPipeline(const Options &opts, Sink snk);
+	
+	
+	/* 
+	 * Calls close() if it hasn't been called yet.
+	 */
+	public: ~QrPipeline();
+	
+	
+	public: QrPipeline(const QrPipeline &) = delete;
+	public: QrPipeline &operator=(const QrPipeline &) = delete;
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	/* 
+	 * Queues the given text (in UTF-8) for encoding and returns its sequence number, which counts up from 0.
+	 * Blocks while the first queue is full. Throws logic_error if close() has been called,
+	 * including during the wait, in which case the text is not encoded.
+	 */
+	public: std::uint64_t push(std::string text);
+	
+	
+	/* 
+	 * Stops accepting input, and waits until every queued payload has reached the sink
+	 * and all stage threads have exited. Calling it again has no effect.
+	 */
+	public: void close();
+	
+	
+	/* 
+	 * Returns the current counters of the given stage.
+	 */
+	public: StageStats getStats(Stage st) const;
+	
+	
+	
+	/*---- Private helper types ----*/
+	
+	// One payload in flight, handed between stages by pointer.
+	private: struct Job;
+	
+	// A bounded multi-producer multi-consumer queue of jobs.
+	private: class Queue;
+	
+	// The counters of one stage.
+	private: struct Counters final {
+		std::atomic<std::uint64_t> processed;
+		std::atomic<std::uint64_t> busyNanoseconds;
+		Counters();
+	};
+	
+	
+	
+	/*---- Private fields ----*/
+	
+	private: Options options;
+	
+	private: Sink sink;
+	
+	// The queue in front of each stage, indexed by Stage.
+	private: std::unique_ptr<Queue> queues[5];
+	
+	private: Counters counters[5];
+	
+	// The threads of every stage, in stage order.
+	private: std::vector<std::thread> threads;
+	
+	// Guards nextSequence and closed, so that push() and close() are mutually ordered.
+	private: std::mutex inputLock;
+	
+	private: std::uint64_t nextSequence;
+	
+	private: bool closed;
+	
+	// The template of each (ECC level, version) pair, made on first use.
+	private: std::unique_ptr<QrCode::Template> templates[4 * 41];
+	
+	private: std::once_flag templateFlags[4 * 41];
+	
+	
+	
+	/*---- Private helper methods ----*/
+	
+	// The main loop of one thread of the given stage.
+	private: void run(Stage st);
+	
+	
+	// Performs the given stage's step on the given job, which is passed on unless the stage is OUTPUT.
+	private: void process(Stage st, Job &job);
+	
+	
+	// Returns the template for the given version and ECC level, making it if needed.
+	private: const QrCode::Template &getTemplate(int ver, QrCode::Ecc ecl);
+	
+};
+
+
+
+/* 
+ * A thread-safe memo of recently encoded payloads and their QR Codes, for services that encode the same
+ * data again and again. Entries are keyed by the payload bytes, whether it is text or binary, and every
+ * encoding parameter, and each stores its symbol as a packed grid of size * size bits. The entries are
+ * spread over shards by hash, each with its own lock and least-recently-used list, and each shard evicts
+ * its oldest entries to stay within an equal part of the byte budget. Instances are not copyable.
+ */
+class QrCache final {
+	
+	/*---- Public helper structure ----*/
+	
+	/* 
+	 * A snapshot of the counters of all shards, which are taken one at a time.
+	 */
+	public: struct Stats final {
+		std::uint64_t hits;       // Lookups that found their entry
+		std::uint64_t misses;     // Lookups that had to encode
+		std::uint64_t evictions;  // Entries removed to make room for others
+		std::size_t entries;      // Entries currently held
+		std::size_t bytes;        // Bytes currently charged against the budget
+	};
+	
+	
+	
+	/*---- Constructor and destructor ----*/
+	
+	/* 
+	 * Creates an empty cache that holds at most about maxBytes bytes of keys, grids, and bookkeeping,
+	 * split into the given number of shards. Throws invalid_argument if numShards is not positive.
+	 */
+	public: explicit QrCache(std::size_t maxBytes, int numShards=16);
+	
+	
+	public: ~QrCache();
+	
+	
+	public: QrCache(const QrCache &) = delete;
+	public: QrCache &operator=(const QrCache &) = delete;
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	/* 
+	 * Returns the same QR Code as QrCode::encodeSegments(QrSegment::makeSegments(text), ...) with the given
+	 * parameters, from the cache if present. Throws data_too_long in the same cases, and such results are not
+	 * cached. An entry that is larger than a shard's share of the budget is encoded each time.
+	 */
+	public: QrCode encodeText(const char *text, QrCode::Ecc ecl,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns the same QR Code as QrCode::encodeSegments({QrSegment::makeBytes(data)}, ...)
+	 * with the given parameters, from the cache if present, like encodeText().
+	 */
+	public: QrCode encodeBinary(const std::vector<std::uint8_t> &data, QrCode::Ecc ecl,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns the current counters, summed over all shards.
+	 */
+	public: Stats getStats() const;
+	
+	
+	/* 
+	 * Removes every entry, without changing the hit, miss, and eviction counters.
+	 */
+	public: void clear();
+	
+	
+	
+	/*---- Private helper structures ----*/
+	
+	// The entries, index, and counters of one shard, all guarded by its lock. Defined in the source file.
+	private: struct Shard;
+	
+	
+	
+	/*---- Private fields ----*/
+	
+	private: std::vector<std::unique_ptr<Shard> > shards;
+	
+	private: std::size_t shardMaxBytes;
+	
+	
+	
+	/*---- Private helper method ----*/
+	
+	// Looks up the given key, which starts with the encoding parameters, and otherwise encodes the
+	// payload with the given function and stores the result if it fits.
+	private: QrCode lookup(std::string &&key, const std::function<QrCode()> &encode);
+	
+	
+	// Returns the key for the given kind of payload ('T' for text or 'B' for binary),
+	// encoding parameters, and payload bytes.
+	private: static std::string makeKey(char kind, QrCode::Ecc ecl, int minVersion, int maxVersion,
+		int mask, bool boostEcl, const char *data, std::size_t len);
+	
+	
+	/*---- Friend ----*/
+	
+	// Keys its files with makeKey().
+	friend class QrDiskCache;
+	
+};
+
+
+
+/* 
+ * A QR Code whose modules are computed on first use. Creating one picks the version and error correction
+ * level and writes the data codewords like QrCode::encodeSegments(), but defers the error correction, the
+ * module placement, and the mask choice until a method needs the modules. That work then runs exactly once,
+ * and gives the same QR Code that encodeSegments() returns for the same arguments. The other getters, and the
+ * data codewords (which together with the parameters identify the symbol, such as for a cache key), never
+ * trigger it. Copies share the data and the realized QR Code. All methods are thread-safe, and concurrent
+ * first calls wait for a single realization.
+ */
+class LazyQrCode final {
+	
+	/*---- Static factory functions ----*/
+	
+	/* 
+	 * Returns a lazy QR Code representing the given text, with the same behavior as QrCode::encodeText().
+	 */
+	public: static LazyQrCode encodeText(const char *text, QrCode::Ecc ecl);
+	
+	
+	/* 
+	 * Returns a lazy QR Code representing the given bytes, with the same behavior as QrCode::encodeBinary().
+	 */
+	public: static LazyQrCode encodeBinary(const std::vector<std::uint8_t> &data, QrCode::Ecc ecl);
+	
+	
+	/* 
+	 * Returns a lazy QR Code representing the given segments with the given encoding parameters, with the
+	 * same behavior as QrCode::encodeSegments(), including throwing data_too_long right away.
+	 */
+	public: static LazyQrCode encodeSegments(const std::vector<QrSegment> &segs, QrCode::Ecc ecl,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	
+	/*---- Constructor (low level) ----*/
+	
+	/* 
+	 * Creates a lazy QR Code with the given version number, error correction level, data codeword bytes, and
+	 * mask number (or -1 for automatic), which realizes to QrCode(ver, ecl, dataCodewords, msk). The arguments
+	 * are checked now: throws std::domain_error if the version or mask is out of range, or std::invalid_argument
+	 * if the number of data codewords is not the capacity of that version and error correction level.
+	 */
+	public: LazyQrCode(int ver, QrCode::Ecc ecl, std::vector<std::uint8_t> dataCodewords, int msk);
+	
+	
+	
+	/*---- Public instance methods (without realizing) ----*/
+	
+	// Returns this QR Code's version, in the range [1, 40].
+	public: int getVersion() const;
+	
+	
+	// Returns this QR Code's size, in the range [21, 177].
+	public: int getSize() const;
+	
+	
+	// Returns this QR Code's error correction level.
+	public: QrCode::Ecc getErrorCorrectionLevel() const;
+	
+	
+	// Returns this QR Code's data codewords, which include the terminator and padding but not error correction.
+	public: const std::vector<std::uint8_t> &getDataCodewords() const;
+	
+	
+	// Returns whether the modules have been computed, by this object or a copy of it.
+	public: bool isRealized() const;
+	
+	
+	
+	/*---- Public instance methods (realizing) ----*/
+	
+	// Returns this QR Code's mask, in the range [0, 7]. This realizes the modules only if the mask is automatic.
+	public: int getMask() const;
+	
+	
+	/* 
+	 * Returns the color of the module (pixel) at the given coordinates, which is false
+	 * for light or true for dark. The top left corner has the coordinates (x=0, y=0).
+	 * If the given coordinates are out of bounds, then false (light) is returned.
+	 */
+	public: bool getModule(int x, int y) const;
+	
+	
+	// Returns the realized QR Code, such as for rendering. The reference stays valid while any copy of this object exists.
+	public: const QrCode &getQrCode() const;
+	
+	
+	
+	/*---- Private helper types and fields ----*/
+	
+	// The part shared by copies, which is written only once, by the realization.
+	private: struct State final {
+		std::vector<std::uint8_t> dataCodewords;
+		std::once_flag flag;
+		std::atomic<bool> realized;
+		std::unique_ptr<const QrCode> qrCode;  // Null until realized
+		explicit State(std::vector<std::uint8_t> &&data);
+	};
+	
+	private: int version;
+	
+	private: QrCode::Ecc errorCorrectionLevel;
+	
+	private: int mask;  // As given, so -1 means automatic
+	
+	private: std::shared_ptr<State> state;
+	
+};
+
+
+
+#if defined(__unix__) || defined(__APPLE__)
+#define QRCODEGEN_HAS_DISK_CACHE 1
+
+/* 
+ * A cache of encoded symbols and rendered outputs in a local directory, which outlives the process
+ * and can be shared by several processes. Each entry is one file named by a 64-bit hash of its key,
+ * which is made of the payload, the encoding parameters, and for rendered outputs a caller-defined
+ * string of render options. The full key is stored in the file and compared on every read, so a hash
+ * collision is only a miss. Hits are read through a memory mapping. Misses are written to a temporary
+ * file that is then renamed into place, so readers never see a partial entry, and temporary files left
+ * by a writer that died are deleted when a cache is next opened on the directory. When the total size of
+ * the entries exceeds the cap, the least recently used ones are deleted until it is 7/8 of the cap;
+ * recency is the file's modification time, refreshed at most once per minute on hits.
+ * All public methods are thread-safe. Instances are not copyable. Available on POSIX systems.
+ */
+class QrDiskCache final {
+	
+	/*---- Public helper types ----*/
+	
+	/* 
+	 * The bytes of a rendered output, either mapped from the cache file or held in memory. Move-only.
+	 */
+	public: class Blob final {
+		
+		private: void *mapping;  // Null if the bytes are in 'owned'
+		private: std::size_t mappingLen;
+		private: std::size_t offset;  // Where the output starts in the mapping
+		private: std::string owned;
+		
+		public: explicit Blob(std::string &&bytes);
+		
+		// Takes ownership of the given mapping of the given length.
+		private: Blob(void *map, std::size_t mapLen, std::size_t off);
+		
+		public: Blob(Blob &&other) noexcept;
+		public: Blob &operator=(Blob &&other) noexcept;
+		public: Blob(const Blob &) = delete;
+		public: Blob &operator=(const Blob &) = delete;
+		public: ~Blob();
+		
+		public: const std::uint8_t *data() const;
+		public: std::size_t size() const;
+		
+		// Makes blobs of mapped files.
+		friend class QrDiskCache;
+		
+	};
+	
+	
+	/* 
+	 * The counters of this object, which don't include other processes' use of the same directory.
+	 */
+	public: struct Stats final {
+		std::uint64_t hits;
+		std::uint64_t misses;
+		std::uint64_t evictions;      // Files deleted to stay under the cap
+		std::uint64_t writeFailures;  // Entries that couldn't be written, which are only left uncached
+		std::uint64_t bytes;          // The total size of the entries known to this object
+	};
+	
+	
+	
+	/*---- Constructor ----*/
+	
+	/* 
+	 * Opens the given directory as a cache of at most maxSize bytes, creating the directory if it
+	 * doesn't exist, reads the sizes and times of the entries in it, and deletes temporary files that
+	 * are over an hour old. Throws runtime_error if the directory can't be created or read.
+	 */
+	public: QrDiskCache(const std::string &dir, std::uint64_t maxSize);
+	
+	
+	public: QrDiskCache(const QrDiskCache &) = delete;
+	public: QrDiskCache &operator=(const QrDiskCache &) = delete;
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	/* 
+	 * Returns the same QR Code as QrCache::encodeText() with the given parameters,
+	 * read from the directory if present, and otherwise encoded and then stored.
+	 */
+	public: QrCode encodeText(const char *text, QrCode::Ecc ecl,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns the same QR Code as QrCache::encodeBinary() with the given parameters,
+	 * read from the directory if present, and otherwise encoded and then stored.
+	 */
+	public: QrCode encodeBinary(const std::vector<std::uint8_t> &data, QrCode::Ecc ecl,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns the output of render() for the QR Code of the given text and parameters, read from the
+	 * directory if an output with the same render options is present. Otherwise the QR Code is encoded
+	 * without looking up its own entry, and the output of render() is stored. The render options string must identify
+	 * everything that render() depends on besides the QR Code, such as the format, scale, and colors.
+	 */
+	public: Blob renderText(const char *text, QrCode::Ecc ecl, const std::string &renderOptions,
+		const std::function<std::string(const QrCode &)> &render,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns a snapshot of the counters.
+	 */
+	public: Stats getStats() const;
+	
+	
+	
+	/*---- Private helper structure ----*/
+	
+	private: struct FileInfo final {
+		std::uint64_t size;
+		long long lastUse;  // Seconds since the epoch, as in the file's modification time
+	};
+	
+	
+	
+	/*---- Private fields ----*/
+	
+	private: std::string directory;
+	
+	private: std::uint64_t maxBytes;
+	
+	// Guards all fields below.
+	private: mutable std::mutex lock;
+	
+	// The entries known to this object, keyed by file name.
+	private: std::unordered_map<std::string,FileInfo> files;
+	
+	private: Stats stats;
+	
+	// Distinguishes the temporary files of concurrent writers in this process.
+	private: std::uint64_t nextTempId;
+	
+	
+	
+	/*---- Private helper methods ----*/
+	
+	// Returns the symbol for the given key from the directory, or otherwise encodes and stores it.
+	private: QrCode lookupSymbol(const std::string &key, const std::function<QrCode()> &encode);
+	
+	
+	// Maps the file for the given key and returns true if it exists and holds that key, setting
+	// the blob to the bytes after the key and refreshing the entry's recency.
+	private: bool read(const std::string &key, Blob &result);
+	
+	
+	// Writes a file holding the given key followed by the given bytes, then evicts if over the cap.
+	private: void write(const std::string &key, const std::string &bytes);
+	
+	
+	// Returns the file name for the given key.
+	private: static std::string getFileName(const std::string &key);
+	
+};
+
+#endif
+
+
+
+#ifdef QRCODEGEN_HAS_COROUTINES
+
+/* 
+ * The result of QrCode::encodeAsync(), which is a coroutine that starts when it is first awaited or when
+ * get() is called. Awaiting the task gives the QR Code, or throws the exception that encoding threw. A task
+ * can be awaited or waited on only once. Instances are movable but not copyable, and destroying a task that
+ * has started but not finished is undefined behavior. Requires C++20.
+ */
+class QrEncodeTask final {
+	
+	/*---- Public helper types ----*/
+	
+	public: struct promise_type;
+	
+	
+	// Resumes the finished task's awaiting coroutine, or wakes up get().
+	private: struct FinalAwaiter final {
+		public: bool await_ready() noexcept;
+		public: std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept;
+		public: void await_resume() noexcept;
+	};
+	
+	
+	// The coroutine state of the task, as required by the language.
+	public: struct promise_type final {
+		
+		public: std::optional<QrCode> result;
+		public: std::exception_ptr error;
+		public: std::coroutine_handle<> continuation;  // The awaiting coroutine, if any
+		
+		// Used by get() when there is no awaiting coroutine
+		public: std::mutex mutex;
+		public: std::condition_variable finished;
+		public: bool isDone = false;
+		
+		public: QrEncodeTask get_return_object();
+		public: std::suspend_always initial_suspend() noexcept;
+		public: FinalAwaiter final_suspend() noexcept;
+		public: void return_value(QrCode &&qr);
+		public: void unhandled_exception() noexcept;
+		
+	};
+	
+	
+	// Suspends the task and posts its resumption to the given executor.
+	private: struct Reschedule final {
+		public: const QrCode::Executor &executor;
+		public: bool await_ready() noexcept;
+		public: void await_suspend(std::coroutine_handle<> h);
+		public: void await_resume() noexcept;
+	};
+	
+	
+	
+	/*---- Fields ----*/
+	
+	private: std::coroutine_handle<promise_type> handle;
+	
+	
+	
+	/*---- Constructors and destructor ----*/
+	
+	private: explicit QrEncodeTask(std::coroutine_handle<promise_type> h);
+	
+	public: QrEncodeTask(QrEncodeTask &&other) noexcept;
+	
+	public: QrEncodeTask &operator=(QrEncodeTask &&other) noexcept;
+	
+	public: QrEncodeTask(const QrEncodeTask &) = delete;
+	
+	public: QrEncodeTask &operator=(const QrEncodeTask &) = delete;
+	
+	public: ~QrEncodeTask();
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Starts the task and blocks the calling thread until it finishes, then returns the QR Code or throws.
+	// Must not be called from a thread that the task's executor needs in order to make progress.
+	public: QrCode get();
+	
+	
+	// Awaiter methods, which start the task and suspend the awaiting coroutine until it finishes.
+	public: bool await_ready() const noexcept;
+	
+	public: std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting);
+	
+	public: QrCode await_resume();
+	
+	
+	/*---- Friend ----*/
+	
+	// Yields to the executor with Reschedule.
+	friend class QrCode;
+	
+};
+
+#endif
+
+#ifdef QRCODEGEN_USE_PMR
+}
+#endif
+
+}
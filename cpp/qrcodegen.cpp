@@ -27,18 +27,31 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 #include <sstream>
 #include <utility>
 #include "qrcodegen.hpp"
 
 using std::int8_t;
+using std::int16_t;
 using std::uint8_t;
 using std::size_t;
 using std::vector;
 
+// Throws the given exception, or aborts the program if the build has no exception support.
+#ifdef QRCODEGEN_NO_EXCEPTIONS
+	#define QRCODEGEN_THROW(e)  std::abort()
+#else
+	#define QRCODEGEN_THROW(e)  throw e
+#endif
+
 
 namespace qrcodegen {
 
+#ifdef QRCODEGEN_USE_PMR
+inline namespace pmr_grid {  // As declared in qrcodegen.hpp
+#endif
+
 /*---- Class QrSegment ----*/
 
 QrSegment::Mode::Mode(int mode, int cc0, int cc1, int cc2) :
@@ -67,75 +80,136 @@ const QrSegment::Mode QrSegment::Mode::ECI         (0x7,  0,  0,  0);
 
 
 QrSegment QrSegment::makeBytes(const vector<uint8_t> &data) {
-	if (data.size() > static_cast<unsigned int>(INT_MAX))
-		throw std::length_error("Data too long");
+	return makeBytes(data.data(), data.size());
+}
+
+
+QrSegment QrSegment::makeBytes(const uint8_t *data, size_t len) {
+	if (len > static_cast<unsigned int>(INT_MAX))
+		QRCODEGEN_THROW(std::length_error("Data too long"));
 	BitBuffer bb;
-	for (uint8_t b : data)
-		bb.appendBits(b, 8);
-	return QrSegment(Mode::BYTE, static_cast<int>(data.size()), std::move(bb));
+	bb.reserve(len * 8);
+	for (size_t i = 0; i < len; i++)
+		bb.appendBits(data[i], 8);
+	return QrSegment(Mode::BYTE, static_cast<int>(len), std::move(bb));
 }
 
 
-QrSegment QrSegment::makeNumeric(const char *digits) {
+QrSegment QrSegment::makeBytes(std::nullptr_t data, size_t len) {
+	return makeBytes(static_cast<const uint8_t*>(data), len);
+}
+
+
+#ifdef QRCODEGEN_HAS_SPAN
+QrSegment QrSegment::makeBytes(std::span<const uint8_t> data) {
+	return makeBytes(data.data(), data.size());
+}
+#endif
+
+
+QrSegment QrSegment::makeBytes(const ByteFragment *fragments, size_t count) {
+	size_t len = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (fragments[i].len > static_cast<unsigned int>(INT_MAX) - len)
+			QRCODEGEN_THROW(std::length_error("Data too long"));
+		len += fragments[i].len;
+	}
 	BitBuffer bb;
-	int accumData = 0;
-	int accumCount = 0;
-	int charCount = 0;
-	for (; *digits != '\0'; digits++, charCount++) {
-		char c = *digits;
-		if (c < '0' || c > '9')
-			throw std::domain_error("String contains non-numeric characters");
-		accumData = accumData * 10 + (c - '0');
-		accumCount++;
-		if (accumCount == 3) {
-			bb.appendBits(static_cast<uint32_t>(accumData), 10);
-			accumData = 0;
-			accumCount = 0;
-		}
+	bb.reserve(len * 8);
+	for (size_t i = 0; i < count; i++) {
+		const uint8_t *data = fragments[i].data;
+		for (size_t j = 0; j < fragments[i].len; j++)
+			bb.appendBits(data[j], 8);
 	}
-	if (accumCount > 0)  // 1 or 2 digits remaining
-		bb.appendBits(static_cast<uint32_t>(accumData), accumCount * 3 + 1);
-	return QrSegment(Mode::NUMERIC, charCount, std::move(bb));
+	return QrSegment(Mode::BYTE, static_cast<int>(len), std::move(bb));
+}
+
+
+QrSegment QrSegment::makeNumeric(const char *digits) {
+	return makeNumeric(digits, std::strlen(digits));
+}
+
+
+#if __cplusplus >= 201703L
+QrSegment QrSegment::makeNumeric(std::string_view digits) {
+	return makeNumeric(digits.data(), digits.size());
+}
+#endif
+
+
+QrSegment QrSegment::makeNumeric(const char *digits, size_t len) {
+	if (len > static_cast<unsigned int>(INT_MAX))
+		QRCODEGEN_THROW(std::length_error("Data too long"));
+	BitBuffer bb;
+	bb.reserve(len / 3 * 10 + 7);
+	if (appendNumeric(digits, len, bb) != len)
+		QRCODEGEN_THROW(std::domain_error("String contains non-numeric characters"));
+	return QrSegment(Mode::NUMERIC, static_cast<int>(len), std::move(bb));
 }
 
 
 QrSegment QrSegment::makeAlphanumeric(const char *text) {
+	return makeAlphanumeric(text, std::strlen(text));
+}
+
+
+#if __cplusplus >= 201703L
+QrSegment QrSegment::makeAlphanumeric(std::string_view text) {
+	return makeAlphanumeric(text.data(), text.size());
+}
+#endif
+
+
+QrSegment QrSegment::makeAlphanumeric(const char *text, size_t len) {
+	if (len > static_cast<unsigned int>(INT_MAX))
+		QRCODEGEN_THROW(std::length_error("Data too long"));
 	BitBuffer bb;
-	int accumData = 0;
-	int accumCount = 0;
-	int charCount = 0;
-	for (; *text != '\0'; text++, charCount++) {
-		const char *temp = std::strchr(ALPHANUMERIC_CHARSET, *text);
-		if (temp == nullptr)
-			throw std::domain_error("String contains unencodable characters in alphanumeric mode");
-		accumData = accumData * 45 + static_cast<int>(temp - ALPHANUMERIC_CHARSET);
-		accumCount++;
-		if (accumCount == 2) {
-			bb.appendBits(static_cast<uint32_t>(accumData), 11);
-			accumData = 0;
-			accumCount = 0;
-		}
-	}
-	if (accumCount > 0)  // 1 character remaining
-		bb.appendBits(static_cast<uint32_t>(accumData), 6);
-	return QrSegment(Mode::ALPHANUMERIC, charCount, std::move(bb));
+	bb.reserve(len / 2 * 11 + 6);
+	if (appendAlphanumeric(text, len, bb) != len)
+		QRCODEGEN_THROW(std::domain_error("String contains unencodable characters in alphanumeric mode"));
+	return QrSegment(Mode::ALPHANUMERIC, static_cast<int>(len), std::move(bb));
 }
 
 
 vector<QrSegment> QrSegment::makeSegments(const char *text) {
-	// Select the most efficient segment encoding automatically
+	return makeSegments(text, std::strlen(text));
+}
+
+
+#if __cplusplus >= 201703L
+vector<QrSegment> QrSegment::makeSegments(std::string_view text) {
+	return makeSegments(text.data(), text.size());
+}
+#endif
+
+
+vector<QrSegment> QrSegment::makeSegments(const char *text, size_t len) {
+	// Select the most efficient segment encoding automatically, by encoding speculatively in the
+	// densest mode. At the first character that the mode can't hold, the text is encoded again from
+	// the start in the next sparser mode, so no text is scanned more than three times.
 	vector<QrSegment> result;
-	if (*text == '\0');  // Leave result empty
-	else if (isNumeric(text))
-		result.push_back(makeNumeric(text));
-	else if (isAlphanumeric(text))
-		result.push_back(makeAlphanumeric(text));
-	else {
-		vector<uint8_t> bytes;
-		for (; *text != '\0'; text++)
-			bytes.push_back(static_cast<uint8_t>(*text));
-		result.push_back(makeBytes(bytes));
+	if (len == 0)
+		return result;  // Leave result empty
+	if (len > static_cast<unsigned int>(INT_MAX))
+		QRCODEGEN_THROW(std::length_error("Data too long"));
+	BitBuffer bb;
+	bb.reserve(len * 8);  // Enough for any of the three modes, so that the buffer is allocated once
+	size_t i = appendNumeric(text, len, bb);
+	const Mode *md = &Mode::NUMERIC;
+	if (i < len && ALPHANUMERIC_MAP[static_cast<unsigned char>(text[i])] != -1) {
+		// Alphanumeric mode: re-pack the digits seen so far, then continue
+		bb.clear();
+		i = appendAlphanumeric(text, len, bb);
+		md = &Mode::ALPHANUMERIC;
 	}
+	if (i < len) {
+		// Byte mode: copy the characters seen so far, then the rest
+		bb.clear();
+		for (i = 0; i < len; i++)
+			bb.appendBits(static_cast<uint8_t>(text[i]), 8);
+		md = &Mode::BYTE;
+	}
+	result.push_back(QrSegment(*md, static_cast<int>(len), std::move(bb)));
 	return result;
 }
 
@@ -143,7 +217,7 @@ vector<QrSegment> QrSegment::makeSegments(const char *text) {
 QrSegment QrSegment::makeEci(long assignVal) {
 	BitBuffer bb;
 	if (assignVal < 0)
-		throw std::domain_error("ECI assignment value out of range");
+		QRCODEGEN_THROW(std::domain_error("ECI assignment value out of range"));
 	else if (assignVal < (1 << 7))
 		bb.appendBits(static_cast<uint32_t>(assignVal), 8);
 	else if (assignVal < (1 << 14)) {
@@ -153,7 +227,7 @@ QrSegment QrSegment::makeEci(long assignVal) {
 		bb.appendBits(6, 3);
 		bb.appendBits(static_cast<uint32_t>(assignVal), 21);
 	} else
-		throw std::domain_error("ECI assignment value out of range");
+		QRCODEGEN_THROW(std::domain_error("ECI assignment value out of range"));
 	return QrSegment(Mode::ECI, 0, std::move(bb));
 }
 
@@ -163,7 +237,7 @@ QrSegment::QrSegment(const Mode &md, int numCh, const std::vector<bool> &dt) :
 		numChars(numCh),
 		data(dt) {
 	if (numCh < 0)
-		throw std::domain_error("Invalid value");
+		QRCODEGEN_THROW(std::domain_error("Invalid value"));
 }
 
 
@@ -172,7 +246,7 @@ QrSegment::QrSegment(const Mode &md, int numCh, std::vector<bool> &&dt) :
 		numChars(numCh),
 		data(std::move(dt)) {
 	if (numCh < 0)
-		throw std::domain_error("Invalid value");
+		QRCODEGEN_THROW(std::domain_error("Invalid value"));
 }
 
 
@@ -194,24 +268,113 @@ int QrSegment::getTotalBits(const vector<QrSegment> &segs, int version) {
 
 
 bool QrSegment::isNumeric(const char *text) {
+	return isNumeric(text, std::strlen(text));
+}
+
+
+bool QrSegment::isNumeric(const char *text, size_t len) {
+	return numericPrefixLength(text, len) == len;
+}
+
+
+#if __cplusplus >= 201703L
+bool QrSegment::isNumeric(std::string_view text) {
+	return isNumeric(text.data(), text.size());
+}
+#endif
+
+
+bool QrSegment::isAlphanumeric(const char *text) {
 	for (; *text != '\0'; text++) {
-		char c = *text;
-		if (c < '0' || c > '9')
+		if (ALPHANUMERIC_MAP[static_cast<unsigned char>(*text)] == -1)
 			return false;
 	}
 	return true;
 }
 
 
-bool QrSegment::isAlphanumeric(const char *text) {
-	for (; *text != '\0'; text++) {
-		if (std::strchr(ALPHANUMERIC_CHARSET, *text) == nullptr)
+bool QrSegment::isAlphanumeric(const char *text, size_t len) {
+	for (size_t i = 0; i < len; i++) {
+		if (ALPHANUMERIC_MAP[static_cast<unsigned char>(text[i])] == -1)
 			return false;
 	}
 	return true;
 }
 
 
+#if __cplusplus >= 201703L
+bool QrSegment::isAlphanumeric(std::string_view text) {
+	return isAlphanumeric(text.data(), text.size());
+}
+#endif
+
+
+size_t QrSegment::appendNumeric(const char *digits, size_t len, BitBuffer &bb) {
+	// Check and pack every 9 digits into one 30-bit append
+	size_t i = 0;
+	for (; len - i >= 9 && numericPrefixLength(&digits[i], 9) == 9; i += 9) {
+		uint32_t accumData = 0;
+		for (size_t j = i; j < i + 9; j += 3) {
+			uint32_t group = (static_cast<uint32_t>(digits[j] - '0') * 10
+				+ static_cast<uint32_t>(digits[j + 1] - '0')) * 10 + static_cast<uint32_t>(digits[j + 2] - '0');
+			accumData = accumData << 10 | group;
+		}
+		bb.appendBits(accumData, 30);
+	}
+	
+	// Encode the remaining digits, up to the first non-digit
+	int accumData = 0;
+	int accumCount = 0;
+	for (; i < len && '0' <= digits[i] && digits[i] <= '9'; i++) {
+		accumData = accumData * 10 + (digits[i] - '0');
+		accumCount++;
+		if (accumCount == 3) {
+			bb.appendBits(static_cast<uint32_t>(accumData), 10);
+			accumData = 0;
+			accumCount = 0;
+		}
+	}
+	if (accumCount > 0)  // 1 or 2 digits remaining
+		bb.appendBits(static_cast<uint32_t>(accumData), accumCount * 3 + 1);
+	return i;
+}
+
+
+size_t QrSegment::appendAlphanumeric(const char *text, size_t len, BitBuffer &bb) {
+	int accumData = 0;
+	size_t i = 0;
+	for (; i < len; i++) {
+		int val = ALPHANUMERIC_MAP[static_cast<unsigned char>(text[i])];
+		if (val == -1)
+			break;
+		if (i % 2 == 0)
+			accumData = val;
+		else  // Each pair of characters becomes 11 bits
+			bb.appendBits(static_cast<uint32_t>(accumData * 45 + val), 11);
+	}
+	if (i % 2 == 1)  // 1 character remaining
+		bb.appendBits(static_cast<uint32_t>(accumData), 6);
+	return i;
+}
+
+
+size_t QrSegment::numericPrefixLength(const char *text, size_t len) {
+	size_t i = 0;
+	for (; len - i >= 8; i += 8) {
+		std::uint64_t word;
+		std::memcpy(&word, &text[i], sizeof(word));
+		// A byte is a digit iff its high nibble is 3 and adding 6 does not carry out of its low nibble.
+		// (A carry between bytes can only come from a byte that already fails the first test.)
+		std::uint64_t bad = ((word & UINT64_C(0xF0F0F0F0F0F0F0F0)) ^ UINT64_C(0x3030303030303030))
+			| (((word + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0)) ^ UINT64_C(0x3030303030303030));
+		if (bad != 0)
+			break;
+	}
+	for (; i < len && '0' <= text[i] && text[i] <= '9'; i++);
+	return i;
+}
+
+
 const QrSegment::Mode &QrSegment::getMode() const {
 	return *mode;
 }
@@ -227,300 +390,965 @@ const std::vector<bool> &QrSegment::getData() const {
 }
 
 
-const char *QrSegment::ALPHANUMERIC_CHARSET = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+const int8_t QrSegment::ALPHANUMERIC_MAP[256] = {
+	// Low nibble: (-1 marks a byte value that is not in the alphanumeric character set)
+	//0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  A,  B,  C,  D,  E,  F    High nibble
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x00
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x10
+	36, -1, -1, -1, 37, 38, -1, -1, -1, -1, 39, 40, -1, 41, 42, 43,  // 0x20
+	 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 44, -1, -1, -1, -1, -1,  // 0x30
+	-1, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,  // 0x40
+	25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, -1, -1, -1, -1, -1,  // 0x50
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x60
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x70
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x80
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0x90
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xA0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xB0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xC0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xD0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xE0
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // 0xF0
+};
+
+
+
+/*---- Class QrPrefix ----*/
+
+QrPrefix::QrPrefix(const vector<QrSegment> &segs) :
+		segments(segs) {
+	static const int BAND_LAST_VERSIONS[] = {9, 26, 40};
+	bool fitsAny = false;
+	for (int i = 0; i < 3; i++) {
+		// The character count widths are the same within a band, so encode at its largest version
+		int ver = BAND_LAST_VERSIONS[i];
+		int bits = QrSegment::getTotalBits(segments, ver);
+		if (bits == -1 || bits > QrCode::getDataCapacityBits(ver, QrCode::Ecc::LOW)) {
+			bitLengths[i] = -1;
+			continue;
+		}
+		data[i].resize((static_cast<size_t>(bits) + 7) / 8);
+		size_t bitLen = 0;
+		QrCode::writeSegments(segments, ver, data[i].data(), bitLen);
+		assert(bitLen == static_cast<unsigned int>(bits));
+		bitLengths[i] = bits;
+		fitsAny = true;
+	}
+	if (!fitsAny)
+		QRCODEGEN_THROW(data_too_long("Prefix does not fit in any version"));
+}
+
+
+const vector<QrSegment> &QrPrefix::getSegments() const {
+	return segments;
+}
+
+
+int QrPrefix::getBitLength(int ver) const {
+	return bitLengths[getBandIndex(ver)];
+}
+
+
+const vector<uint8_t> &QrPrefix::getData(int ver) const {
+	return data[getBandIndex(ver)];
+}
+
+
+int QrPrefix::getBandIndex(int ver) {
+	if (ver < QrCode::MIN_VERSION || ver > QrCode::MAX_VERSION)
+		QRCODEGEN_THROW(std::domain_error("Version number out of range"));
+	return ver < 10 ? 0 : (ver < 27 ? 1 : 2);
+}
 
 
 
 /*---- Class QrCode ----*/
 
+// The grid over the modules and isFunction fields of a QrCode, for the layout functions.
+class QrCode::GridAccessor final {
+	
+	private: Grid &modules;
+	private: Grid &isFunc;
+	private: int sz;
+	
+	
+	public: explicit GridAccessor(QrCode &qr) :
+		modules(qr.modules),
+		isFunc(qr.isFunction),
+		sz(qr.size) {}
+	
+	
+	public: int size() const {
+		return sz;
+	}
+	
+	
+	public: bool get(int x, int y) const {
+		return modules.at(static_cast<size_t>(y)).at(static_cast<size_t>(x));
+	}
+	
+	
+	public: void set(int x, int y, bool isDark) {
+		modules.at(static_cast<size_t>(y)).at(static_cast<size_t>(x)) = isDark;
+	}
+	
+	
+	public: bool isFunction(int x, int y) const {
+		return isFunc.at(static_cast<size_t>(y)).at(static_cast<size_t>(x));
+	}
+	
+	
+	public: void setFunction(int x, int y, bool isDark) {
+		size_t ux = static_cast<size_t>(x);
+		size_t uy = static_cast<size_t>(y);
+		modules.at(uy).at(ux) = isDark;
+		isFunc .at(uy).at(ux) = true;
+	}
+	
+};
+
+
 int QrCode::getFormatBits(Ecc ecl) {
 	switch (ecl) {
 		case Ecc::LOW     :  return 1;
 		case Ecc::MEDIUM  :  return 0;
 		case Ecc::QUARTILE:  return 3;
 		case Ecc::HIGH    :  return 2;
-		default:  throw std::logic_error("Unreachable");
+		default:  QRCODEGEN_THROW(std::logic_error("Unreachable"));
 	}
 }
 
 
+int QrCode::getFormatCodeword(Ecc ecl, int msk) {
+	// Calculate error correction code and pack bits
+	int data = getFormatBits(ecl) << 3 | msk;  // errCorrLvl is uint2, msk is uint3
+	int rem = data;
+	for (int i = 0; i < 10; i++)
+		rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+	int bits = (data << 10 | rem) ^ 0x5412;  // uint15
+	assert(bits >> 15 == 0);
+	return bits;
+}
+
+
 QrCode QrCode::encodeText(const char *text, Ecc ecl) {
 	vector<QrSegment> segs = QrSegment::makeSegments(text);
 	return encodeSegments(segs, ecl);
 }
 
 
+QrCode QrCode::encodeText(const char *text, size_t len, Ecc ecl) {
+	vector<QrSegment> segs = QrSegment::makeSegments(text, len);
+	return encodeSegments(segs, ecl);
+}
+
+
+#if __cplusplus >= 201703L
+QrCode QrCode::encodeText(std::string_view text, Ecc ecl) {
+	return encodeText(text.data(), text.size(), ecl);
+}
+#endif
+
+
 QrCode QrCode::encodeBinary(const vector<uint8_t> &data, Ecc ecl) {
 	vector<QrSegment> segs{QrSegment::makeBytes(data)};
 	return encodeSegments(segs, ecl);
 }
 
 
+QrCode QrCode::encodeBinary(const uint8_t *data, size_t len, Ecc ecl) {
+	vector<QrSegment> segs{QrSegment::makeBytes(data, len)};
+	return encodeSegments(segs, ecl);
+}
+
+
+QrCode QrCode::encodeBinary(std::nullptr_t data, size_t len, Ecc ecl) {
+	return encodeBinary(static_cast<const uint8_t*>(data), len, ecl);
+}
+
+
+#ifdef QRCODEGEN_HAS_SPAN
+QrCode QrCode::encodeBinary(std::span<const uint8_t> data, Ecc ecl) {
+	return encodeBinary(data.data(), data.size(), ecl);
+}
+#endif
+
+
+QrCode QrCode::encodeBinary(const QrSegment::ByteFragment *fragments, size_t count, Ecc ecl) {
+	vector<QrSegment> segs{QrSegment::makeBytes(fragments, count)};
+	return encodeSegments(segs, ecl);
+}
+
+
 QrCode QrCode::encodeSegments(const vector<QrSegment> &segs, Ecc ecl,
 		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	return encodeSegments(nullptr, segs, ecl, minVersion, maxVersion, mask, boostEcl);
+}
+
+
+QrCode QrCode::encodeSegments(const QrPrefix &prefix, const vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	return encodeSegments(&prefix, segs, ecl, minVersion, maxVersion, mask, boostEcl);
+}
+
+
+QrCode QrCode::encodeSegments(const QrPrefix *prefix, const vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
 	if (!(MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= MAX_VERSION) || mask < -1 || mask > 7)
-		throw std::invalid_argument("Invalid value");
-	
-	// Find the minimal version number to use
-	int version, dataUsedBits;
-	for (version = minVersion; ; version++) {
-		int dataCapacityBits = getNumDataCodewords(version, ecl) * 8;  // Number of data bits available
-		dataUsedBits = QrSegment::getTotalBits(segs, version);
-		if (dataUsedBits != -1 && dataUsedBits <= dataCapacityBits)
-			break;  // This version number is found to be suitable
-		if (version >= maxVersion) {  // All versions in the range could not fit the given data
-			std::ostringstream sb;
-			if (dataUsedBits == -1)
-				sb << "Segment too long";
-			else {
-				sb << "Data length = " << dataUsedBits << " bits, ";
-				sb << "Max capacity = " << dataCapacityBits << " bits";
-			}
-			throw data_too_long(sb.str());
-		}
-	}
-	assert(dataUsedBits != -1);
-	
-	// Increase the error correction level while the data still fits in the current version number
-	for (Ecc newEcl : {Ecc::MEDIUM, Ecc::QUARTILE, Ecc::HIGH}) {  // From low to high
-		if (boostEcl && dataUsedBits <= getNumDataCodewords(version, newEcl) * 8)
-			ecl = newEcl;
-	}
-	
-	// Concatenate all segments to create the data bit string
-	BitBuffer bb;
-	for (const QrSegment &seg : segs) {
-		bb.appendBits(static_cast<uint32_t>(seg.getMode().getModeBits()), 4);
-		bb.appendBits(static_cast<uint32_t>(seg.getNumChars()), seg.getMode().numCharCountBits(version));
-		bb.insert(bb.end(), seg.getData().begin(), seg.getData().end());
-	}
-	assert(bb.size() == static_cast<unsigned int>(dataUsedBits));
-	
-	// Add terminator and pad up to a byte if applicable
-	size_t dataCapacityBits = static_cast<size_t>(getNumDataCodewords(version, ecl)) * 8;
-	assert(bb.size() <= dataCapacityBits);
-	bb.appendBits(0, std::min(4, static_cast<int>(dataCapacityBits - bb.size())));
-	bb.appendBits(0, (8 - static_cast<int>(bb.size() % 8)) % 8);
-	assert(bb.size() % 8 == 0);
-	
-	// Pad with alternating bytes until data capacity is reached
-	for (uint8_t padByte = 0xEC; bb.size() < dataCapacityBits; padByte ^= 0xEC ^ 0x11)
-		bb.appendBits(padByte, 8);
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
 	
-	// Pack bits into bytes in big endian
-	vector<uint8_t> dataCodewords(bb.size() / 8);
-	for (size_t i = 0; i < bb.size(); i++)
-		dataCodewords.at(i >> 3) |= (bb.at(i) ? 1 : 0) << (7 - (i & 7));
+	// Find the minimal version number to use, and the final ECC level
+	const Plan plan = planSegments(prefix, segs, ecl, minVersion, maxVersion, boostEcl);
 	
 	// Create the QR Code object
-	return QrCode(version, ecl, dataCodewords, mask);
+	return QrCode(plan.version, plan.errorCorrectionLevel, makeDataCodewords(prefix, segs, plan), mask);
 }
 
 
-QrCode::QrCode(int ver, Ecc ecl, const vector<uint8_t> &dataCodewords, int msk) :
-		// Initialize fields and check arguments
-		version(ver),
-		errorCorrectionLevel(ecl) {
-	if (ver < MIN_VERSION || ver > MAX_VERSION)
-		throw std::domain_error("Version value out of range");
-	if (msk < -1 || msk > 7)
-		throw std::domain_error("Mask value out of range");
-	size = ver * 4 + 17;
-	size_t sz = static_cast<size_t>(size);
-	modules    = vector<vector<bool> >(sz, vector<bool>(sz));  // Initially all light
-	isFunction = vector<vector<bool> >(sz, vector<bool>(sz));
-	
-	// Compute ECC, draw modules
-	drawFunctionPatterns();
-	const vector<uint8_t> allCodewords = addEccAndInterleave(dataCodewords);
-	drawCodewords(allCodewords);
-	
-	// Do masking
-	if (msk == -1) {  // Automatically choose best mask
-		long minPenalty = LONG_MAX;
-		for (int i = 0; i < 8; i++) {
-			applyMask(i);
-			drawFormatBits(i);
-			long penalty = getPenaltyScore();
-			if (penalty < minPenalty) {
-				msk = i;
-				minPenalty = penalty;
-			}
-			applyMask(i);  // Undoes the mask due to XOR
-		}
-	}
-	assert(0 <= msk && msk <= 7);
-	mask = msk;
-	applyMask(msk);  // Apply the final choice of mask
-	drawFormatBits(msk);  // Overwrite old format bits
-	
-	isFunction.clear();
-	isFunction.shrink_to_fit();
+QrCodeResult QrCode::tryEncodeSegments(const vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) noexcept {
+	if (mask < -1 || mask > 7)
+		return QrCodeResult(Status::INVALID_ARGUMENT);
+	Plan plan;
+	Status st = tryPlanSegments(nullptr, segs, ecl, minVersion, maxVersion, boostEcl, plan);
+	if (st != Status::OK)
+		return QrCodeResult(st);
+	return QrCode(plan.version, plan.errorCorrectionLevel, makeDataCodewords(nullptr, segs, plan), mask);
 }
 
 
-int QrCode::getVersion() const {
-	return version;
+QrCodeResult QrCode::tryEncodeText(const char *text, size_t len, Ecc ecl) noexcept {
+	if (len > static_cast<unsigned int>(INT_MAX))  // Where makeSegments() throws
+		return QrCodeResult(Status::DATA_TOO_LONG);
+	return tryEncodeSegments(QrSegment::makeSegments(text, len), ecl);
 }
 
 
-int QrCode::getSize() const {
-	return size;
+QrCodeResult QrCode::tryEncodeBinary(const uint8_t *data, size_t len, Ecc ecl) noexcept {
+	if (len > static_cast<unsigned int>(INT_MAX))  // Where makeBytes() throws
+		return QrCodeResult(Status::DATA_TOO_LONG);
+	return tryEncodeSegments(vector<QrSegment>{QrSegment::makeBytes(data, len)}, ecl);
 }
 
 
-QrCode::Ecc QrCode::getErrorCorrectionLevel() const {
-	return errorCorrectionLevel;
+#ifdef QRCODEGEN_USE_PMR
+
+QrCode QrCode::encodeSegments(const vector<QrSegment> &segs, Ecc ecl, std::pmr::memory_resource *resource,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	if (!(MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= MAX_VERSION) || mask < -1 || mask > 7)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	if (resource == nullptr)
+		QRCODEGEN_THROW(std::invalid_argument("Null memory resource"));
+	const Plan plan = planSegments(nullptr, segs, ecl, minVersion, maxVersion, boostEcl);
+	
+	// Same steps as the QrCode constructor, with every buffer taken from the resource
+	std::pmr::vector<uint8_t> dataCodewords(static_cast<size_t>(plan.dataCapacityBits / 8), resource);
+	makeDataCodewords(nullptr, segs, plan, dataCodewords.data());
+	QrCode result(plan.version, plan.errorCorrectionLevel, Grid::allocator_type(resource));
+	int degree = ECC_CODEWORDS_PER_BLOCK[static_cast<int>(result.errorCorrectionLevel)][result.version];
+	uint8_t rsDiv[30];
+	reedSolomonComputeDivisor(degree, rsDiv);
+	size_t rawCodewords = static_cast<size_t>(getNumRawDataModules(result.version) / 8);
+	std::pmr::vector<uint8_t> allCodewords(rawCodewords, resource);
+	std::pmr::vector<uint8_t> eccCodewords(rawCodewords - dataCodewords.size(), resource);
+	result.addEccAndInterleave(dataCodewords.data(), rsDiv, allCodewords.data(), eccCodewords.data());
+	result.drawCodewords(allCodewords.data(), allCodewords.size());
+	result.finishMask(mask);
+	return result;
 }
 
+#endif
 
-int QrCode::getMask() const {
-	return mask;
+
+vector<uint8_t> QrCode::makeDataCodewords(const QrPrefix *prefix, const vector<QrSegment> &segs, const Plan &plan) {
+	vector<uint8_t> result(static_cast<size_t>(plan.dataCapacityBits) / 8);
+	makeDataCodewords(prefix, segs, plan, result.data());
+	return result;
 }
 
 
-bool QrCode::getModule(int x, int y) const {
-	return 0 <= x && x < size && 0 <= y && y < size && module(x, y);
+void QrCode::makeDataCodewords(const QrPrefix *prefix, const vector<QrSegment> &segs, const Plan &plan,
+		uint8_t *dataCodewords) {
+	int version = plan.version;
+	
+	// Copy the prefix's bytes, then write all segments straight into the zero-initialized data codewords
+	size_t dataCapacityBits = static_cast<size_t>(plan.dataCapacityBits);
+	size_t dataLen = dataCapacityBits / 8;
+	std::fill_n(dataCodewords, dataLen, static_cast<uint8_t>(0));
+	size_t bitLen = 0;
+	if (prefix != nullptr) {
+		const vector<uint8_t> &prefixData = prefix->getData(version);
+		std::copy(prefixData.begin(), prefixData.end(), dataCodewords);
+		bitLen = static_cast<size_t>(prefix->getBitLength(version));
+	}
+	writeSegments(segs, version, dataCodewords, bitLen);
+	assert(bitLen == static_cast<unsigned int>(plan.dataUsedBits));
+	padDataCodewords(dataCodewords, bitLen, dataCapacityBits);
 }
 
 
-void QrCode::drawFunctionPatterns() {
-	// Draw horizontal and vertical timing patterns
-	for (int i = 0; i < size; i++) {
-		setFunctionModule(6, i, i % 2 == 0);
-		setFunctionModule(i, 6, i % 2 == 0);
-	}
-	
-	// Draw 3 finder patterns (all corners except bottom right; overwrites some timing modules)
-	drawFinderPattern(3, 3);
-	drawFinderPattern(size - 4, 3);
-	drawFinderPattern(3, size - 4);
+void QrCode::padDataCodewords(uint8_t *dataCodewords, size_t bitLen, size_t dataCapacityBits) {
+	// Add terminator and pad up to a byte if applicable, both of which are already zero
+	size_t dataLen = dataCapacityBits / 8;
+	assert(bitLen <= dataCapacityBits);
+	bitLen += std::min(static_cast<size_t>(4), dataCapacityBits - bitLen);
+	bitLen = (bitLen + 7) / 8 * 8;
 	
-	// Draw numerous alignment patterns
-	const vector<int> alignPatPos = getAlignmentPatternPositions();
-	size_t numAlign = alignPatPos.size();
-	for (size_t i = 0; i < numAlign; i++) {
-		for (size_t j = 0; j < numAlign; j++) {
+	// Pad with alternating bytes until data capacity is reached
+	uint8_t padByte = 0xEC;
+	for (size_t i = bitLen / 8; i < dataLen; i++, padByte ^= 0xEC ^ 0x11)
+		dataCodewords[i] = padByte;
+}
+
+
+QrCode::Template QrCode::makeTemplate(int ver, Ecc ecl) {
+	QrCode base(ver, ecl);
+	Template result;
+	result.version = ver;
+	result.errorCorrectionLevel = ecl;
+	result.modules = std::move(base.modules);
+	result.isFunction = std::move(base.isFunction);
+	result.rsDivisor = reedSolomonComputeDivisor(ECC_CODEWORDS_PER_BLOCK[static_cast<int>(ecl)][ver]);
+	return result;
+}
+
+
+QrCode::Plan QrCode::planSegments(const vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, bool boostEcl) {
+	return planSegments(nullptr, segs, ecl, minVersion, maxVersion, boostEcl);
+}
+
+
+QrCode::Plan QrCode::planSegments(const QrPrefix &prefix, const vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, bool boostEcl) {
+	return planSegments(&prefix, segs, ecl, minVersion, maxVersion, boostEcl);
+}
+
+
+QrCode::Plan QrCode::planSegments(const QrPrefix *prefix, const vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, bool boostEcl) {
+	Plan result;
+	switch (tryPlanSegments(prefix, segs, ecl, minVersion, maxVersion, boostEcl, result)) {
+		case Status::OK:
+			return result;
+		case Status::DATA_TOO_LONG:
+			QRCODEGEN_THROW(data_too_long(getDataTooLongMessage(result.dataUsedBits, maxVersion, ecl)));
+		default:
+			QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	}
+}
+
+
+QrCode::Status QrCode::tryPlanSegments(const vector<QrSegment> &segs, Ecc ecl, Plan &result,
+		int minVersion, int maxVersion, bool boostEcl) noexcept {
+	return tryPlanSegments(nullptr, segs, ecl, minVersion, maxVersion, boostEcl, result);
+}
+
+
+QrCode::Status QrCode::tryPlanSegments(const QrPrefix *prefix, const vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, bool boostEcl, Plan &result) noexcept {
+	if (!(MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= MAX_VERSION)
+			|| static_cast<unsigned int>(ecl) > 3)
+		return Status::INVALID_ARGUMENT;
+	
+	// Find the minimal version number to use, summing the segments only once per version band
+	static const int BAND_STARTS[] = {1, 10, 27, 41};
+	const int16_t *capacities = NUM_DATA_CODEWORDS[static_cast<int>(ecl)];
+	int dataUsedBits = -1;
+	for (int i = 0; i < 3; i++) {
+		int lo = std::max(BAND_STARTS[i], minVersion);
+		int hi = std::min(BAND_STARTS[i + 1] - 1, maxVersion);
+		if (lo > hi)
+			continue;
+		dataUsedBits = QrSegment::getTotalBits(segs, lo);
+		if (prefix != nullptr && dataUsedBits != -1) {  // Add the prefix's cached length, checking for overflow
+			int prefixBits = prefix->getBitLength(lo);
+			dataUsedBits = prefixBits == -1 || dataUsedBits > INT_MAX - prefixBits ? -1 : dataUsedBits + prefixBits;
+		}
+		if (dataUsedBits == -1)
+			continue;
+		const int16_t *end = capacities + hi + 1;
+		const int16_t *it = std::lower_bound(capacities + lo, end, (dataUsedBits + 7) / 8);
+		if (it == end)
+			continue;
+		
+		// This version number is found to be suitable; increase the error
+		// correction level while the data still fits in this version number
+		result.version = static_cast<int>(it - capacities);
+		result.errorCorrectionLevel = ecl;
+		result.dataUsedBits = dataUsedBits;
+		for (Ecc newEcl : {Ecc::MEDIUM, Ecc::QUARTILE, Ecc::HIGH}) {  // From low to high
+			if (boostEcl && dataUsedBits <= NUM_DATA_CODEWORDS[static_cast<int>(newEcl)][result.version] * 8)
+				result.errorCorrectionLevel = newEcl;
+		}
+		result.dataCapacityBits = NUM_DATA_CODEWORDS[static_cast<int>(result.errorCorrectionLevel)][result.version] * 8;
+		return Status::OK;
+	}
+	
+	// All versions in the range could not fit the given data
+	result.dataUsedBits = dataUsedBits;
+	return Status::DATA_TOO_LONG;
+}
+
+
+std::string QrCode::getDataTooLongMessage(int dataUsedBits, int maxVersion, Ecc ecl) {
+	std::ostringstream sb;
+	if (dataUsedBits == -1)
+		sb << "Segment too long";
+	else {
+		sb << "Data length = " << dataUsedBits << " bits, ";
+		sb << "Max capacity = " << getDataCapacityBits(maxVersion, ecl) << " bits";
+	}
+	return sb.str();
+}
+
+
+int QrCode::getDataCapacityBits(int ver, Ecc ecl) {
+	if (ver < MIN_VERSION || ver > MAX_VERSION)
+		QRCODEGEN_THROW(std::domain_error("Version number out of range"));
+	return NUM_DATA_CODEWORDS[static_cast<int>(ecl)][ver] * 8;
+}
+
+
+void QrCode::writeSegments(const vector<QrSegment> &segs, int version, uint8_t *buf, size_t &bitLen) {
+	for (const QrSegment &seg : segs) {
+		writeBits(static_cast<uint32_t>(seg.getMode().getModeBits()), 4, buf, bitLen);
+		writeBits(static_cast<uint32_t>(seg.getNumChars()), seg.getMode().numCharCountBits(version), buf, bitLen);
+		
+		// Gather the segment's bits into 24-bit words, then write each word with shifts
+		const vector<bool> &data = seg.getData();
+		for (size_t i = 0; i < data.size(); ) {
+			int n = static_cast<int>(std::min(data.size() - i, static_cast<size_t>(24)));
+			uint32_t word = 0;
+			for (int j = 0; j < n; j++, i++)
+				word = word << 1 | (data[i] ? 1 : 0);
+			writeBits(word, n, buf, bitLen);
+		}
+	}
+}
+
+
+void QrCode::writeBits(uint32_t val, int len, uint8_t *buf, size_t &bitLen) {
+	if (len < 0 || len > 24 || val >> len != 0)
+		QRCODEGEN_THROW(std::domain_error("Value out of range"));
+	if (len == 0)
+		return;
+	// Align the value within a 32-bit window that starts at the byte containing bitLen
+	int offset = static_cast<int>(bitLen & 7);
+	uint32_t word = val << (32 - offset - len);
+	size_t index = bitLen >> 3;
+	for (int i = 0; i < offset + len; i += 8, word <<= 8)
+		buf[index++] |= static_cast<uint8_t>(word >> 24);
+	bitLen += static_cast<size_t>(len);
+}
+
+
+QrCode::QrCode(int ver, Ecc ecl, const vector<uint8_t> &dataCodewords, int msk) :
+		// Initialize fields and check arguments
+		version(ver),
+		errorCorrectionLevel(ecl) {
+	if (ver < MIN_VERSION || ver > MAX_VERSION)
+		QRCODEGEN_THROW(std::domain_error("Version value out of range"));
+	if (msk < -1 || msk > 7)
+		QRCODEGEN_THROW(std::domain_error("Mask value out of range"));
+	size = ver * 4 + 17;
+	size_t sz = static_cast<size_t>(size);
+	modules    = Grid(sz, Grid::value_type(sz));  // Initially all light
+	isFunction = Grid(sz, Grid::value_type(sz));
+	
+	// Compute ECC, draw modules, do masking
+	drawFunctionPatterns();
+	drawCodewordsAndMask(dataCodewords,
+		reedSolomonComputeDivisor(ECC_CODEWORDS_PER_BLOCK[static_cast<int>(ecl)][ver]), msk);
+}
+
+
+QrCode::QrCode(const Template &tmpl, const vector<uint8_t> &dataCodewords, int msk) :
+		QrCode(tmpl) {
+	if (msk < -1 || msk > 7)
+		QRCODEGEN_THROW(std::domain_error("Mask value out of range"));
+	drawCodewordsAndMask(dataCodewords, tmpl.rsDivisor, msk);
+}
+
+
+QrCode::QrCode(const Template &tmpl) :
+		// Initialize fields from the template
+		version(tmpl.version),
+		size(tmpl.version * 4 + 17),
+		errorCorrectionLevel(tmpl.errorCorrectionLevel),
+		mask(-1),
+		modules(tmpl.modules),
+		isFunction(tmpl.isFunction) {}
+
+
+QrCode::QrCode(int ver, Ecc ecl, const Grid::allocator_type &alloc) :
+		version(ver),
+		size(getCheckedSize(ver)),  // Before the grids are sized from it
+		errorCorrectionLevel(ecl),
+		mask(-1),
+		// Initially all light, and allocated with the given allocator
+		modules   (static_cast<size_t>(size), Grid::value_type(static_cast<size_t>(size)), alloc),
+		isFunction(static_cast<size_t>(size), Grid::value_type(static_cast<size_t>(size)), alloc) {
+	drawFunctionPatterns();
+}
+
+
+void QrCode::reset(const Template &tmpl, Grid &spareRows) {
+	version = tmpl.version;
+	size = tmpl.version * 4 + 17;
+	errorCorrectionLevel = tmpl.errorCorrectionLevel;
+	mask = -1;
+	for (Grid *grid : {&modules, &isFunction}) {
+		// Move rows between the grid and the spares instead of freeing or allocating them
+		size_t sz = static_cast<size_t>(size);
+		while (grid->size() > sz) {
+			spareRows.push_back(std::move(grid->back()));
+			grid->pop_back();
+		}
+		while (grid->size() < sz) {
+			if (spareRows.empty())
+				grid->emplace_back();
+			else {
+				grid->push_back(std::move(spareRows.back()));
+				spareRows.pop_back();
+			}
+		}
+	}
+	for (size_t y = 0; y < modules.size(); y++) {
+		modules[y] = tmpl.modules[y];
+		isFunction[y] = tmpl.isFunction[y];
+	}
+}
+
+
+size_t QrCode::getMemoryUsage() const {
+	return getMemoryUsage(modules) + getMemoryUsage(isFunction);
+}
+
+
+size_t QrCode::getMemoryUsage(const Grid &grid) {
+	size_t result = grid.capacity() * sizeof(Grid::value_type);
+	for (const Grid::value_type &row : grid)
+		result += (row.capacity() + 7) / 8;
+	return result;
+}
+
+
+QrCode::QrCode(int ver, Ecc ecl, int msk, const uint8_t *packedModules) :
+		version(ver),
+		errorCorrectionLevel(ecl),
+		mask(msk) {
+	if (ver < MIN_VERSION || ver > MAX_VERSION)
+		QRCODEGEN_THROW(std::domain_error("Version value out of range"));
+	if (msk < 0 || msk > 7)
+		QRCODEGEN_THROW(std::domain_error("Mask value out of range"));
+	size = ver * 4 + 17;
+	size_t sz = static_cast<size_t>(size);
+	modules = Grid(sz, Grid::value_type(sz));
+	for (size_t y = 0, i = 0; y < sz; y++) {
+		for (size_t x = 0; x < sz; x++, i++)
+			modules[y][x] = ((packedModules[i >> 3] >> (i & 7)) & 1) != 0;
+	}
+}
+
+
+void QrCode::drawCodewordsAndMask(const vector<uint8_t> &dataCodewords, const vector<uint8_t> &rsDiv, int msk) {
+	const vector<uint8_t> allCodewords = addEccAndInterleave(dataCodewords, rsDiv);
+	drawCodewords(allCodewords);
+	finishMask(msk);
+}
+
+
+void QrCode::finishMask(int msk) {
+	applyFinalMask(msk);
+	isFunction.clear();
+	isFunction.shrink_to_fit();
+}
+
+
+void QrCode::applyFinalMask(int msk) {
+	if (msk < -1 || msk > 7)
+		QRCODEGEN_THROW(std::domain_error("Mask value out of range"));
+	if (msk == -1) {  // Automatically choose best mask
+		long minPenalty = LONG_MAX;
+		for (int i = 0; i < 8; i++) {
+			long penalty = evaluateMask(i);
+			if (penalty < minPenalty) {
+				msk = i;
+				minPenalty = penalty;
+			}
+		}
+	}
+	assert(0 <= msk && msk <= 7);
+	mask = msk;
+	applyMask(msk);  // Apply the final choice of mask
+	drawFormatBits(msk);  // Overwrite old format bits
+}
+
+
+long QrCode::evaluateMask(int msk) {
+	applyMask(msk);
+	drawFormatBits(msk);
+	long result = getPenaltyScore(GridAccessor(*this));
+	applyMask(msk);  // Undoes the mask due to XOR
+	return result;
+}
+
+
+int QrCode::getVersion() const {
+	return version;
+}
+
+
+int QrCode::getSize() const {
+	return size;
+}
+
+
+QrCode::Ecc QrCode::getErrorCorrectionLevel() const {
+	return errorCorrectionLevel;
+}
+
+
+int QrCode::getMask() const {
+	return mask;
+}
+
+
+bool QrCode::getModule(int x, int y) const {
+	return 0 <= x && x < size && 0 <= y && y < size && module(x, y);
+}
+
+
+void QrCode::packModules(uint8_t *out) const {
+	std::fill_n(out, (static_cast<size_t>(size) * static_cast<size_t>(size) + 7) / 8, static_cast<uint8_t>(0));
+	for (int y = 0, i = 0; y < size; y++) {
+		for (int x = 0; x < size; x++, i++) {
+			if (module(x, y))
+				out[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+		}
+	}
+}
+
+
+// The first two bytes of every serialized QR Code: the magic byte, then the format version.
+static const uint8_t SERIALIZED_MAGIC = 0x51;  // 'Q'
+static const uint8_t SERIALIZED_FORMAT_VERSION = 1;
+
+
+vector<uint8_t> QrCode::serialize(bool dataRegionOnly) const {
+	vector<uint8_t> result(getSerializedLength(version, dataRegionOnly));
+	result[0] = SERIALIZED_MAGIC;
+	result[1] = SERIALIZED_FORMAT_VERSION;
+	result[2] = static_cast<uint8_t>((dataRegionOnly ? 0x80 : 0) | static_cast<int>(errorCorrectionLevel) << 3 | mask);
+	result[3] = static_cast<uint8_t>(size);
+	if (!dataRegionOnly) {
+		packModules(&result[4]);
+		return result;
+	}
+	
+	// Pack only the modules outside the function patterns, which a fresh symbol marks
+	const QrCode base(version, errorCorrectionLevel);
+	size_t k = 0;
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			if (base.isFunction.at(static_cast<size_t>(y)).at(static_cast<size_t>(x)))
+				continue;
+			if (module(x, y))
+				result[4 + (k >> 3)] |= static_cast<uint8_t>(1 << (k & 7));
+			k++;
+		}
+	}
+	assert(k == static_cast<unsigned int>(getNumRawDataModules(version)));
+	return result;
+}
+
+
+QrCode QrCode::deserialize(const vector<uint8_t> &data) {
+	return deserialize(data.data(), data.size());
+}
+
+
+QrCode QrCode::deserialize(const uint8_t *data, size_t len) {
+	int ver;
+	Ecc ecl;
+	int msk;
+	bool dataRegionOnly;
+	if (data == nullptr || !parseSerialized(data, len, ver, ecl, msk, dataRegionOnly))
+		QRCODEGEN_THROW(std::invalid_argument("Malformed serialized QR Code"));
+	if (!dataRegionOnly)
+		return QrCode(ver, ecl, msk, &data[4]);
+	
+	// Same steps as the constructor, with the modules outside the function patterns read in row-major order
+	QrCode result(ver, ecl);
+	size_t sz = static_cast<size_t>(result.size);
+	for (size_t y = 0, k = 0; y < sz; y++) {
+		for (size_t x = 0; x < sz; x++) {
+			if (!result.isFunction[y][x]) {
+				result.modules[y][x] = ((data[4 + (k >> 3)] >> (k & 7)) & 1) != 0;
+				k++;
+			}
+		}
+	}
+	result.mask = msk;
+	result.drawFormatBits(msk);
+	result.isFunction.clear();
+	result.isFunction.shrink_to_fit();
+	return result;
+}
+
+
+size_t QrCode::getSerializedLength(int ver, bool dataRegionOnly) {
+	if (ver < MIN_VERSION || ver > MAX_VERSION)
+		QRCODEGEN_THROW(std::domain_error("Version number out of range"));
+	size_t sz = static_cast<size_t>(ver) * 4 + 17;
+	size_t numBits = dataRegionOnly ? static_cast<size_t>(getNumRawDataModules(ver)) : sz * sz;
+	return 4 + (numBits + 7) / 8;  // Header and packed modules
+}
+
+
+bool QrCode::parseSerialized(const uint8_t *data, size_t len, int &ver, Ecc &ecl, int &msk, bool &dataRegionOnly) {
+	if (len < 4 || data[0] != SERIALIZED_MAGIC || data[1] != SERIALIZED_FORMAT_VERSION || (data[2] & 0x60) != 0)
+		return false;
+	int sz = data[3];
+	if (sz < MIN_VERSION * 4 + 17 || sz > MAX_VERSION * 4 + 17 || (sz - 17) % 4 != 0)
+		return false;
+	ver = (sz - 17) / 4;
+	ecl = static_cast<Ecc>(data[2] >> 3 & 3);
+	msk = data[2] & 7;
+	dataRegionOnly = (data[2] & 0x80) != 0;
+	if (len != getSerializedLength(ver, dataRegionOnly))
+		return false;
+	if (dataRegionOnly)
+		return true;
+	
+	// Read the first copy of the format bits, as drawn by drawFormatBits()
+	const uint8_t *packed = &data[4];
+	auto module = [packed, sz](int x, int y) {
+		int i = y * sz + x;
+		return ((packed[i >> 3] >> (i & 7)) & 1);
+	};
+	int bits = 0;
+	for (int i = 0; i <= 5; i++)
+		bits |= module(8, i) << i;
+	bits |= module(8, 7) << 6;
+	bits |= module(8, 8) << 7;
+	bits |= module(7, 8) << 8;
+	for (int i = 9; i < 15; i++)
+		bits |= module(14 - i, 8) << i;
+	return bits == getFormatCodeword(ecl, msk);
+}
+
+
+void QrCode::drawFunctionPatterns() {
+	GridAccessor grid(*this);
+	drawFunctionPatterns(version, errorCorrectionLevel, grid);
+}
+
+
+void QrCode::drawFormatBits(int msk) {
+	GridAccessor grid(*this);
+	drawFormatBits(errorCorrectionLevel, msk, grid);
+}
+
+
+template <typename G>
+void QrCode::drawFunctionPatterns(int ver, Ecc ecl, G &grid) {
+	int size = grid.size();
+	
+	// Draw horizontal and vertical timing patterns
+	for (int i = 0; i < size; i++) {
+		grid.setFunction(6, i, i % 2 == 0);
+		grid.setFunction(i, 6, i % 2 == 0);
+	}
+	
+	// Draw 3 finder patterns (all corners except bottom right; overwrites some timing modules)
+	drawFinderPattern(3, 3, grid);
+	drawFinderPattern(size - 4, 3, grid);
+	drawFinderPattern(3, size - 4, grid);
+	
+	// Draw numerous alignment patterns
+	std::array<int,7> alignPatPos;
+	size_t numAlign = static_cast<size_t>(getAlignmentPatternPositions(ver, alignPatPos));
+	for (size_t i = 0; i < numAlign; i++) {
+		for (size_t j = 0; j < numAlign; j++) {
 			// Don't draw on the three finder corners
 			if (!((i == 0 && j == 0) || (i == 0 && j == numAlign - 1) || (i == numAlign - 1 && j == 0)))
-				drawAlignmentPattern(alignPatPos.at(i), alignPatPos.at(j));
+				drawAlignmentPattern(alignPatPos.at(i), alignPatPos.at(j), grid);
 		}
 	}
 	
 	// Draw configuration data
-	drawFormatBits(0);  // Dummy mask value; overwritten later in the constructor
-	drawVersion();
+	drawFormatBits(ecl, 0, grid);  // Dummy mask value; overwritten later in the constructor
+	drawVersion(ver, grid);
 }
 
 
-void QrCode::drawFormatBits(int msk) {
-	// Calculate error correction code and pack bits
-	int data = getFormatBits(errorCorrectionLevel) << 3 | msk;  // errCorrLvl is uint2, msk is uint3
-	int rem = data;
-	for (int i = 0; i < 10; i++)
-		rem = (rem << 1) ^ ((rem >> 9) * 0x537);
-	int bits = (data << 10 | rem) ^ 0x5412;  // uint15
-	assert(bits >> 15 == 0);
+template <typename G>
+void QrCode::drawFormatBits(Ecc ecl, int msk, G &grid) {
+	int size = grid.size();
+	int bits = getFormatCodeword(ecl, msk);
 	
 	// Draw first copy
 	for (int i = 0; i <= 5; i++)
-		setFunctionModule(8, i, getBit(bits, i));
-	setFunctionModule(8, 7, getBit(bits, 6));
-	setFunctionModule(8, 8, getBit(bits, 7));
-	setFunctionModule(7, 8, getBit(bits, 8));
+		grid.setFunction(8, i, getBit(bits, i));
+	grid.setFunction(8, 7, getBit(bits, 6));
+	grid.setFunction(8, 8, getBit(bits, 7));
+	grid.setFunction(7, 8, getBit(bits, 8));
 	for (int i = 9; i < 15; i++)
-		setFunctionModule(14 - i, 8, getBit(bits, i));
+		grid.setFunction(14 - i, 8, getBit(bits, i));
 	
 	// Draw second copy
 	for (int i = 0; i < 8; i++)
-		setFunctionModule(size - 1 - i, 8, getBit(bits, i));
+		grid.setFunction(size - 1 - i, 8, getBit(bits, i));
 	for (int i = 8; i < 15; i++)
-		setFunctionModule(8, size - 15 + i, getBit(bits, i));
-	setFunctionModule(8, size - 8, true);  // Always dark
+		grid.setFunction(8, size - 15 + i, getBit(bits, i));
+	grid.setFunction(8, size - 8, true);  // Always dark
 }
 
 
-void QrCode::drawVersion() {
-	if (version < 7)
+template <typename G>
+void QrCode::drawVersion(int ver, G &grid) {
+	if (ver < 7)
 		return;
 	
 	// Calculate error correction code and pack bits
-	int rem = version;  // version is uint6, in the range [7, 40]
+	int rem = ver;  // version is uint6, in the range [7, 40]
 	for (int i = 0; i < 12; i++)
 		rem = (rem << 1) ^ ((rem >> 11) * 0x1F25);
-	long bits = static_cast<long>(version) << 12 | rem;  // uint18
+	long bits = static_cast<long>(ver) << 12 | rem;  // uint18
 	assert(bits >> 18 == 0);
 	
 	// Draw two copies
 	for (int i = 0; i < 18; i++) {
 		bool bit = getBit(bits, i);
-		int a = size - 11 + i % 3;
+		int a = grid.size() - 11 + i % 3;
 		int b = i / 3;
-		setFunctionModule(a, b, bit);
-		setFunctionModule(b, a, bit);
+		grid.setFunction(a, b, bit);
+		grid.setFunction(b, a, bit);
 	}
 }
 
 
-void QrCode::drawFinderPattern(int x, int y) {
+template <typename G>
+void QrCode::drawFinderPattern(int x, int y, G &grid) {
+	int size = grid.size();
 	for (int dy = -4; dy <= 4; dy++) {
 		for (int dx = -4; dx <= 4; dx++) {
 			int dist = std::max(std::abs(dx), std::abs(dy));  // Chebyshev/infinity norm
 			int xx = x + dx, yy = y + dy;
 			if (0 <= xx && xx < size && 0 <= yy && yy < size)
-				setFunctionModule(xx, yy, dist != 2 && dist != 4);
+				grid.setFunction(xx, yy, dist != 2 && dist != 4);
 		}
 	}
 }
 
 
-void QrCode::drawAlignmentPattern(int x, int y) {
+template <typename G>
+void QrCode::drawAlignmentPattern(int x, int y, G &grid) {
 	for (int dy = -2; dy <= 2; dy++) {
 		for (int dx = -2; dx <= 2; dx++)
-			setFunctionModule(x + dx, y + dy, std::max(std::abs(dx), std::abs(dy)) != 1);
+			grid.setFunction(x + dx, y + dy, std::max(std::abs(dx), std::abs(dy)) != 1);
 	}
 }
 
 
-void QrCode::setFunctionModule(int x, int y, bool isDark) {
-	size_t ux = static_cast<size_t>(x);
-	size_t uy = static_cast<size_t>(y);
-	modules   .at(uy).at(ux) = isDark;
-	isFunction.at(uy).at(ux) = true;
+bool QrCode::module(int x, int y) const {
+	return modules.at(static_cast<size_t>(y)).at(static_cast<size_t>(x));
 }
 
 
-bool QrCode::module(int x, int y) const {
-	return modules.at(static_cast<size_t>(y)).at(static_cast<size_t>(x));
+vector<uint8_t> QrCode::addEccAndInterleave(const vector<uint8_t> &data, const vector<uint8_t> &rsDiv) const {
+	if (data.size() != static_cast<unsigned int>(getNumDataCodewords(version, errorCorrectionLevel)))
+		QRCODEGEN_THROW(std::invalid_argument("Invalid argument"));
+	if (rsDiv.size() != static_cast<unsigned int>(ECC_CODEWORDS_PER_BLOCK[static_cast<int>(errorCorrectionLevel)][version]))
+		QRCODEGEN_THROW(std::invalid_argument("Invalid argument"));
+	size_t rawCodewords = static_cast<size_t>(getNumRawDataModules(version) / 8);
+	vector<uint8_t> result(rawCodewords);
+	vector<uint8_t> ecc(rawCodewords - data.size());
+	addEccAndInterleave(data.data(), rsDiv.data(), result.data(), ecc.data());
+	return result;
+}
+
+
+void QrCode::addEccAndInterleave(const uint8_t *data, const uint8_t *rsDiv, uint8_t *result, uint8_t *ecc) const {
+	addEccAndInterleave(version, errorCorrectionLevel, data, rsDiv, result, ecc);
+}
+
+
+void QrCode::addEccAndInterleave(int ver, Ecc ecl, const uint8_t *data, const uint8_t *rsDiv, uint8_t *result, uint8_t *ecc) {
+	// Calculate parameter numbers
+	int numBlocks = NUM_ERROR_CORRECTION_BLOCKS[static_cast<int>(ecl)][ver];
+	int blockEccLen = ECC_CODEWORDS_PER_BLOCK[static_cast<int>(ecl)][ver];
+	int rawCodewords = getNumRawDataModules(ver) / 8;
+	int numShortBlocks = numBlocks - rawCodewords % numBlocks;
+	int shortDataLen = rawCodewords / numBlocks - blockEccLen;
+	
+	// Compute the ECC of each block in place, where long blocks come after all short blocks
+	for (int i = 0; i < numBlocks; i++) {
+		int start = i * shortDataLen + std::max(i - numShortBlocks, 0);
+		reedSolomonComputeRemainder(&data[start], static_cast<size_t>(shortDataLen + (i < numShortBlocks ? 0 : 1)),
+			rsDiv, static_cast<size_t>(blockEccLen), &ecc[i * blockEccLen]);
+	}
+	
+	// Interleave the data bytes of all blocks, then the ECC bytes of all blocks
+	int k = 0;
+	for (int j = 0; j <= shortDataLen; j++) {
+		for (int i = 0; i < numBlocks; i++) {
+			if (j < shortDataLen || i >= numShortBlocks)  // Only long blocks have a last data byte
+				result[k++] = data[i * shortDataLen + std::max(i - numShortBlocks, 0) + j];
+		}
+	}
+	for (int j = 0; j < blockEccLen; j++) {
+		for (int i = 0; i < numBlocks; i++)
+			result[k++] = ecc[i * blockEccLen + j];
+	}
+	assert(k == rawCodewords);
+}
+
+
+int QrCode::getNumEccBlocks() const {
+	return NUM_ERROR_CORRECTION_BLOCKS[static_cast<int>(errorCorrectionLevel)][version];
 }
 
 
-vector<uint8_t> QrCode::addEccAndInterleave(const vector<uint8_t> &data) const {
+vector<uint8_t> QrCode::makeEccBlock(const vector<uint8_t> &data, const vector<uint8_t> &rsDiv, int index) const {
 	if (data.size() != static_cast<unsigned int>(getNumDataCodewords(version, errorCorrectionLevel)))
-		throw std::invalid_argument("Invalid argument");
+		QRCODEGEN_THROW(std::invalid_argument("Invalid argument"));
 	
 	// Calculate parameter numbers
-	int numBlocks = NUM_ERROR_CORRECTION_BLOCKS[static_cast<int>(errorCorrectionLevel)][version];
-	int blockEccLen = ECC_CODEWORDS_PER_BLOCK  [static_cast<int>(errorCorrectionLevel)][version];
+	int numBlocks = getNumEccBlocks();
+	int blockEccLen = ECC_CODEWORDS_PER_BLOCK[static_cast<int>(errorCorrectionLevel)][version];
 	int rawCodewords = getNumRawDataModules(version) / 8;
 	int numShortBlocks = numBlocks - rawCodewords % numBlocks;
-	int shortBlockLen = rawCodewords / numBlocks;
+	int shortDataLen = rawCodewords / numBlocks - blockEccLen;
+	if (index < 0 || index >= numBlocks)
+		QRCODEGEN_THROW(std::domain_error("Block index out of range"));
+	assert(rsDiv.size() == static_cast<unsigned int>(blockEccLen));
 	
-	// Split data into blocks and append ECC to each block
-	vector<vector<uint8_t> > blocks;
-	const vector<uint8_t> rsDiv = reedSolomonComputeDivisor(blockEccLen);
-	for (int i = 0, k = 0; i < numBlocks; i++) {
-		vector<uint8_t> dat(data.cbegin() + k, data.cbegin() + (k + shortBlockLen - blockEccLen + (i < numShortBlocks ? 0 : 1)));
-		k += static_cast<int>(dat.size());
-		const vector<uint8_t> ecc = reedSolomonComputeRemainder(dat, rsDiv);
-		if (i < numShortBlocks)
-			dat.push_back(0);
-		dat.insert(dat.end(), ecc.cbegin(), ecc.cend());
-		blocks.push_back(std::move(dat));
-	}
+	// Long blocks come after all short blocks and hold one more data codeword each
+	int start = index * shortDataLen + std::max(index - numShortBlocks, 0);
+	vector<uint8_t> dat(data.cbegin() + start, data.cbegin() + (start + shortDataLen + (index < numShortBlocks ? 0 : 1)));
+	const vector<uint8_t> ecc = reedSolomonComputeRemainder(dat, rsDiv);
+	if (index < numShortBlocks)
+		dat.push_back(0);
+	dat.insert(dat.end(), ecc.cbegin(), ecc.cend());
+	return dat;
+}
+
+
+vector<uint8_t> QrCode::interleaveBlocks(const vector<vector<uint8_t> > &blocks) const {
+	int numBlocks = getNumEccBlocks();
+	int blockEccLen = ECC_CODEWORDS_PER_BLOCK[static_cast<int>(errorCorrectionLevel)][version];
+	int rawCodewords = getNumRawDataModules(version) / 8;
+	int numShortBlocks = numBlocks - rawCodewords % numBlocks;
+	int shortBlockLen = rawCodewords / numBlocks;
+	if (blocks.size() != static_cast<unsigned int>(numBlocks))
+		QRCODEGEN_THROW(std::invalid_argument("Invalid argument"));
 	
 	// Interleave (not concatenate) the bytes from every block into a single sequence
 	vector<uint8_t> result;
+	result.reserve(static_cast<size_t>(rawCodewords));
 	for (size_t i = 0; i < blocks.at(0).size(); i++) {
 		for (size_t j = 0; j < blocks.size(); j++) {
 			// Skip the padding byte in short blocks
@@ -534,9 +1362,21 @@ vector<uint8_t> QrCode::addEccAndInterleave(const vector<uint8_t> &data) const {
 
 
 void QrCode::drawCodewords(const vector<uint8_t> &data) {
-	if (data.size() != static_cast<unsigned int>(getNumRawDataModules(version) / 8))
-		throw std::invalid_argument("Invalid argument");
-	
+	drawCodewords(data.data(), data.size());
+}
+
+
+void QrCode::drawCodewords(const uint8_t *data, size_t len) {
+	if (len != static_cast<unsigned int>(getNumRawDataModules(version) / 8))
+		QRCODEGEN_THROW(std::invalid_argument("Invalid argument"));
+	GridAccessor grid(*this);
+	drawCodewords(data, len, grid);
+}
+
+
+template <typename G>
+void QrCode::drawCodewords(const uint8_t *data, size_t len, G &grid) {
+	int size = grid.size();
 	size_t i = 0;  // Bit index into the data
 	// Do the funny zigzag scan
 	for (int right = size - 1; right >= 1; right -= 2) {  // Index of right column in each column pair
@@ -544,11 +1384,11 @@ void QrCode::drawCodewords(const vector<uint8_t> &data) {
 			right = 5;
 		for (int vert = 0; vert < size; vert++) {  // Vertical counter
 			for (int j = 0; j < 2; j++) {
-				size_t x = static_cast<size_t>(right - j);  // Actual x coordinate
+				int x = right - j;  // Actual x coordinate
 				bool upward = ((right + 1) & 2) == 0;
-				size_t y = static_cast<size_t>(upward ? size - 1 - vert : vert);  // Actual y coordinate
-				if (!isFunction.at(y).at(x) && i < data.size() * 8) {
-					modules.at(y).at(x) = getBit(data.at(i >> 3), 7 - static_cast<int>(i & 7));
+				int y = upward ? size - 1 - vert : vert;  // Actual y coordinate
+				if (!grid.isFunction(x, y) && i < len * 8) {
+					grid.set(x, y, getBit(data[i >> 3], 7 - static_cast<int>(i & 7)));
 					i++;
 				}
 				// If this QR Code has any remainder bits (0 to 7), they were assigned as
@@ -556,16 +1396,23 @@ void QrCode::drawCodewords(const vector<uint8_t> &data) {
 			}
 		}
 	}
-	assert(i == data.size() * 8);
+	assert(i == len * 8);
 }
 
 
 void QrCode::applyMask(int msk) {
 	if (msk < 0 || msk > 7)
-		throw std::domain_error("Mask value out of range");
-	size_t sz = static_cast<size_t>(size);
-	for (size_t y = 0; y < sz; y++) {
-		for (size_t x = 0; x < sz; x++) {
+		QRCODEGEN_THROW(std::domain_error("Mask value out of range"));
+	GridAccessor grid(*this);
+	applyMask(msk, grid);
+}
+
+
+template <typename G>
+void QrCode::applyMask(int msk, G &grid) {
+	int size = grid.size();
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
 			bool invert;
 			switch (msk) {
 				case 0:  invert = (x + y) % 2 == 0;                    break;
@@ -576,15 +1423,18 @@ void QrCode::applyMask(int msk) {
 				case 5:  invert = x * y % 2 + x * y % 3 == 0;          break;
 				case 6:  invert = (x * y % 2 + x * y % 3) % 2 == 0;    break;
 				case 7:  invert = ((x + y) % 2 + x * y % 3) % 2 == 0;  break;
-				default:  throw std::logic_error("Unreachable");
+				default:  QRCODEGEN_THROW(std::logic_error("Unreachable"));
 			}
-			modules.at(y).at(x) = modules.at(y).at(x) ^ (invert & !isFunction.at(y).at(x));
+			if (invert && !grid.isFunction(x, y))
+				grid.set(x, y, !grid.get(x, y));
 		}
 	}
 }
 
 
-long QrCode::getPenaltyScore() const {
+template <typename G>
+long QrCode::getPenaltyScore(const G &grid) {
+	int size = grid.size();
 	long result = 0;
 	
 	// Adjacent modules in row having same color, and finder-like patterns
@@ -593,21 +1443,21 @@ long QrCode::getPenaltyScore() const {
 		int runX = 0;
 		std::array<int,7> runHistory = {};
 		for (int x = 0; x < size; x++) {
-			if (module(x, y) == runColor) {
+			if (grid.get(x, y) == runColor) {
 				runX++;
 				if (runX == 5)
 					result += PENALTY_N1;
 				else if (runX > 5)
 					result++;
 			} else {
-				finderPenaltyAddHistory(runX, runHistory);
+				finderPenaltyAddHistory(runX, runHistory, size);
 				if (!runColor)
-					result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-				runColor = module(x, y);
+					result += finderPenaltyCountPatterns(runHistory, size) * PENALTY_N3;
+				runColor = grid.get(x, y);
 				runX = 1;
 			}
 		}
-		result += finderPenaltyTerminateAndCount(runColor, runX, runHistory) * PENALTY_N3;
+		result += finderPenaltyTerminateAndCount(runColor, runX, runHistory, size) * PENALTY_N3;
 	}
 	// Adjacent modules in column having same color, and finder-like patterns
 	for (int x = 0; x < size; x++) {
@@ -615,39 +1465,39 @@ long QrCode::getPenaltyScore() const {
 		int runY = 0;
 		std::array<int,7> runHistory = {};
 		for (int y = 0; y < size; y++) {
-			if (module(x, y) == runColor) {
+			if (grid.get(x, y) == runColor) {
 				runY++;
 				if (runY == 5)
 					result += PENALTY_N1;
 				else if (runY > 5)
 					result++;
 			} else {
-				finderPenaltyAddHistory(runY, runHistory);
+				finderPenaltyAddHistory(runY, runHistory, size);
 				if (!runColor)
-					result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-				runColor = module(x, y);
+					result += finderPenaltyCountPatterns(runHistory, size) * PENALTY_N3;
+				runColor = grid.get(x, y);
 				runY = 1;
 			}
 		}
-		result += finderPenaltyTerminateAndCount(runColor, runY, runHistory) * PENALTY_N3;
+		result += finderPenaltyTerminateAndCount(runColor, runY, runHistory, size) * PENALTY_N3;
 	}
 	
 	// 2*2 blocks of modules having same color
 	for (int y = 0; y < size - 1; y++) {
 		for (int x = 0; x < size - 1; x++) {
-			bool  color = module(x, y);
-			if (  color == module(x + 1, y) &&
-			      color == module(x, y + 1) &&
-			      color == module(x + 1, y + 1))
+			bool  color = grid.get(x, y);
+			if (  color == grid.get(x + 1, y) &&
+			      color == grid.get(x, y + 1) &&
+			      color == grid.get(x + 1, y + 1))
 				result += PENALTY_N2;
 		}
 	}
 	
 	// Balance of dark and light modules
 	int dark = 0;
-	for (const vector<bool> &row : modules) {
-		for (bool color : row) {
-			if (color)
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			if (grid.get(x, y))
 				dark++;
 		}
 	}
@@ -661,25 +1511,31 @@ long QrCode::getPenaltyScore() const {
 }
 
 
-vector<int> QrCode::getAlignmentPatternPositions() const {
-	if (version == 1)
-		return vector<int>();
+int QrCode::getAlignmentPatternPositions(int ver, std::array<int,7> &result) {
+	if (ver == 1)
+		return 0;
 	else {
-		int numAlign = version / 7 + 2;
-		int step = (version == 32) ? 26 :
-			(version * 4 + numAlign * 2 + 1) / (numAlign * 2 - 2) * 2;
-		vector<int> result;
-		for (int i = 0, pos = size - 7; i < numAlign - 1; i++, pos -= step)
-			result.insert(result.begin(), pos);
-		result.insert(result.begin(), 6);
-		return result;
+		int numAlign = ver / 7 + 2;
+		int step = (ver == 32) ? 26 :
+			(ver * 4 + numAlign * 2 + 1) / (numAlign * 2 - 2) * 2;
+		for (int i = numAlign - 1, pos = ver * 4 + 10; i >= 1; i--, pos -= step)
+			result.at(static_cast<size_t>(i)) = pos;
+		result.at(0) = 6;
+		return numAlign;
 	}
 }
 
 
+int QrCode::getCheckedSize(int ver) {
+	if (ver < MIN_VERSION || ver > MAX_VERSION)
+		QRCODEGEN_THROW(std::domain_error("Version value out of range"));
+	return ver * 4 + 17;
+}
+
+
 int QrCode::getNumRawDataModules(int ver) {
 	if (ver < MIN_VERSION || ver > MAX_VERSION)
-		throw std::domain_error("Version number out of range");
+		QRCODEGEN_THROW(std::domain_error("Version number out of range"));
 	int result = (16 * ver + 128) * ver + 64;
 	if (ver >= 2) {
 		int numAlign = ver / 7 + 2;
@@ -701,11 +1557,21 @@ int QrCode::getNumDataCodewords(int ver, Ecc ecl) {
 
 vector<uint8_t> QrCode::reedSolomonComputeDivisor(int degree) {
 	if (degree < 1 || degree > 255)
-		throw std::domain_error("Degree out of range");
+		QRCODEGEN_THROW(std::domain_error("Degree out of range"));
+	vector<uint8_t> result(static_cast<size_t>(degree));
+	reedSolomonComputeDivisor(degree, result.data());
+	return result;
+}
+
+
+void QrCode::reedSolomonComputeDivisor(int degree, uint8_t *result) {
+	if (degree < 1 || degree > 255)
+		QRCODEGEN_THROW(std::domain_error("Degree out of range"));
 	// Polynomial coefficients are stored from highest to lowest power, excluding the leading term which is always 1.
 	// For example the polynomial x^3 + 255x^2 + 8x + 93 is stored as the uint8 array {255, 8, 93}.
-	vector<uint8_t> result(static_cast<size_t>(degree));
-	result.at(result.size() - 1) = 1;  // Start off with the monomial x^0
+	size_t len = static_cast<size_t>(degree);
+	std::fill_n(result, len - 1, static_cast<uint8_t>(0));
+	result[len - 1] = 1;  // Start off with the monomial x^0
 	
 	// Compute the product polynomial (x - r^0) * (x - r^1) * (x - r^2) * ... * (x - r^{degree-1}),
 	// and drop the highest monomial term which is always 1x^degree.
@@ -713,14 +1579,26 @@ vector<uint8_t> QrCode::reedSolomonComputeDivisor(int degree) {
 	uint8_t root = 1;
 	for (int i = 0; i < degree; i++) {
 		// Multiply the current product by (x - r^i)
-		for (size_t j = 0; j < result.size(); j++) {
-			result.at(j) = reedSolomonMultiply(result.at(j), root);
-			if (j + 1 < result.size())
-				result.at(j) ^= result.at(j + 1);
+		for (size_t j = 0; j < len; j++) {
+			result[j] = reedSolomonMultiply(result[j], root);
+			if (j + 1 < len)
+				result[j] ^= result[j + 1];
 		}
 		root = reedSolomonMultiply(root, 0x02);
 	}
-	return result;
+}
+
+
+void QrCode::reedSolomonComputeRemainder(const uint8_t *data, size_t len,
+		const uint8_t *divisor, size_t degree, uint8_t *result) {
+	std::fill_n(result, degree, static_cast<uint8_t>(0));
+	for (size_t i = 0; i < len; i++) {  // Polynomial division
+		uint8_t factor = data[i] ^ result[0];
+		std::memmove(result, result + 1, degree - 1);
+		result[degree - 1] = 0;
+		for (size_t j = 0; j < degree; j++)
+			result[j] ^= reedSolomonMultiply(divisor[j], factor);
+	}
 }
 
 
@@ -749,7 +1627,7 @@ uint8_t QrCode::reedSolomonMultiply(uint8_t x, uint8_t y) {
 }
 
 
-int QrCode::finderPenaltyCountPatterns(const std::array<int,7> &runHistory) const {
+int QrCode::finderPenaltyCountPatterns(const std::array<int,7> &runHistory, int size) {
 	int n = runHistory.at(1);
 	assert(n <= size * 3);
 	bool core = n > 0 && runHistory.at(2) == n && runHistory.at(3) == n * 3 && runHistory.at(4) == n && runHistory.at(5) == n;
@@ -758,18 +1636,18 @@ int QrCode::finderPenaltyCountPatterns(const std::array<int,7> &runHistory) cons
 }
 
 
-int QrCode::finderPenaltyTerminateAndCount(bool currentRunColor, int currentRunLength, std::array<int,7> &runHistory) const {
+int QrCode::finderPenaltyTerminateAndCount(bool currentRunColor, int currentRunLength, std::array<int,7> &runHistory, int size) {
 	if (currentRunColor) {  // Terminate dark run
-		finderPenaltyAddHistory(currentRunLength, runHistory);
+		finderPenaltyAddHistory(currentRunLength, runHistory, size);
 		currentRunLength = 0;
 	}
 	currentRunLength += size;  // Add light border to final run
-	finderPenaltyAddHistory(currentRunLength, runHistory);
-	return finderPenaltyCountPatterns(runHistory);
+	finderPenaltyAddHistory(currentRunLength, runHistory, size);
+	return finderPenaltyCountPatterns(runHistory, size);
 }
 
 
-void QrCode::finderPenaltyAddHistory(int currentRunLength, std::array<int,7> &runHistory) const {
+void QrCode::finderPenaltyAddHistory(int currentRunLength, std::array<int,7> &runHistory, int size) {
 	if (runHistory.at(0) == 0)
 		currentRunLength += size;  // Add light border to initial run
 	std::copy_backward(runHistory.cbegin(), runHistory.cend() - 1, runHistory.end());
@@ -808,12 +1686,1425 @@ const int8_t QrCode::NUM_ERROR_CORRECTION_BLOCKS[4][41] = {
 	{-1, 1, 1, 2, 4, 4, 4, 5, 6, 8, 8, 11, 11, 16, 16, 18, 16, 19, 21, 25, 25, 25, 34, 30, 32, 35, 37, 40, 42, 45, 48, 51, 54, 57, 60, 63, 66, 70, 74, 77, 81},  // High
 };
 
+const int16_t QrCode::NUM_DATA_CODEWORDS[4][41] = {
+	// Version: (note that index 0 is for padding, and is set to an illegal value)
+	//   0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,   15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25,   26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40    Error correction level
+	{  -1,   19,   34,   55,   80,  108,  136,  156,  194,  232,  274,  324,  370,  428,  461,  523,  589,  647,  721,  795,  861,  932, 1006, 1094, 1174, 1276, 1370, 1468, 1531, 1631, 1735, 1843, 1955, 2071, 2191, 2306, 2434, 2566, 2702, 2812, 2956},  // Low
+	{  -1,   16,   28,   44,   64,   86,  108,  124,  154,  182,  216,  254,  290,  334,  365,  415,  453,  507,  563,  627,  669,  714,  782,  860,  914, 1000, 1062, 1128, 1193, 1267, 1373, 1455, 1541, 1631, 1725, 1812, 1914, 1992, 2102, 2216, 2334},  // Medium
+	{  -1,   13,   22,   34,   48,   62,   76,   88,  110,  132,  154,  180,  206,  244,  261,  295,  325,  367,  397,  445,  485,  512,  568,  614,  664,  718,  754,  808,  871,  911,  985, 1033, 1115, 1171, 1231, 1286, 1354, 1426, 1502, 1582, 1666},  // Quartile
+	{  -1,    9,   16,   26,   36,   46,   60,   66,   86,  100,  122,  140,  158,  180,  197,  223,  253,  283,  313,  341,  385,  406,  442,  464,  514,  538,  596,  628,  661,  701,  745,  793,  845,  901,  961,  986, 1054, 1096, 1142, 1222, 1276},  // High
+};
+
+
+/*---- Class QrCodeResult ----*/
+
+QrCodeResult::QrCodeResult(QrCode &&qr) noexcept :
+		status(QrCode::Status::OK),
+		qrCode(std::move(qr)) {}
+
+
+QrCodeResult::QrCodeResult(QrCode::Status st) noexcept :
+		status(st) {
+	assert(st != QrCode::Status::OK);
+}
+
+
+QrCodeResult::QrCodeResult(const QrCodeResult &other) :
+		status(other.status) {
+	if (status == QrCode::Status::OK)
+		new (&qrCode) QrCode(other.qrCode);
+}
+
+
+QrCodeResult::QrCodeResult(QrCodeResult &&other) noexcept :
+		status(other.status) {
+	if (status == QrCode::Status::OK)
+		new (&qrCode) QrCode(std::move(other.qrCode));
+}
+
+
+QrCodeResult &QrCodeResult::operator=(const QrCodeResult &other) {
+	if (this != &other) {
+		if (status == QrCode::Status::OK && other.status == QrCode::Status::OK)
+			qrCode = other.qrCode;
+		else {
+			if (other.status == QrCode::Status::OK)
+				new (&qrCode) QrCode(other.qrCode);
+			else if (status == QrCode::Status::OK)
+				qrCode.~QrCode();
+			status = other.status;
+		}
+	}
+	return *this;
+}
+
+
+QrCodeResult &QrCodeResult::operator=(QrCodeResult &&other) noexcept {
+	if (this != &other) {
+		if (status == QrCode::Status::OK && other.status == QrCode::Status::OK)
+			qrCode = std::move(other.qrCode);
+		else {
+			if (other.status == QrCode::Status::OK)
+				new (&qrCode) QrCode(std::move(other.qrCode));
+			else if (status == QrCode::Status::OK)
+				qrCode.~QrCode();
+			status = other.status;
+		}
+	}
+	return *this;
+}
+
+
+QrCodeResult::~QrCodeResult() {
+	if (status == QrCode::Status::OK)
+		qrCode.~QrCode();
+}
+
+
+bool QrCodeResult::isOk() const noexcept {
+	return status == QrCode::Status::OK;
+}
+
+
+QrCode::Status QrCodeResult::getStatus() const noexcept {
+	return status;
+}
+
+
+const QrCode &QrCodeResult::getQrCode() const noexcept {
+	assert(status == QrCode::Status::OK);
+	return qrCode;
+}
+
+
+QrCode &QrCodeResult::getQrCode() noexcept {
+	assert(status == QrCode::Status::OK);
+	return qrCode;
+}
+
+
+
+/*---- Class data_too_long ----*/
 
 data_too_long::data_too_long(const std::string &msg) :
 	std::length_error(msg) {}
 
 
 
+/*---- Class QrSegmentAdvanced ----*/
+
+vector<QrSegment> QrSegmentAdvanced::makeSegmentsOptimally(const char *text,
+		QrCode::Ecc ecl, int minVersion, int maxVersion) {
+	return makeSegmentsOptimally(text, std::strlen(text), ecl, minVersion, maxVersion);
+}
+
+
+#if __cplusplus >= 201703L
+vector<QrSegment> QrSegmentAdvanced::makeSegmentsOptimally(std::string_view text,
+		QrCode::Ecc ecl, int minVersion, int maxVersion) {
+	return makeSegmentsOptimally(text.data(), text.size(), ecl, minVersion, maxVersion);
+}
+#endif
+
+
+vector<QrSegment> QrSegmentAdvanced::makeSegmentsOptimally(const char *text, size_t len,
+		QrCode::Ecc ecl, int minVersion, int maxVersion) {
+	// Check arguments
+	if (!(QrCode::MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= QrCode::MAX_VERSION))
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	
+	// Iterate through version numbers, and make tentative segments
+	vector<QrSegment> segs;
+	const vector<uint32_t> codePoints = toCodePoints(text, len);
+	for (int version = minVersion; ; version++) {
+		if (version == minVersion || version == 10 || version == 27)
+			segs = makeSegmentsOptimally(text, codePoints, version);
+		
+		// Check if the segments fit
+		int dataCapacityBits = QrCode::getDataCapacityBits(version, ecl);  // Number of data bits available
+		int dataUsedBits = QrSegment::getTotalBits(segs, version);
+		if (dataUsedBits != -1 && dataUsedBits <= dataCapacityBits)
+			return segs;  // This version number is found to be suitable
+		if (version >= maxVersion) {  // All versions in the range could not fit the given text
+			std::ostringstream sb;
+			if (dataUsedBits == -1)
+				sb << "Segment too long";
+			else {
+				sb << "Data length = " << dataUsedBits << " bits, ";
+				sb << "Max capacity = " << dataCapacityBits << " bits";
+			}
+			QRCODEGEN_THROW(data_too_long(sb.str()));
+		}
+	}
+}
+
+
+vector<QrSegment> QrSegmentAdvanced::makeSegmentsOptimally(const char *text,
+		const vector<uint32_t> &codePoints, int version) {
+	if (codePoints.empty())
+		return vector<QrSegment>();
+	const vector<const QrSegment::Mode*> charModes = computeCharacterModes(codePoints, version);
+	return splitIntoSegments(text, codePoints, charModes);
+}
+
+
+vector<const QrSegment::Mode*> QrSegmentAdvanced::computeCharacterModes(
+		const vector<uint32_t> &codePoints, int version) {
+	if (codePoints.empty())
+		QRCODEGEN_THROW(std::invalid_argument("Invalid argument"));
+	const QrSegment::Mode *const modeTypes[] = {  // Do not modify
+		&QrSegment::Mode::BYTE, &QrSegment::Mode::ALPHANUMERIC, &QrSegment::Mode::NUMERIC, &QrSegment::Mode::KANJI};
+	const size_t numModes = sizeof(modeTypes) / sizeof(modeTypes[0]);
+	
+	// Segment header sizes, measured in 1/6 bits
+	vector<long> headCosts(numModes);
+	for (size_t i = 0; i < numModes; i++)
+		headCosts.at(i) = (4L + modeTypes[i]->numCharCountBits(version)) * 6;
+	
+	// charModes[i][j] represents the mode to encode the code point at
+	// index i such that the final segment ends in modeTypes[j] and the
+	// total number of bits is minimized over all possible choices
+	vector<vector<const QrSegment::Mode*> > charModes(codePoints.size(), vector<const QrSegment::Mode*>(numModes));
+	
+	// At the beginning of each iteration of the loop below,
+	// prevCosts[j] is the exact minimum number of 1/6 bits needed to
+	// encode the entire string prefix of length i, and end in modeTypes[j]
+	vector<long> prevCosts = headCosts;
+	
+	// Calculate costs using dynamic programming
+	for (size_t i = 0; i < codePoints.size(); i++) {
+		uint32_t c = codePoints.at(i);
+		vector<const QrSegment::Mode*> &curModes = charModes.at(i);
+		vector<long> curCosts(numModes);
+		{  // Always extend a byte mode segment
+			curCosts.at(0) = prevCosts.at(0) + countUtf8Bytes(c) * 8 * 6;
+			curModes.at(0) = modeTypes[0];
+		}
+		// Extend a segment if possible
+		if (c < 0x80 && QrSegment::ALPHANUMERIC_MAP[c] != -1) {  // Is alphanumeric
+			curCosts.at(1) = prevCosts.at(1) + 33;  // 5.5 bits per alphanumeric char
+			curModes.at(1) = modeTypes[1];
+		}
+		if ('0' <= c && c <= '9') {  // Is numeric
+			curCosts.at(2) = prevCosts.at(2) + 20;  // 3.33 bits per digit
+			curModes.at(2) = modeTypes[2];
+		}
+		if (toQrKanji(c) != -1) {  // Is kanji
+			curCosts.at(3) = prevCosts.at(3) + 78;  // 13 bits per Shift JIS char
+			curModes.at(3) = modeTypes[3];
+		}
+		
+		// Start new segment at the end to switch modes
+		for (size_t j = 0; j < numModes; j++) {  // To mode
+			for (size_t k = 0; k < numModes; k++) {  // From mode
+				long newCost = (curCosts.at(k) + 5) / 6 * 6 + headCosts.at(j);
+				if (curModes.at(k) != nullptr && (curModes.at(j) == nullptr || newCost < curCosts.at(j))) {
+					curCosts.at(j) = newCost;
+					curModes.at(j) = modeTypes[k];
+				}
+			}
+		}
+		
+		prevCosts = std::move(curCosts);
+	}
+	
+	// Find optimal ending mode
+	const QrSegment::Mode *curMode = nullptr;
+	long minCost = 0;
+	for (size_t i = 0; i < numModes; i++) {
+		if (curMode == nullptr || prevCosts.at(i) < minCost) {
+			minCost = prevCosts.at(i);
+			curMode = modeTypes[i];
+		}
+	}
+	
+	// Get optimal mode for each code point by tracing backwards
+	vector<const QrSegment::Mode*> result(charModes.size());
+	for (size_t i = result.size(); i-- > 0; ) {
+		for (size_t j = 0; j < numModes; j++) {
+			if (modeTypes[j] == curMode) {
+				curMode = charModes.at(i).at(j);
+				result.at(i) = curMode;
+				break;
+			}
+		}
+	}
+	return result;
+}
+
+
+vector<QrSegment> QrSegmentAdvanced::splitIntoSegments(const char *text,
+		const vector<uint32_t> &codePoints, const vector<const QrSegment::Mode*> &charModes) {
+	if (codePoints.empty())
+		QRCODEGEN_THROW(std::invalid_argument("Invalid argument"));
+	vector<QrSegment> result;
+	
+	// Accumulate run of modes
+	const QrSegment::Mode *curMode = charModes.at(0);
+	size_t start = 0;  // Byte offset into the text
+	size_t end = 0;
+	for (size_t i = 0; ; ) {
+		end += static_cast<size_t>(countUtf8Bytes(codePoints.at(i)));
+		i++;
+		if (i < codePoints.size() && charModes.at(i) == curMode)
+			continue;
+		if (curMode == &QrSegment::Mode::BYTE)
+			result.push_back(QrSegment::makeBytes(reinterpret_cast<const uint8_t*>(text + start), end - start));
+		else if (curMode == &QrSegment::Mode::NUMERIC)
+			result.push_back(QrSegment::makeNumeric(text + start, end - start));
+		else if (curMode == &QrSegment::Mode::ALPHANUMERIC)
+			result.push_back(QrSegment::makeAlphanumeric(text + start, end - start));
+		else if (curMode == &QrSegment::Mode::KANJI)
+			result.push_back(makeKanji(text + start, end - start));
+		else
+			QRCODEGEN_THROW(std::logic_error("Unreachable"));
+		if (i >= codePoints.size())
+			return result;
+		curMode = charModes.at(i);
+		start = end;
+	}
+}
+
+
+vector<uint32_t> QrSegmentAdvanced::toCodePoints(const char *text, size_t len) {
+	vector<uint32_t> result;
+	if (!decodeUtf8(text, len, result))
+		QRCODEGEN_THROW(std::domain_error("Invalid UTF-8 string"));
+	return result;
+}
+
+
+bool QrSegmentAdvanced::decodeUtf8(const char *text, size_t len, vector<uint32_t> &result) {
+	const unsigned char *end = reinterpret_cast<const unsigned char*>(text) + len;
+	for (const unsigned char *p = reinterpret_cast<const unsigned char*>(text); p != end; ) {
+		uint32_t c = *p;
+		int n;  // Number of continuation bytes
+		uint32_t min;  // Smallest code point allowed for this length, to reject overlong forms
+		if      (c < 0x80) { n = 0;                  min = 0;       }
+		else if (c < 0xC0) return false;
+		else if (c < 0xE0) { n = 1;  c &= 0x1F;  min = 0x80;    }
+		else if (c < 0xF0) { n = 2;  c &= 0x0F;  min = 0x800;   }
+		else if (c < 0xF8) { n = 3;  c &= 0x07;  min = 0x10000; }
+		else return false;
+		p++;
+		for (int i = 0; i < n; i++, p++) {
+			if (p == end || (*p & 0xC0) != 0x80)
+				return false;
+			c = c << 6 | (*p & 0x3Fu);
+		}
+		if (c < min || c > 0x10FFFF || (0xD800 <= c && c < 0xE000))
+			return false;
+		result.push_back(c);
+	}
+	return true;
+}
+
+
+int QrSegmentAdvanced::countUtf8Bytes(uint32_t cp) {
+	if      (cp <     0x80) return 1;
+	else if (cp <    0x800) return 2;
+	else if (cp <  0x10000) return 3;
+	else if (cp < 0x110000) return 4;
+	else                    QRCODEGEN_THROW(std::domain_error("Invalid code point"));
+}
+
+
+
+QrSegment QrSegmentAdvanced::makeKanji(const char *text) {
+	return makeKanji(text, std::strlen(text));
+}
+
+
+QrSegment QrSegmentAdvanced::makeKanji(const char *text, size_t len) {
+	BitBuffer bb;
+	int numChars = 0;
+	for (uint32_t c : toCodePoints(text, len)) {
+		int val = toQrKanji(c);
+		if (val == -1)
+			QRCODEGEN_THROW(std::domain_error("String contains non-kanji-mode characters"));
+		bb.appendBits(static_cast<uint32_t>(val), 13);
+		numChars++;
+	}
+	return QrSegment(QrSegment::Mode::KANJI, numChars, std::move(bb));
+}
+
+
+QrSegment QrSegmentAdvanced::makeKanji(const std::u16string &text) {
+	BitBuffer bb;
+	for (char16_t c : text) {
+		int val = toQrKanji(c);  // Surrogates are never encodable
+		if (val == -1)
+			QRCODEGEN_THROW(std::domain_error("String contains non-kanji-mode characters"));
+		bb.appendBits(static_cast<uint32_t>(val), 13);
+	}
+	return QrSegment(QrSegment::Mode::KANJI, static_cast<int>(text.size()), std::move(bb));
+}
+
+
+bool QrSegmentAdvanced::isEncodableAsKanji(const char *text) {
+	vector<uint32_t> codePoints;
+	if (!decodeUtf8(text, std::strlen(text), codePoints))
+		return false;
+	for (uint32_t c : codePoints) {
+		if (toQrKanji(c) == -1)
+			return false;
+	}
+	return true;
+}
+
+
+bool QrSegmentAdvanced::isEncodableAsKanji(const std::u16string &text) {
+	for (char16_t c : text) {
+		if (toQrKanji(c) == -1)
+			return false;
+	}
+	return true;
+}
+
+
+int QrSegmentAdvanced::toQrKanji(uint32_t cp) {
+	if (cp >= 0x10000)
+		return -1;
+	const uint32_t *end = PACKED_UNICODE_TO_QR_KANJI + sizeof(PACKED_UNICODE_TO_QR_KANJI) / sizeof(PACKED_UNICODE_TO_QR_KANJI[0]);
+	const uint32_t *it = std::lower_bound(PACKED_UNICODE_TO_QR_KANJI, end, cp << 13);
+	if (it == end || *it >> 13 != cp)
+		return -1;
+	return static_cast<int>(*it & 0x1FFF);
+}
+
+
+const uint32_t QrSegmentAdvanced::PACKED_UNICODE_TO_QR_KANJI[6879] = {
+	0x000B801F, 0x00144051, 0x00146052, 0x0014E058, 0x0015000E, 0x0015808A, 0x0016004B, 0x0016203D, 0x0016800C, 0x0016C0B7,
+	0x001AE03E, 0x001EE040, 0x007221DF, 0x007241E0, 0x007261E1, 0x007281E2, 0x0072A1E3, 0x0072C1E4, 0x0072E1E5, 0x007301E6,
+	0x007321E7, 0x007341E8, 0x007361E9, 0x007381EA, 0x0073A1EB, 0x0073C1EC, 0x0073E1ED, 0x007401EE, 0x007421EF, 0x007461F0,
+	0x007481F1, 0x0074A1F2, 0x0074C1F3, 0x0074E1F4, 0x007501F5, 0x007521F6, 0x007621FF, 0x00764200, 0x00766201, 0x00768202,
+	0x0076A203, 0x0076C204, 0x0076E205, 0x00770206, 0x00772207, 0x00774208, 0x00776209, 0x0077820A, 0x0077A20B, 0x0077C20C,
+	0x0077E20D, 0x0078020E, 0x0078220F, 0x00786210, 0x00788211, 0x0078A212, 0x0078C213, 0x0078E214, 0x00790215, 0x00792216,
+	0x00802246, 0x00820240, 0x00822241, 0x00824242, 0x00826243, 0x00828244, 0x0082A245, 0x0082C247, 0x0082E248, 0x00830249,
+	0x0083224A, 0x0083424B, 0x0083624C, 0x0083824D, 0x0083A24E, 0x0083C24F, 0x0083E250, 0x00840251, 0x00842252, 0x00844253,
+	0x00846254, 0x00848255, 0x0084A256, 0x0084C257, 0x0084E258, 0x00850259, 0x0085225A, 0x0085425B, 0x0085625C, 0x0085825D,
+	0x0085A25E, 0x0085C25F, 0x0085E260, 0x00860270, 0x00862271, 0x00864272, 0x00866273, 0x00868274, 0x0086A275, 0x0086C277,
+	0x0086E278, 0x00870279, 0x0087227A, 0x0087427B, 0x0087627C, 0x0087827D, 0x0087A27E, 0x0087C280, 0x0087E281, 0x00880282,
+	0x00882283, 0x00884284, 0x00886285, 0x00888286, 0x0088A287, 0x0088C288, 0x0088E289, 0x0089028A, 0x0089228B, 0x0089428C,
+	0x0089628D, 0x0089828E, 0x0089A28F, 0x0089C290, 0x0089E291, 0x008A2276, 0x0402001D, 0x0402A01C, 0x0402C021, 0x04030025,
+	0x04032026, 0x04038027, 0x0403A028, 0x040400B5, 0x040420B6, 0x0404A024, 0x0404C023, 0x040600B1, 0x0406404C, 0x0406604D,
+	0x04076066, 0x0420604E, 0x042560B0, 0x04320069, 0x0432206A, 0x04324068, 0x0432606B, 0x043A408B, 0x043A808C, 0x0440008D,
+	0x0440409D, 0x0440608E, 0x0440E09E, 0x04410078, 0x04416079, 0x0442403C, 0x044340A3, 0x0443A0A5, 0x0443C047, 0x0444009A,
+	0x0444E088, 0x04450089, 0x0445207F, 0x0445407E, 0x044560A7, 0x044580A8, 0x04468048, 0x0446A0A6, 0x0447A0A4, 0x044A40A0,
+	0x044C0042, 0x044C209F, 0x044CC045, 0x044CE046, 0x044D40A1, 0x044D60A2, 0x0450407C, 0x0450607D, 0x0450C07A, 0x0450E07B,
+	0x0454A09B, 0x0462409C, 0x04A0029F, 0x04A022AA, 0x04A042A0, 0x04A062AB, 0x04A182A1, 0x04A1E2AC, 0x04A202A2, 0x04A262AD,
+	0x04A282A4, 0x04A2E2AF, 0x04A302A3, 0x04A362AE, 0x04A382A5, 0x04A3A2BA, 0x04A402B5, 0x04A462B0, 0x04A482A7, 0x04A4A2BC,
+	0x04A502B7, 0x04A562B2, 0x04A582A6, 0x04A5E2B6, 0x04A602BB, 0x04A662B1, 0x04A682A8, 0x04A6E2B8, 0x04A702BD, 0x04A762B3,
+	0x04A782A9, 0x04A7E2B9, 0x04A842BE, 0x04A962B4, 0x04B40061, 0x04B42060, 0x04B64063, 0x04B66062, 0x04B78065, 0x04B7A064,
+	0x04B8C05F, 0x04B8E05E, 0x04B9605B, 0x04B9C05D, 0x04B9E05C, 0x04BDE0BC, 0x04C0A05A, 0x04C0C059, 0x04C8004A, 0x04C84049,
+	0x04CD40B4, 0x04CDA0B3, 0x04CDE0B2, 0x06000000, 0x06002001, 0x06004002, 0x06006016, 0x0600A018, 0x0600C019, 0x0600E01A,
+	0x06010031, 0x06012032, 0x06014033, 0x06016034, 0x06018035, 0x0601A036, 0x0601C037, 0x0601E038, 0x06020039, 0x0602203A,
+	0x06024067, 0x0602606C, 0x0602802B, 0x0602A02C, 0x06038020, 0x0608211F, 0x06084120, 0x06086121, 0x06088122, 0x0608A123,
+	0x0608C124, 0x0608E125, 0x06090126, 0x06092127, 0x06094128, 0x06096129, 0x0609812A, 0x0609A12B, 0x0609C12C, 0x0609E12D,
+	0x060A012E, 0x060A212F, 0x060A4130, 0x060A6131, 0x060A8132, 0x060AA133, 0x060AC134, 0x060AE135, 0x060B0136, 0x060B2137,
+	0x060B4138, 0x060B6139, 0x060B813A, 0x060BA13B, 0x060BC13C, 0x060BE13D, 0x060C013E, 0x060C213F, 0x060C4140, 0x060C6141,
+	0x060C8142, 0x060CA143, 0x060CC144, 0x060CE145, 0x060D0146, 0x060D2147, 0x060D4148, 0x060D6149, 0x060D814A, 0x060DA14B,
+	0x060DC14C, 0x060DE14D, 0x060E014E, 0x060E214F, 0x060E4150, 0x060E6151, 0x060E8152, 0x060EA153, 0x060EC154, 0x060EE155,
+	0x060F0156, 0x060F2157, 0x060F4158, 0x060F6159, 0x060F815A, 0x060FA15B, 0x060FC15C, 0x060FE15D, 0x0610015E, 0x0610215F,
+	0x06104160, 0x06106161, 0x06108162, 0x0610A163, 0x0610C164, 0x0610E165, 0x06110166, 0x06112167, 0x06114168, 0x06116169,
+	0x0611816A, 0x0611A16B, 0x0611C16C, 0x0611E16D, 0x0612016E, 0x0612216F, 0x06124170, 0x06126171, 0x0613600A, 0x0613800B,
+	0x0613A014, 0x0613C015, 0x06142180, 0x06144181, 0x06146182, 0x06148183, 0x0614A184, 0x0614C185, 0x0614E186, 0x06150187,
+	0x06152188, 0x06154189, 0x0615618A, 0x0615818B, 0x0615A18C, 0x0615C18D, 0x0615E18E, 0x0616018F, 0x06162190, 0x06164191,
+	0x06166192, 0x06168193, 0x0616A194, 0x0616C195, 0x0616E196, 0x06170197, 0x06172198, 0x06174199, 0x0617619A, 0x0617819B,
+	0x0617A19C, 0x0617C19D, 0x0617E19E, 0x0618019F, 0x061821A0, 0x061841A1, 0x061861A2, 0x061881A3, 0x0618A1A4, 0x0618C1A5,
+	0x0618E1A6, 0x061901A7, 0x061921A8, 0x061941A9, 0x061961AA, 0x061981AB, 0x0619A1AC, 0x0619C1AD, 0x0619E1AE, 0x061A01AF,
+	0x061A21B0, 0x061A41B1, 0x061A61B2, 0x061A81B3, 0x061AA1B4, 0x061AC1B5, 0x061AE1B6, 0x061B01B7, 0x061B21B8, 0x061B41B9,
+	0x061B61BA, 0x061B81BB, 0x061BA1BC, 0x061BC1BD, 0x061BE1BE, 0x061C01C0, 0x061C21C1, 0x061C41C2, 0x061C61C3, 0x061C81C4,
+	0x061CA1C5, 0x061CC1C6, 0x061CE1C7, 0x061D01C8, 0x061D21C9, 0x061D41CA, 0x061D61CB, 0x061D81CC, 0x061DA1CD, 0x061DC1CE,
+	0x061DE1CF, 0x061E01D0, 0x061E21D1, 0x061E41D2, 0x061E61D3, 0x061E81D4, 0x061EA1D5, 0x061EC1D6, 0x061F6005, 0x061F801B,
+	0x061FA012, 0x061FC013, 0x09C005EA, 0x09C02D1A, 0x09C06A35, 0x09C0F01C, 0x09C10B24, 0x09C129CF, 0x09C14B23, 0x09C1667A,
+	0x09C1AF33, 0x09C1D09E, 0x09C211A0, 0x09C2260E, 0x09C2870E, 0x09C2B1A1, 0x09C2CBA2, 0x09C2F280, 0x09C307B5, 0x09C32F78,
+	0x09C3CB25, 0x09C430FC, 0x09C4CF80, 0x09C551A2, 0x09C5AD06, 0x09C631A3, 0x09C64838, 0x09C6D1A4, 0x09C7075B, 0x09C72CCF,
+	0x09C76A65, 0x09C791A5, 0x09C7F1A6, 0x09C851A7, 0x09C86E54, 0x09C8A7B6, 0x09C96E56, 0x09C9AE21, 0x09C9C8C1, 0x09C9EFD2,
+	0x09CABB28, 0x09CAD1A8, 0x09CAEB26, 0x09CB11A9, 0x09CB2673, 0x09CBA823, 0x09CBC8EE, 0x09CBF067, 0x09CC53E4, 0x09CE30D0,
+	0x09CE6E3B, 0x09CFC723, 0x09D00794, 0x09D051AA, 0x09D0B1AB, 0x09D0D0F9, 0x09D1109C, 0x09D12C48, 0x09D151AD, 0x09D16A16,
+	0x09D18E31, 0x09D1D1B0, 0x09D2261D, 0x09D248DD, 0x09D288DC, 0x09D2A5E4, 0x09D3116A, 0x09D33169, 0x09D36971, 0x09D3859F,
+	0x09D3D1B1, 0x09D3F1B2, 0x09D411B3, 0x09D42FD3, 0x09D451B4, 0x09D488F0, 0x09D4A5E5, 0x09D4D012, 0x09D507DC, 0x09D567DD,
+	0x09D587DE, 0x09D5AD60, 0x09D5D0FA, 0x09D611B5, 0x09D671B6, 0x09D6D1B7, 0x09D74B6C, 0x09D80A99, 0x09D82B6D, 0x09D851BC,
+	0x09D891BA, 0x09D8D1BB, 0x09D8E7B7, 0x09D94961, 0x09D966AE, 0x09D9B1B9, 0x09D9D1B8, 0x09D9EF67, 0x09DA89E5, 0x09DAA9E4,
+	0x09DACC7C, 0x09DAF1BD, 0x09DB0F34, 0x09DB2BE5, 0x09DBA017, 0x09DBD1BE, 0x09DBF1C0, 0x09DC6CA3, 0x09DC911F, 0x09DCA5C8,
+	0x09DDB1BF, 0x09DDC67C, 0x09DE0802, 0x09DE4D07, 0x09DEC88F, 0x09DEF1C1, 0x09DF6E43, 0x09E02769, 0x09E131C2, 0x09E145C9,
+	0x09E1A8DE, 0x09E1C76A, 0x09E1EF5A, 0x09E20EB0, 0x09E227B8, 0x09E346AF, 0x09E391E5, 0x09E3ADA0, 0x09E5EE8C, 0x09E611C4,
+	0x09E68EBA, 0x09E6D120, 0x09E70B4C, 0x09E749E6, 0x09E78A17, 0x09E7A67E, 0x09E86D4F, 0x09E8CCC1, 0x09E8F1C8, 0x09E9A5CA,
+	0x09E9CD61, 0x09E9EA9A, 0x09EA0972, 0x09EA3083, 0x09EA6C8C, 0x09EAA67D, 0x09EAF1C7, 0x09EB309D, 0x09EB51C3, 0x09EB71C5,
+	0x09EB89AC, 0x09EBB1C6, 0x09EBD383, 0x09ED31CE, 0x09EDF1D1, 0x09EE11CF, 0x09EE6680, 0x09EEAF79, 0x09EED1C9, 0x09EF71CD,
+	0x09EF88F1, 0x09EFE9E7, 0x09F06724, 0x09F0D1D2, 0x09F111CA, 0x09F17121, 0x09F1AA18, 0x09F1F1CB, 0x09F231D0, 0x09F2D1D3,
+	0x09F311CC, 0x09F367DF, 0x09F3A5CB, 0x09F407E0, 0x09F4267F, 0x09F57384, 0x09F5B019, 0x09F5CF4E, 0x09F5E8F2, 0x09F6AB4E,
+	0x09F6D0F5, 0x09F7EF96, 0x09F84857, 0x09F86C63, 0x09F886A2, 0x09F94AB2, 0x09F9D1D7, 0x09FA11DC, 0x09FA31DA, 0x09FA91D5,
+	0x09FAEC6D, 0x09FB11D8, 0x09FB51DB, 0x09FB71D9, 0x09FBAF9B, 0x09FBF1D6, 0x09FC2B4D, 0x09FC7013, 0x09FC91DD, 0x09FCB1DE,
+	0x09FDCA83, 0x09FDF1EB, 0x09FE6E6F, 0x09FEAF15, 0x09FED1E6, 0x09FF0FAE, 0x09FF4674, 0x09FFD1EA, 0x0A00B1E4, 0x0A00D1ED,
+	0x0A012C31, 0x0A0168C2, 0x0A01AE7B, 0x0A01F7C5, 0x0A0231EC, 0x0A024DBC, 0x0A0291E1, 0x0A02C8F4, 0x0A0328F3, 0x0A0351DF,
+	0x0A03EA58, 0x0A0431E7, 0x0A046FAD, 0x0A048CEC, 0x0A04B1E3, 0x0A04C891, 0x0A0511E0, 0x0A0531E8, 0x0A0551E2, 0x0A05710F,
+	0x0A0591E9, 0x0A05B160, 0x0A06C824, 0x0A072890, 0x0A0871EE, 0x0A08F1EF, 0x0A0911F3, 0x0A0925CC, 0x0A09EF8E, 0x0A0A11F2,
+	0x0A0AB1F1, 0x0A0AD1F5, 0x0A0B51F4, 0x0A0B8D62, 0x0A0CA892, 0x0A0D91F6, 0x0A0E4A43, 0x0A0E8C64, 0x0A0EAD63, 0x0A0EC834,
+	0x0A0F11F7, 0x0A0FA795, 0x0A1011F8, 0x0A10B1FA, 0x0A11AFD4, 0x0A122886, 0x0A1309D0, 0x0A132EF5, 0x0A1351F9, 0x0A158983,
+	0x0A15B0A2, 0x0A1651FC, 0x0A167202, 0x0A1691FB, 0x0A16A982, 0x0A16EADD, 0x0A17C858, 0x0A185203, 0x0A18A80D, 0x0A193200,
+	0x0A195201, 0x0A19ADED, 0x0A19EC5C, 0x0A1A27E1, 0x0A1AAFEC, 0x0A1AD204, 0x0A1B50FB, 0x0A1BD205, 0x0A1C7208, 0x0A1CB206,
+	0x0A1CEC2D, 0x0A1DB207, 0x0A1DD209, 0x0A1EB20B, 0x0A1F320A, 0x0A1F6F86, 0x0A200796, 0x0A20320D, 0x0A20520E, 0x0A20866D,
+	0x0A21320C, 0x0A224A72, 0x0A229211, 0x0A22B210, 0x0A22D20F, 0x0A2311D4, 0x0A235212, 0x0A23EADE, 0x0A243213, 0x0A255084,
+	0x0A265057, 0x0A26F215, 0x0A275214, 0x0A277217, 0x0A279216, 0x0A27F218, 0x0A281219, 0x0A2825F2, 0x0A2868B3, 0x0A28885A,
+	0x0A28AA9B, 0x0A28CD1B, 0x0A28E7E2, 0x0A290BE6, 0x0A2928F5, 0x0A29694E, 0x0A29921B, 0x0A29B046, 0x0A29CDA5, 0x0A2A0A19,
+	0x0A2A521A, 0x0A2A921C, 0x0A2B4DBD, 0x0A2B8715, 0x0A2C521D, 0x0A2CAE3C, 0x0A2D0C13, 0x0A2D321F, 0x0A2D5220, 0x0A2D6EAA,
+	0x0A2D88F6, 0x0A2DB15A, 0x0A2DD221, 0x0A2E27E4, 0x0A2EAF7A, 0x0A2ECC74, 0x0A2EE82F, 0x0A2F0D94, 0x0A2F8893, 0x0A301222,
+	0x0A305223, 0x0A30AE20, 0x0A30C63E, 0x0A313226, 0x0A3149BB, 0x0A319225, 0x0A31A984, 0x0A31F227, 0x0A321A2C, 0x0A323228,
+	0x0A324FE0, 0x0A327229, 0x0A32B22A, 0x0A32D22B, 0x0A32EB27, 0x0A332A4A, 0x0A340725, 0x0A34522E, 0x0A34922C, 0x0A34B03B,
+	0x0A34D22D, 0x0A350F39, 0x0A35322F, 0x0A355230, 0x0A357231, 0x0A358DBE, 0x0A361235, 0x0A363233, 0x0A365234, 0x0A367232,
+	0x0A3689A1, 0x0A36B236, 0x0A36D068, 0x0A36F122, 0x0A37B237, 0x0A388BA6, 0x0A38B238, 0x0A38CAB9, 0x0A393239, 0x0A396D1C,
+	0x0A3990FD, 0x0A39ADC0, 0x0A3AD283, 0x0A3B723A, 0x0A3B9F23, 0x0A3BA803, 0x0A3C123B, 0x0A3C2FFD, 0x0A3CCAC8, 0x0A3CECBA,
+	0x0A3D323D, 0x0A3D4E22, 0x0A3DB23E, 0x0A3E1240, 0x0A3E26CD, 0x0A3EB241, 0x0A3EC7E5, 0x0A3F0E0A, 0x0A3F265A, 0x0A3F4AAF,
+	0x0A3FAE9F, 0x0A3FD242, 0x0A400DC1, 0x0A406B6E, 0x0A409243, 0x0A40CF6A, 0x0A40EBD8, 0x0A410720, 0x0A414727, 0x0A417244,
+	0x0A41D246, 0x0A422859, 0x0A429245, 0x0A42F131, 0x0A43AAC9, 0x0A448EBB, 0x0A44AF8A, 0x0A44F247, 0x0A4530D8, 0x0A455248,
+	0x0A45D249, 0x0A460DDE, 0x0A46724A, 0x0A46CBA7, 0x0A46E9BC, 0x0A470894, 0x0A47324B, 0x0A4749E8, 0x0A47694F, 0x0A486D64,
+	0x0A48924D, 0x0A48EC65, 0x0A4949AD, 0x0A49724E, 0x0A49924F, 0x0A49AC0F, 0x0A49F24C, 0x0A4A9251, 0x0A4ACFD5, 0x0A4B6944,
+	0x0A4BD250, 0x0A4C6895, 0x0A4C899C, 0x0A4CAE8D, 0x0A4D3254, 0x0A4D5252, 0x0A4DEF5B, 0x0A4E0B28, 0x0A4E325B, 0x0A4E4704,
+	0x0A4E7255, 0x0A4E9253, 0x0A4EAC2E, 0x0A4FB257, 0x0A4FF256, 0x0A5066E3, 0x0A50E880, 0x0A51125C, 0x0A5130EB, 0x0A51B258,
+	0x0A52325D, 0x0A52525A, 0x0A529259, 0x0A53710D, 0x0A53E8F7, 0x0A540681, 0x0A547132, 0x0A552AD5, 0x0A554DB7, 0x0A556945,
+	0x0A559260, 0x0A55B261, 0x0A563123, 0x0A56914A, 0x0A56B263, 0x0A5728F8, 0x0A579262, 0x0A57C6CE, 0x0A583264, 0x0A586FF5,
+	0x0A58AD3A, 0x0A58F085, 0x0A592F97, 0x0A59B265, 0x0A5A5DD3, 0x0A5AADEE, 0x0A5AF266, 0x0A5B0728, 0x0A5B3031, 0x0A5BAADF,
+	0x0A5BD267, 0x0A5BEFA5, 0x0A5C126B, 0x0A5C4BA8, 0x0A5C7268, 0x0A5C880E, 0x0A5CD269, 0x0A5CE729, 0x0A5E484D, 0x0A5E726C,
+	0x0A5EB26D, 0x0A5F126E, 0x0A5F326F, 0x0A5F4A59, 0x0A5FC8F9, 0x0A5FF05C, 0x0A603066, 0x0A604E35, 0x0A60AFAF, 0x0A60D270,
+	0x0A611271, 0x0A61B273, 0x0A61F275, 0x0A621274, 0x0A62B276, 0x0A62C67B, 0x0A62EFEB, 0x0A6329BA, 0x0A635277, 0x0A63AC38,
+	0x0A640AE0, 0x0A6427E7, 0x0A647278, 0x0A654ED9, 0x0A65F279, 0x0A66327A, 0x0A66727B, 0x0A67127C, 0x0A672F03, 0x0A674826,
+	0x0A6765E3, 0x0A67EDFD, 0x0A68127D, 0x0A682A9C, 0x0A686BE7, 0x0A68B27F, 0x0A68D27E, 0x0A68EAE1, 0x0A6908DF, 0x0A693281,
+	0x0A694EBC, 0x0A69B282, 0x0A6A2EDA, 0x0A6A4C72, 0x0A6A6CAC, 0x0A6A87E6, 0x0A6AEE2C, 0x0A6B0CD0, 0x0A6B4E8E, 0x0A6B8FED,
+	0x0A6BD284, 0x0A6C0BE8, 0x0A6CC854, 0x0A6D3285, 0x0A6DD286, 0x0A6DE60B, 0x0A6E05F3, 0x0A6E276B, 0x0A6E6C66, 0x0A6E87B0,
+	0x0A6EB0D1, 0x0A6EF289, 0x0A6F0675, 0x0A6F7288, 0x0A6FE7E8, 0x0A70528A, 0x0A70906F, 0x0A72D28B, 0x0A731110, 0x0A7348FA,
+	0x0A73E8B4, 0x0A74128C, 0x0A74B28E, 0x0A74D28D, 0x0A750B7E, 0x0A752618, 0x0A75A63D, 0x0A75D28F, 0x0A761290, 0x0A7668B5,
+	0x0A76D291, 0x0A7767CE, 0x0A7849D1, 0x0A787292, 0x0A791014, 0x0A792973, 0x0A7947B9, 0x0A797086, 0x0A798C2F, 0x0A79AEBD,
+	0x0A79CA7B, 0x0A7A8AA6, 0x0A7ACA66, 0x0A7AEA73, 0x0A7B2AD6, 0x0A7B6EBE, 0x0A7BF295, 0x0A7C2622, 0x0A7C4C30, 0x0A7C68FB,
+	0x0A7C88C3, 0x0A7CA825, 0x0A7D1299, 0x0A7D2CC0, 0x0A7D4CBC, 0x0A7D67E9, 0x0A7D8AE2, 0x0A7DB29A, 0x0A7DD298, 0x0A7DE682,
+	0x0A7E0CA4, 0x0A7E2A36, 0x0A7E49EA, 0x0A7E6605, 0x0A7EC710, 0x0A7EE946, 0x0A7F09E9, 0x0A7F529B, 0x0A80329C, 0x0A8067A8,
+	0x0A8086E5, 0x0A810947, 0x0A8127A7, 0x0A814D5D, 0x0A816604, 0x0A818DEF, 0x0A81B03C, 0x0A81C900, 0x0A81F0D9, 0x0A820DA6,
+	0x0A8228FC, 0x0A83684E, 0x0A83B2A5, 0x0A83E821, 0x0A840FE9, 0x0A84CEDB, 0x0A8532A4, 0x0A85675C, 0x0A85929F, 0x0A85B2A0,
+	0x0A85D2A2, 0x0A86D2A3, 0x0A8707BA, 0x0A872B81, 0x0A876F6B, 0x0A8792A1, 0x0A87B29D, 0x0A87C8E1, 0x0A88129E, 0x0A885143,
+	0x0A88CFB0, 0x0A890D66, 0x0A8928E0, 0x0A894950, 0x0A89D2A6, 0x0A8A2E1B, 0x0A8BF2AA, 0x0A8D0A7C, 0x0A8D4A74, 0x0A8E12AD,
+	0x0A8E32AB, 0x0A8E7021, 0x0A8EB2A8, 0x0A8ED2B1, 0x0A8EF2AC, 0x0A8F72AF, 0x0A8F88C4, 0x0A8FB03D, 0x0A9012B0, 0x0A9092B2,
+	0x0A90D2B4, 0x0A9169AE, 0x0A919161, 0x0A91D2A9, 0x0A91F2A7, 0x0A9212B3, 0x0A9252AE, 0x0A9452B6, 0x0A9492C2, 0x0A94B2B8,
+	0x0A9512BC, 0x0A9572C0, 0x0A9592B9, 0x0A95F2DD, 0x0A9649A7, 0x0A9666D0, 0x0A9712B7, 0x0A9792C4, 0x0A97A5F4, 0x0A97D2C3,
+	0x0A9805A3, 0x0A982F29, 0x0A9852C1, 0x0A9892BA, 0x0A98F2B5, 0x0A9912BB, 0x0A992986, 0x0A9B12C5, 0x0A9C25F5, 0x0A9C52CE,
+	0x0A9CB2C6, 0x0A9CD2C7, 0x0A9D0AE3, 0x0A9D3009, 0x0A9DB2CC, 0x0A9DD2CB, 0x0A9E4D8E, 0x0A9F52CD, 0x0A9FB2CA, 0x0AA08613,
+	0x0AA0C974, 0x0AA0EB4F, 0x0AA1F2C8, 0x0AA20DC2, 0x0AA292C9, 0x0AA2C5A0, 0x0AA5D2D3, 0x0AA5F082, 0x0AA62AE5, 0x0AA672D9,
+	0x0AA712D8, 0x0AA732CF, 0x0AA7CC81, 0x0AA812D0, 0x0AA88CAD, 0x0AA8B2D5, 0x0AA8CAE4, 0x0AA992D2, 0x0AA9F062, 0x0AAA685B,
+	0x0AAAD2D6, 0x0AAAF2D7, 0x0AAB92D4, 0x0AABB2DA, 0x0AAC72D1, 0x0AAF72E0, 0x0AAF92E5, 0x0AAFD2E1, 0x0AB012DC, 0x0AB072E6,
+	0x0AB08C10, 0x0AB0F2E8, 0x0AB12901, 0x0AB152DE, 0x0AB16D1D, 0x0AB312E2, 0x0AB332DB, 0x0AB3472B, 0x0AB3876C, 0x0AB3A705,
+	0x0AB3D2E3, 0x0AB3F2DF, 0x0AB4E896, 0x0AB512E9, 0x0AB532E7, 0x0AB54C32, 0x0AB567A9, 0x0AB587EA, 0x0AB5D2E4, 0x0AB60832,
+	0x0AB6C623, 0x0AB892ED, 0x0AB8B2EB, 0x0AB8F325, 0x0ABA92F0, 0x0ABB52EA, 0x0ABB92EE, 0x0ABBF2EC, 0x0ABC69EB, 0x0ABC92EF,
+	0x0ABEF2F2, 0x0ABF32F7, 0x0ABFB2F5, 0x0ABFD2F4, 0x0AC0CCD1, 0x0AC12683, 0x0AC292F1, 0x0AC2D2F3, 0x0AC2EAE6, 0x0AC30612,
+	0x0AC372F6, 0x0AC5269C, 0x0AC5F302, 0x0AC62B3A, 0x0AC652FD, 0x0AC692FB, 0x0AC6D2FC, 0x0AC712FE, 0x0AC8461C, 0x0AC98C18,
+	0x0AC9D2F8, 0x0ACA12F9, 0x0ACB671A, 0x0ACC9301, 0x0ACD076D, 0x0ACD5304, 0x0ACD7300, 0x0ACD9303, 0x0ACE8F6C, 0x0ACF0E13,
+	0x0ACF4EB6, 0x0AD01306, 0x0AD0D305, 0x0AD0E6E4, 0x0AD15307, 0x0AD1F30A, 0x0AD29309, 0x0AD41308, 0x0AD44E58, 0x0AD4B30B,
+	0x0AD5D30C, 0x0AD6930E, 0x0AD6D30D, 0x0AD79310, 0x0AD81313, 0x0AD83311, 0x0AD8530F, 0x0AD87312, 0x0AD91314, 0x0AD9D315,
+	0x0ADA3316, 0x0ADA7317, 0x0ADAF318, 0x0ADB1224, 0x0ADB4A7A, 0x0ADB69EC, 0x0ADBC6B1, 0x0ADC05F6, 0x0ADC6CE3, 0x0ADDD319,
+	0x0ADE0962, 0x0ADE45CD, 0x0ADE6B7D, 0x0ADF331A, 0x0ADF48C5, 0x0ADFA951, 0x0ADFF31C, 0x0AE0131B, 0x0AE06F9E, 0x0AE0931D,
+	0x0AE1131F, 0x0AE1331E, 0x0AE17320, 0x0AE1B321, 0x0AE1E897, 0x0AE24640, 0x0AE27322, 0x0AE2D324, 0x0AE31323, 0x0AE39326,
+	0x0AE3EDB9, 0x0AE4D327, 0x0AE4E5B3, 0x0AE5099D, 0x0AE5A85C, 0x0AE60CEE, 0x0AE6F328, 0x0AE71329, 0x0AE7732B, 0x0AE8132C,
+	0x0AE849A2, 0x0AE8E80F, 0x0AE94FD6, 0x0AE9D32A, 0x0AE9F32D, 0x0AEA097F, 0x0AEA2902, 0x0AEC3331, 0x0AEC8963, 0x0AECCCD2,
+	0x0AED332E, 0x0AED4D58, 0x0AEFF332, 0x0AF04B82, 0x0AF11330, 0x0AF13333, 0x0AF1685E, 0x0AF27334, 0x0AF41335, 0x0AF44903,
+	0x0AF466DF, 0x0AF49337, 0x0AF55338, 0x0AF61339, 0x0AF67336, 0x0AF8132F, 0x0AF8733A, 0x0AF8D33B, 0x0AF97004, 0x0AF9CB29,
+	0x0AFA533D, 0x0AFA733E, 0x0AFA933C, 0x0AFAD340, 0x0AFB8E57, 0x0AFBE5E6, 0x0AFC0F35, 0x0AFC7341, 0x0AFE8B3B, 0x0AFEEA37,
+	0x0AFF2E7C, 0x0AFF476E, 0x0AFF89A9, 0x0B000FF8, 0x0B004DF0, 0x0B00A898, 0x0B00CC8D, 0x0B01533F, 0x0B017342, 0x0B02AC82,
+	0x0B033343, 0x0B03B344, 0x0B043346, 0x0B048D67, 0x0B05472C, 0x0B05FF1F, 0x0B060641, 0x0B062FB1, 0x0B068B2A, 0x0B06ADA7,
+	0x0B0749A4, 0x0B07B34C, 0x0B080F7B, 0x0B08311B, 0x0B0946B2, 0x0B097348, 0x0B0A2C19, 0x0B0A534B, 0x0B0A8DC3, 0x0B0AEDA8,
+	0x0B0B0DC4, 0x0B0B2EB7, 0x0B0B4D4B, 0x0B0BC987, 0x0B0C5347, 0x0B0D2656, 0x0B0D6D95, 0x0B0E1349, 0x0B0E5345, 0x0B0EAB6F,
+	0x0B0F334D, 0x0B0FCAAD, 0x0B1067EB, 0x0B10B34E, 0x0B126FA6, 0x0B12EC5D, 0x0B138D44, 0x0B13F350, 0x0B150FEE, 0x0B157351,
+	0x0B15D356, 0x0B166F6D, 0x0B171355, 0x0B17334F, 0x0B175352, 0x0B177354, 0x0B17C964, 0x0B182F87, 0x0B18B357, 0x0B18ECE4,
+	0x0B1946B3, 0x0B198B2B, 0x0B1A3359, 0x0B1A7358, 0x0B1AA948, 0x0B1AF35A, 0x0B1B135C, 0x0B1B335B, 0x0B1B935E, 0x0B1BD353,
+	0x0B1BF360, 0x0B1C935F, 0x0B1CB35D, 0x0B1D69ED, 0x0B1D8B70, 0x0B1DCC33, 0x0B1DF361, 0x0B1E0BBA, 0x0B1E25EB, 0x0B1E4E84,
+	0x0B1EED59, 0x0B1F3363, 0x0B1F5362, 0x0B1F7364, 0x0B1F9365, 0x0B1FB366, 0x0B205367, 0x0B212F8F, 0x0B215368, 0x0B21E684,
+	0x0B221369, 0x0B22B09B, 0x0B22C6CF, 0x0B231287, 0x0B232AA7, 0x0B234C7D, 0x0B23736A, 0x0B239069, 0x0B245032, 0x0B24B36C,
+	0x0B24ECA5, 0x0B252D96, 0x0B254C7E, 0x0B256F36, 0x0B25936D, 0x0B25B36E, 0x0B25C65B, 0x0B262A38, 0x0B26536F, 0x0B26E5CE,
+	0x0B271370, 0x0B27D371, 0x0B288642, 0x0B28E76F, 0x0B290E1E, 0x0B292FB2, 0x0B29D375, 0x0B29EC34, 0x0B2A1374, 0x0B2A285F,
+	0x0B2A8FFA, 0x0B2AB373, 0x0B2AEDC5, 0x0B2B1377, 0x0B2B5376, 0x0B2C1379, 0x0B2C5378, 0x0B2CA65C, 0x0B2CF37A, 0x0B2D0AE7,
+	0x0B2D337C, 0x0B2D4CC4, 0x0B2D937B, 0x0B2DCF71, 0x0B2E6AD7, 0x0B2E8DBA, 0x0B2F1380, 0x0B2FA904, 0x0B303381, 0x0B304E40,
+	0x0B306EDC, 0x0B30904F, 0x0B314E44, 0x0B31B38A, 0x0B326797, 0x0B32D0A4, 0x0B33302D, 0x0B3373EA, 0x0B33B382, 0x0B347385,
+	0x0B34AC83, 0x0B350FD7, 0x0B358DA9, 0x0B365386, 0x0B373005, 0x0B376988, 0x0B37CAE8, 0x0B38D387, 0x0B3929EF, 0x0B3969EE,
+	0x0B3A05B7, 0x0B3A28C6, 0x0B3A6BA9, 0x0B3A85CF, 0x0B3B338B, 0x0B3B538C, 0x0B3B9389, 0x0B3CA617, 0x0B3CC72D, 0x0B3D1388,
+	0x0B3D5043, 0x0B3D6F10, 0x0B3EC5A6, 0x0B3F65F7, 0x0B3FE9F0, 0x0B4025D0, 0x0B4065A1, 0x0B413391, 0x0B42338F, 0x0B43103A,
+	0x0B435392, 0x0B439390, 0x0B43F38E, 0x0B440B50, 0x0B44B38D, 0x0B452F98, 0x0B45E8E2, 0x0B46B396, 0x0B46D397, 0x0B478AE9,
+	0x0B481393, 0x0B48314B, 0x0B48CE6B, 0x0B493395, 0x0B4B4965, 0x0B4C5398, 0x0B4CCF37, 0x0B4D5399, 0x0B4D9394, 0x0B4FF039,
+	0x0B524E7D, 0x0B53539A, 0x0B536F11, 0x0B57939B, 0x0B57B39F, 0x0B57D39C, 0x0B582685, 0x0B58539E, 0x0B592A39, 0x0B59739D,
+	0x0B598899, 0x0B5A13AB, 0x0B5AD3A4, 0x0B5AF3A1, 0x0B5C2D04, 0x0B5C73A0, 0x0B5CD3A2, 0x0B5D33A3, 0x0B5F53A5, 0x0B5F73A6,
+	0x0B612770, 0x0B6173A8, 0x0B6193A7, 0x0B62D3A9, 0x0B644B2C, 0x0B6553AC, 0x0B658D5A, 0x0B660624, 0x0B6653AA, 0x0B66D3AD,
+	0x0B67D3AE, 0x0B6813B1, 0x0B6873AF, 0x0B68B3B0, 0x0B6A09F1, 0x0B6A33B2, 0x0B6A8905, 0x0B6AB3B3, 0x0B6AEA1A, 0x0B6B0C76,
+	0x0B6B53B4, 0x0B6B73B5, 0x0B6B89F9, 0x0B6BA906, 0x0B6BF050, 0x0B6C6787, 0x0B6C88C7, 0x0B6CB3B6, 0x0B6CC6F7, 0x0B6D33B7,
+	0x0B6D6C77, 0x0B6E13B8, 0x0B6E33E1, 0x0B6E73B9, 0x0B6EB3BA, 0x0B6F13BB, 0x0B6F53BD, 0x0B7013BE, 0x0B7073C0, 0x0B70ACAE,
+	0x0B70E606, 0x0B710A67, 0x0B7125C0, 0x0B716C36, 0x0B71872E, 0x0B71AA33, 0x0B71E907, 0x0B72ADC6, 0x0B72EA80, 0x0B73072F,
+	0x0B732D08, 0x0B734D68, 0x0B7365B6, 0x0B738798, 0x0B73AFB3, 0x0B73EA40, 0x0B7447B1, 0x0B746BE9, 0x0B748A3A, 0x0B74B087,
+	0x0B74D3C1, 0x0B75C7BB, 0x0B760989, 0x0B7666D1, 0x0B768643, 0x0B76AAEA, 0x0B76C686, 0x0B7713C2, 0x0B7730A5, 0x0B77EAA8,
+	0x0B784A62, 0x0B7873C3, 0x0B788771, 0x0B78AE10, 0x0B78D027, 0x0B78F3C4, 0x0B7933C5, 0x0B798F38, 0x0B7A13C7, 0x0B7A4726,
+	0x0B7A6835, 0x0B7A93C6, 0x0B7B6730, 0x0B7BAB51, 0x0B7BD3CB, 0x0B7BE9C0, 0x0B7C2687, 0x0B7C53CA, 0x0B7C93C8, 0x0B7CB3CC,
+	0x0B7CD3C9, 0x0B7CEE4A, 0x0B7D164B, 0x0B7D2B52, 0x0B7D73CD, 0x0B7DD0FE, 0x0B7E13CE, 0x0B7E73D0, 0x0B7EAD1E, 0x0B7ED3CF,
+	0x0B7F0BA1, 0x0B7F4A1B, 0x0B7FCC8E, 0x0B7FEA75, 0x0B802F55, 0x0B804BEA, 0x0B808A4B, 0x0B80B3D1, 0x0B80CAEB, 0x0B80F3D2,
+	0x0B8113D3, 0x0B8125D1, 0x0B814C78, 0x0B816B71, 0x0B81B3D4, 0x0B81CDF1, 0x0B81EAEC, 0x0B822AED, 0x0B8273D5, 0x0B82CBEB,
+	0x0B834AEE, 0x0B8413D6, 0x0B8453D7, 0x0B84905E, 0x0B8513D8, 0x0B85A804, 0x0B862A81, 0x0B8713D9, 0x0B8733DA, 0x0B874A5A,
+	0x0B876B4B, 0x0B878E32, 0x0B87AB73, 0x0B87CEF6, 0x0B87EE41, 0x0B880807, 0x0B8833DB, 0x0B88A7CF, 0x0B88D3DC, 0x0B89083C,
+	0x0B894E0D, 0x0B89666E, 0x0B89A9F2, 0x0B89D3DD, 0x0B89F3E0, 0x0B8A13DF, 0x0B8A283B, 0x0B8A73DE, 0x0B8AAD97, 0x0B8BCC6E,
+	0x0B8C0DAA, 0x0B8C2A46, 0x0B8C8C37, 0x0B8CB0DA, 0x0B8D93E2, 0x0B8DD3E3, 0x0B8DEE14, 0x0B8E29D2, 0x0B8ED3E5, 0x0B8F33E6,
+	0x0B9193E7, 0x0B920772, 0x0B9233E8, 0x0B9293E9, 0x0B94266A, 0x0B950C1A, 0x0B952762, 0x0B9573EB, 0x0B959026, 0x0B962C90,
+	0x0B9666F8, 0x0B96D3ED, 0x0B96F3EF, 0x0B97075D, 0x0B9773EC, 0x0B9793EE, 0x0B97D3F1, 0x0B98B3F0, 0x0B98F3F2, 0x0B9B33F3,
+	0x0B9C0DFB, 0x0B9C27EC, 0x0B9D06A3, 0x0B9D33F4, 0x0B9D53F9, 0x0B9DB3F7, 0x0B9DEFB5, 0x0B9E0FB4, 0x0B9ECDC7, 0x0B9F53F6,
+	0x0B9F6AB3, 0x0B9FB3F5, 0x0BA0EB92, 0x0BA173FA, 0x0BA1C9A8, 0x0BA23400, 0x0BA29401, 0x0BA2B3FB, 0x0BA2C6D2, 0x0BA2F3FC,
+	0x0BA31405, 0x0BA33404, 0x0BA35403, 0x0BA373FF, 0x0BA3F3FE, 0x0BA45402, 0x0BA52FB6, 0x0BA97409, 0x0BA99406, 0x0BA9D408,
+	0x0BAA10D2, 0x0BAA5407, 0x0BAB93FD, 0x0BAD2B93, 0x0BAD940A, 0x0BADE975, 0x0BAE740B, 0x0BAED40C, 0x0BB0540F, 0x0BB0940E,
+	0x0BB0F40D, 0x0BB16DC8, 0x0BB193F8, 0x0BB21415, 0x0BB3B411, 0x0BB45410, 0x0BB59412, 0x0BB5D413, 0x0BB6F416, 0x0BB75124,
+	0x0BB79417, 0x0BB7B414, 0x0BB93418, 0x0BB9875E, 0x0BB9B419, 0x0BBA541B, 0x0BBA741A, 0x0BBAD41C, 0x0BBB741D, 0x0BBBABEC,
+	0x0BBBCA82, 0x0BBC2AC4, 0x0BBC6C43, 0x0BBCA908, 0x0BBCC976, 0x0BBCE909, 0x0BBD07D0, 0x0BBD741E, 0x0BBDC977, 0x0BBE28C8,
+	0x0BBE541F, 0x0BBE7024, 0x0BBE8E62, 0x0BBEB420, 0x0BBEE90A, 0x0BBF672A, 0x0BBFACC6, 0x0BBFC810, 0x0BC049F3, 0x0BC06F3A,
+	0x0BC0CEBF, 0x0BC17421, 0x0BC18773, 0x0BC23424, 0x0BC2CD1F, 0x0BC33423, 0x0BC35422, 0x0BC37425, 0x0BC3AD69, 0x0BC4AB83,
+	0x0BC569F4, 0x0BC5ABC8, 0x0BC5EC91, 0x0BC60781, 0x0BC66D20, 0x0BC6D426, 0x0BC6F427, 0x0BC70B2D, 0x0BC7AFD8, 0x0BC8142A,
+	0x0BC87429, 0x0BC89428, 0x0BC8AF5D, 0x0BC8F431, 0x0BC98FF9, 0x0BC9D42B, 0x0BCA942D, 0x0BCAB00B, 0x0BCAF42C, 0x0BCBF42E,
+	0x0BCC2EA6, 0x0BCC542F, 0x0BCC6F7C, 0x0BCC9430, 0x0BCE4731, 0x0BCE6F7D, 0x0BCE8E4E, 0x0BCEB432, 0x0BCED433, 0x0BCF090B,
+	0x0BCF2732, 0x0BCF5434, 0x0BCF68B6, 0x0BCF90A3, 0x0BCFB088, 0x0BCFC774, 0x0BCFF436, 0x0BD02D21, 0x0BD0690C, 0x0BD08AEF,
+	0x0BD0EEDD, 0x0BD14AF0, 0x0BD1EAD8, 0x0BD2AD6A, 0x0BD2CFB7, 0x0BD2ED98, 0x0BD3490D, 0x0BD38F3B, 0x0BD41437, 0x0BD4CDB8,
+	0x0BD4E980, 0x0BD568C9, 0x0BD5AD6B, 0x0BD6A5C1, 0x0BD6CACE, 0x0BD6E90E, 0x0BD710A6, 0x0BD83438, 0x0BD85439, 0x0BD86E70,
+	0x0BD9143A, 0x0BD93135, 0x0BD9514C, 0x0BD9F43C, 0x0BDA143B, 0x0BDA66E6, 0x0BDAD440, 0x0BDB5443, 0x0BDB7444, 0x0BDBB442,
+	0x0BDBEF1F, 0x0BDC0AF1, 0x0BDC3446, 0x0BDC5445, 0x0BDC7441, 0x0BDD1447, 0x0BDD3448, 0x0BDD9449, 0x0BDE144C, 0x0BDE344A,
+	0x0BDE744B, 0x0BDE944D, 0x0BDEC644, 0x0BDEED6C, 0x0BDF144E, 0x0BDF489A, 0x0BDF66B4, 0x0BDF8E55, 0x0BDFD44F, 0x0BDFEE39,
+	0x0BE02F99, 0x0BE07450, 0x0BE0914D, 0x0BE13451, 0x0BE14F7E, 0x0BE17454, 0x0BE1919F, 0x0BE1B1AF, 0x0BE1EA2E, 0x0BE20E33,
+	0x0BE23455, 0x0BE267BC, 0x0BE28D22, 0x0BE2A5F8, 0x0BE2D456, 0x0BE2EF64, 0x0BE3090F, 0x0BE36CEF, 0x0BE3ED6D, 0x0BE4B06D,
+	0x0BE4C8B7, 0x0BE4E8CA, 0x0BE53457, 0x0BE5B458, 0x0BE5F45E, 0x0BE62A63, 0x0BE6AD23, 0x0BE6E7ED, 0x0BE71459, 0x0BE78F0A,
+	0x0BE7CCE5, 0x0BE8345A, 0x0BE9145B, 0x0BE947EE, 0x0BE9945C, 0x0BE9D45D, 0x0BEA345F, 0x0BEA6DD6, 0x0BEAD460, 0x0BEAF461,
+	0x0BEB3462, 0x0BEB9453, 0x0BEBB452, 0x0BEC3463, 0x0BEC4860, 0x0BECCF06, 0x0BED298A, 0x0BED4F16, 0x0BED6D24, 0x0BED8F2A,
+	0x0BEDB464, 0x0BEE0AF2, 0x0BEE2625, 0x0BEE7465, 0x0BEEF466, 0x0BEF3070, 0x0BEF8EDE, 0x0BEFF469, 0x0BF0065D, 0x0BF02BAA,
+	0x0BF05468, 0x0BF07467, 0x0BF08861, 0x0BF0AC92, 0x0BF0F46D, 0x0BF1146B, 0x0BF1546A, 0x0BF170E5, 0x0BF188E3, 0x0BF20AD9,
+	0x0BF2346C, 0x0BF24DAB, 0x0BF26A9D, 0x0BF2EDFE, 0x0BF31470, 0x0BF3346F, 0x0BF3D46E, 0x0BF41471, 0x0BF428E4, 0x0BF51472,
+	0x0BF52F5C, 0x0BF54ABA, 0x0BF5B473, 0x0BF5CEF7, 0x0BF66DFF, 0x0BF68D25, 0x0BF72D8F, 0x0BF79474, 0x0BF7A78A, 0x0BF86B53,
+	0x0BF8AF0B, 0x0BF98775, 0x0BF9AE45, 0x0BFAD475, 0x0BFAE9F5, 0x0BFB0FD9, 0x0BFB2FDA, 0x0BFB865E, 0x0BFBB47A, 0x0BFC0D09,
+	0x0BFC9477, 0x0BFD66B5, 0x0BFE14AB, 0x0BFE3479, 0x0BFEAE4F, 0x0BFF1478, 0x0BFF7476, 0x0BFFA95A, 0x0BFFF47C, 0x0C01D483,
+	0x0C01F489, 0x0C021481, 0x0C024DBB, 0x0C02B486, 0x0C02CF3C, 0x0C033480, 0x0C037485, 0x0C039125, 0x0C03A9F6, 0x0C040C93,
+	0x0C04347D, 0x0C04A7BD, 0x0C04D488, 0x0C04EBAB, 0x0C050645, 0x0C053482, 0x0C0546B6, 0x0C057487, 0x0C05E7EF, 0x0C063484,
+	0x0C07548A, 0x0C08348C, 0x0C085496, 0x0C087494, 0x0C08D491, 0x0C095490, 0x0C097136, 0x0C09B492, 0x0C0A07F0, 0x0C0A4910,
+	0x0C0AAADA, 0x0C0B3499, 0x0C0B548B, 0x0C0BF48F, 0x0C0C147E, 0x0C0C46B8, 0x0C0C7493, 0x0C0C9495, 0x0C0CACF0, 0x0C0D0966,
+	0x0C0D2676, 0x0C0D548D, 0x0C0D7498, 0x0C0D9497, 0x0C0DA7F1, 0x0C0DEC67, 0x0C0E0706, 0x0C0EA862, 0x0C0EF48E, 0x0C10349A,
+	0x0C10749D, 0x0C10949F, 0x0C112A3B, 0x0C1174A5, 0x0C118D6E, 0x0C11B49B, 0x0C1254A3, 0x0C1286B7, 0x0C12D4A1, 0x0C12F4A2,
+	0x0C13549E, 0x0C1374A0, 0x0C13E8E5, 0x0C141089, 0x0C146733, 0x0C14C638, 0x0C14F4A4, 0x0C152E59, 0x0C1545AB, 0x0C164EDF,
+	0x0C16747B, 0x0C1694AA, 0x0C16B4AE, 0x0C16D063, 0x0C1714A7, 0x0C178DC9, 0x0C17B4AC, 0x0C18AB2E, 0x0C18D4AD, 0x0C18EE15,
+	0x0C1A3166, 0x0C1A74A9, 0x0C1B14AF, 0x0C1B495B, 0x0C1B8BC9, 0x0C1BE5D2, 0x0C1C14A8, 0x0C1C34A6, 0x0C1C6C39, 0x0C1CF49C,
+	0x0C1D09D3, 0x0C1E0C84, 0x0C1E34BB, 0x0C1E6C3A, 0x0C1E94B6, 0x0C1ED4B3, 0x0C1EF4B4, 0x0C1F2A64, 0x0C1F54B7, 0x0C1F74BA,
+	0x0C2014B5, 0x0C202A84, 0x0C2074B8, 0x0C20D4B2, 0x0C21107A, 0x0C213079, 0x0C21B4BC, 0x0C21D4BD, 0x0C21E5D3, 0x0C22B4B1,
+	0x0C234830, 0x0C2365A4, 0x0C23E734, 0x0C2434B9, 0x0C24F4C1, 0x0C2514C0, 0x0C2594C5, 0x0C2694C6, 0x0C2794C4, 0x0C27B4C7,
+	0x0C27D4BF, 0x0C27F4C3, 0x0C2854C8, 0x0C2894C9, 0x0C28F4BE, 0x0C290A1C, 0x0C2954C2, 0x0C296C94, 0x0C298911, 0x0C29B4B0,
+	0x0C29CB54, 0x0C2A74D6, 0x0C2AAFA7, 0x0C2B14CC, 0x0C2B34CD, 0x0C2B54CE, 0x0C2BB4D5, 0x0C2BF4D4, 0x0C2C501D, 0x0C2C6735,
+	0x0C2CB4D2, 0x0C2CE864, 0x0C2D06D3, 0x0C2D74CF, 0x0C2DD0F6, 0x0C2DF4D1, 0x0C2E05D4, 0x0C2E34D3, 0x0C2E74CA, 0x0C2E94D0,
+	0x0C2EB4D7, 0x0C2EC863, 0x0C2EF4CB, 0x0C2FD0BC, 0x0C30508A, 0x0C30F4DA, 0x0C3154DE, 0x0C31CC5E, 0x0C321137, 0x0C3234DF,
+	0x0C3294DC, 0x0C32D4D9, 0x0C3334D8, 0x0C3354DD, 0x0C348F6E, 0x0C34EDF2, 0x0C352865, 0x0C3574E0, 0x0C3594DB, 0x0C35D4E1,
+	0x0C36489B, 0x0C36C66F, 0x0C3754E9, 0x0C37C736, 0x0C3874E7, 0x0C38D4E8, 0x0C38E967, 0x0C3914E6, 0x0C3934E4, 0x0C3954E3,
+	0x0C3974EA, 0x0C3994E2, 0x0C39B4EC, 0x0C3A06B9, 0x0C3C74EE, 0x0C3CD4ED, 0x0C3E4D26, 0x0C3E94F1, 0x0C3ED4EF, 0x0C3EF4E5,
+	0x0C3F089C, 0x0C3F54F0, 0x0C3F94F4, 0x0C3FB4F3, 0x0C3FD4F5, 0x0C3FF4F2, 0x0C4014F6, 0x0C4114F7, 0x0C4134F8, 0x0C414FA8,
+	0x0C4194FA, 0x0C41B4F9, 0x0C41CA9E, 0x0C420BAC, 0x0C4226A4, 0x0C4246BA, 0x0C4294FB, 0x0C42C5BD, 0x0C434BCA, 0x0C4374FC,
+	0x0C43BC41, 0x0C43D500, 0x0C43E881, 0x0C443501, 0x0C44CBED, 0x0C455502, 0x0C45D503, 0x0C45E799, 0x0C461504, 0x0C465505,
+	0x0C467506, 0x0C468C95, 0x0C4708CB, 0x0C47705F, 0x0C47EFDB, 0x0C480ACA, 0x0C483507, 0x0C48EBEE, 0x0C491CFB, 0x0C492EE0,
+	0x0C496A68, 0x0C49A98B, 0x0C49D508, 0x0C4A6C85, 0x0C4AAF65, 0x0C4B0CAF, 0x0C4B750B, 0x0C4BD509, 0x0C4C150C, 0x0C4C750A,
+	0x0C4D150D, 0x0C4DCF6F, 0x0C4E25B5, 0x0C4ECF3D, 0x0C4F2EE1, 0x0C4F950E, 0x0C4FD511, 0x0C4FEAF3, 0x0C50079A, 0x0C50550F,
+	0x0C507516, 0x0C508AF4, 0x0C513510, 0x0C514E63, 0x0C5230BD, 0x0C525512, 0x0C527513, 0x0C529517, 0x0C52ADCA, 0x0C52D514,
+	0x0C52E912, 0x0C530BDC, 0x0C537525, 0x0C538EB2, 0x0C53CCB0, 0x0C556EE2, 0x0C55956B, 0x0C562FB8, 0x0C56AD6F, 0x0C573015,
+	0x0C57751A, 0x0C57865F, 0x0C57AD0A, 0x0C585523, 0x0C58ACD3, 0x0C58D51D, 0x0C58F524, 0x0C59151F, 0x0C593526, 0x0C595522,
+	0x0C599521, 0x0C59AE8F, 0x0C59F51B, 0x0C5A06BB, 0x0C5A3519, 0x0C5A47D1, 0x0C5A6CB1, 0x0C5A9515, 0x0C5AF518, 0x0C5B0913,
+	0x0C5B2BD9, 0x0C5B6AF5, 0x0C5B9520, 0x0C5BAE71, 0x0C5C07D2, 0x0C5C26E7, 0x0C5D8707, 0x0C5DAB40, 0x0C5DD528, 0x0C5DF52D,
+	0x0C5E3529, 0x0C5E689D, 0x0C5EB52E, 0x0C5EC9C1, 0x0C5EE949, 0x0C5FCA85, 0x0C5FF51C, 0x0C602A1D, 0x0C60552B, 0x0C60E9F7,
+	0x0C61152C, 0x0C6125C2, 0x0C619527, 0x0C622D27, 0x0C6327D3, 0x0C63E7F2, 0x0C64F52A, 0x0C6505A5, 0x0C656981, 0x0C65EB55,
+	0x0C674D70, 0x0C67AED2, 0x0C67D530, 0x0C67EC3D, 0x0C692C68, 0x0C6989CA, 0x0C69B531, 0x0C69F533, 0x0C6A152F, 0x0C6AAF9F,
+	0x0C6AED3B, 0x0C6B8C3B, 0x0C6CEFB9, 0x0C6D0A4C, 0x0C6D3540, 0x0C6D753E, 0x0C6DCB98, 0x0C6E489E, 0x0C6ED538, 0x0C6EEAF7,
+	0x0C6F4E26, 0x0C6F6E50, 0x0C701536, 0x0C706C3C, 0x0C710A76, 0x0C71353B, 0x0C718AF6, 0x0C71D535, 0x0C71F53A, 0x0C724E72,
+	0x0C72D534, 0x0C730840, 0x0C7366FC, 0x0C73F53C, 0x0C7410E9, 0x0C74298C, 0x0C744CD4, 0x0C747539, 0x0C74ABDA, 0x0C74E914,
+	0x0C750B84, 0x0C752646, 0x0C754C1B, 0x0C757537, 0x0C7587A4, 0x0C764866, 0x0C768D4D, 0x0C76B53D, 0x0C776C3E, 0x0C77D541,
+	0x0C781543, 0x0C786C75, 0x0C789549, 0x0C78D544, 0x0C793546, 0x0C79EF20, 0x0C7A0D71, 0x0C7A5547, 0x0C7AD08B, 0x0C7B50A7,
+	0x0C7B6737, 0x0C7C25AC, 0x0C7C7545, 0x0C7D3542, 0x0C7DC776, 0x0C7E8647, 0x0C7ED548, 0x0C7F50A8, 0x0C80D54C, 0x0C81AC79,
+	0x0C81F553, 0x0C82754D, 0x0C82D54A, 0x0C82F551, 0x0C839532, 0x0C84D54E, 0x0C851552, 0x0C858EC0, 0x0C85ADCB, 0x0C86954B,
+	0x0C86D54F, 0x0C874867, 0x0C87C9AF, 0x0C884BDB, 0x0C89D557, 0x0C8B0D85, 0x0C8CF554, 0x0C8D3000, 0x0C8DF555, 0x0C8ED556,
+	0x0C8F104C, 0x0C8F4BA0, 0x0C906882, 0x0C91155D, 0x0C9249D4, 0x0C92755A, 0x0C92B559, 0x0C934E51, 0x0C93CDF3, 0x0C948D90,
+	0x0C94B55B, 0x0C95355C, 0x0C956F4F, 0x0C95AE64, 0x0C95C9C2, 0x0C960BEF, 0x0C964FEF, 0x0C9726E8, 0x0C977563, 0x0C97955E,
+	0x0C9830A9, 0x0C985565, 0x0C98B561, 0x0C98F562, 0x0C99AC40, 0x0C9A5560, 0x0C9A951E, 0x0C9B1564, 0x0C9B555F, 0x0C9C1569,
+	0x0C9C356A, 0x0C9C4D86, 0x0C9C756C, 0x0C9CC9C3, 0x0C9CF567, 0x0C9D879B, 0x0C9DF56D, 0x0C9E3566, 0x0C9E5571, 0x0C9E9570,
+	0x0C9ED56F, 0x0C9F5572, 0x0C9FB574, 0x0C9FCB2F, 0x0CA01573, 0x0CA0B577, 0x0CA31575, 0x0CA39576, 0x0CA3B550, 0x0CA47579,
+	0x0CA49578, 0x0CA55558, 0x0CA5757A, 0x0CA5956E, 0x0CA5E9F8, 0x0CA6957B, 0x0CA6B57C, 0x0CA6D57E, 0x0CA6F57D, 0x0CA7157F,
+	0x0CA726BC, 0x0CA76915, 0x0CA7CFBA, 0x0CA7EBAD, 0x0CA8A8CC, 0x0CA91581, 0x0CA9B584, 0x0CA9EF31, 0x0CAA27BE, 0x0CAAB583,
+	0x0CAAD582, 0x0CAAEE73, 0x0CAB1585, 0x0CAB27F3, 0x0CABB587, 0x0CABD586, 0x0CAC4738, 0x0CAC69D5, 0x0CACCE16, 0x0CAD8868,
+	0x0CAE0B94, 0x0CAE5588, 0x0CAE8BAE, 0x0CAEAD87, 0x0CAEEF3E, 0x0CAF1589, 0x0CB0558A, 0x0CB0758B, 0x0CB0EF76, 0x0CB113BC,
+	0x0CB12BC4, 0x0CB18F2B, 0x0CB1C996, 0x0CB20EE3, 0x0CB22EC1, 0x0CB2EDAC, 0x0CB330FF, 0x0CB3758D, 0x0CB38A4E, 0x0CB3F58E,
+	0x0CB425B4, 0x0CB48812, 0x0CB4ABCB, 0x0CB4EF40, 0x0CB5758F, 0x0CB589E1, 0x0CB5ACE6, 0x0CB5E9FA, 0x0CB60B56, 0x0CB6F590,
+	0x0CB72FBB, 0x0CB78657, 0x0CB7A9FB, 0x0CB83593, 0x0CB87591, 0x0CB89594, 0x0CB8B0F7, 0x0CB8D592, 0x0CB96BF9, 0x0CB99595,
+	0x0CB9EC70, 0x0CBA5596, 0x0CBAE778, 0x0CBB3598, 0x0CBB7597, 0x0CBC1599, 0x0CBC359A, 0x0CBC4779, 0x0CBCAE3A, 0x0CBCCCD5,
+	0x0CBCE7CC, 0x0CBD09FC, 0x0CBD2C41, 0x0CBD8ABB, 0x0CBDA5AE, 0x0CBE359B, 0x0CBF4660, 0x0CBF759F, 0x0CC04916, 0x0CC0759E,
+	0x0CC0C969, 0x0CC0EAF8, 0x0CC1559D, 0x0CC18AF9, 0x0CC1D03E, 0x0CC1E968, 0x0CC265D5, 0x0CC28BCC, 0x0CC395A4, 0x0CC3EBAF,
+	0x0CC40626, 0x0CC4AAB4, 0x0CC4F006, 0x0CC509B0, 0x0CC5AAFA, 0x0CC5EBA5, 0x0CC695A3, 0x0CC6B5A1, 0x0CC6D5A2, 0x0CC78D0B,
+	0x0CC7F5C5, 0x0CC835A8, 0x0CC84A1E, 0x0CC86917, 0x0CC895A6, 0x0CC935A7, 0x0CC96B57, 0x0CC9F5A5, 0x0CCA49CE, 0x0CCBB5AA,
+	0x0CCBD5A9, 0x0CCBF5AE, 0x0CCC55AF, 0x0CCC95AB, 0x0CCCC6C1, 0x0CCCF5AC, 0x0CCD15AD, 0x0CCD2ED3, 0x0CCDCF41, 0x0CCDE869,
+	0x0CCE15B0, 0x0CCE8BB0, 0x0CCECAFB, 0x0CCF4CF1, 0x0CD02805, 0x0CD075B1, 0x0CD095B5, 0x0CD0E689, 0x0CD115B2, 0x0CD135B4,
+	0x0CD1D5B3, 0x0CD22ACB, 0x0CD2CCE7, 0x0CD2E5C3, 0x0CD315B6, 0x0CD3B5B7, 0x0CD44D28, 0x0CD4D12F, 0x0CD569E2, 0x0CD5CFA9,
+	0x0CD68FDC, 0x0CD715C1, 0x0CD735B9, 0x0CD795BC, 0x0CD7D5BB, 0x0CD835B8, 0x0CD895C0, 0x0CD8EE1C, 0x0CD935BA, 0x0CDAD5C2,
+	0x0CDB2ACC, 0x0CDB55C3, 0x0CDB90AA, 0x0CDBAE98, 0x0CDC15C4, 0x0CDCD5C6, 0x0CDD35C7, 0x0CDE15C8, 0x0CDE4808, 0x0CDE6627,
+	0x0CDE8918, 0x0CDEB5C9, 0x0CDEF5CA, 0x0CDF0AD1, 0x0CDF2C42, 0x0CDF9296, 0x0CDFAC1D, 0x0CDFCC1C, 0x0CDFEC96, 0x0CE00985,
+	0x0CE071F0, 0x0CE1088E, 0x0CE1308C, 0x0CE16FBC, 0x0CE1AF5E, 0x0CE1F5CB, 0x0CE289B1, 0x0CE2AD3D, 0x0CE2D5CC, 0x0CE2F14E,
+	0x0CE36FDD, 0x0CE3AD29, 0x0CE3D5CD, 0x0CE3E77A, 0x0CE4D5CE, 0x0CE4F5CF, 0x0CE51058, 0x0CE55022, 0x0CE57016, 0x0CE58FFB,
+	0x0CE5A9C4, 0x0CE5D5D1, 0x0CE62A69, 0x0CE68FF0, 0x0CE6D5D3, 0x0CE6F5D6, 0x0CE715D5, 0x0CE74777, 0x0CE7A7C0, 0x0CE7F5D2,
+	0x0CE835D4, 0x0CE8D5D7, 0x0CE92B99, 0x0CE9D0DB, 0x0CE9E5C7, 0x0CEA099E, 0x0CEA2C7A, 0x0CEA6A5B, 0x0CEACB31, 0x0CEB35DA,
+	0x0CEB8DAD, 0x0CEBD5D8, 0x0CEBEC69, 0x0CEC15D9, 0x0CEC2B30, 0x0CEC505B, 0x0CEC75DB, 0x0CEC95DC, 0x0CECB0C8, 0x0CED55E1,
+	0x0CEDA919, 0x0CEDEE74, 0x0CEE15DE, 0x0CEE2DCC, 0x0CEE559C, 0x0CEE75A0, 0x0CEEA7AE, 0x0CEEEE66, 0x0CEF95E0, 0x0CEFCAFC,
+	0x0CEFEEC2, 0x0CF0B5E6, 0x0CF0EEF8, 0x0CF135DD, 0x0CF175E3, 0x0CF195E2, 0x0CF20BCD, 0x0CF2B00D, 0x0CF2F111, 0x0CF35007,
+	0x0CF3868A, 0x0CF3A9FD, 0x0CF41167, 0x0CF435E5, 0x0CF44B95, 0x0CF4D5E4, 0x0CF535DF, 0x0CF5E8CD, 0x0CF675EB, 0x0CF695E9,
+	0x0CF6C68B, 0x0CF6F5E7, 0x0CF715ED, 0x0CF735F3, 0x0CF82C86, 0x0CF88F7F, 0x0CF8D5F5, 0x0CF94F01, 0x0CF9D5F4, 0x0CF9EE90,
+	0x0CFA0FDE, 0x0CFA2739, 0x0CFA6BF5, 0x0CFA8A9F, 0x0CFB0D51, 0x0CFB508D, 0x0CFBB5F0, 0x0CFBD5EF, 0x0CFC55F1, 0x0CFC95EE,
+	0x0CFCF5F6, 0x0CFD35EC, 0x0CFD95EA, 0x0CFDD5F2, 0x0CFDF5E8, 0x0CFE2D0C, 0x0CFE7076, 0x0CFE8A44, 0x0CFEA9B2, 0x0CFF6978,
+	0x0CFFD00F, 0x0CFFE6E0, 0x0D004D4C, 0x0D006E08, 0x0D008628, 0x0D026BF0, 0x0D02CBB2, 0x0D02E849, 0x0D03D5F8, 0x0D04291A,
+	0x0D04471C, 0x0D0535FA, 0x0D054714, 0x0D057601, 0x0D0655FD, 0x0D068BF1, 0x0D0706EA, 0x0D07296A, 0x0D0786E9, 0x0D07A98D,
+	0x0D0815FB, 0x0D082885, 0x0D08486A, 0x0D086DCD, 0x0D08D5F9, 0x0D0905C4, 0x0D09B5FC, 0x0D09D5FE, 0x0D0A080B, 0x0D0A284B,
+	0x0D0A673A, 0x0D0A87AA, 0x0D0B3602, 0x0D0B89B7, 0x0D0BB011, 0x0D0BE9D6, 0x0D0C7603, 0x0D0CEF0F, 0x0D0E960F, 0x0D0EC671,
+	0x0D0EF604, 0x0D0FD615, 0x0D0FF605, 0x0D103100, 0x0D10760C, 0x0D10AE7E, 0x0D11B614, 0x0D11F607, 0x0D1265B2, 0x0D129609,
+	0x0D12E91B, 0x0D13760B, 0x0D13B60A, 0x0D13F606, 0x0D141611, 0x0D144AFD, 0x0D14D36B, 0x0D14E8E6, 0x0D1510DC, 0x0D15B608,
+	0x0D15ED72, 0x0D1606C2, 0x0D16296B, 0x0D167600, 0x0D16B610, 0x0D16C701, 0x0D17360E, 0x0D175612, 0x0D178DCE, 0x0D18877C,
+	0x0D18D630, 0x0D193047, 0x0D195617, 0x0D19677B, 0x0D19B61E, 0x0D1A4FDF, 0x0D1A961F, 0x0D1AB621, 0x0D1AF625, 0x0D1B1619,
+	0x0D1B4CC9, 0x0D1BEDCF, 0x0D1C1629, 0x0D1C361C, 0x0D1C7626, 0x0D1CF620, 0x0D1DCB58, 0x0D1DF62A, 0x0D1E4BB1, 0x0D1F3628,
+	0x0D1F473B, 0x0D20116F, 0x0D203616, 0x0D209624, 0x0D20A5D6, 0x0D211618, 0x0D217038, 0x0D21961D, 0x0D21AB41, 0x0D21CD45,
+	0x0D21F613, 0x0D225623, 0x0D232B9A, 0x0D23562D, 0x0D236711, 0x0D23889F, 0x0D24362F, 0x0D24561A, 0x0D24762E, 0x0D24B627,
+	0x0D24D61B, 0x0D25162B, 0x0D25562C, 0x0D26163D, 0x0D268E0C, 0x0D26D622, 0x0D273639, 0x0D27B63B, 0x0D27ED56, 0x0D2950AB,
+	0x0D2A6F56, 0x0D2A9636, 0x0D2AAC88, 0x0D2B363C, 0x0D2B4C1E, 0x0D2B9633, 0x0D2BB640, 0x0D2BD63F, 0x0D2C0E2D, 0x0D2C363E,
+	0x0D2C4E28, 0x0D2D5642, 0x0D2D7635, 0x0D2DA806, 0x0D2DD638, 0x0D2DEABC, 0x0D2E6E80, 0x0D2E963A, 0x0D2EA809, 0x0D2EF632,
+	0x0D2F1634, 0x0D2F3631, 0x0D2F914F, 0x0D2FA6F9, 0x0D2FD637, 0x0D303641, 0x0D3046D4, 0x0D3149A5, 0x0D31C63C, 0x0D323652,
+	0x0D329150, 0x0D32B655, 0x0D336B59, 0x0D339654, 0x0D341653, 0x0D34F650, 0x0D35D644, 0x0D363661, 0x0D365643, 0x0D369656,
+	0x0D37764E, 0x0D37D649, 0x0D37F646, 0x0D383647, 0x0D38764F, 0x0D38FF20, 0x0D39564C, 0x0D39691C, 0x0D398D46, 0x0D39AC44,
+	0x0D39D64A, 0x0D3A1645, 0x0D3A7648, 0x0D3B10AC, 0x0D3B300A, 0x0D3BB64D, 0x0D3BD657, 0x0D3CF65F, 0x0D3D1658, 0x0D3D7665,
+	0x0D3DB663, 0x0D3E565E, 0x0D3F365D, 0x0D3F6D4E, 0x0D3FAC45, 0x0D3FF65B, 0x0D405659, 0x0D40B660, 0x0D415666, 0x0D416EF3,
+	0x0D41966C, 0x0D425667, 0x0D42766A, 0x0D429664, 0x0D42ED14, 0x0D432F17, 0x0D43765A, 0x0D43D662, 0x0D43EAFE, 0x0D44304D,
+	0x0D445676, 0x0D447669, 0x0D4528A0, 0x0D454661, 0x0D4566FE, 0x0D45D651, 0x0D46AAFF, 0x0D46D66E, 0x0D471675, 0x0D472A77,
+	0x0D474712, 0x0D47ACCD, 0x0D48966B, 0x0D48F670, 0x0D491674, 0x0D4967F4, 0x0D4B07AB, 0x0D4B3672, 0x0D4BE780, 0x0D4C2E09,
+	0x0D4C5671, 0x0D4CD673, 0x0D4E566D, 0x0D4F166F, 0x0D4FE700, 0x0D500CE8, 0x0D50967A, 0x0D51B678, 0x0D51C8E7, 0x0D521677,
+	0x0D52F680, 0x0D5395F7, 0x0D541679, 0x0D54567B, 0x0D54767C, 0x0D55568B, 0x0D559687, 0x0D55D60D, 0x0D567686, 0x0D571685,
+	0x0D577682, 0x0D583668, 0x0D585684, 0x0D587683, 0x0D5A3689, 0x0D5A7145, 0x0D5B568C, 0x0D5B6839, 0x0D5BD688, 0x0D5BF68A,
+	0x0D5D0EA5, 0x0D5D568D, 0x0D5F5691, 0x0D5F768E, 0x0D6090D3, 0x0D60B68F, 0x0D61565C, 0x0D625692, 0x0D62D693, 0x0D63A614,
+	0x0D63F695, 0x0D640887, 0x0D642A1F, 0x0D646813, 0x0D64E662, 0x0D6650BE, 0x0D66F697, 0x0D671696, 0x0D673699, 0x0D67479C,
+	0x0D67A814, 0x0D67C73C, 0x0D68769C, 0x0D68F69B, 0x0D69369D, 0x0D69868C, 0x0D69CCD6, 0x0D6A169E, 0x0D6A673D, 0x0D6A96A0,
+	0x0D6B369F, 0x0D6B76A1, 0x0D6BF6A2, 0x0D6C36A3, 0x0D6C49FE, 0x0D6C6BB3, 0x0D6C895F, 0x0D6CCF50, 0x0D6D2FA0, 0x0D6D5163,
+	0x0D6DEA15, 0x0D6E698E, 0x0D6E9130, 0x0D6F16A4, 0x0D6F36A5, 0x0D6F6A00, 0x0D6FF6A6, 0x0D7016A7, 0x0D7076A9, 0x0D7096A8,
+	0x0D70CFF7, 0x0D712ABD, 0x0D714A6A, 0x0D7169E3, 0x0D71B6AA, 0x0D72B6AC, 0x0D72CB42, 0x0D7316AB, 0x0D73D6AD, 0x0D7496AE,
+	0x0D7556AF, 0x0D7576B0, 0x0D75F6B1, 0x0D7636B3, 0x0D7656B2, 0x0D7676B4, 0x0D768663, 0x0D76ACE9, 0x0D76F6B5, 0x0D7749C5,
+	0x0D7766EB, 0x0D7796B6, 0x0D77EDA1, 0x0D78134A, 0x0D78A782, 0x0D78D6B7, 0x0D7976B8, 0x0D79AFAA, 0x0D79D008, 0x0D7A4E05,
+	0x0D7A76B9, 0x0D7A8EE4, 0x0D7B0EF9, 0x0D7B7051, 0x0D7BF6BA, 0x0D7D76BC, 0x0D7D96BB, 0x0D7DF6BE, 0x0D7E76BD, 0x0D8116C1,
+	0x0D81EA01, 0x0D82302F, 0x0D8276C2, 0x0D8296C3, 0x0D82E783, 0x0D8376C4, 0x0D8476C6, 0x0D8496C5, 0x0D868B85, 0x0D86EF18,
+	0x0D870629, 0x0D87CEC3, 0x0D880D73, 0x0D882AA0, 0x0D8847C1, 0x0D89CEC4, 0x0D8A0A2C, 0x0D8AB6C8, 0x0D8AE73E, 0x0D8B4658,
+	0x0D8BAE30, 0x0D8BD6C7, 0x0D8BE91D, 0x0D8C0CF2, 0x0D8C56C9, 0x0D8D16D1, 0x0D8D56CA, 0x0D8E0C7F, 0x0D8E47C2, 0x0D8E76D2,
+	0x0D8F4888, 0x0D8FA784, 0x0D8FD6D0, 0x0D9036CE, 0x0D9056CB, 0x0D9070C0, 0x0D910D3E, 0x0D918E17, 0x0D91B6CC, 0x0D9216D4,
+	0x0D9256D3, 0x0D926842, 0x0D92C66B, 0x0D932979, 0x0D9356CD, 0x0D9376CF, 0x0D942FF6, 0x0D944CB2, 0x0D957017, 0x0D95D6DC,
+	0x0D9636DD, 0x0D96668D, 0x0D970F66, 0x0D97307B, 0x0D9756DF, 0x0D976A21, 0x0D978B00, 0x0D97B6D8, 0x0D97D6DE, 0x0D97E648,
+	0x0D9827F5, 0x0D9896D5, 0x0D98B6DA, 0x0D992BF2, 0x0D994E91, 0x0D998EE5, 0x0D9A76D7, 0x0D9AAFC0, 0x0D9AF6D9, 0x0D9B36E2,
+	0x0D9B76E0, 0x0D9BB6DB, 0x0D9C2FC1, 0x0D9C4E67, 0x0D9C67C3, 0x0D9CAD84, 0x0D9D0D0D, 0x0D9D56E3, 0x0D9DF6E1, 0x0D9E0C97,
+	0x0D9E36D6, 0x0D9E662A, 0x0DA170AD, 0x0DA196EE, 0x0DA256ED, 0x0DA2EBF4, 0x0DA336EA, 0x0DA370CC, 0x0DA3CDF4, 0x0DA3F6E4,
+	0x0DA4AD43, 0x0DA5262B, 0x0DA5491E, 0x0DA576E7, 0x0DA64A86, 0x0DA676EC, 0x0DA6B6EB, 0x0DA6D6E6, 0x0DA716E9, 0x0DA76708,
+	0x0DA7B6E8, 0x0DA7CE68, 0x0DA830EC, 0x0DA88B32, 0x0DA8ABF3, 0x0DAB36F4, 0x0DAB56F2, 0x0DAB8F2C, 0x0DAC76EF, 0x0DAC96F1,
+	0x0DACC619, 0x0DAD291F, 0x0DAD5151, 0x0DAD86DC, 0x0DADCF42, 0x0DAE90C1, 0x0DAEE6C3, 0x0DAF0B5A, 0x0DAF36F3, 0x0DB0B6F8,
+	0x0DB10B01, 0x0DB1908F, 0x0DB1D6F5, 0x0DB276F0, 0x0DB2B6F6, 0x0DB3311C, 0x0DB36DD3, 0x0DB38E00, 0x0DB5E6D5, 0x0DB64634,
+	0x0DB6B6FC, 0x0DB716FF, 0x0DB79101, 0x0DB810C4, 0x0DB8B706, 0x0DB8D700, 0x0DB8F6FD, 0x0DB97112, 0x0DB99703, 0x0DBA2AA9,
+	0x0DBA5705, 0x0DBAB70A, 0x0DBB0DD1, 0x0DBB3708, 0x0DBBD702, 0x0DBC2CD7, 0x0DBC9709, 0x0DBCD6FE, 0x0DBD1704, 0x0DBD570B,
+	0x0DBD65FA, 0x0DBD9701, 0x0DBDD70C, 0x0DBE2B5B, 0x0DBE6ABE, 0x0DBEAF63, 0x0DBEE96C, 0x0DBF36F9, 0x0DBF5707, 0x0DBF6D99,
+	0x0DC0ABB4, 0x0DC0E709, 0x0DC1098F, 0x0DC12B02, 0x0DC156FB, 0x0DC16AA1, 0x0DC2686B, 0x0DC2B6FA, 0x0DC33710, 0x0DC34ACD,
+	0x0DC368B8, 0x0DC3B71F, 0x0DC3F719, 0x0DC407D4, 0x0DC42DAE, 0x0DC47714, 0x0DC4971D, 0x0DC4A5AD, 0x0DC4C611, 0x0DC52677,
+	0x0DC57716, 0x0DC58C6A, 0x0DC5B70D, 0x0DC5D70F, 0x0DC5E920, 0x0DC71720, 0x0DC7571B, 0x0DC7D713, 0x0DC8771A, 0x0DC95029,
+	0x0DC9B718, 0x0DC9D71C, 0x0DCAC8CE, 0x0DCB0B03, 0x0DCB6CD8, 0x0DCBF712, 0x0DCCF08E, 0x0DCD7715, 0x0DCDD70E, 0x0DCDEDD2,
+	0x0DCE5711, 0x0DCED717, 0x0DCFD170, 0x0DCFEA3C, 0x0DD0101E, 0x0DD05721, 0x0DD18EAC, 0x0DD1F72D, 0x0DD208B9, 0x0DD2CAC0,
+	0x0DD31723, 0x0DD390ED, 0x0DD3A921, 0x0DD3F730, 0x0DD445EC, 0x0DD4B72E, 0x0DD55722, 0x0DD5F728, 0x0DD6572A, 0x0DD6D0AE,
+	0x0DD6F725, 0x0DD74D8D, 0x0DD7B727, 0x0DD8572F, 0x0DD89729, 0x0DD8B045, 0x0DD93724, 0x0DD96A20, 0x0DD9973C, 0x0DDA270A,
+	0x0DDA7726, 0x0DDA972B, 0x0DDAB72C, 0x0DDBACAA, 0x0DDBCC98, 0x0DDD9734, 0x0DDDF73A, 0x0DDE5738, 0x0DDE8D88, 0x0DDEF742,
+	0x0DDF1735, 0x0DDFD736, 0x0DDFF71E, 0x0DE027D9, 0x0DE04F19, 0x0DE0CA3D, 0x0DE12957, 0x0DE1F152, 0x0DE23732, 0x0DE27741,
+	0x0DE28649, 0x0DE2AC46, 0x0DE40E99, 0x0DE4473F, 0x0DE47138, 0x0DE5701F, 0x0DE58D50, 0x0DE63739, 0x0DE6573B, 0x0DE70C11,
+	0x0DE7D740, 0x0DE7F737, 0x0DE83731, 0x0DE8A741, 0x0DEA8889, 0x0DEB174E, 0x0DEB7749, 0x0DEB8BF6, 0x0DEBE703, 0x0DEC8AC1,
+	0x0DECD752, 0x0DEDB74B, 0x0DEDCD2A, 0x0DEDF748, 0x0DEE0D57, 0x0DEE976B, 0x0DEF1745, 0x0DEF5744, 0x0DEF974D, 0x0DF01747,
+	0x0DF03746, 0x0DF0574C, 0x0DF08B9F, 0x0DF0D743, 0x0DF1D74F, 0x0DF23750, 0x0DF2E740, 0x0DF43755, 0x0DF47754, 0x0DF49756,
+	0x0DF55759, 0x0DF62DA2, 0x0DF67753, 0x0DF73757, 0x0DF80883, 0x0DF82CB7, 0x0DF85751, 0x0DF86E5A, 0x0DF8D758, 0x0DFA975D,
+	0x0DFAB75B, 0x0DFB175E, 0x0DFB7761, 0x0DFBF75A, 0x0DFC094A, 0x0DFC2E47, 0x0DFC96F7, 0x0DFD70D4, 0x0DFD975C, 0x0DFDD760,
+	0x0DFDECB3, 0x0DFE375F, 0x0DFE774A, 0x0DFEDD89, 0x0DFF5764, 0x0DFFD768, 0x0E003766, 0x0E013762, 0x0E017763, 0x0E01F767,
+	0x0E023765, 0x0E02AF2D, 0x0E03176D, 0x0E03576A, 0x0E037769, 0x0E03B76C, 0x0E03CE12, 0x0E03F76E, 0x0E04CD15, 0x0E04ECAB,
+	0x0E058BA3, 0x0E06176F, 0x0E065771, 0x0E07D770, 0x0E099733, 0x0E0A3772, 0x0E0B0E25, 0x0E0C7773, 0x0E0D668E, 0x0E0DEDD4,
+	0x0E0E06C4, 0x0E0F07C4, 0x0E0F8A5C, 0x0E0FA990, 0x0E113146, 0x0E114B86, 0x0E11C64A, 0x0E125775, 0x0E133774, 0x0E159778,
+	0x0E15ACD9, 0x0E15D77B, 0x0E15F776, 0x0E16777A, 0x0E171779, 0x0E172D9F, 0x0E1745D7, 0x0E191133, 0x0E19777D, 0x0E19E607,
+	0x0E1B3780, 0x0E1BB77E, 0x0E1BF77C, 0x0E1E3777, 0x0E1F2FC2, 0x0E1FB782, 0x0E213781, 0x0E22864B, 0x0E233784, 0x0E234F70,
+	0x0E239783, 0x0E243033, 0x0E24CB05, 0x0E26CC12, 0x0E278B04, 0x0E293139, 0x0E29978A, 0x0E29CBF7, 0x0E2AB786, 0x0E2AD78B,
+	0x0E2B264C, 0x0E2C5789, 0x0E2C8E81, 0x0E2CB785, 0x0E2CD788, 0x0E2CEB06, 0x0E2D2ECF, 0x0E2D978C, 0x0E2DCA4F, 0x0E2FABF8,
+	0x0E30978F, 0x0E311787, 0x0E314846, 0x0E31F78D, 0x0E3290AF, 0x0E32B790, 0x0E333F24, 0x0E33EAAE, 0x0E351791, 0x0E359792,
+	0x0E362E4D, 0x0E373794, 0x0E37D795, 0x0E386E52, 0x0E390DD5, 0x0E393797, 0x0E39D799, 0x0E3A1113, 0x0E3A5796, 0x0E3A9798,
+	0x0E3AA64D, 0x0E3AF793, 0x0E3BF2FA, 0x0E3C179A, 0x0E3CAC47, 0x0E3CC9D7, 0x0E3CF79C, 0x0E3D979B, 0x0E3DAB43, 0x0E3DD297,
+	0x0E3EB79D, 0x0E3F379F, 0x0E3F778E, 0x0E3F979E, 0x0E3FF7A0, 0x0E40CE9A, 0x0E41B7A1, 0x0E4217A2, 0x0E4377A3, 0x0E4517A4,
+	0x0E454D5C, 0x0E4597A6, 0x0E45B7A5, 0x0E4617A7, 0x0E4657A8, 0x0E46AA5D, 0x0E46CF43, 0x0E47506A, 0x0E4777A9, 0x0E4797AA,
+	0x0E47AC35, 0x0E47CA22, 0x0E47F7AB, 0x0E4817AC, 0x0E48D7AD, 0x0E48EF90, 0x0E490EC5, 0x0E4977AE, 0x0E498E76, 0x0E4A4D2B,
+	0x0E4B17AF, 0x0E4B26A5, 0x0E4B67CD, 0x0E4BB044, 0x0E4BF034, 0x0E4C2672, 0x0E4C5153, 0x0E4CEFF1, 0x0E4D2F68, 0x0E4E4BB5,
+	0x0E4E97B0, 0x0E4F2E01, 0x0E4FA8A1, 0x0E4FD7B1, 0x0E500992, 0x0E5037B3, 0x0E5057B2, 0x0E50F7B4, 0x0E5257B5, 0x0E52D7B6,
+	0x0E54079D, 0x0E5457B7, 0x0E54F7B8, 0x0E5588A2, 0x0E55EEC6, 0x0E5657BA, 0x0E56CB33, 0x0E5737B9, 0x0E5847F6, 0x0E5877BB,
+	0x0E5897BD, 0x0E58D7BC, 0x0E59D7BE, 0x0E5A08CF, 0x0E5A57BF, 0x0E5AE827, 0x0E5B2C1F, 0x0E5B695D, 0x0E5C17C1, 0x0E5C37C2,
+	0x0E5C57C0, 0x0E5D2A6B, 0x0E5D8E06, 0x0E5DA7F7, 0x0E5EF7C4, 0x0E5F0CCB, 0x0E5F37C3, 0x0E5F9154, 0x0E5FAE82, 0x0E6157C7,
+	0x0E62D7C9, 0x0E62F7C6, 0x0E637052, 0x0E6397C8, 0x0E63B7CA, 0x0E63F102, 0x0E64B7CE, 0x0E6537CD, 0x0E654D16, 0x0E656E4C,
+	0x0E65C8A3, 0x0E65F7CC, 0x0E6697CB, 0x0E66D090, 0x0E66F091, 0x0E67D7CF, 0x0E67E64E, 0x0E688956, 0x0E68AA02, 0x0E69D7D0,
+	0x0E69F7D1, 0x0E6AF7D3, 0x0E6C6AA2, 0x0E6D17D5, 0x0E6D57D4, 0x0E6E17D6, 0x0E6E46EC, 0x0E6EB7D8, 0x0E6F17D7, 0x0E6F57DA,
+	0x0E6F77D9, 0x0E7088BA, 0x0E70F0E6, 0x0E71280A, 0x0E716664, 0x0E72C828, 0x0E75275F, 0x0E765126, 0x0E7677DC, 0x0E7777DE,
+	0x0E7817DF, 0x0E78468F, 0x0E7917DB, 0x0E7949D8, 0x0E79AD3F, 0x0E79D7DD, 0x0E7BD7E2, 0x0E7C0A6C, 0x0E7CB7E0, 0x0E7D485D,
+	0x0E7DAEC7, 0x0E7DD7E1, 0x0E7E37FC, 0x0E7F17E7, 0x0E7FC8BB, 0x0E8067C5, 0x0E80B7E4, 0x0E80D0DD, 0x0E8130EE, 0x0E844CB4,
+	0x0E84B7E6, 0x0E8657E8, 0x0E867114, 0x0E868815, 0x0E86AEFA, 0x0E86CE69, 0x0E8757E9, 0x0E87F7EB, 0x0E8837EE, 0x0E8AB7EA,
+	0x0E8B37ED, 0x0E8B48E8, 0x0E8B662C, 0x0E8B97EF, 0x0E8BCB90, 0x0E8BF7EC, 0x0E8C111A, 0x0E8C77F2, 0x0E8C9F22, 0x0E8D37F0,
+	0x0E8D57F3, 0x0E8DF7E5, 0x0E8E17F1, 0x0E8E697A, 0x0E8ED7F4, 0x0E8FD7F5, 0x0E9070DE, 0x0E9177F6, 0x0E93D7F7, 0x0E9457E3,
+	0x0E94F7F8, 0x0E960742, 0x0E97AA23, 0x0E9957F9, 0x0E99F7FA, 0x0E9A97FB, 0x0E9B861A, 0x0E9C1800, 0x0E9C4F1A, 0x0E9C7801,
+	0x0E9CC722, 0x0E9CF802, 0x0E9D3803, 0x0E9DD804, 0x0E9E1806, 0x0E9E3807, 0x0E9E5805, 0x0E9ECF32, 0x0E9EF809, 0x0E9F1808,
+	0x0EA0780B, 0x0EA0980A, 0x0EA0B80C, 0x0EA1980D, 0x0EA1B80F, 0x0EA1D80E, 0x0EA22959, 0x0EA27811, 0x0EA2B810, 0x0EA30743,
+	0x0EA34B72, 0x0EA38D9B, 0x0EA3D812, 0x0EA3EBB6, 0x0EA469D9, 0x0EA4A659, 0x0EA4D813, 0x0EA510B0, 0x0EA56FA1, 0x0EA59814,
+	0x0EA60DA3, 0x0EA63092, 0x0EA64922, 0x0EA66B5C, 0x0EA6ECEA, 0x0EA71272, 0x0EA74D2C, 0x0EA766A6, 0x0EA79815, 0x0EA89816,
+	0x0EA8D81B, 0x0EA93819, 0x0EA95818, 0x0EA97580, 0x0EA986C5, 0x0EA9B817, 0x0EA9E5D8, 0x0EAA2EA8, 0x0EAA8EC8, 0x0EAB30EF,
+	0x0EAB581C, 0x0EAB781A, 0x0EAB8CFB, 0x0EABABA4, 0x0EAC0EA9, 0x0EAC4F0C, 0x0EAC981E, 0x0EACB0EA, 0x0EACC86C, 0x0EACF81F,
+	0x0EAD381D, 0x0EAD4ED4, 0x0EAD7820, 0x0EADB821, 0x0EAE05D9, 0x0EAE6B34, 0x0EAE9826, 0x0EAED823, 0x0EAEEE2B, 0x0EAF1822,
+	0x0EAFE785, 0x0EB05829, 0x0EB0D824, 0x0EB0F825, 0x0EB13828, 0x0EB15827, 0x0EB16F04, 0x0EB1CC21, 0x0EB1EC20, 0x0EB2279E,
+	0x0EB2982A, 0x0EB3582B, 0x0EB3B82C, 0x0EB4782E, 0x0EB4B82D, 0x0EB56635, 0x0EB63836, 0x0EB64EE6, 0x0EB67830, 0x0EB6B832,
+	0x0EB71834, 0x0EB72B5D, 0x0EB79835, 0x0EB7B833, 0x0EB7CA3E, 0x0EB8582F, 0x0EB87831, 0x0EB8AF21, 0x0EB8EB07, 0x0EB95838,
+	0x0EB9B837, 0x0EBA5839, 0x0EBA8A24, 0x0EBAA96D, 0x0EBB0DD7, 0x0EBB383A, 0x0EBB6D49, 0x0EBBD83C, 0x0EBC50DF, 0x0EBC783B,
+	0x0EBD2C49, 0x0EBE1842, 0x0EBE5844, 0x0EBE7845, 0x0EBE8CF3, 0x0EBF5843, 0x0EBF9840, 0x0EBFD83D, 0x0EBFF83E, 0x0EC03841,
+	0x0EC13848, 0x0EC17846, 0x0EC1B847, 0x0EC3F849, 0x0EC4184B, 0x0EC4384C, 0x0EC4584D, 0x0EC4984E, 0x0EC4F84A, 0x0EC61850,
+	0x0EC6984F, 0x0EC77851, 0x0EC85103, 0x0EC8D854, 0x0EC8F852, 0x0EC91853, 0x0EC98760, 0x0ECA507C, 0x0ECACF88, 0x0ECB1856,
+	0x0ECB9855, 0x0ECC3857, 0x0ECC5858, 0x0ECCF85C, 0x0ECD1859, 0x0ECD385A, 0x0ECD585B, 0x0ECD985D, 0x0ECE185E, 0x0ECE585F,
+	0x0ECED860, 0x0ECF1861, 0x0ECF4EAD, 0x0ECF6DAF, 0x0ECF9862, 0x0ECFAE92, 0x0ECFCF13, 0x0ED01863, 0x0ED07864, 0x0ED08D89,
+	0x0ED0C6C6, 0x0ED0E923, 0x0ED11865, 0x0ED17866, 0x0ED1D867, 0x0ED209C8, 0x0ED27869, 0x0ED2D868, 0x0ED3386A, 0x0ED3586B,
+	0x0ED5CEE7, 0x0ED6186C, 0x0ED6986D, 0x0ED6FF09, 0x0ED7186E, 0x0ED7386F, 0x0ED75870, 0x0ED7E9CD, 0x0ED85871, 0x0ED86E75,
+	0x0ED8CFFE, 0x0ED9062D, 0x0ED94636, 0x0ED9B872, 0x0EDA5874, 0x0EDAD873, 0x0EDAEDD0, 0x0EDB6BB7, 0x0EDB9698, 0x0EDBD875,
+	0x0EDBF03F, 0x0EDC3876, 0x0EDC6744, 0x0EDC8ED5, 0x0EDCB877, 0x0EDCF878, 0x0EDD5879, 0x0EDDD05A, 0x0EDE5053, 0x0EDE8D3C,
+	0x0EDF0C4A, 0x0EDF787B, 0x0EDFCAC2, 0x0EE02B08, 0x0EE0987E, 0x0EE0F87D, 0x0EE1187C, 0x0EE12EFB, 0x0EE16745, 0x0EE188A7,
+	0x0EE37884, 0x0EE3D881, 0x0EE3EB5E, 0x0EE41030, 0x0EE49880, 0x0EE4B882, 0x0EE4D883, 0x0EE5387F, 0x0EE6F885, 0x0EE71886,
+	0x0EE74D2D, 0x0EE78761, 0x0EE80D05, 0x0EE8F887, 0x0EEB5888, 0x0EEB788B, 0x0EEC2B87, 0x0EEC6E02, 0x0EECB88C, 0x0EECCFF2,
+	0x0EED1889, 0x0EED788A, 0x0EEF388F, 0x0EEFD88E, 0x0EEFF88D, 0x0EF17891, 0x0EF1D890, 0x0EF23892, 0x0EF3D894, 0x0EF41893,
+	0x0EF4AF8B, 0x0EF58AB5, 0x0EF5B104, 0x0EF61895, 0x0EF66DF5, 0x0EF6D896, 0x0EF73897, 0x0EF7789B, 0x0EF79899, 0x0EF7B89A,
+	0x0EF7F898, 0x0EF8F89C, 0x0EF9B89D, 0x0EFAF89E, 0x0EFB589F, 0x0EFB7035, 0x0EFB98A0, 0x0EFC506E, 0x0EFC78A1, 0x0EFCACED,
+	0x0EFCEE8A, 0x0EFD2829, 0x0EFDACDA, 0x0EFDD8A2, 0x0EFDE7F8, 0x0EFE6BCE, 0x0EFF98A3, 0x0F00497B, 0x0F0198A4, 0x0F0258A5,
+	0x0F0288A4, 0x0F02A993, 0x0F0418A7, 0x0F04ADB5, 0x0F04C994, 0x0F04E7AD, 0x0F064FC3, 0x0F068E6A, 0x0F074DB6, 0x0F07E93B,
+	0x0F08B8A9, 0x0F0BAB09, 0x0F0D70F0, 0x0F0D8924, 0x0F0DE8A5, 0x0F0E4EA1, 0x0F0E98AB, 0x0F0F98AD, 0x0F1028E9, 0x0F10D8AC,
+	0x0F10ED74, 0x0F1198AF, 0x0F11A6D6, 0x0F11D8AA, 0x0F122EE8, 0x0F12660F, 0x0F12A9AA, 0x0F12F171, 0x0F1358AE, 0x0F1478B0,
+	0x0F14EF89, 0x0F152BD7, 0x0F1558B2, 0x0F15F8B3, 0x0F16B8B1, 0x0F1746ED, 0x0F1798B9, 0x0F17D8B8, 0x0F182A25, 0x0F18B8BA,
+	0x0F18D8B5, 0x0F1958BB, 0x0F1978B6, 0x0F1A0ED6, 0x0F1A38B4, 0x0F1A98B7, 0x0F1B58C1, 0x0F1CF8C0, 0x0F1D1001, 0x0F1D98BC,
+	0x0F1DE5E9, 0x0F1E98C3, 0x0F1FB8C2, 0x0F202B0A, 0x0F20F8C4, 0x0F21CC22, 0x0F2238C6, 0x0F2258C5, 0x0F2338C7, 0x0F24D8A6,
+	0x0F2558A8, 0x0F2578C9, 0x0F2598C8, 0x0F274A26, 0x0F279127, 0x0F27CA50, 0x0F2818CA, 0x0F282856, 0x0F28E79F, 0x0F290786,
+	0x0F292A03, 0x0F2A1093, 0x0F2A78D0, 0x0F2AB8CF, 0x0F2ACC23, 0x0F2AF8CC, 0x0F2B58CE, 0x0F2BAAAA, 0x0F2BCB5F, 0x0F2BF8CD,
+	0x0F2C18CB, 0x0F2C4E49, 0x0F2CAB0B, 0x0F2D0F1B, 0x0F2DA995, 0x0F2EEDD8, 0x0F2F58D1, 0x0F2FF8D2, 0x0F3018E8, 0x0F302816,
+	0x0F30915C, 0x0F30AC14, 0x0F3158D3, 0x0F31A690, 0x0F31CD75, 0x0F31EF5F, 0x0F33B8D4, 0x0F34C7DA, 0x0F34F8D5, 0x0F3558D7,
+	0x0F35D8D8, 0x0F360E48, 0x0F3678D9, 0x0F3738DA, 0x0F3758DB, 0x0F37A817, 0x0F37C691, 0x0F37EE03, 0x0F380A87, 0x0F382A04,
+	0x0F3938DC, 0x0F396A88, 0x0F3A2688, 0x0F3A4F22, 0x0F3AB8DD, 0x0F3B0EE9, 0x0F3BEC24, 0x0F3C38E0, 0x0F3C78E1, 0x0F3C8E89,
+	0x0F3CCB60, 0x0F3CF8DE, 0x0F3D2D01, 0x0F3D98DF, 0x0F3E0B0C, 0x0F3F65DA, 0x0F400788, 0x0F4118E2, 0x0F416D76, 0x0F41B8E3,
+	0x0F41CBC5, 0x0F42902B, 0x0F42EF02, 0x0F4318E4, 0x0F4338E5, 0x0F434CF4, 0x0F439105, 0x0F43F8E7, 0x0F4418E6, 0x0F45CA6D,
+	0x0F4638E9, 0x0F4645EE, 0x0F46F8EC, 0x0F4778EA, 0x0F478692, 0x0F47A86D, 0x0F47D8EB, 0x0F47E925, 0x0F480952, 0x0F484FA4,
+	0x0F4878ED, 0x0F48CFF3, 0x0F4938EF, 0x0F49ABCF, 0x0F49C62E, 0x0F49E678, 0x0F4A05AA, 0x0F4AF8EE, 0x0F4C38F0, 0x0F4C58F1,
+	0x0F4C6B35, 0x0F4D38F2, 0x0F4D66EE, 0x0F4E18F4, 0x0F4E888A, 0x0F4EC7C6, 0x0F4F38F5, 0x0F4F4833, 0x0F4FB8F6, 0x0F4FEBFA,
+	0x0F502E0B, 0x0F506BDE, 0x0F5089B3, 0x0F5118F7, 0x0F524D02, 0x0F526C4B, 0x0F52B8F9, 0x0F52D8FB, 0x0F52F8F8, 0x0F5318FA,
+	0x0F53E841, 0x0F5538FC, 0x0F554845, 0x0F55C7C7, 0x0F55F0B1, 0x0F5618FE, 0x0F56D900, 0x0F57460D, 0x0F57F903, 0x0F586716,
+	0x0F589902, 0x0F58B901, 0x0F58F905, 0x0F5918FD, 0x0F595906, 0x0F5970E7, 0x0F59B907, 0x0F59F908, 0x0F5A5372, 0x0F5A790A,
+	0x0F5AB909, 0x0F5B390B, 0x0F5B590C, 0x0F5B90F3, 0x0F5BB90D, 0x0F5BFDED, 0x0F5C0B0D, 0x0F5C390E, 0x0F5C590F, 0x0F5C6AB6,
+	0x0F5CADF6, 0x0F5CD910, 0x0F5D4CC7, 0x0F5DB911, 0x0F5DECDB, 0x0F5E1912, 0x0F5EC7E3, 0x0F5F121E, 0x0F5F2CFC, 0x0F5F4A31,
+	0x0F5FE746, 0x0F605913, 0x0F609920, 0x0F60D916, 0x0F6107C8, 0x0F615915, 0x0F617922, 0x0F61F914, 0x0F622B0E, 0x0F631918,
+	0x0F633919, 0x0F636D8A, 0x0F63D91A, 0x0F6406FD, 0x0F64AB79, 0x0F64CF44, 0x0F65191C, 0x0F658CA6, 0x0F667917, 0x0F66B91B,
+	0x0F66D91D, 0x0F6729B9, 0x0F68B924, 0x0F68CF0D, 0x0F690EA4, 0x0F692DD9, 0x0F696818, 0x0F699923, 0x0F69B921, 0x0F69EEB3,
+	0x0F6A191E, 0x0F6A2CFD, 0x0F6A4DDB, 0x0F6A8DDA, 0x0F6AC9B4, 0x0F6BB936, 0x0F6CB926, 0x0F6CF928, 0x0F6D992B, 0x0F6DD92C,
+	0x0F6E1929, 0x0F6E392A, 0x0F6E9927, 0x0F6EB925, 0x0F6F591F, 0x0F70CF8D, 0x0F70E693, 0x0F717933, 0x0F71B930, 0x0F71F935,
+	0x0F725934, 0x0F728E93, 0x0F72B025, 0x0F72E9DA, 0x0F73192E, 0x0F733937, 0x0F735932, 0x0F739931, 0x0F73B92D, 0x0F73F92F,
+	0x0F742747, 0x0F754CDC, 0x0F75ABFB, 0x0F762EA0, 0x0F76993C, 0x0F770EA2, 0x0F780BDF, 0x0F783939, 0x0F788ECD, 0x0F78D93D,
+	0x0F78EF91, 0x0F792CFA, 0x0F797938, 0x0F79993A, 0x0F79F93B, 0x0F7BB93E, 0x0F7C0A42, 0x0F7C8E04, 0x0F7CB943, 0x0F7CD942,
+	0x0F7D393F, 0x0F7DB155, 0x0F7E7948, 0x0F7ED94C, 0x0F7EF949, 0x0F801945, 0x0F80F946, 0x0F81B94B, 0x0F823940, 0x0F825293,
+	0x0F827947, 0x0F829941, 0x0F82F94A, 0x0F83F950, 0x0F842748, 0x0F84794D, 0x0F84F94E, 0x0F85594F, 0x0F857952, 0x0F86F951,
+	0x0F870EF4, 0x0F87B953, 0x0F87D13A, 0x0F87EFAB, 0x0F881958, 0x0F887955, 0x0F899954, 0x0F89ABD0, 0x0F89F957, 0x0F8A1959,
+	0x0F8A9956, 0x0F8AD95D, 0x0F8B195A, 0x0F8BF95B, 0x0F8C1944, 0x0F8C995C, 0x0F8CB95E, 0x0F8D995F, 0x0F8E6F84, 0x0F8EB960,
+	0x0F8FD060, 0x0F90280C, 0x0F904848, 0x0F907961, 0x0F912F72, 0x0F916B88, 0x0F91B02E, 0x0F921962, 0x0F9250F1, 0x0F92AE94,
+	0x0F92EC25, 0x0F930E53, 0x0F936AAC, 0x0F93E5BE, 0x0F943967, 0x0F945965, 0x0F949963, 0x0F94A71F, 0x0F94EB0F, 0x0F951968,
+	0x0F957966, 0x0F95B964, 0x0F95D96C, 0x0F96396B, 0x0F96596A, 0x0F967969, 0x0F97396D, 0x0F97B96E, 0x0F97CBB8, 0x0F98196F,
+	0x0F985971, 0x0F98B970, 0x0F9948D0, 0x0F99CC17, 0x0F9A5973, 0x0F9ACDDC, 0x0F9B1972, 0x0F9B9974, 0x0F9BCF73, 0x0F9BEC4C,
+	0x0F9C0926, 0x0F9C5975, 0x0F9CF106, 0x0F9DF977, 0x0F9E5978, 0x0F9E9979, 0x0F9ED97A, 0x0F9F0A05, 0x0F9F597B, 0x0F9F686E,
+	0x0F9FC7CA, 0x0FA00789, 0x0FA05980, 0x0FA09071, 0x0FA0A927, 0x0FA0D97C, 0x0FA15983, 0x0FA17064, 0x0FA1AE5B, 0x0FA20F12,
+	0x0FA28AC3, 0x0FA2B982, 0x0FA2EA51, 0x0FA30928, 0x0FA32A06, 0x0FA347C9, 0x0FA36F74, 0x0FA39981, 0x0FA40C26, 0x0FA42FE1,
+	0x0FA449B5, 0x0FA56A07, 0x0FA58D5B, 0x0FA5D986, 0x0FA5F11D, 0x0FA60997, 0x0FA65987, 0x0FA66B61, 0x0FA6B989, 0x0FA72B10,
+	0x0FA7496E, 0x0FA7F988, 0x0FA84A89, 0x0FA868BC, 0x0FA88C27, 0x0FA8B984, 0x0FA8D98A, 0x0FA97985, 0x0FA9886F, 0x0FA9D98D,
+	0x0FA9F991, 0x0FAA088B, 0x0FAAD98C, 0x0FAB7995, 0x0FABC929, 0x0FAC30CD, 0x0FAC45BA, 0x0FAC7992, 0x0FACC7CB, 0x0FAD198F,
+	0x0FADD990, 0x0FAE2DDD, 0x0FAE598E, 0x0FAE798B, 0x0FAEA6C7, 0x0FAECBE2, 0x0FAF28A6, 0x0FAFB997, 0x0FB13994, 0x0FB1F996,
+	0x0FB27993, 0x0FB32870, 0x0FB34C71, 0x0FB37998, 0x0FB38C4E, 0x0FB3F9A5, 0x0FB459A1, 0x0FB4799B, 0x0FB5799F, 0x0FB58A78,
+	0x0FB5A5DB, 0x0FB5D99A, 0x0FB5F9A2, 0x0FB619A6, 0x0FB6292A, 0x0FB65054, 0x0FB68D54, 0x0FB6B99C, 0x0FB719A4, 0x0FB75999,
+	0x0FB76CDD, 0x0FB7B99E, 0x0FB7C5BB, 0x0FB7F048, 0x0FB8F99D, 0x0FB94819, 0x0FB96EEA, 0x0FB9EC4D, 0x0FBA310E, 0x0FBA4ACF,
+	0x0FBAB9CE, 0x0FBB19A7, 0x0FBB4BFC, 0x0FBB99A3, 0x0FBBB9A8, 0x0FBBD9AA, 0x0FBC0D77, 0x0FBC39AD, 0x0FBC99A9, 0x0FBD0F92,
+	0x0FBD2749, 0x0FBD9049, 0x0FBDE5DC, 0x0FBE59AC, 0x0FBE913B, 0x0FBF79AB, 0x0FC0264F, 0x0FC08E2A, 0x0FC0B9AE, 0x0FC139B5,
+	0x0FC159AF, 0x0FC179B6, 0x0FC259B2, 0x0FC36E9B, 0x0FC3CA48, 0x0FC3F9B4, 0x0FC439B1, 0x0FC459B7, 0x0FC479B0, 0x0FC4CAA3,
+	0x0FC56FC4, 0x0FC5CAAB, 0x0FC639B3, 0x0FC659C0, 0x0FC6B9BB, 0x0FC6F9BE, 0x0FC739BC, 0x0FC759C1, 0x0FC779BA, 0x0FC7B9A0,
+	0x0FC7CBD1, 0x0FC82EC9, 0x0FC879BD, 0x0FC8D9B8, 0x0FC94C00, 0x0FC96871, 0x0FC9AA8A, 0x0FCA8B44, 0x0FCAAC15, 0x0FCAD9C4,
+	0x0FCB39C6, 0x0FCB59C7, 0x0FCBB9C3, 0x0FCBD9C5, 0x0FCCD9B9, 0x0FCCF9C2, 0x0FCD39CA, 0x0FCD59C9, 0x0FCDB01A, 0x0FCE084A,
+	0x0FCF39C8, 0x0FCF79CC, 0x0FCF99CB, 0x0FCFB9CF, 0x0FCFF9D1, 0x0FD049DB, 0x0FD079CD, 0x0FD119D2, 0x0FD139D3, 0x0FD199D4,
+	0x0FD1D9DA, 0x0FD1ED9A, 0x0FD219D6, 0x0FD259D5, 0x0FD279D7, 0x0FD299D8, 0x0FD2D9D9, 0x0FD379DB, 0x0FD399DC, 0x0FE6C74A,
+	0x0FE719DD, 0x0FE759DE, 0x0FE8B9DF, 0x0FE999E0, 0x0FE9B9E1, 0x0FE9D9E2, 0x0FEA19E3, 0x0FEA39E4, 0x0FEA99E6, 0x0FEAB9E5,
+	0x0FEB19E7, 0x0FEBF9E8, 0x0FEC19E9, 0x0FECF9EC, 0x0FED19EA, 0x0FED39EB, 0x0FED499F, 0x0FED6872, 0x0FEDCCF5, 0x0FEE0EB1,
+	0x0FEE4AD0, 0x0FEEAE6C, 0x0FEEEEEB, 0x0FEF19ED, 0x0FEF34EB, 0x0FF059EE, 0x0FF079F0, 0x0FF0B0C5, 0x0FF0D9EF, 0x0FF0F9F2,
+	0x0FF119F1, 0x0FF150B2, 0x0FF199F3, 0x0FF1CEFC, 0x0FF299F4, 0x0FF359F7, 0x0FF3B9F6, 0x0FF3D9F5, 0x0FF479F8, 0x0FF48851,
+	0x0FF50C01, 0x0FF527A0, 0x0FF5D9FC, 0x0FF5F9F9, 0x0FF659FA, 0x0FF6D9FD, 0x0FF719FE, 0x0FF739FB, 0x0FF7A608, 0x0FF82665,
+	0x0FF8BA00, 0x0FF8DA01, 0x0FF95A02, 0x0FF990C2, 0x0FFA4A8B, 0x0FFA9A04, 0x0FFABA03, 0x0FFC0B89, 0x0FFC3A05, 0x0FFCDA06,
+	0x0FFD3A07, 0x0FFD6763, 0x0FFE074B, 0x0FFE7A08, 0x0FFF3A09, 0x0FFF6FFC, 0x0FFF90C3, 0x100010B3, 0x10003156, 0x1000692C,
+	0x10009A0C, 0x1000AA52, 0x1000DA0B, 0x10017A0D, 0x10018A27, 0x10020C8F, 0x10025A0E, 0x1002A92B, 0x1002F055, 0x10031A0F,
+	0x10033A10, 0x10039A11, 0x10043A12, 0x10051A13, 0x10066A28, 0x1006D06B, 0x10077A15, 0x1007ACDE, 0x1007FA14, 0x1008DA17,
+	0x10095A16, 0x100A5A18, 0x100ACBB9, 0x100B1A19, 0x100B5A1A, 0x100BCF77, 0x100BFA1B, 0x100C2C4F, 0x100C5A1C, 0x100D1A1D,
+	0x100DF13C, 0x100E1A20, 0x100E5A1F, 0x100E7A1E, 0x100E8D2E, 0x100EDA21, 0x100EEB45, 0x100F3A22, 0x100FBA23, 0x100FD157,
+	0x100FFA24, 0x10109A25, 0x1010BA27, 0x1010DA26, 0x1010EEA3, 0x10112E37, 0x1011715D, 0x10118EA7, 0x10127A29, 0x1012CB11,
+	0x10130F09, 0x10135A2A, 0x10137A28, 0x1013A74C, 0x101428D2, 0x10144A08, 0x1014AEEC, 0x101528A8, 0x10154FE2, 0x10159A2D,
+	0x1015BA2B, 0x1015E92D, 0x1016292E, 0x101645E7, 0x101689A6, 0x10174E78, 0x101865DD, 0x10189A32, 0x1018CCDF, 0x10198E77,
+	0x1019CC99, 0x101ADA34, 0x101B3A30, 0x101B5A33, 0x101B7A2E, 0x101BBA31, 0x101BCFC5, 0x101C28D3, 0x101C85FB, 0x101CBA2F,
+	0x101DFA36, 0x101E3A37, 0x101E8DF7, 0x101F07F9, 0x101F9A45, 0x101FAE5C, 0x10204A09, 0x1020A7FA, 0x1020CBC6, 0x1020F165,
+	0x1021102C, 0x10213A35, 0x10214BD2, 0x102347B2, 0x10237A38, 0x10247A3A, 0x10253A39, 0x1025FA3B, 0x10262CC5, 0x10266E5D,
+	0x10272D2F, 0x1027DA42, 0x1028DA41, 0x10297A3C, 0x1029CB74, 0x102A0F45, 0x102A3A44, 0x102A7A43, 0x102A892F, 0x102AB172,
+	0x102BFA54, 0x102CBA48, 0x102CDA49, 0x102D6A6E, 0x102DDA47, 0x102E0958, 0x102E3A46, 0x102E9A4A, 0x102F0D30, 0x102F2F60,
+	0x102F4C02, 0x102FEC9A, 0x10301A4E, 0x10305A4F, 0x10307A4B, 0x10311A4C, 0x10315A4D, 0x1031E930, 0x10327A55, 0x1032BA51,
+	0x10334F46, 0x1033900C, 0x1033AF07, 0x10341A50, 0x10347A53, 0x10349A52, 0x10350FE3, 0x10353A56, 0x10361A57, 0x10366C16,
+	0x1036BA58, 0x10371A5A, 0x10375A5E, 0x1037BA5B, 0x1037DA59, 0x1037EE5E, 0x10381A5C, 0x10385A5D, 0x1038C670, 0x10391A64,
+	0x10393A5F, 0x1039BA60, 0x103A3A61, 0x103A6C5F, 0x103B1A63, 0x103B3A62, 0x103B5A65, 0x103BFA66, 0x103C1A67, 0x103C6B62,
+	0x103CA6A7, 0x103CFA68, 0x103D1115, 0x103D4A29, 0x103DAA8C, 0x103E6A0A, 0x103E8CF6, 0x103F5A69, 0x103F7A6A, 0x103F8610,
+	0x103FDA6B, 0x10403A6C, 0x10405A6D, 0x1040BA6E, 0x1040FA6F, 0x104107FB, 0x10413568, 0x10415A70, 0x10418BE3, 0x1041BA71,
+	0x1041CA49, 0x10421A72, 0x104251AE, 0x1042DA73, 0x1042EF9C, 0x1043075A, 0x10436C03, 0x10438AB7, 0x1043CF51, 0x1043EA8D,
+	0x10453A74, 0x10454931, 0x10457A75, 0x10458ECA, 0x1045DA84, 0x10467A77, 0x1046AC87, 0x1046CE95, 0x1046E8BD, 0x10471A76,
+	0x10472C04, 0x10481A78, 0x1048ED78, 0x104B1A7A, 0x104B3A79, 0x104B5A7C, 0x104BBA7B, 0x104BFA7D, 0x104C5A80, 0x104C9A7E,
+	0x104CC74D, 0x104D1A81, 0x104D5A82, 0x104D7A83, 0x104DC96F, 0x104DF107, 0x104E3A85, 0x104E4B46, 0x104EC650, 0x104EFA86,
+	0x104F1A87, 0x104FDA88, 0x105165F0, 0x1051BA89, 0x10525A8A, 0x10532F47, 0x1053AA45, 0x1053FA8C, 0x1054A6C8, 0x1054C5B0,
+	0x10557A8B, 0x10559A8E, 0x1055AE6D, 0x1055EB63, 0x10562694, 0x10566FC6, 0x1057087C, 0x1057281A, 0x10577A8D, 0x1057A6A8,
+	0x1058A721, 0x105A2651, 0x105A5A92, 0x105A7128, 0x105A8C9B, 0x105AEF23, 0x105B3A9E, 0x105B6695, 0x105B9A9C, 0x105BDA9A,
+	0x105BFA91, 0x105C3A8F, 0x105C7A90, 0x105CAA61, 0x105CC82A, 0x105CED17, 0x105D6E0F, 0x105E2630, 0x105E7A94, 0x105E9A93,
+	0x105F3A99, 0x105F5A95, 0x105F7A98, 0x1060504E, 0x10607A97, 0x10608696, 0x1060A71D, 0x1060DA9B, 0x10613A9D, 0x1061C873,
+	0x1062DAA1, 0x1062FAAA, 0x10631AAB, 0x106385A9, 0x10647AB2, 0x106505EF, 0x10657AA9, 0x1065FAA8, 0x10663AA3, 0x10665AA2,
+	0x10669AA0, 0x1066BA9F, 0x1066CD03, 0x10670CB9, 0x10673AA5, 0x10681AA4, 0x1068BAA7, 0x10692C50, 0x10694874, 0x1069E620,
+	0x106A1AA6, 0x106A4932, 0x106B0C51, 0x106E7AB8, 0x106EBAB9, 0x106EE697, 0x106F666C, 0x106F9AB6, 0x1070BAAC, 0x1070FAB4,
+	0x10713ABB, 0x10715AB5, 0x1071DAB3, 0x10727A96, 0x1072DAB1, 0x10735AAD, 0x1073C74E, 0x1073FAAF, 0x10741ABA, 0x10745AB0,
+	0x10751ABC, 0x10755AAE, 0x10756E9C, 0x107630C9, 0x1076BAB7, 0x1077BACD, 0x10783AC5, 0x1078AB9B, 0x107947A5, 0x1079881B,
+	0x1079DAC0, 0x107A6699, 0x107ACB12, 0x107B1AC3, 0x107B8998, 0x107BEDB0, 0x107C1AC8, 0x107D2FAC, 0x107D7ABF, 0x107DE698,
+	0x107E08D4, 0x107E2F08, 0x107E5AC9, 0x107E9ABD, 0x107EFAC6, 0x107F7AD0, 0x107FBAC1, 0x10807AC2, 0x10808DF8, 0x1080FAC7,
+	0x10817AC4, 0x10818FC7, 0x1081BACA, 0x1081C5DE, 0x10827ABE, 0x10841ACC, 0x10845ACB, 0x10852E8B, 0x10855AD2, 0x10859ADD,
+	0x1086271E, 0x1086BAE0, 0x10871ACE, 0x10879AD3, 0x1087B0CE, 0x1088DADC, 0x108930B4, 0x1089D0E8, 0x108AED18, 0x108B670B,
+	0x108C2F52, 0x108C5AE2, 0x108C6DDF, 0x108CC5AF, 0x108D3ADB, 0x108D7AD7, 0x108D8C52, 0x108DBAD1, 0x108DDAD9, 0x108DFADE,
+	0x108E2E4B, 0x108EA5A8, 0x108EFAD6, 0x108F3ADF, 0x108F4F58, 0x10905ADA, 0x10909AD5, 0x10916B13, 0x10920A8E, 0x10928A2A,
+	0x10933056, 0x10938F26, 0x1093FAE5, 0x10943AEE, 0x1095BAD8, 0x10964717, 0x10970B36, 0x10973AE3, 0x10977AE8, 0x10978C53,
+	0x1097FAE4, 0x10983AEB, 0x10988CFE, 0x1098DAEC, 0x109930B5, 0x10995AE1, 0x109966D7, 0x1099BAE7, 0x109A1AEA, 0x109A302A,
+	0x109ADAED, 0x109B3AE6, 0x109B5AE9, 0x109D8FC8, 0x109DD140, 0x109E9AF1, 0x109F9AF8, 0x109FFAF0, 0x10A00A41, 0x10A0DACF,
+	0x10A22F8C, 0x10A27020, 0x10A29AF7, 0x10A2BAF6, 0x10A2FAF2, 0x10A31AF3, 0x10A34615, 0x10A3FAF5, 0x10A43AEF, 0x10A4CD53,
+	0x10A59AF4, 0x10A5A5FC, 0x10A6AC60, 0x10A7AF81, 0x10A81AF9, 0x10A83B00, 0x10A86ED7, 0x10A91AFC, 0x10A92B14, 0x10A94A47,
+	0x10A97B02, 0x10A9C7FC, 0x10AABB03, 0x10AAEF59, 0x10AB1AFB, 0x10AB5AD4, 0x10AC7AFA, 0x10AD116E, 0x10AD2DE0, 0x10AD4F53,
+	0x10ADBB0A, 0x10AEFB10, 0x10AFDB11, 0x10B01B04, 0x10B08E96, 0x10B0FB0E, 0x10B11B06, 0x10B15B08, 0x10B21B12, 0x10B23B07,
+	0x10B29B0B, 0x10B2E652, 0x10B32E23, 0x10B37B0C, 0x10B39B0F, 0x10B49B05, 0x10B4CC05, 0x10B51B09, 0x10B529C6, 0x10B54B64,
+	0x10B5684F, 0x10B59072, 0x10B5D077, 0x10B5EAD2, 0x10B73B16, 0x10B75B14, 0x10B8316D, 0x10B93B13, 0x10B9B0D5, 0x10B9FB15,
+	0x10BA1B17, 0x10BABB18, 0x10BB9B1B, 0x10BBBB19, 0x10BC8DE1, 0x10BCBB1A, 0x10BD2ECB, 0x10BD5B0D, 0x10BEEAD3, 0x10BF3B1C,
+	0x10BF5B21, 0x10BF6C54, 0x10BFDB20, 0x10C05B01, 0x10C0DB22, 0x10C0EC28, 0x10C15B1D, 0x10C17B1F, 0x10C27B1E, 0x10C2D690,
+	0x10C2F681, 0x10C35B24, 0x10C45B23, 0x10C5B0D6, 0x10C5F87A, 0x10C61B25, 0x10C7FB26, 0x10C9BB27, 0x10C9C8D5, 0x10CA07B3,
+	0x10CA9B29, 0x10CAB23C, 0x10CB47D5, 0x10CB90F8, 0x10CBC831, 0x10CBFB2A, 0x10CCFB2B, 0x10CD6D0E, 0x10CE3B2C, 0x10CF2E38,
+	0x10CF65B8, 0x10D146A1, 0x10D17B31, 0x10D19B32, 0x10D27B2D, 0x10D2A9DC, 0x10D47B2E, 0x10D48E61, 0x10D53B2F, 0x10D55B30,
+	0x10D57B3A, 0x10D5FB34, 0x10D61B37, 0x10D6DB33, 0x10D89B35, 0x10D8DB36, 0x10D8EA56, 0x10D93B38, 0x10D96CE0, 0x10D9A875,
+	0x10D9C6E1, 0x10DA9B3B, 0x10DB26DE, 0x10DB7B41, 0x10DBDB3C, 0x10DBFB40, 0x10DC8EB8, 0x10DD3B3D, 0x10DD9B3E, 0x10DDAF27,
+	0x10DDCED8, 0x10DDFB42, 0x10DF0CBB, 0x10DF3B4C, 0x10DF7B48, 0x10DFC6A9, 0x10E01B46, 0x10E04FC9, 0x10E07B47, 0x10E0DB44,
+	0x10E11B45, 0x10E13B4A, 0x10E15B4D, 0x10E1BB4B, 0x10E23B49, 0x10E25B43, 0x10E30CF7, 0x10E35B54, 0x10E39028, 0x10E4BB52,
+	0x10E53B53, 0x10E69B4E, 0x10E6FB50, 0x10E77B51, 0x10E7FB4F, 0x10E92BE4, 0x10E97158, 0x10E99B58, 0x10E9DB59, 0x10EA7B5F,
+	0x10EAAB49, 0x10EAFB5B, 0x10EB3B5E, 0x10EBFB56, 0x10EC1B55, 0x10EC7B60, 0x10ECC69A, 0x10ED1B5C, 0x10ED5B61, 0x10EDDB5D,
+	0x10EE9B5A, 0x10EECD31, 0x10EF1B57, 0x10EFEE88, 0x10F05B65, 0x10F1B09A, 0x10F3FB64, 0x10F45B63, 0x10F57B6C, 0x10F5FB66,
+	0x10F67B6E, 0x10F750C6, 0x10F77B71, 0x10F7BB68, 0x10F81B69, 0x10F89B6D, 0x10F8DB70, 0x10F8FB6F, 0x10F97B67, 0x10FA1B6A,
+	0x10FA5B7B, 0x10FC1B74, 0x10FDFB72, 0x10FE5B73, 0x10FEDB78, 0x10FEFB79, 0x10FF26C9, 0x10FF67A1, 0x10FFDB77, 0x1100BB62,
+	0x1101BB76, 0x1101DB7A, 0x1101FB75, 0x11023B7C, 0x1102BB7E, 0x1102DB7D, 0x11043B80, 0x11045B7F, 0x11047B39, 0x1104FB84,
+	0x11063B81, 0x1106DB82, 0x11073B83, 0x11077B85, 0x1108088C, 0x11085B87, 0x11089B86, 0x1108CA8F, 0x11098933, 0x1109B6E5,
+	0x110A5B88, 0x110A6AB0, 0x110AE6D8, 0x110B3B89, 0x110B6631, 0x110BAB15, 0x110BDB8A, 0x110C2934, 0x110C5B8B, 0x110C65DF,
+	0x110D0F1C, 0x110D7B8C, 0x110E0B8A, 0x110E5B93, 0x110EBB90, 0x110EED0F, 0x110FBB91, 0x110FDB8E, 0x110FE81C, 0x11103B8D,
+	0x11105B94, 0x11110855, 0x11116C9C, 0x1111BB9A, 0x11125B96, 0x1112CC73, 0x1112FB95, 0x11133B98, 0x1113DB8F, 0x11145B99,
+	0x11149B9B, 0x11156EED, 0x1115DB97, 0x11161B9C, 0x11163B9E, 0x111688D1, 0x1116BB92, 0x1116E5BF, 0x1117FB9D, 0x11182999,
+	0x11185134, 0x11187B9F, 0x11189BA0, 0x1118AC55, 0x1119F0E0, 0x111A9BA1, 0x111AB094, 0x111B1BA2, 0x111B3BA3, 0x111B8FA2,
+	0x111BBBA4, 0x111BE97E, 0x111C30E1, 0x111D1BA9, 0x111E5BAA, 0x111E6B16, 0x111E9BA8, 0x111F10C7, 0x111F3BA5, 0x111F9BA7,
+	0x111FABBB, 0x111FCB9E, 0x11205BA6, 0x11209BAB, 0x1120EF61, 0x11215BAD, 0x11219BAC, 0x1122070C, 0x11224FCA, 0x11227BAE,
+	0x1123BBBA, 0x1123DBB0, 0x1124BBB1, 0x11255BB2, 0x11257BB3, 0x1126DBB7, 0x11271BB8, 0x11277BB6, 0x11283BB4, 0x11287BAF,
+	0x11289BB5, 0x11299BB9, 0x1129BDB5, 0x112AC666, 0x112BDBBC, 0x112BE81D, 0x112C1BBB, 0x112C9BC1, 0x112CDBC0, 0x112D5BC3,
+	0x112DBBC2, 0x112DFBC4, 0x112E4A90, 0x112E9BC5, 0x112EFBC6, 0x112FDBC7, 0x112FEBBC, 0x113030B6, 0x11307BC8, 0x1130CF62,
+	0x1130EE65, 0x11311BC9, 0x11315BCA, 0x113168A9, 0x1131E78B, 0x11327BCB, 0x1132CA0B, 0x1132EE60, 0x11331BCC, 0x113346EF,
+	0x11343BCD, 0x1134DBCF, 0x1134F0D7, 0x11353BCE, 0x11354B65, 0x11359BD0, 0x1135FBD1, 0x11365BD2, 0x1136674F, 0x11375BD3,
+	0x1137BBD4, 0x1137FBD5, 0x11381BD6, 0x113A46F0, 0x113B5BD7, 0x113B9BD8, 0x113BBBD9, 0x113C66B0, 0x113CCB47, 0x113CFBDA,
+	0x113E9BDB, 0x113F1BDC, 0x114008BE, 0x11404D79, 0x11407BDD, 0x11410876, 0x11414B75, 0x11419BE0, 0x1141CDE2, 0x11421BDF,
+	0x11426850, 0x1142DBDE, 0x1142ECB5, 0x1143078C, 0x11437BE1, 0x1143BBE2, 0x1143EB17, 0x1144688D, 0x1144BBE3, 0x11454FCB,
+	0x1145ABDD, 0x114627D6, 0x11467073, 0x11468C29, 0x1146DBE4, 0x11474B66, 0x11476D10, 0x11478B18, 0x11483BE5, 0x1148DBE8,
+	0x11491BE9, 0x114A097C, 0x114A2C80, 0x114A5BE7, 0x114A8B19, 0x114AAF1D, 0x114B7BE6, 0x114BCA0C, 0x114C0632, 0x114C5BED,
+	0x114C6877, 0x114CCA0E, 0x114D2A0D, 0x114D716C, 0x114D9BEC, 0x114DBBEB, 0x114DCC06, 0x114E07AC, 0x114E3162, 0x114E46D9,
+	0x114E6B1A, 0x114F9BEA, 0x11505BEF, 0x11509BF0, 0x1150BBEE, 0x1150E8D6, 0x1151309F, 0x11518A0F, 0x1151AE46, 0x11523BF3,
+	0x11526BBE, 0x1152ACE1, 0x11531095, 0x11535BF6, 0x1153C8EA, 0x11540BBD, 0x11543BF2, 0x11547BF7, 0x115488EB, 0x1154BBF4,
+	0x1154DBF5, 0x11551BF1, 0x11558BE0, 0x1155AE07, 0x11560CCE, 0x1156469B, 0x11572EEE, 0x115787A2, 0x1157ED32, 0x11585BFA,
+	0x11589BF8, 0x1158ECEB, 0x11596BBF, 0x11598750, 0x1159BBF9, 0x1159EB7A, 0x115A5108, 0x115AD15F, 0x115B5BFB, 0x115B7C07,
+	0x115B8D33, 0x115BDC06, 0x115C1C03, 0x115C3C0B, 0x115C5C04, 0x115C9C00, 0x115CCD7A, 0x115CFBFE, 0x115D7BFC, 0x115DB080,
+	0x115DCA10, 0x115E3C01, 0x115E7BFD, 0x115EFC05, 0x115F0AD4, 0x115F48BF, 0x115FCCB8, 0x11600FE4, 0x11602639, 0x116045E0,
+	0x11608DE3, 0x1160FC09, 0x11619C08, 0x1161CE24, 0x11621C0D, 0x11629C02, 0x1162DC0C, 0x1162FC0E, 0x116328AA, 0x11635C0A,
+	0x11636935, 0x1163AA53, 0x11641C0F, 0x116430B7, 0x1164DC12, 0x11651C15, 0x11657C13, 0x11658F14, 0x11667C10, 0x1167281E,
+	0x1167DC14, 0x11683C16, 0x11693C1A, 0x11699C17, 0x1169DC19, 0x1169FC18, 0x116ADC1B, 0x116B0A2F, 0x116B5C1D, 0x116B7C1C,
+	0x116B8F48, 0x116BFC1F, 0x116CC878, 0x116D7C1E, 0x116D9C20, 0x116DFC21, 0x116E07A3, 0x116E39FF, 0x116E4B37, 0x116E9C22,
+	0x116EE8EC, 0x116FBC23, 0x11701C24, 0x117069DD, 0x1171558C, 0x11719C25, 0x1171DC26, 0x11720A91, 0x11725C27, 0x11727C28,
+	0x1172DC29, 0x11733C2A, 0x11735C2B, 0x1186ECCA, 0x11875C2C, 0x1187FC2E, 0x11883C2D, 0x1188CDE4, 0x11891C2F, 0x11894FCC,
+	0x11899C30, 0x1189DC31, 0x118A1C32, 0x118ABC33, 0x118B4E18, 0x118C2B1B, 0x118C5C34, 0x118D494B, 0x118D71AC, 0x118D9C35,
+	0x118F1C36, 0x118F2F1E, 0x118F5C37, 0x118F9C3F, 0x11905C38, 0x1190BC3A, 0x11913C39, 0x11915C3B, 0x11918FE5, 0x1191BC3C,
+	0x1191DC3D, 0x11929C3E, 0x11931C40, 0x1193A6CC, 0x1193CD65, 0x11940F49, 0x119429A0, 0x11944936, 0x1194EF2E, 0x1195069D,
+	0x11952ECC, 0x11955C43, 0x11956751, 0x11958BD3, 0x1195BC42, 0x1195DC47, 0x1195ED19, 0x11961061, 0x11965C45, 0x11967C46,
+	0x1196878D, 0x1196DC48, 0x1196EE83, 0x11970C9D, 0x11976EEF, 0x11978D9C, 0x1197BC44, 0x1197EFE6, 0x119806AA, 0x11983C4A,
+	0x11985147, 0x11986D40, 0x11989164, 0x1198EA11, 0x11991C49, 0x11994C6F, 0x1199BC5A, 0x1199CC07, 0x119A2E36, 0x119A6F2F,
+	0x119B5C4D, 0x119B69DE, 0x119B8A12, 0x119BCB1C, 0x119C0E85, 0x119C48AB, 0x119C7C4C, 0x119C9C4B, 0x119CCF4A, 0x119D4A3F,
+	0x119DADB1, 0x119F5C4F, 0x119F7C50, 0x119F8937, 0x119FBC4E, 0x11A09C51, 0x11A0BC52, 0x11A0FC54, 0x11A10C61, 0x11A15C53,
+	0x11A16764, 0x11A1BC56, 0x11A1FC55, 0x11A21C57, 0x11A27C59, 0x11A29C5B, 0x11A2DC5C, 0x11AC8BD4, 0x11ACCA4D, 0x11ACFC5D,
+	0x11AD66F1, 0x11ADBC5E, 0x11AE0C56, 0x11AE3C5F, 0x11AE7C60, 0x11AE8F4B, 0x11AEE78E, 0x11B03C61, 0x11B0AD34, 0x11B1463A,
+	0x11B33C62, 0x11B46A6F, 0x11B50B96, 0x11B66C6B, 0x11B75C65, 0x11B7DC64, 0x11B85C63, 0x11B97C6B, 0x11B99C69, 0x11B9FC66,
+	0x11BADC68, 0x11BB5C67, 0x11BB7C6A, 0x11BBA7D7, 0x11BBFC6E, 0x11BC2BD5, 0x11BC7C6F, 0x11BD08D7, 0x11BD5C6C, 0x11BD7C6D,
+	0x11BDF148, 0x11BE6D35, 0x11BEAC08, 0x11BF9C70, 0x11BFFC73, 0x11C11C71, 0x11C13C72, 0x11C150B8, 0x11C1EDE5, 0x11C21C76,
+	0x11C3BC74, 0x11C3DC75, 0x11C3FC77, 0x11C55C88, 0x11C61C7A, 0x11C69C7B, 0x11C6BC79, 0x11C85C78, 0x11C88D7B, 0x11C8FC80,
+	0x11C91C84, 0x11C93C81, 0x11C95C7C, 0x11C99C82, 0x11CA1C83, 0x11CABC8A, 0x11CB3C85, 0x11CBEBD6, 0x11CC1C87, 0x11CC7C89,
+	0x11CC9C86, 0x11CE5C8C, 0x11CE8A92, 0x11CEDC8B, 0x11CF9C8D, 0x11D03C8E, 0x11D09C91, 0x11D0BC90, 0x11D0FC8F, 0x11D15C93,
+	0x11D17C92, 0x11D1B074, 0x11D23C95, 0x11D27C94, 0x11D29C96, 0x11D33C97, 0x11D43C99, 0x11D55C98, 0x11D56B67, 0x11D59C9A,
+	0x11D5E82B, 0x11D61C9B, 0x11D63C9D, 0x11D7DC9E, 0x11D8BC9F, 0x11D8DC9C, 0x11D91CA0, 0x11D94A54, 0x11D97CA1, 0x11D9878F,
+	0x11D9A852, 0x11DA48AC, 0x11DB7CA2, 0x11DBEE2E, 0x11DC4D9D, 0x11DC7CA3, 0x11DD7CA6, 0x11DF0A32, 0x11DF7CA5, 0x11DF9CA4,
+	0x11DFA879, 0x11DFDCA7, 0x11E066F2, 0x11E0BCA9, 0x11E1299A, 0x11E15CA8, 0x11E19CB1, 0x11E25CAB, 0x11E27CAD, 0x11E28FA3,
+	0x11E2BCAA, 0x11E33CAC, 0x11E37CB0, 0x11E39CAE, 0x11E3A790, 0x11E3FCAF, 0x11E4DCB2, 0x11E52E79, 0x11E55116, 0x11E5EA93,
+	0x11E67CB3, 0x11E71081, 0x11E73CB5, 0x11E77CB4, 0x11E7DCB8, 0x11E7F0A0, 0x11E85CB7, 0x11E8870D, 0x11E8BCB6, 0x11E8DCBB,
+	0x11E93CBA, 0x11E99CB9, 0x11E9AD91, 0x11E9DCBC, 0x11EAFCBD, 0x11EB9CBE, 0x11EBE94C, 0x11EC2844, 0x11EC5CC0, 0x11EC7CC1,
+	0x11EC9CC2, 0x11F36B68, 0x11F39CC3, 0x11F3CA2B, 0x11F3FCC4, 0x11F47CC5, 0x11F4F25F, 0x11F5125E, 0x11F5BCC6, 0x11F5D9D0,
+	0x11F5FCC7, 0x11F60CC3, 0x11F62B4A, 0x11F64E5F, 0x11F6FCC8, 0x11F74F93, 0x11F76D52, 0x11F7895E, 0x11F7ECC8, 0x11F84609,
+	0x11F89018, 0x11F8AB76, 0x11F9C87D, 0x11FA281F, 0x11FA8F94, 0x11FB5CC9, 0x11FC5CCB, 0x11FCBCCA, 0x11FCC69E, 0x11FD2E34,
+	0x11FD5CCC, 0x11FD6E97, 0x11FDAD92, 0x11FDFCCD, 0x11FE0AB1, 0x11FE9CCF, 0x11FEF040, 0x11FF1CDE, 0x11FF3CD1, 0x11FF5CD2,
+	0x11FFAD47, 0x12000C9E, 0x12002C57, 0x12006DE6, 0x1200BCD0, 0x1200C7B4, 0x12017CD9, 0x1201BCD6, 0x1201DCE3, 0x1201EDE7,
+	0x12020D00, 0x12023CD3, 0x12026D7C, 0x12028DB2, 0x1202BCD4, 0x1202DCD8, 0x1202EB80, 0x12032E87, 0x12034D4A, 0x1203ABC0,
+	0x1203DCD7, 0x1203EC6C, 0x12040C62, 0x12043CD5, 0x120445A7, 0x12047141, 0x1204FCDA, 0x1205CC9F, 0x12062A94, 0x12064B69,
+	0x1206BCDC, 0x1206DCDB, 0x120705ED, 0x12073CDD, 0x12078F0E, 0x1207DCE5, 0x12082E19, 0x12084B8B, 0x1208ACF8, 0x1208E836,
+	0x12093CE4, 0x12095096, 0x1209661E, 0x1209AF95, 0x1209C69F, 0x1209FCDF, 0x120A1CE0, 0x120A3CE1, 0x120A5CE2, 0x120A6DF9,
+	0x120A8CC2, 0x120AA5E1, 0x120ADCE6, 0x120B1CE7, 0x120B3F21, 0x120B8C7B, 0x120BDCE8, 0x120C0653, 0x120C2C2B, 0x120C68AD,
+	0x120CB0B9, 0x120D1CE9, 0x120D2D8B, 0x120DAC58, 0x120DCA55, 0x120DFCEA, 0x120E5CED, 0x120EAAC5, 0x120EDCEB, 0x120EEC0A,
+	0x120F0C09, 0x120F45E2, 0x120F9109, 0x120FBCEF, 0x120FEEF0, 0x12101CF1, 0x12103CF0, 0x12105CEE, 0x12107904, 0x12108752,
+	0x1210FCCE, 0x12113CF3, 0x12115CF2, 0x1211FCF4, 0x12123097, 0x12146E1F, 0x1214CFCD, 0x12151CF5, 0x12154A57, 0x1215FCF6,
+	0x12163CF7, 0x1216BCF8, 0x12170D80, 0x121825E8, 0x12194938, 0x1219D159, 0x121B7CFC, 0x121C2853, 0x121C5CF9, 0x121C9CFA,
+	0x121D0F54, 0x121DA6F3, 0x121EB098, 0x121EE7FD, 0x121FADB3, 0x12205CFD, 0x12225CFE, 0x12233CFF, 0x1225AD81, 0x12261D01,
+	0x12265D00, 0x12292E11, 0x12295D02, 0x12296A95, 0x12298A5E, 0x1229AE7A, 0x1229CD11, 0x122A4A70, 0x122A8B8C, 0x122ADD03,
+	0x122B1D04, 0x122C4B7C, 0x122C7D05, 0x122CBD06, 0x122D3D07, 0x122D50CF, 0x122D8A96, 0x122E5D09, 0x122E7D08, 0x122EA939,
+	0x122EE953, 0x122F09DF, 0x12305D0C, 0x1230EAC6, 0x12313D0B, 0x12317D0A, 0x1231ACA7, 0x123208ED, 0x12324BC1, 0x1232EEAE,
+	0x12338A98, 0x12345D0D, 0x12348B1D, 0x12355D10, 0x12357D0E, 0x1235FD0F, 0x12369D12, 0x1236BD11, 0x12370B38, 0x12375D13,
+	0x12381D14, 0x12383D15, 0x1238CECE, 0x1238E991, 0x12390A5F, 0x12393D16, 0x12397D17, 0x123990E2, 0x1239AAA4, 0x1239D06C,
+	0x1239F10A, 0x123A1D18, 0x123A2820, 0x123ADD19, 0x123B0D82, 0x123B7D1C, 0x123B8718, 0x123BAB6A, 0x123BFD1A, 0x123C3D1B,
+	0x123C6D5E, 0x123CCFF4, 0x123CE83A, 0x123EBD1E, 0x123EDD1F, 0x123F9D1D, 0x123FFD21, 0x1241AE1D, 0x1241C6E2, 0x12423D25,
+	0x12429D22, 0x1242BD24, 0x1243DD20, 0x12453D6E, 0x12459D23, 0x12469129, 0x1246E8D8, 0x1247FD2D, 0x12488D93, 0x1248BD28,
+	0x12491D2B, 0x12493D29, 0x12497D2E, 0x124A1D2F, 0x124AFD27, 0x124B5D34, 0x124B6654, 0x124BDD26, 0x124C4EAB, 0x124C9D2A,
+	0x124CCB1E, 0x124E293A, 0x124FCFE7, 0x12500822, 0x12506AA5, 0x1250ADFA, 0x12522C0C, 0x12527D32, 0x1252BD2C, 0x1252DD31,
+	0x12531041, 0x12534D36, 0x12537D33, 0x12539D30, 0x1255AC0B, 0x1256FD37, 0x12573D36, 0x1259FD35, 0x125A4FCE, 0x125C8ADB,
+	0x125D3D38, 0x125D4F9D, 0x125DA633, 0x125E4F25, 0x125E6D12, 0x125F07D8, 0x125F5D3A, 0x125F893C, 0x1260C9CB, 0x1261FD39,
+	0x12620B8D, 0x12630B8E, 0x12633D40, 0x12635D42, 0x12640B39, 0x12645D41, 0x12647D43, 0x1264C811, 0x12650F24, 0x12656A60,
+	0x12659142, 0x1265DD3C, 0x1265E9B6, 0x1266515E, 0x1266BD45, 0x12675D44, 0x12677D46, 0x12689D3B, 0x12696E27, 0x1269ADB4,
+	0x126A8D55, 0x126ADD4B, 0x126B6CE2, 0x126B9D47, 0x126C1D48, 0x126D884C, 0x126DDD4A, 0x126EA8AE, 0x126F9D49, 0x126FCB1F,
+	0x12718719, 0x12729D4F, 0x1272C97D, 0x1272EC59, 0x12734D48, 0x1274E6DA, 0x12759D4D, 0x1275BD4E, 0x1275CD41, 0x12761D4C,
+	0x12773D50, 0x12787D56, 0x12791D59, 0x127A1D58, 0x127A2D8C, 0x127ADD51, 0x127AFD52, 0x127B1D55, 0x127BBD57, 0x127C27FE,
+	0x127C9D5A, 0x127CBD54, 0x127D1D53, 0x12807D5E, 0x1280FD5F, 0x12821D60, 0x12827D5D, 0x12829D5C, 0x12830B20, 0x12832DE8,
+	0x12835D5B, 0x12843D64, 0x12857D62, 0x1286BD63, 0x1286DD61, 0x12870CB6, 0x12875D65, 0x12883D66, 0x12889D68, 0x128A2753,
+	0x128A5D67, 0x128A7078, 0x128B5D73, 0x128B7D69, 0x128BDD6C, 0x128C1D6A, 0x128C5D6B, 0x128D5D6D, 0x128E1D6F, 0x128EBD70,
+	0x128EFD71, 0x128F9D74, 0x128FBD72, 0x128FDD75, 0x128FFD77, 0x12903D76, 0x12AEED37, 0x12B01065, 0x12B05D78, 0x12B06C0D,
+	0x12B0FD79, 0x12B12F82, 0x12B15D7A, 0x12B166CA, 0x12B1E61B, 0x12B22755, 0x12B26754, 0x12B29D7B, 0x12B2DD7C, 0x12B31D7D,
+	0x12B33D7E, 0x12B41D80, 0x12B44756, 0x12B466F4, 0x12B4893D, 0x12B4AEB4, 0x12B4FD82, 0x12B51D81, 0x12B5BD83, 0x12B6463B,
+	0x12B73D86, 0x12B77D85, 0x12B79D84, 0x12B7DD87, 0x12B87D8A, 0x12B8E5C5, 0x12B95D88, 0x12B99D8C, 0x12B9BD8B, 0x12BA9D8E,
+	0x12BABD8D, 0x12BADD8F, 0x12BB0DEC, 0x12BB9D90, 0x12BC3D91, 0x12BC5D93, 0x12BCBD92, 0x12C38F4C, 0x12C43D94, 0x12C51D95,
+	0x12C549A3, 0x12C5DD96, 0x12C5FD97, 0x12C64FE8, 0x12C76C2A, 0x12C7E5A2, 0x12C80C89, 0x12C85D98, 0x12C88F4D, 0x12C97D9B,
+	0x12C99D99, 0x12C9A93E, 0x12C9FD9A, 0x12CA08C0, 0x12CB6F83, 0x12CB9D9D, 0x12CBBD9F, 0x12CBDD9E, 0x12CBFDA0, 0x12CC4600,
+	0x12CC6B77, 0x12CC8ADC, 0x12CCA757, 0x12CCDDA1, 0x12CD4E86, 0x12CD9DA3, 0x12CE0601, 0x12CE5DA2, 0x12CE6D42, 0x12CEB10B,
+	0x12CECDE9, 0x12CEFD9C, 0x12CF10E4, 0x12CF48AF, 0x12CFB0BA, 0x12D0A837, 0x12D0D0F2, 0x12D10847, 0x12D14CA0, 0x12D17A40,
+	0x12D1BDA4, 0x12D1C6CB, 0x12D1EB8F, 0x12D286F5, 0x12D2BDA6, 0x12D2FDA7, 0x12D31DA5, 0x12D32884, 0x12D3699B, 0x12D38B21,
+	0x12D40602, 0x12D47117, 0x12D4FDA9, 0x12D51CEC, 0x12D55DA8, 0x12D61DAC, 0x12D63DAA, 0x12D65DAB, 0x12D69DAD, 0x12D6DDAE,
+	0x12D6F12A, 0x12D71DAF, 0x12D73DB0, 0x12D76BC7, 0x12D78EB9, 0x12D80B9D, 0x12D82765, 0x12D89099, 0x12D8A6AB, 0x12D8CA97,
+	0x12D8E8D9, 0x12D93DB3, 0x12D97DB2, 0x12D98A13, 0x12D9BDB4, 0x12D9DDB1, 0x12DA29C7, 0x12DABDB8, 0x12DADB6B, 0x12DB3294,
+	0x12DB6B97, 0x12DB9DB6, 0x12DC50E3, 0x12DC6E2F, 0x12DD060A, 0x12DD4BE1, 0x12DD6A34, 0x12DE0F75, 0x12DE461F, 0x12DED12B,
+	0x12DEF0CB, 0x12DF3DB9, 0x12DF6DA4, 0x12E00A79, 0x12E09DBA, 0x12E0DDBB, 0x12E0EB6B, 0x12E11DBC, 0x12E1512C, 0x12E1BDB7,
+	0x12E1DDBE, 0x12E1FDC0, 0x12E23DBF, 0x12E27DBD, 0x12E2DDC1, 0x12E33DC2, 0x12E38C5A, 0x12E3C6A0, 0x12E49DC3, 0x12E4F036,
+	0x12E55DC4, 0x12E61DC5, 0x12E65149, 0x12E715D0, 0x12E73DC6, 0x12E7BDC7, 0x12E7DDC8, 0x12E85DCC, 0x12E89DC9, 0x12E8DDCA,
+	0x12E91DCB, 0x12E93DCD, 0x12EA4BC2, 0x12EAD075, 0x12EB2BC3, 0x12EB9DCE, 0x12EBCEF1, 0x12EC1DCF, 0x12EC3EF2, 0x12EC504A,
+	0x12EC9DD0, 0x12ECDDD1, 0x12ED1DD2, 0x12ED26F6, 0x12ED7DD4, 0x12EDAB78, 0x12EE3DD5, 0x12EE8843, 0x12EF3DD6, 0x12EF5DDA,
+	0x12EF9DD8, 0x12F03DD9, 0x12F08713, 0x12F0BDD7, 0x12F0DDDB, 0x12F17DDC, 0x12F1A5C6, 0x12F1FDDD, 0x12F21DDE, 0x12F30B22,
+	0x12F39DDF, 0x12F407A6, 0x12F47DE2, 0x12F4DDE1, 0x12F51DE0, 0x12F57C11, 0x12F5AF9A, 0x12F67DE3, 0x12F69DE4, 0x12F87DE5,
+	0x12F8DDE6, 0x12F91DE7, 0x12F97DE8, 0x12FA6758, 0x12FB9DE9, 0x12FDBDEA, 0x12FDCE42, 0x12FE5DEC, 0x12FE6679, 0x12FEBDEF,
+	0x12FEDDEE, 0x12FF6603, 0x12FFE7FF, 0x13002F85, 0x13004D38, 0x13006960, 0x1300A940, 0x1300CAC7, 0x13010B7B, 0x13019DF1,
+	0x1301FDF0, 0x130210A1, 0x13022766, 0x13024ED0, 0x13026E1A, 0x1302EB9C, 0x1303110C, 0x1303487A, 0x13043DF4, 0x13049DF3,
+	0x13058FEA, 0x1305ADEA, 0x1306862F, 0x1306FDF5, 0x13071DF2, 0x13076F30, 0x130790CA, 0x1307BDF6, 0x1308DDF7, 0x13097DF9,
+	0x13098CA8, 0x1309A6FA, 0x1309C6FB, 0x1309FDF8, 0x130A8767, 0x130AA8B0, 0x130B0768, 0x130B6D9E, 0x130BD11E, 0x130CE8DA,
+	0x130D7DFA, 0x130DFDFB, 0x130E1DFC, 0x130E3E00, 0x130E7E02, 0x130E9E01, 0x13150F57, 0x13155E03, 0x1315FE04, 0x13163E05,
+	0x1316DE06, 0x13187E08, 0x13189E07, 0x1318DE09, 0x131B6EF2, 0x131B9A0A, 0x131BEB48, 0x131C4791, 0x131D3E0A, 0x131D7E0B,
+	0x131DB26A, 0x131DD69A, 0x131DEED1, 0x131E45F9, 0x131E85B9, 0x131F8A14, 0x131FAFCF, 0x131FCB3C, 0x13207E0C, 0x1320B05D,
+	0x13213E0D, 0x132150BB, 0x13218621, 0x132209E0, 0x13225E0E, 0x132266AC, 0x13229E0F, 0x13231E10, 0x1323BE12, 0x1323DE13,
+	0x13241E15, 0x13243E11, 0x13249E14, 0x13250759, 0x13259E16, 0x1325DE17, 0x1327BE18, 0x1327DE19, 0x13285E1A, 0x1328BE1C,
+	0x13293E1B, 0x13297E1E, 0x13299E21, 0x132A1E1D, 0x132A3E1F, 0x132A5E20, 0x132ABE22, 0x132AE800, 0x1332CA71, 0x1332FE23,
+	0x13331E24, 0x13332941, 0x1334BE25, 0x133506DD, 0x13358E6E, 0x1335BE26, 0x1335DE27, 0x13366CF9, 0x13368E29, 0x13379E28,
+	0x13382E9D, 0x13388C8A, 0x1338A637, 0x1338C82C, 0x1339082D, 0x133A0D13, 0x133A3E2D, 0x133A482E, 0x133AA6AD, 0x133B1E2C,
+	0x133B7E2A, 0x133BBE2B, 0x133BFE29, 0x133C5E37, 0x133DBE2E, 0x133DDE2F, 0x133E3E30, 0x133E5E31, 0x133F1E33, 0x133F7E32,
+	0x133FEAB8, 0x13403E34, 0x1340BE36, 0x1341C792, 0x1341FE35, 0x13424C5B, 0x134268B1, 0x13433E38, 0x13450C8B, 0x13457E39,
+	0x13460DEB, 0x1346FE3A, 0x1347DE40, 0x13481E3D, 0x13485E3C, 0x13487E3E, 0x1348BE3B, 0x1349BE42, 0x134ABE41, 0x134AFE44,
+	0x134B4801, 0x134B7E43, 0x134BFE45, 0x134C5E46, 0x134C9E48, 0x134CBE47, 0x134D3E49, 0x134D5E4B, 0x134D7E4A, 0x1355095C,
+	0x1355BE4C, 0x13561E4D, 0x135706DB, 0x13579E4E, 0x13581E4F, 0x13588B91, 0x1359FE50, 0x135A3E51, 0x135A7E52, 0x135A9E53,
+	0x135B0942, 0x135BDE54, 0x135BFE55, 0x135C5E56, 0x135C7E57, 0x135CDE58, 0x135D4EAF, 0x135D7E5A, 0x135DAF05, 0x135DDE5B,
+	0x135DFE59, 0x135E3E5D, 0x135E9E5C, 0x135EFE5E, 0x135F7E5F, 0x1360DE60, 0x13631E61, 0x13635E62, 0x1363FE63, 0x13645E64,
+	0x13647E65, 0x1364BE66, 0x1364FE67, 0x13651E68, 0x13653E69, 0x13655E6A, 0x1365DE6B, 0x1365FE6C, 0x13663694, 0x13665E6D,
+	0x13677976, 0x13678793, 0x136826C0, 0x13684970, 0x13687E6F, 0x13689E6E, 0x1368B023, 0x1369BE71, 0x1369DE72, 0x1369FE70,
+	0x136A3E73, 0x136A9002, 0x136B1E74, 0x136B47DB, 0x136DF144, 0x136E9E75, 0x13707E77, 0x1371C5BC, 0x13723E78, 0x13724F69,
+	0x13727E76, 0x1372DE79, 0x1372FE7A, 0x1373FE7B, 0x13741E7C, 0x13751E7D, 0x1375500E, 0x137569CC, 0x1375A9B8, 0x1375CC0E,
+	0x13769E7E, 0x13773E81, 0x13781E7F, 0x1378DE82, 0x137928EF, 0x13795E80, 0x1379FE83, 0x137A3E84, 0x137A5E85, 0x137A9E89,
+	0x137AC9C9, 0x137B6CA2, 0x137C3E8A, 0x137C5E87, 0x137C7E86, 0x137C9E88, 0x137D087E, 0x137E1E8E, 0x137E3E8D, 0x137E5E8C,
+	0x137EA5B1, 0x13809E98, 0x1380DE94, 0x13811E95, 0x13813E91, 0x13815E97, 0x13819E93, 0x1381A702, 0x1382116B, 0x13825E96,
+	0x13827E92, 0x13829E90, 0x1382BE8F, 0x13837E9A, 0x13843E9D, 0x13849E9C, 0x1384BE9B, 0x1385AF28, 0x1385DE99, 0x1385E5F1,
+	0x13861E9E, 0x13865EA0, 0x1387270F, 0x13875E8B, 0x13876616, 0x1387DEA2, 0x1388DEA1, 0x1388FE9F, 0x13890CCC, 0x138A5010,
+	0x138AF118, 0x138B5EA3, 0x138C1EA4, 0x138CFEA5, 0x138EDEA6, 0x138F1EA7, 0x139CAD39, 0x139CFEA8, 0x139D2EB5, 0x139D7EAD,
+	0x139D9EA9, 0x139E1EAA, 0x139E6FD0, 0x139E9042, 0x139ECE0E, 0x13A07EAE, 0x13A0DEAF, 0x13A0EDFC, 0x13A11EAC, 0x13A13EAB,
+	0x13A1C668, 0x13A25EB7, 0x13A2BEB6, 0x13A36655, 0x13A3FEB4, 0x13A47EB3, 0x13A4DEB1, 0x13A5071B, 0x13A55EB0, 0x13A56A30,
+	0x13A58667, 0x13A76943, 0x13A7DEBA, 0x13A7FEB9, 0x13A83EB8, 0x13A89EB5, 0x13A8DEBB, 0x13A91EBC, 0x13AA1EC4, 0x13AA3EC3,
+	0x13AB3EC5, 0x13AB860C, 0x13ABBEC0, 0x13ABDEC1, 0x13AC0954, 0x13AC3037, 0x13AC9EC2, 0x13AD8FD1, 0x13ADFECA, 0x13AE5EC6,
+	0x13AF5ECB, 0x13B0FEC8, 0x13B13EC7, 0x13B1E87B, 0x13B35ECC, 0x13B49ECD, 0x13B53ECE, 0x13B57EC9, 0x13B5FEB2, 0x13B65ECF,
+	0x13B68D5F, 0x13B71ED3, 0x13B75ED4, 0x13B77ED2, 0x13B83ED1, 0x13B85ED7, 0x13B89ED0, 0x13B8DED5, 0x13B9FED6, 0x13BA7ED9,
+	0x13BB3ED8, 0x13BCDEDB, 0x13BDBEDC, 0x13BDFEDD, 0x13BE5168, 0x13BF1EDA, 0x13BF2CA9, 0x13BF49AB, 0x13BFBEDE, 0x13C35EDF,
+	0x13C37EE0, 0x13C3DEE1, 0x13CEBEE2, 0x13CF08B2, 0x13CF3EE3, 0x13CFBEE4, 0x13CFEA2D, 0x13D03EE5, 0x13D11EE6, 0x13D17EE7,
+	0x13D19EE8, 0x13D23EEB, 0x13D25EE9, 0x13D2715B, 0x13D2BEEA, 0x13D2F12D, 0x13D3BEEC, 0x13D3F119, 0x13D4BEED, 0x13D4CE9E,
+	0x13D53EEE, 0x13D55EF0, 0x13D5BEF1, 0x13D71EEF, 0x13D7294D, 0x13D7504B, 0x13D77003, 0x13D79435, 0x13D7D6C0, 0x13D7F01B,
+	0x13D88669, 0x13D99EF3, 0x13D9A7AF, 0x13D9DEF4, 0x13D9FEF5, 0x13DA1EF6, 0x13DA4955, 0x13DA9EF7, 0x13DB17D2, 0x13DB3059,
+	0x13DB6CA1, 0x13DB9EF8, 0x13DBBEFA, 0x13DBDEF9, 0x13DC1EFB, 0x13DCBEFC, 0x13DD1EFD, 0x13DDFEFE, 0x13DE9F00, 0x13DEDF01,
+	0x13DEFF02, 0x13DF3F03, 0x13DF7F04, 0x13DF9F05, 0x13DFBF06, 0x13E0FF07, 0x13E11F08, 0x13E1CD83, 0x13E268DB, 0x13E2BF0A,
+	0x13E40C2C, 0x13E43F0B, 0x13E59F0C, 0x13E76F00, 0x13E7DF0D, 0x13E95F0E, 0x13E978D6, 0x13E9DC58, 0x13E9FDEB, 0x13EA5F0F,
+	0x13EA9F10, 0x13EBFF12, 0x13EC1F13, 0x13EC3F14, 0x13EC512E, 0x13EC7F11, 0x13ECDF15, 0x13ECFF16, 0x13ED5F18, 0x13ED9F17,
+	0x13EE5F1A, 0x13EEDF1B, 0x13EEFF19, 0x13F1B0F4, 0x13F2BF1C, 0x13F39F1D, 0x13F3B8F3, 0x13F41F1E, 0x1FE02009, 0x1FE06054,
+	0x1FE08050, 0x1FE0A053, 0x1FE0C055, 0x1FE10029, 0x1FE1202A, 0x1FE14056, 0x1FE1603B, 0x1FE18003, 0x1FE1C004, 0x1FE1E01E,
+	0x1FE200CF, 0x1FE220D0, 0x1FE240D1, 0x1FE260D2, 0x1FE280D3, 0x1FE2A0D4, 0x1FE2C0D5, 0x1FE2E0D6, 0x1FE300D7, 0x1FE320D8,
+	0x1FE34006, 0x1FE36007, 0x1FE38043, 0x1FE3A041, 0x1FE3C044, 0x1FE3E008, 0x1FE40057, 0x1FE420E0, 0x1FE440E1, 0x1FE460E2,
+	0x1FE480E3, 0x1FE4A0E4, 0x1FE4C0E5, 0x1FE4E0E6, 0x1FE500E7, 0x1FE520E8, 0x1FE540E9, 0x1FE560EA, 0x1FE580EB, 0x1FE5A0EC,
+	0x1FE5C0ED, 0x1FE5E0EE, 0x1FE600EF, 0x1FE620F0, 0x1FE640F1, 0x1FE660F2, 0x1FE680F3, 0x1FE6A0F4, 0x1FE6C0F5, 0x1FE6E0F6,
+	0x1FE700F7, 0x1FE720F8, 0x1FE740F9, 0x1FE7602D, 0x1FE7A02E, 0x1FE7C00F, 0x1FE7E011, 0x1FE8000D, 0x1FE82101, 0x1FE84102,
+	0x1FE86103, 0x1FE88104, 0x1FE8A105, 0x1FE8C106, 0x1FE8E107, 0x1FE90108, 0x1FE92109, 0x1FE9410A, 0x1FE9610B, 0x1FE9810C,
+	0x1FE9A10D, 0x1FE9C10E, 0x1FE9E10F, 0x1FEA0110, 0x1FEA2111, 0x1FEA4112, 0x1FEA6113, 0x1FEA8114, 0x1FEAA115, 0x1FEAC116,
+	0x1FEAE117, 0x1FEB0118, 0x1FEB2119, 0x1FEB411A, 0x1FEB602F, 0x1FEB8022, 0x1FEBA030, 0x1FFC6010, 0x1FFCA04F,
+};
+
+
+
+/*---- Class QrEncoder ----*/
+
+QrEncoder::QrEncoder() :
+	templateBytes(0),
+	highWaterMark(0) {}
+
+
+const QrCode &QrEncoder::encodeSegments(const vector<QrSegment> &segs, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	if (!(QrCode::MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= QrCode::MAX_VERSION) || mask < -1 || mask > 7)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	const QrCode::Plan plan = QrCode::planSegments(segs, ecl, minVersion, maxVersion, boostEcl);
+	dataCodewords.resize(static_cast<size_t>(plan.dataCapacityBits / 8));
+	QrCode::makeDataCodewords(nullptr, segs, plan, dataCodewords.data());
+	
+	std::unique_ptr<QrCode::Template> &tmpl = templates[static_cast<int>(plan.errorCorrectionLevel) * 41 + plan.version];
+	if (!tmpl) {
+		tmpl.reset(new QrCode::Template(QrCode::makeTemplate(plan.version, plan.errorCorrectionLevel)));
+		templateBytes += QrCode::getMemoryUsage(tmpl->modules) + QrCode::getMemoryUsage(tmpl->isFunction)
+			+ tmpl->rsDivisor.capacity();
+	}
+	if (result)
+		result->reset(*tmpl, spareRows);
+	else
+		result.reset(new QrCode(*tmpl));
+	
+	// Same steps as the QrCode constructor, keeping every buffer
+	size_t rawCodewords = static_cast<size_t>(QrCode::getNumRawDataModules(plan.version) / 8);
+	allCodewords.resize(rawCodewords);
+	eccCodewords.resize(rawCodewords - dataCodewords.size());
+	result->addEccAndInterleave(dataCodewords.data(), tmpl->rsDivisor.data(), allCodewords.data(), eccCodewords.data());
+	result->drawCodewords(allCodewords);
+	result->applyFinalMask(mask);
+	
+	// Like finishMask(), leave the result without function module flags, so that copies of it are no
+	// larger than other QR Codes, but keep the rows as spares for reset() instead of freeing them
+	for (QrCode::Grid::value_type &row : result->isFunction)
+		spareRows.push_back(std::move(row));
+	result->isFunction.clear();
+	highWaterMark = std::max(getRetainedBytes(), highWaterMark);
+	return *result;
+}
+
+
+const QrCode &QrEncoder::encodeText(const char *text, QrCode::Ecc ecl) {
+	return encodeSegments(QrSegment::makeSegments(text), ecl);
+}
+
+
+size_t QrEncoder::getRetainedBytes() const {
+	size_t sum = templateBytes + (result ? result->getMemoryUsage() : 0) + QrCode::getMemoryUsage(spareRows);
+	sum += dataCodewords.capacity() + allCodewords.capacity() + eccCodewords.capacity();
+	return sum;
+}
+
+
+size_t QrEncoder::getHighWaterMark() const {
+	return highWaterMark;
+}
+
+
+/*---- Class StaticQrCodeBase ----*/
+
+// The grid over a pair of packed buffers in the layout of QrCode::packModules(), for QrCode's layout functions.
+class StaticQrCodeBase::PackedGrid final {
+	
+	private: uint8_t *modules;
+	private: uint8_t *isFunc;
+	private: int sz;
+	
+	
+	public: PackedGrid(uint8_t *mods, uint8_t *isFn, int size) :
+		modules(mods),
+		isFunc(isFn),
+		sz(size) {}
+	
+	
+	public: int size() const {
+		return sz;
+	}
+	
+	
+	public: bool get(int x, int y) const {
+		return getBit(modules, y * sz + x);
+	}
+	
+	
+	public: void set(int x, int y, bool isDark) {
+		setBit(modules, y * sz + x, isDark);
+	}
+	
+	
+	public: bool isFunction(int x, int y) const {
+		return getBit(isFunc, y * sz + x);
+	}
+	
+	
+	public: void setFunction(int x, int y, bool isDark) {
+		setBit(modules, y * sz + x, isDark);
+		setBit(isFunc, y * sz + x, true);
+	}
+	
+};
+
+
+StaticQrCodeBase::StaticQrCodeBase() :
+	version(0),
+	size(0),
+	errorCorrectionLevel(QrCode::Ecc::LOW),
+	mask(-1) {}
+
+
+int StaticQrCodeBase::getVersion() const {
+	return version;
+}
+
+
+int StaticQrCodeBase::getSize() const {
+	return size;
+}
+
+
+QrCode::Ecc StaticQrCodeBase::getErrorCorrectionLevel() const {
+	return errorCorrectionLevel;
+}
+
+
+int StaticQrCodeBase::getMask() const {
+	return mask;
+}
+
+
+bool StaticQrCodeBase::encodeText(const char *text, size_t len, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int msk, bool boostEcl,
+		int capacityVersion, uint8_t *modules, uint8_t *scratch) {
+	// Choose the mode like QrSegment::makeSegments(), which makes no segment for empty text
+	const QrSegment::Mode *md = nullptr;
+	if (len > 0) {
+		if (QrSegment::isNumeric(text, len))
+			md = &QrSegment::Mode::NUMERIC;
+		else if (QrSegment::isAlphanumeric(text, len))
+			md = &QrSegment::Mode::ALPHANUMERIC;
+		else
+			md = &QrSegment::Mode::BYTE;
+	}
+	return encode(md, text, len, ecl, minVersion, maxVersion, msk, boostEcl, capacityVersion, modules, scratch);
+}
+
+
+bool StaticQrCodeBase::encodeBinary(const uint8_t *data, size_t len, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int msk, bool boostEcl,
+		int capacityVersion, uint8_t *modules, uint8_t *scratch) {
+	return encode(&QrSegment::Mode::BYTE, reinterpret_cast<const char *>(data), len, ecl,
+		minVersion, maxVersion, msk, boostEcl, capacityVersion, modules, scratch);
+}
+
+
+bool StaticQrCodeBase::getModule(const uint8_t *modules, int x, int y) const {
+	return 0 <= x && x < size && 0 <= y && y < size && getBit(modules, y * size + x);
+}
+
+
+bool StaticQrCodeBase::encode(const QrSegment::Mode *md, const char *data, size_t len, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int msk, bool boostEcl,
+		int capacityVersion, uint8_t *modules, uint8_t *scratch) {
+	if (!(QrCode::MIN_VERSION <= minVersion && minVersion <= maxVersion && maxVersion <= capacityVersion
+			&& capacityVersion <= QrCode::MAX_VERSION) || msk < -1 || msk > 7)
+		QRCODEGEN_THROW(std::invalid_argument("Invalid value"));
+	
+	// Find the minimal version number to use, failing without touching anything if none fits
+	int ver;
+	long dataUsedBits;
+	for (ver = minVersion; ; ver++) {
+		dataUsedBits = md != nullptr ? getSegmentBits(*md, len, ver) : 0;
+		if (dataUsedBits != -1 && dataUsedBits <= QrCode::getNumDataCodewords(ver, ecl) * 8L)
+			break;  // This version number is found to be suitable
+		if (ver >= maxVersion)
+			return false;
+	}
+	
+	// Increase the error correction level while the data still fits in the current version number
+	for (QrCode::Ecc newEcl : {QrCode::Ecc::MEDIUM, QrCode::Ecc::QUARTILE, QrCode::Ecc::HIGH}) {  // From low to high
+		if (boostEcl && dataUsedBits <= QrCode::getNumDataCodewords(ver, newEcl) * 8L)
+			ecl = newEcl;
+	}
+	
+	// Lay out the scratch space: the function module marks, then all codewords, then data and ECC codewords
+	int sz = ver * 4 + 17;
+	size_t gridLen = (static_cast<size_t>(sz) * static_cast<size_t>(sz) + 7) / 8;
+	size_t rawCodewords = static_cast<size_t>(QrCode::getNumRawDataModules(ver) / 8);
+	size_t dataLen = static_cast<size_t>(QrCode::getNumDataCodewords(ver, ecl));
+	uint8_t *isFunction = scratch;
+	uint8_t *allCodewords = isFunction + gridLen;
+	uint8_t *dataCodewords = allCodewords + rawCodewords;
+	uint8_t *eccCodewords = dataCodewords + dataLen;
+	
+	// Write the segment header and data, then the terminator and padding
+	std::fill_n(dataCodewords, dataLen, static_cast<uint8_t>(0));
+	size_t bitLen = 0;
+	if (md != nullptr) {
+		QrCode::writeBits(static_cast<uint32_t>(md->getModeBits()), 4, dataCodewords, bitLen);
+		QrCode::writeBits(static_cast<uint32_t>(len), md->numCharCountBits(ver), dataCodewords, bitLen);
+		if (md == &QrSegment::Mode::NUMERIC) {
+			for (size_t i = 0; i < len; i += 3) {  // Groups of 3 digits, then 1 or 2 digits remaining
+				size_t n = std::min(len - i, static_cast<size_t>(3));
+				uint32_t group = 0;
+				for (size_t j = i; j < i + n; j++)
+					group = group * 10 + static_cast<uint32_t>(data[j] - '0');
+				QrCode::writeBits(group, static_cast<int>(n) * 3 + 1, dataCodewords, bitLen);
+			}
+		} else if (md == &QrSegment::Mode::ALPHANUMERIC) {
+			for (size_t i = 0; i < len; i += 2) {  // Pairs of characters, then 1 character remaining
+				uint32_t pair = static_cast<uint32_t>(QrSegment::ALPHANUMERIC_MAP[static_cast<unsigned char>(data[i])]);
+				if (i + 1 < len) {
+					pair = pair * 45 + static_cast<uint32_t>(QrSegment::ALPHANUMERIC_MAP[static_cast<unsigned char>(data[i + 1])]);
+					QrCode::writeBits(pair, 11, dataCodewords, bitLen);
+				} else
+					QrCode::writeBits(pair, 6, dataCodewords, bitLen);
+			}
+		} else {
+			for (size_t i = 0; i < len; i++)
+				QrCode::writeBits(static_cast<unsigned char>(data[i]), 8, dataCodewords, bitLen);
+		}
+	}
+	assert(bitLen == static_cast<unsigned long>(dataUsedBits));
+	QrCode::padDataCodewords(dataCodewords, bitLen, dataLen * 8);
+	
+	// Compute ECC, draw modules, do masking
+	uint8_t rsDiv[30];
+	QrCode::reedSolomonComputeDivisor(QrCode::ECC_CODEWORDS_PER_BLOCK[static_cast<int>(ecl)][ver], rsDiv);
+	QrCode::addEccAndInterleave(ver, ecl, dataCodewords, rsDiv, allCodewords, eccCodewords);
+	std::fill_n(modules, gridLen, static_cast<uint8_t>(0));
+	std::fill_n(isFunction, gridLen, static_cast<uint8_t>(0));
+	PackedGrid grid(modules, isFunction, sz);
+	QrCode::drawFunctionPatterns(ver, ecl, grid);
+	QrCode::drawCodewords(allCodewords, rawCodewords, grid);
+	if (msk == -1) {  // Automatically choose best mask
+		long minPenalty = LONG_MAX;
+		for (int i = 0; i < 8; i++) {
+			QrCode::applyMask(i, grid);
+			QrCode::drawFormatBits(ecl, i, grid);
+			long penalty = QrCode::getPenaltyScore(grid);
+			if (penalty < minPenalty) {
+				msk = i;
+				minPenalty = penalty;
+			}
+			QrCode::applyMask(i, grid);  // Undoes the mask due to XOR
+		}
+	}
+	assert(0 <= msk && msk <= 7);
+	QrCode::applyMask(msk, grid);  // Apply the final choice of mask
+	QrCode::drawFormatBits(ecl, msk, grid);  // Overwrite old format bits
+	
+	version = ver;
+	size = sz;
+	errorCorrectionLevel = ecl;
+	mask = msk;
+	return true;
+}
+
+
+long StaticQrCodeBase::getSegmentBits(const QrSegment::Mode &md, size_t len, int ver) {
+	int ccbits = md.numCharCountBits(ver);
+	if (len >= (1UL << ccbits))
+		return -1;  // The segment's length doesn't fit the field's bit width
+	long n = static_cast<long>(len);
+	long dataBits;
+	if (&md == &QrSegment::Mode::NUMERIC)
+		dataBits = n / 3 * 10 + (n % 3 == 0 ? 0 : n % 3 * 3 + 1);
+	else if (&md == &QrSegment::Mode::ALPHANUMERIC)
+		dataBits = n / 2 * 11 + n % 2 * 6;
+	else
+		dataBits = n * 8;
+	return 4 + ccbits + dataBits;
+}
+
+
+bool StaticQrCodeBase::getBit(const uint8_t *grid, int index) {
+	return ((grid[index >> 3] >> (index & 7)) & 1) != 0;
+}
+
+
+void StaticQrCodeBase::setBit(uint8_t *grid, int index, bool value) {
+	uint8_t bit = static_cast<uint8_t>(1 << (index & 7));
+	if (value)
+		grid[index >> 3] |= bit;
+	else
+		grid[index >> 3] &= static_cast<uint8_t>(~bit);
+}
+
+
+
+/*---- Class QrCodeView ----*/
+
+QrCodeView::QrCodeView(const uint8_t *data, size_t len) {
+	bool dataRegionOnly;
+	if (data == nullptr || !QrCode::parseSerialized(data, len, version, errorCorrectionLevel, mask, dataRegionOnly))
+		QRCODEGEN_THROW(std::invalid_argument("Malformed serialized QR Code"));
+	if (dataRegionOnly)
+		QRCODEGEN_THROW(std::invalid_argument("Serialized QR Code has only the data region"));
+	modules = &data[4];
+	size = version * 4 + 17;
+}
+
+
+int QrCodeView::getVersion() const {
+	return version;
+}
+
+
+int QrCodeView::getSize() const {
+	return size;
+}
+
+
+QrCode::Ecc QrCodeView::getErrorCorrectionLevel() const {
+	return errorCorrectionLevel;
+}
+
+
+int QrCodeView::getMask() const {
+	return mask;
+}
+
+
+bool QrCodeView::getModule(int x, int y) const {
+	if (x < 0 || x >= size || y < 0 || y >= size)
+		return false;
+	int i = y * size + x;
+	return ((modules[i >> 3] >> (i & 7)) & 1) != 0;
+}
+
+
+QrCode QrCodeView::toQrCode() const {
+	return QrCode(version, errorCorrectionLevel, mask, modules);
+}
+
+
+
 /*---- Class BitBuffer ----*/
 
 BitBuffer::BitBuffer()
@@ -822,9 +3113,13 @@ BitBuffer::BitBuffer()
 
 void BitBuffer::appendBits(std::uint32_t val, int len) {
 	if (len < 0 || len > 31 || val >> len != 0)
-		throw std::domain_error("Value out of range");
+		QRCODEGEN_THROW(std::domain_error("Value out of range"));
 	for (int i = len - 1; i >= 0; i--)  // Append bit by bit
 		this->push_back(((val >> i) & 1) != 0);
 }
 
+#ifdef QRCODEGEN_USE_PMR
+}
+#endif
+
 }
@@ -24,14 +24,54 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
+#if __cplusplus >= 201703L
+	#include <string_view>
+#endif
+#if __cplusplus > 201703L && __has_include(<span>)
+	#include <span>
+	#define QRCODEGEN_HAS_SPAN 1
+#endif
+#ifdef QRCODEGEN_USE_PMR
+	#if __cplusplus < 201703L
+		#error "QRCODEGEN_USE_PMR requires C++17"
+	#endif
+	#include <memory_resource>
+#endif
+// Defined when the compiler is building without exception support (such as with -fno-exceptions).
+// Then the functions that would throw abort the program instead, and callers should use the
+// non-throwing functions such as QrCode::tryEncodeSegments() for input that may be rejected.
+#if !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+	#define QRCODEGEN_NO_EXCEPTIONS 1
+#endif
+#if __cplusplus > 201703L && __has_include(<coroutine>)
+	#include <coroutine>
+	#define QRCODEGEN_HAS_COROUTINES 1
+#endif
 
 
 namespace qrcodegen {
 
+#ifdef QRCODEGEN_USE_PMR
+// With std::pmr grids, everything is also in this inline namespace. The classes then have different
+// linker names, so code built with and without QRCODEGEN_USE_PMR fails to link instead of mixing layouts.
+inline namespace pmr_grid {
+#endif
+
+class BitBuffer;
+class QrCodeResult;
+class QrEncodeTask;
+class QrPrefix;
+class QrScheduler;
+
+
 /* 
  * A segment of character/binary/control data in a QR Code symbol.
  * Instances of this class are immutable.
@@ -92,6 +132,17 @@ class QrSegment final {
 	
 	
 	
+	/* 
+	 * One piece of a byte sequence that is stored in several separate buffers,
+	 * in the manner of a POSIX iovec. Used by makeBytes(const ByteFragment*, std::size_t).
+	 */
+	public: struct ByteFragment final {
+		const std::uint8_t *data;  // Can be null if len is zero
+		std::size_t len;
+	};
+	
+	
+	
 	/*---- Static factory functions (mid level) ----*/
 	
 	/* 
@@ -102,12 +153,48 @@ class QrSegment final {
 	public: static QrSegment makeBytes(const std::vector<std::uint8_t> &data);
 	
 	
+	/* 
+	 * Returns a segment representing the given binary data data[0 : len] encoded in byte mode.
+	 * The data is read in place, so a caller's existing buffer needn't be copied into a vector.
+	 */
+	public: static QrSegment makeBytes(const std::uint8_t *data, std::size_t len);
+	
+	
+	/* 
+	 * Same as makeBytes(const std::uint8_t*, std::size_t), so that a call such as makeBytes(nullptr, 0)
+	 * isn't ambiguous with the overload for fragments.
+	 */
+	public: static QrSegment makeBytes(std::nullptr_t data, std::size_t len);
+	
+#ifdef QRCODEGEN_HAS_SPAN
+	public: static QrSegment makeBytes(std::span<const std::uint8_t> data);
+#endif
+	
+	
+	/* 
+	 * Returns a single byte mode segment representing the concatenation of the given fragments,
+	 * each of which is read in place. This avoids gathering a payload that is stored in several
+	 * buffers into one contiguous vector before encoding it.
+	 */
+	public: static QrSegment makeBytes(const ByteFragment *fragments, std::size_t count);
+	
+	
 	/* 
 	 * Returns a segment representing the given string of decimal digits encoded in numeric mode.
 	 */
 	public: static QrSegment makeNumeric(const char *digits);
 	
 	
+	/* 
+	 * Returns a segment representing the given decimal digits digits[0 : len] encoded in numeric mode.
+	 */
+	public: static QrSegment makeNumeric(const char *digits, std::size_t len);
+	
+#if __cplusplus >= 201703L
+	public: static QrSegment makeNumeric(std::string_view digits);
+#endif
+	
+	
 	/* 
 	 * Returns a segment representing the given text string encoded in alphanumeric mode.
 	 * The characters allowed are: 0 to 9, A to Z (uppercase only), space,
@@ -116,6 +203,16 @@ class QrSegment final {
 	public: static QrSegment makeAlphanumeric(const char *text);
 	
 	
+	/* 
+	 * Returns a segment representing the given text text[0 : len] encoded in alphanumeric mode.
+	 */
+	public: static QrSegment makeAlphanumeric(const char *text, std::size_t len);
+	
+#if __cplusplus >= 201703L
+	public: static QrSegment makeAlphanumeric(std::string_view text);
+#endif
+	
+	
 	/* 
 	 * Returns a list of zero or more segments to represent the given text string. The result
 	 * may use various segment modes and switch modes to optimize the length of the bit stream.
@@ -123,6 +220,17 @@ class QrSegment final {
 	public: static std::vector<QrSegment> makeSegments(const char *text);
 	
 	
+	/* 
+	 * Returns a list of zero or more segments to represent the given text text[0 : len].
+	 * The text may contain NUL bytes, which are encoded in byte mode.
+	 */
+	public: static std::vector<QrSegment> makeSegments(const char *text, std::size_t len);
+	
+#if __cplusplus >= 201703L
+	public: static std::vector<QrSegment> makeSegments(std::string_view text);
+#endif
+	
+	
 	/* 
 	 * Returns a segment representing an Extended Channel Interpretation
 	 * (ECI) designator with the given assignment value.
@@ -139,6 +247,16 @@ class QrSegment final {
 	public: static bool isNumeric(const char *text);
 	
 	
+	/* 
+	 * Tests whether the given text text[0 : len] can be encoded as a segment in numeric mode.
+	 */
+	public: static bool isNumeric(const char *text, std::size_t len);
+	
+#if __cplusplus >= 201703L
+	public: static bool isNumeric(std::string_view text);
+#endif
+	
+	
 	/* 
 	 * Tests whether the given string can be encoded as a segment in alphanumeric mode.
 	 * A string is encodable iff each character is in the following set: 0 to 9, A to Z
@@ -147,6 +265,16 @@ class QrSegment final {
 	public: static bool isAlphanumeric(const char *text);
 	
 	
+	/* 
+	 * Tests whether the given text text[0 : len] can be encoded as a segment in alphanumeric mode.
+	 */
+	public: static bool isAlphanumeric(const char *text, std::size_t len);
+	
+#if __cplusplus >= 201703L
+	public: static bool isAlphanumeric(std::string_view text);
+#endif
+	
+	
 	
 	/*---- Instance fields ----*/
 	
@@ -207,11 +335,100 @@ class QrSegment final {
 	public: static int getTotalBits(const std::vector<QrSegment> &segs, int version);
 	
 	
+	/*---- Private helper functions ----*/
+	
+	// Appends the numeric mode encoding of the longest prefix of digits[0 : len] that has only digits
+	// to the given buffer, and returns its length. This lets makeSegments() demote the mode there.
+	private: static std::size_t appendNumeric(const char *digits, std::size_t len, BitBuffer &bb);
+	
+	
+	// Appends the alphanumeric mode encoding of the longest prefix of text[0 : len] that has only encodable
+	// characters to the given buffer, and returns its length. This lets makeSegments() demote the mode there.
+	private: static std::size_t appendAlphanumeric(const char *text, std::size_t len, BitBuffer &bb);
+	
+	
+	// Returns the number of leading characters in text[0 : len] that are in the range 0 to 9.
+	// Whole 8-byte words are checked at once, and the scalar loop finds the exact stopping point.
+	private: static std::size_t numericPrefixLength(const char *text, std::size_t len);
+	
+	
 	/*---- Private constant ----*/
 	
-	/* The set of all legal characters in alphanumeric mode, where
-	 * each character value maps to the index in the string. */
-	private: static const char *ALPHANUMERIC_CHARSET;
+	/* Maps each byte value to its index in the alphanumeric character set
+	 * "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:", or -1 if it is not a legal character. */
+	private: static const std::int8_t ALPHANUMERIC_MAP[256];
+	
+	
+	/*---- Friends ----*/
+	
+	// These classes classify alphanumeric characters with the table above.
+	friend class QrSegmentAdvanced;
+	friend class StaticQrCodeBase;
+	
+};
+
+
+
+/* 
+ * A sequence of segments that begins the data of many QR Codes, encoded ahead of time.
+ * QrCode::encodeSegments(const QrPrefix&, ...) copies these bits into each symbol in bulk
+ * and only encodes the fresh suffix segments, so a shared head like a URL is never rescanned.
+ * The segments are encoded once for each band of versions that uses the same character count
+ * widths (1-9, 10-26, 27-40). Instances of this class are immutable, so a single instance
+ * can be shared by any number of threads that encode concurrently.
+ */
+class QrPrefix final {
+	
+	/*---- Constructor ----*/
+	
+	/* 
+	 * Encodes the given segments for every version band. Throws data_too_long if the segments
+	 * don't fit in a QR Code of any version, even at the lowest error correction level.
+	 */
+	public: explicit QrPrefix(const std::vector<QrSegment> &segs);
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	/* 
+	 * Returns the segments that this prefix was created from.
+	 */
+	public: const std::vector<QrSegment> &getSegments() const;
+	
+	
+	/* 
+	 * Returns the number of bits that the segments take at the given version, including
+	 * their headers, or -1 if they can't be used at that version. Requires 1 <= ver <= 40.
+	 */
+	public: int getBitLength(int ver) const;
+	
+	
+	// Returns the encoded bits of the segments at the given version, packed in
+	// big endian and padded with zeros to a whole byte. Empty if getBitLength(ver) returns -1.
+	private: const std::vector<std::uint8_t> &getData(int ver) const;
+	
+	
+	
+	/*---- Private fields and helper function ----*/
+	
+	private: std::vector<QrSegment> segments;
+	
+	// The value of getBitLength() for each version band, or -1 if the band can't be used.
+	private: int bitLengths[3];
+	
+	// The value of getData() for each version band.
+	private: std::vector<std::uint8_t> data[3];
+	
+	
+	// Returns the index of the version band that contains the given version number.
+	private: static int getBandIndex(int ver);
+	
+	
+	/*---- Friend ----*/
+	
+	// Copies the encoded bits from getData().
+	friend class QrCode;
 	
 };
 
@@ -248,10 +465,61 @@ class QrCode final {
 	};
 	
 	
+	/* 
+	 * The outcome of a non-throwing function such as tryEncodeSegments().
+	 */
+	public: enum class Status {
+		OK = 0          ,  // The function succeeded
+		DATA_TOO_LONG   ,  // The data doesn't fit in any version in the range, where others throw data_too_long
+		INVALID_ARGUMENT,  // A parameter value is out of range, where others throw std::invalid_argument
+	};
+	
+	
 	// Returns a value in the range 0 to 3 (unsigned 2-bit integer).
 	private: static int getFormatBits(Ecc ecl);
 	
 	
+	// Returns the 15 format bits, including error correction, for the given level and mask.
+	private: static int getFormatCodeword(Ecc ecl, int msk);
+	
+	
+	/* 
+	 * The storage of a grid of modules, indexed by row and then column. If QRCODEGEN_USE_PMR is defined
+	 * (which requires C++17, and must be the same for the library and all code that includes this header,
+	 * or else linking fails), then the rows are std::pmr vectors, so that a QR Code can live in a caller's
+	 * memory resource.
+	 */
+#ifdef QRCODEGEN_USE_PMR
+	public: typedef std::pmr::vector<std::pmr::vector<bool> > Grid;
+#else
+	public: typedef std::vector<std::vector<bool> > Grid;
+#endif
+	
+	
+	/* 
+	 * The encoding parameters that encodeSegments() chooses for some data, as computed by planSegments().
+	 */
+	public: struct Plan final {
+		int version;  // The chosen version number, in the range [1, 40]
+		Ecc errorCorrectionLevel;  // The final ECC level, after any boost
+		int dataUsedBits;  // Bits used by the segment headers and data, excluding terminator and padding
+		int dataCapacityBits;  // Data bits available at the chosen version and ECC level
+	};
+	
+	
+	/* 
+	 * The parts of a QR Code that depend only on its version and error correction
+	 * level, built once by makeTemplate() and shared read-only by every symbol with those parameters.
+	 */
+	private: struct Template final {
+		int version;
+		Ecc errorCorrectionLevel;
+		Grid modules;  // With all function patterns drawn, and format bits for mask 0
+		Grid isFunction;
+		std::vector<std::uint8_t> rsDivisor;  // The Reed-Solomon generator for this level's ECC block length
+	};
+	
+	
 	
 	/*---- Static factory functions (high level) ----*/
 	
@@ -265,6 +533,18 @@ class QrCode final {
 	public: static QrCode encodeText(const char *text, Ecc ecl);
 	
 	
+	/* 
+	 * Returns a QR Code representing the given text text[0 : len] at the given error correction level.
+	 * The text needn't be NUL-terminated and may contain NUL bytes; otherwise this behaves like
+	 * encodeText(const char*, Ecc).
+	 */
+	public: static QrCode encodeText(const char *text, std::size_t len, Ecc ecl);
+	
+#if __cplusplus >= 201703L
+	public: static QrCode encodeText(std::string_view text, Ecc ecl);
+#endif
+	
+	
 	/* 
 	 * Returns a QR Code representing the given binary data at the given error correction level.
 	 * This function always encodes using the binary segment mode, not any text mode. The maximum number of
@@ -274,6 +554,32 @@ class QrCode final {
 	public: static QrCode encodeBinary(const std::vector<std::uint8_t> &data, Ecc ecl);
 	
 	
+	/* 
+	 * Returns a QR Code representing the given binary data data[0 : len] at the given error correction
+	 * level. The data is read in place; otherwise this behaves like encodeBinary(const std::vector&, Ecc).
+	 */
+	public: static QrCode encodeBinary(const std::uint8_t *data, std::size_t len, Ecc ecl);
+	
+	
+	/* 
+	 * Same as encodeBinary(const std::uint8_t*, std::size_t, Ecc), so that a call such as
+	 * encodeBinary(nullptr, 0, ecl) isn't ambiguous with the overload for fragments.
+	 */
+	public: static QrCode encodeBinary(std::nullptr_t data, std::size_t len, Ecc ecl);
+	
+#ifdef QRCODEGEN_HAS_SPAN
+	public: static QrCode encodeBinary(std::span<const std::uint8_t> data, Ecc ecl);
+#endif
+	
+	
+	/* 
+	 * Returns a QR Code representing the concatenation of the given byte fragments at the given error
+	 * correction level, exactly as encodeBinary() would for the concatenated data. The fragments are
+	 * read in place into one byte mode segment, without assembling a contiguous copy of the payload.
+	 */
+	public: static QrCode encodeBinary(const QrSegment::ByteFragment *fragments, std::size_t count, Ecc ecl);
+	
+	
 	/*---- Static factory functions (mid level) ----*/
 	
 	/* 
@@ -291,6 +597,149 @@ class QrCode final {
 		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
 	
 	
+	/* 
+	 * Returns a QR Code representing the given prefix followed by the given suffix segments, with the
+	 * same parameters and behavior as encodeSegments(const std::vector<QrSegment>&, ...). The result
+	 * is identical to encoding the concatenation of both segment lists, but the prefix bits are copied
+	 * as whole bytes instead of being encoded again. The prefix may be shared between threads.
+	 */
+	public: static QrCode encodeSegments(const QrPrefix &prefix, const std::vector<QrSegment> &segs, Ecc ecl,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns a QR Code identical to encodeSegments(segs, ecl, minVersion, maxVersion, mask, boostEcl),
+	 * but if the chosen version is at least PARALLEL_MIN_VERSION, then the error correction blocks and
+	 * the mask candidates are computed in parallel on the given scheduler as INTERACTIVE tasks. The
+	 * calling thread takes part in the work, so this may be called from a task of the same scheduler.
+	 * Like QrScheduler, this is in the concurrent part of the library (qrcodegen-concurrent.hpp).
+	 */
+	public: static QrCode encodeSegments(const std::vector<QrSegment> &segs, Ecc ecl, QrScheduler &pool,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+#ifdef QRCODEGEN_USE_PMR
+	/* 
+	 * Returns a QR Code identical to encodeSegments(segs, ecl, minVersion, maxVersion, mask, boostEcl),
+	 * where all memory for the encoding steps and for the result's module grids comes from the given
+	 * resource, which must outlive the result. Copies of the result use the default resource as usual
+	 * for std::pmr containers, but moving keeps the resource. Only if QRCODEGEN_USE_PMR is defined.
+	 */
+	public: static QrCode encodeSegments(const std::vector<QrSegment> &segs, Ecc ecl, std::pmr::memory_resource *resource,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+#endif
+	
+	
+	/*---- Static factory functions (non-throwing) ----*/
+	
+	/* 
+	 * Returns the QR Code that encodeSegments(segs, ecl, minVersion, maxVersion, mask, boostEcl)
+	 * would return, or the reason that it would throw, without throwing or building an error message.
+	 * This suits callers that reject many payloads, and builds without exception support. Running
+	 * out of memory still terminates the program, as for any other noexcept function.
+	 */
+	public: static QrCodeResult tryEncodeSegments(const std::vector<QrSegment> &segs, Ecc ecl,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true) noexcept;  // All optional parameters
+	
+	
+	/* 
+	 * Returns the QR Code that encodeText(text, len, ecl) would return, or the reason that it would throw.
+	 */
+	public: static QrCodeResult tryEncodeText(const char *text, std::size_t len, Ecc ecl) noexcept;
+	
+	
+	/* 
+	 * Returns the QR Code that encodeBinary(data, len, ecl) would return, or the reason that it would throw.
+	 */
+	public: static QrCodeResult tryEncodeBinary(const std::uint8_t *data, std::size_t len, Ecc ecl) noexcept;
+	
+	
+#ifdef QRCODEGEN_HAS_COROUTINES
+	
+	/*---- Static factory functions (asynchronous, C++20) ----*/
+	
+	/* 
+	 * Runs a piece of work on some thread, now or later. An executor must run every piece it is given.
+	 */
+	public: typedef std::function<void(std::function<void()>)> Executor;
+	
+	
+	/* 
+	 * Returns a task that encodes the given segments with the same parameters and result as encodeSegments(),
+	 * when it is awaited or its get() is called. The work runs on the given executor, or on a pool of threads
+	 * owned by the library if the executor is empty. For versions of at least ASYNC_YIELD_MIN_VERSION, the task
+	 * goes back to the executor between ECC blocks and between mask candidates, so that other work on the
+	 * same threads can run. The awaiting coroutine is resumed on the executor's thread.
+	 * Like QrEncodeTask, this is in the concurrent part of the library (qrcodegen-concurrent.hpp).
+	 */
+	public: static QrEncodeTask encodeAsync(std::vector<QrSegment> segs, Ecc ecl, Executor exec=Executor(),
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+#endif
+	
+	
+	
+	/*---- Static planning functions ----*/
+	
+	/* 
+	 * Returns the version number and ECC level that encodeSegments() would choose for the given arguments,
+	 * along with the data bits used and available, without creating any modules. The segments are summed
+	 * once for each version band that uses the same character count widths (1-9, 10-26, 27-40), and each
+	 * band's smallest fitting version is found by binary search over a capacity table. Throws data_too_long
+	 * in the same cases as encodeSegments(), so this can be used to reject oversized payloads cheaply.
+	 */
+	public: static Plan planSegments(const std::vector<QrSegment> &segs, Ecc ecl,
+		int minVersion=1, int maxVersion=40, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns the plan that encodeSegments(const QrPrefix&, ...) would use for the given prefix followed
+	 * by the given suffix segments. The prefix's bit lengths are read, not recomputed.
+	 */
+	public: static Plan planSegments(const QrPrefix &prefix, const std::vector<QrSegment> &segs, Ecc ecl,
+		int minVersion=1, int maxVersion=40, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Computes the plan that planSegments() would return into the given result, and returns Status::OK,
+	 * or returns the reason that planSegments() would throw, without throwing. On DATA_TOO_LONG, only
+	 * result.dataUsedBits is set, to the bits needed in maxVersion's band or -1 if a segment is too long.
+	 */
+	public: static Status tryPlanSegments(const std::vector<QrSegment> &segs, Ecc ecl, Plan &result,
+		int minVersion=1, int maxVersion=40, bool boostEcl=true) noexcept;  // All optional parameters
+	
+	
+	/* 
+	 * Returns the number of data bits that a QR Code of the given version number and
+	 * error correction level can hold, which is the capacity for segment headers and data.
+	 * Requires 1 <= ver <= 40. The result is in the range [72, 23648].
+	 */
+	public: static int getDataCapacityBits(int ver, Ecc ecl);
+	
+	
+	
+	/*---- Static serialization functions ----*/
+	
+	/* 
+	 * Returns the QR Code represented by the given bytes from serialize(), in either layout.
+	 * Throws std::invalid_argument if the data is malformed or has the wrong length.
+	 */
+	public: static QrCode deserialize(const std::uint8_t *data, std::size_t len);
+	
+	
+	/* 
+	 * Returns the QR Code represented by the given bytes from serialize(), like the pointer overload.
+	 */
+	public: static QrCode deserialize(const std::vector<std::uint8_t> &data);
+	
+	
+	/* 
+	 * Returns the number of bytes that serialize() returns for a QR Code of the given version
+	 * number, in the data region layout if dataRegionOnly is true or else in the full layout.
+	 */
+	public: static std::size_t getSerializedLength(int ver, bool dataRegionOnly);
+	
+	
 	
 	/*---- Instance fields ----*/
 	
@@ -316,10 +765,10 @@ class QrCode final {
 	
 	// The modules of this QR Code (false = light, true = dark).
 	// Immutable after constructor finishes. Accessed through getModule().
-	private: std::vector<std::vector<bool> > modules;
+	private: Grid modules;
 	
 	// Indicates function modules that are not subjected to masking. Discarded when constructor finishes.
-	private: std::vector<std::vector<bool> > isFunction;
+	private: Grid isFunction;
 	
 	
 	
@@ -334,6 +783,34 @@ class QrCode final {
 	public: QrCode(int ver, Ecc ecl, const std::vector<std::uint8_t> &dataCodewords, int msk);
 	
 	
+	/* 
+	 * Creates a new QR Code like the constructor above, with the version number and
+	 * error correction level of the given template, whose function modules and divisor are copied
+	 * instead of recomputed.
+	 */
+	private: QrCode(const Template &tmpl, const std::vector<std::uint8_t> &dataCodewords, int msk);
+	
+	
+	/* 
+	 * Creates an unfinished QR Code that has only the function modules of the given
+	 * template. It must be completed by calling addEccAndInterleave(), drawCodewords(), and finishMask()
+	 * in that order, which is how QrPipeline runs the steps of the constructor above as separate stages.
+	 */
+	private: explicit QrCode(const Template &tmpl);
+	
+	
+	/* 
+	 * Creates a finished QR Code with the given version number, error correction
+	 * level, and mask, whose modules are read from the given grid in the layout of packModules().
+	 */
+	private: QrCode(int ver, Ecc ecl, int msk, const std::uint8_t *packedModules);
+	
+	
+	// Creates a QR Code of the given version number and error correction level with only the function
+	// modules drawn, and isFunction kept, whose grids use the given allocator. Used by makeTemplate().
+	private: QrCode(int ver, Ecc ecl, const Grid::allocator_type &alloc=Grid::allocator_type());
+	
+	
 	
 	/*---- Public instance methods ----*/
 	
@@ -369,6 +846,48 @@ class QrCode final {
 	public: bool getModule(int x, int y) const;
 	
 	
+	/* 
+	 * Returns this QR Code in a compact and stable binary format, which the C library reads and writes
+	 * too. It is a 4-byte header followed by packed module bits:
+	 * - Byte 0 is 'Q' (0x51), and byte 1 is the format version, which is 1.
+	 * - Byte 2 holds the mask in bits 0 to 2, the error correction level in bits 3 and 4 (as the
+	 *   ordinal of Ecc), and in bit 7 whether only the data region is stored. Bits 5 and 6 are 0.
+	 * - Byte 3 is the size.
+	 * - In the full layout, the body holds all modules in row-major order: module (x, y) is bit (i % 8)
+	 *   of byte (i / 8) for i = y * size + x. In the data region layout, which is the smaller one, it holds
+	 *   only the modules outside the function patterns, in the same order and bit packing, and a reader
+	 *   redraws the function patterns and format bits from the header. Unused bits at the end are 0.
+	 * QrCodeView reads the full layout in place. Use deserialize() to read either layout.
+	 */
+	public: std::vector<std::uint8_t> serialize(bool dataRegionOnly=false) const;
+	
+	
+	
+	/*---- Private helper methods for friend classes ----*/
+	
+	/* 
+	 * Writes this QR Code's modules to out[0 : (size * size + 7) / 8], where the module at
+	 * (x, y) is bit (i % 8) of byte (i / 8) for i = y * size + x, and the unused high bits of the last byte are 0.
+	 */
+	private: void packModules(std::uint8_t *out) const;
+	
+	
+	/* 
+	 * Turns this object into an unfinished QR Code like QrCode(tmpl), reusing its storage.
+	 * Rows of modules and isFunction that aren't needed at the template's size are moved to the given
+	 * spares, and missing rows are taken from there first, so that switching versions frees nothing.
+	 */
+	private: void reset(const Template &tmpl, Grid &spareRows);
+	
+	
+	// Returns the number of bytes held by this object's module grids.
+	private: std::size_t getMemoryUsage() const;
+	
+	
+	// Returns the number of bytes held by the given grid of modules.
+	private: static std::size_t getMemoryUsage(const Grid &grid);
+	
+	
 	
 	/*---- Private helper methods for constructor: Drawing function modules ----*/
 	
@@ -381,67 +900,219 @@ class QrCode final {
 	private: void drawFormatBits(int msk);
 	
 	
-	// Draws two copies of the version bits (with its own error correction code),
-	// based on this object's version field, iff 7 <= version <= 40.
-	private: void drawVersion();
+	// Returns the color of the module at the given coordinates, which must be in range.
+	private: bool module(int x, int y) const;
 	
 	
-	// Draws a 9*9 finder pattern including the border separator,
-	// with the center module at (x, y). Modules can be out of bounds.
-	private: void drawFinderPattern(int x, int y);
+	/*---- Private helper methods for constructor: Codewords and masking ----*/
 	
+	// Draws the given data codewords with their error correction codewords, which are computed with
+	// the given divisor, then finishes with finishMask(). The function modules must already be drawn.
+	// Shared by the public constructors.
+	private: void drawCodewordsAndMask(const std::vector<std::uint8_t> &dataCodewords,
+		const std::vector<std::uint8_t> &rsDiv, int msk);
 	
-	// Draws a 5*5 alignment pattern, with the center module
-	// at (x, y). All modules must be in bounds.
-	private: void drawAlignmentPattern(int x, int y);
 	
+	// Same as above, but if this QR Code's version is at least PARALLEL_MIN_VERSION, then the error
+	// correction blocks and the mask candidates are computed in parallel on the given scheduler, as tasks
+	// of the given QrScheduler::Priority value. Defined with the concurrent classes, which share it.
+	private: void drawCodewordsAndMask(const std::vector<std::uint8_t> &dataCodewords,
+		const std::vector<std::uint8_t> &rsDiv, int msk, QrScheduler &pool, int pri);
 	
-	// Sets the color of a module and marks it as a function module.
-	// Only used by the constructor. Coordinates must be in bounds.
-	private: void setFunctionModule(int x, int y, bool isDark);
 	
+	// Returns a new byte string representing the given data with the appropriate error
+	// correction codewords appended to it, based on this object's version and error correction level
+	// and the given Reed-Solomon divisor for that level's block length.
+	private: std::vector<std::uint8_t> addEccAndInterleave(const std::vector<std::uint8_t> &data,
+		const std::vector<std::uint8_t> &rsDiv) const;
 	
-	// Returns the color of the module at the given coordinates, which must be in range.
-	private: bool module(int x, int y) const;
 	
+	// Same as above without allocating, where data has getNumDataCodewords() bytes and
+	// rsDiv has the degree of the level's block length. Writes getNumRawDataModules() / 8 bytes to result,
+	// and uses the rest of that length (the total ECC length) at ecc as scratch space.
+	private: void addEccAndInterleave(const std::uint8_t *data, const std::uint8_t *rsDiv,
+		std::uint8_t *result, std::uint8_t *ecc) const;
 	
-	/*---- Private helper methods for constructor: Codewords and masking ----*/
 	
-	// Returns a new byte string representing the given data with the appropriate error correction
-	// codewords appended to it, based on this object's version and error correction level.
-	private: std::vector<std::uint8_t> addEccAndInterleave(const std::vector<std::uint8_t> &data) const;
+	// Same as above for the given version and error correction level.
+	private: static void addEccAndInterleave(int ver, Ecc ecl, const std::uint8_t *data,
+		const std::uint8_t *rsDiv, std::uint8_t *result, std::uint8_t *ecc);
 	
 	
-	// Draws the given sequence of 8-bit codewords (data and error correction) onto the entire
-	// data area of this QR Code. Function modules need to be marked off before this is called.
-	private: void drawCodewords(const std::vector<std::uint8_t> &data);
+	// Returns the number of error correction blocks at this object's version and level.
+	private: int getNumEccBlocks() const;
 	
 	
-	// XORs the codeword modules in this QR Code with the given mask pattern.
-	// The function modules must be marked and the codeword bits must be drawn
-	// before masking. Due to the arithmetic of XOR, calling applyMask() with
-	// the same mask value a second time will undo the mask. A final well-formed
-	// QR Code needs exactly one (not zero, two, etc.) mask applied.
-	private: void applyMask(int msk);
+	// Returns the block at the given index of the given data codewords, followed by its ECC
+	// codewords computed with the given divisor, where a short block has a padding byte before its ECC.
+	// Calling this for every index and passing the results to interleaveBlocks() is addEccAndInterleave().
+	private: std::vector<std::uint8_t> makeEccBlock(const std::vector<std::uint8_t> &data,
+		const std::vector<std::uint8_t> &rsDiv, int index) const;
 	
 	
-	// Calculates and returns the penalty score based on state of this QR Code's current modules.
-	// This is used by the automatic mask choice algorithm to find the mask pattern that yields the lowest score.
-	private: long getPenaltyScore() const;
+	// Interleaves all blocks from makeEccBlock(), in index order, into the final codewords.
+	private: std::vector<std::uint8_t> interleaveBlocks(const std::vector<std::vector<std::uint8_t> > &blocks) const;
+	
+	
+	// Draws the given sequence of 8-bit codewords (data and error correction) onto the
+	// entire data area of this QR Code. Function modules need to be marked off before this is called.
+	private: void drawCodewords(const std::vector<std::uint8_t> &data);
+	
+	
+	// Same as above, for the given array of the given length.
+	private: void drawCodewords(const std::uint8_t *data, std::size_t len);
+	
+	
+	// Applies the given mask, or the one with the lowest penalty score if msk is -1,
+	// draws the final format bits, and drops isFunction. The codewords must already be drawn.
+	private: void finishMask(int msk);
+	
+	
+	// Same as finishMask(), but keeps isFunction so that reset() can reuse its storage.
+	private: void applyFinalMask(int msk);
+	
+	
+	// Returns the penalty score of this QR Code with the given mask and its format bits,
+	// leaving the codeword modules unmasked afterward. The codewords must already be drawn.
+	private: long evaluateMask(int msk);
+	
+	
+	// XORs the codeword modules in this QR Code with the given mask pattern.
+	// The function modules must be marked and the codeword bits must be drawn
+	// before masking. Due to the arithmetic of XOR, calling applyMask() with
+	// the same mask value a second time will undo the mask. A final well-formed
+	// QR Code needs exactly one (not zero, two, etc.) mask applied.
+	private: void applyMask(int msk);
+	
+	
+	/*---- Private helper functions: Symbol layout ----*/
+	
+	// These functions draw, mask, and score a symbol through the given grid, so that this class's rows
+	// and StaticQrCodeBase's packed buffers share one implementation of the layout. A grid type G has
+	// int size() const, bool get(int x, int y) const, void set(int x, int y, bool isDark),
+	// bool isFunction(int x, int y) const, and void setFunction(int x, int y, bool isDark),
+	// which also marks the module as a function module. They are only instantiated in qrcodegen.cpp.
+	
+	// Draws and marks all function modules of a symbol of the given version and error
+	// correction level, with the format bits of mask 0. The grid must be all light and unmarked.
+	private: template <typename G> static void drawFunctionPatterns(int ver, Ecc ecl, G &grid);
+	
+	
+	// Draws two copies of the format bits (with its own error correction code)
+	// based on the given error correction level and mask.
+	private: template <typename G> static void drawFormatBits(Ecc ecl, int msk, G &grid);
+	
+	
+	// Draws two copies of the version bits (with its own error correction code),
+	// based on the given version, iff 7 <= version <= 40.
+	private: template <typename G> static void drawVersion(int ver, G &grid);
+	
+	
+	// Draws a 9*9 finder pattern including the border separator,
+	// with the center module at (x, y). Modules can be out of bounds.
+	private: template <typename G> static void drawFinderPattern(int x, int y, G &grid);
+	
+	
+	// Draws a 5*5 alignment pattern, with the center module
+	// at (x, y). All modules must be in bounds.
+	private: template <typename G> static void drawAlignmentPattern(int x, int y, G &grid);
+	
+	
+	// Draws the given sequence of len 8-bit codewords onto the modules that aren't function modules,
+	// in the zigzag order. The length must already have been checked against the grid's version.
+	private: template <typename G> static void drawCodewords(const std::uint8_t *data, std::size_t len, G &grid);
+	
+	
+	// XORs the modules that aren't function modules with the given mask pattern, which must be in [0, 7].
+	private: template <typename G> static void applyMask(int msk, G &grid);
+	
+	
+	// Calculates and returns the penalty score based on the state of the grid's current modules.
+	// This is used by the automatic mask choice algorithm to find the mask pattern that yields the lowest score.
+	private: template <typename G> static long getPenaltyScore(const G &grid);
+	
+	
+	// The grid over this object's modules and isFunction fields, bounds-checked like module().
+	private: class GridAccessor;
 	
 	
 	
 	/*---- Private helper functions ----*/
 	
-	// Returns an ascending list of positions of alignment patterns for this version number.
+	// The shared implementation of both planSegments() overloads, where prefix may be null.
+	private: static Plan planSegments(const QrPrefix *prefix, const std::vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, bool boostEcl);
+	
+	
+	// The non-throwing implementation of planSegments() and tryPlanSegments(), where prefix may be null.
+	private: static Status tryPlanSegments(const QrPrefix *prefix, const std::vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, bool boostEcl, Plan &result) noexcept;
+	
+	
+	// Returns the message of the data_too_long exception for data that needs the given number
+	// of bits (or -1 if a segment is too long for any version), at the given maximum version and ECC level.
+	private: static std::string getDataTooLongMessage(int dataUsedBits, int maxVersion, Ecc ecl);
+	
+	
+	// Checks the header and length of the given bytes from serialize() and returns its fields,
+	// or returns false if they are malformed. In the full layout, this also checks that the format bits of the
+	// modules, which start at data + 4, match the header.
+	private: static bool parseSerialized(const std::uint8_t *data, std::size_t len,
+		int &ver, Ecc &ecl, int &msk, bool &dataRegionOnly);
+	
+	
+	// The shared implementation of both encodeSegments() overloads, where prefix may be null.
+	private: static QrCode encodeSegments(const QrPrefix *prefix, const std::vector<QrSegment> &segs, Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl);
+	
+	
+	// Returns the data codewords for the given prefix (which may be null) and
+	// segments at the version and ECC level of the given plan, with the terminator and padding.
+	private: static std::vector<std::uint8_t> makeDataCodewords(const QrPrefix *prefix,
+		const std::vector<QrSegment> &segs, const Plan &plan);
+	
+	
+	// Same as above without allocating, writing plan.dataCapacityBits / 8 bytes to result.
+	private: static void makeDataCodewords(const QrPrefix *prefix,
+		const std::vector<QrSegment> &segs, const Plan &plan, std::uint8_t *result);
+	
+	
+	// Returns the template for the given version number and error correction level.
+	private: static Template makeTemplate(int ver, Ecc ecl);
+	
+	
+	// Writes the header and data bits of each given segment at the given version
+	// into the given zero-initialized byte buffer at bit position bitLen, then advances bitLen.
+	private: static void writeSegments(const std::vector<QrSegment> &segs, int version,
+		std::uint8_t *buf, std::size_t &bitLen);
+	
+	
+	// Adds the terminator and padding after the first bitLen bits of the given
+	// zero-initialized data codewords, up to the given capacity, which is a multiple of 8.
+	private: static void padDataCodewords(std::uint8_t *dataCodewords, std::size_t bitLen, std::size_t dataCapacityBits);
+	
+	
+	// Writes the given number of low-order bits of the given value into the given
+	// zero-initialized byte buffer at bit position bitLen (big endian), then advances bitLen. The value
+	// is shifted into place within one 32-bit word. Requires 0 <= len <= 24 and val < 2^len.
+	private: static void writeBits(std::uint32_t val, int len, std::uint8_t *buf, std::size_t &bitLen);
+	
+	
+	// Writes an ascending list of positions of alignment patterns for the given version
+	// number to the given array, and returns the number of positions, which is in the range [0,7].
 	// Each position is in the range [0,177), and are used on both the x and y axes.
 	// This could be implemented as lookup table of 40 variable-length lists of unsigned bytes.
-	private: std::vector<int> getAlignmentPatternPositions() const;
+	private: static int getAlignmentPatternPositions(int ver, std::array<int,7> &result);
 	
 	
-	// Returns the number of data bits that can be stored in a QR Code of the given version number, after
-	// all function modules are excluded. This includes remainder bits, so it might not be a multiple of 8.
-	// The result is in the range [208, 29648]. This could be implemented as a 40-entry lookup table.
+	// Returns the size of a QR Code of the given version number, or throws domain_error if the version is
+	// out of range. Used in constructor initializer lists, so that no grid is allocated for a bad version.
+	private: static int getCheckedSize(int ver);
+	
+	
+	// Returns the number of data bits that can be stored in a QR Code of the given version
+	// number, after all function modules are excluded. This includes remainder bits, so it might not be a
+	// multiple of 8. The result is in the range [208, 29648]. This could be implemented as a 40-entry lookup table.
 	private: static int getNumRawDataModules(int ver);
 	
 	
@@ -456,10 +1127,20 @@ class QrCode final {
 	private: static std::vector<std::uint8_t> reedSolomonComputeDivisor(int degree);
 	
 	
+	// Same as above, writing the polynomial to result[0 : degree] without allocating.
+	private: static void reedSolomonComputeDivisor(int degree, std::uint8_t *result);
+	
+	
 	// Returns the Reed-Solomon error correction codeword for the given data and divisor polynomials.
 	private: static std::vector<std::uint8_t> reedSolomonComputeRemainder(const std::vector<std::uint8_t> &data, const std::vector<std::uint8_t> &divisor);
 	
 	
+	// Writes the Reed-Solomon error correction codeword for data[0 : len] and the divisor
+	// polynomial divisor[0 : degree] to result[0 : degree], without allocating.
+	private: static void reedSolomonComputeRemainder(const std::uint8_t *data, std::size_t len,
+		const std::uint8_t *divisor, std::size_t degree, std::uint8_t *result);
+	
+	
 	// Returns the product of the two given field elements modulo GF(2^8/0x11D).
 	// All inputs are valid. This could be implemented as a 256*256 lookup table.
 	private: static std::uint8_t reedSolomonMultiply(std::uint8_t x, std::uint8_t y);
@@ -467,15 +1148,15 @@ class QrCode final {
 	
 	// Can only be called immediately after a light run is added, and
 	// returns either 0, 1, or 2. A helper function for getPenaltyScore().
-	private: int finderPenaltyCountPatterns(const std::array<int,7> &runHistory) const;
+	private: static int finderPenaltyCountPatterns(const std::array<int,7> &runHistory, int size);
 	
 	
 	// Must be called at the end of a line (row or column) of modules. A helper function for getPenaltyScore().
-	private: int finderPenaltyTerminateAndCount(bool currentRunColor, int currentRunLength, std::array<int,7> &runHistory) const;
+	private: static int finderPenaltyTerminateAndCount(bool currentRunColor, int currentRunLength, std::array<int,7> &runHistory, int size);
 	
 	
 	// Pushes the given value to the front and drops the last value. A helper function for getPenaltyScore().
-	private: void finderPenaltyAddHistory(int currentRunLength, std::array<int,7> &runHistory) const;
+	private: static void finderPenaltyAddHistory(int currentRunLength, std::array<int,7> &runHistory, int size);
 	
 	
 	// Returns true iff the i'th bit of x is set to 1.
@@ -490,6 +1171,12 @@ class QrCode final {
 	// The maximum version number supported in the QR Code Model 2 standard.
 	public: static constexpr int MAX_VERSION = 40;
 	
+	// The smallest version at which encodeAsync() yields between steps; smaller symbols take a few microseconds.
+	public: static constexpr int ASYNC_YIELD_MIN_VERSION = 10;
+	
+	// The smallest version that encodeSegments() with a scheduler splits across threads.
+	public: static constexpr int PARALLEL_MIN_VERSION = 10;
+	
 	
 	// For use in getPenaltyScore(), when evaluating which mask is best.
 	private: static const int PENALTY_N1;
@@ -498,9 +1185,90 @@ class QrCode final {
 	private: static const int PENALTY_N4;
 	
 	
+	// The number of ECC codewords in each block, for each ECC level and version.
 	private: static const std::int8_t ECC_CODEWORDS_PER_BLOCK[4][41];
+	
 	private: static const std::int8_t NUM_ERROR_CORRECTION_BLOCKS[4][41];
 	
+	// Equal to getNumDataCodewords() for each ECC level and version, which increases strictly with the version.
+	private: static const std::int16_t NUM_DATA_CODEWORDS[4][41];
+	
+	
+	/*---- Friends ----*/
+	
+	// These classes run the steps of the constructor separately or on other storage,
+	// so they share its private helpers instead of those becoming part of the public API.
+	friend class QrPrefix;
+	friend class QrBatch;
+	friend class QrPipeline;
+	friend class QrCache;
+	friend class QrEncoder;
+	friend class StaticQrCodeBase;
+	template <int MaxVersion> friend class StaticQrCode;
+	friend class QrCodeView;
+	friend class LazyQrCode;
+	friend class QrDiskCache;
+	
+};
+
+
+
+/* 
+ * The result of a non-throwing QR Code factory function, which holds either a QR Code
+ * or the status that tells why the function failed, in the style of std::expected.
+ */
+class QrCodeResult final {
+	
+	/*---- Constructors and destructor ----*/
+	
+	// Creates a successful result holding the given QR Code.
+	public: QrCodeResult(QrCode &&qr) noexcept;
+	
+	
+	// Creates a failed result with the given status, which must not be Status::OK.
+	public: explicit QrCodeResult(QrCode::Status st) noexcept;
+	
+	
+	public: QrCodeResult(const QrCodeResult &other);
+	
+	public: QrCodeResult(QrCodeResult &&other) noexcept;
+	
+	public: QrCodeResult &operator=(const QrCodeResult &other);
+	
+	public: QrCodeResult &operator=(QrCodeResult &&other) noexcept;
+	
+	public: ~QrCodeResult();
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	// Returns true iff this result holds a QR Code.
+	public: bool isOk() const noexcept;
+	
+	
+	// Returns Status::OK if this result holds a QR Code, or otherwise the reason for the failure.
+	public: QrCode::Status getStatus() const noexcept;
+	
+	
+	// Returns the QR Code of this result. Requires isOk() to be true.
+	public: const QrCode &getQrCode() const noexcept;
+	
+	
+	// Returns the QR Code of this result, which may be moved out. Requires isOk() to be true.
+	public: QrCode &getQrCode() noexcept;
+	
+	
+	
+	/*---- Private fields ----*/
+	
+	private: QrCode::Status status;
+	
+	// Constructed iff status is Status::OK.
+	private: union {
+		QrCode qrCode;
+	};
+	
 };
 
 
@@ -517,6 +1285,7 @@ class QrCode final {
  * - Change the text or binary data to be shorter.
  * - Change the text to fit the character set of a particular segment mode (e.g. alphanumeric).
  * - Propagate the error upward to the caller/user.
+ * The non-throwing functions such as QrCode::tryEncodeSegments() report this case as Status::DATA_TOO_LONG.
  */
 class data_too_long : public std::length_error {
 	
@@ -526,6 +1295,490 @@ class data_too_long : public std::length_error {
 
 
 
+/* 
+ * Splits text into optimal segments. Provides static functions only; not instantiable.
+ */
+class QrSegmentAdvanced final {
+	
+	/*---- Optimal list of segments encoder ----*/
+	
+	/* 
+	 * Returns a list of zero or more segments to represent the given UTF-8 text string.
+	 * The resulting list optimally minimizes the total encoded bit length, subjected to the constraints
+	 * in the given {error correction level, minimum version number, maximum version number}.
+	 * This function can utilize all four text encoding modes: numeric, alphanumeric, byte (UTF-8),
+	 * and kanji.
+	 * This can be considered as a sophisticated but slower replacement for QrSegment::makeSegments().
+	 * This requires more input parameters because it searches a range of versions, like
+	 * QrCode::encodeSegments(). Throws std::domain_error if the text is not well-formed UTF-8,
+	 * or data_too_long if the text fails to fit in the maxVersion QR Code at the ECL.
+	 */
+	public: static std::vector<QrSegment> makeSegmentsOptimally(const char *text,
+		QrCode::Ecc ecl, int minVersion=1, int maxVersion=40);  // All optional parameters
+	
+	
+	/* 
+	 * Returns a list of zero or more segments to represent the given UTF-8 text text[0 : len],
+	 * which may contain NUL characters. Otherwise this behaves like the overload above.
+	 */
+	public: static std::vector<QrSegment> makeSegmentsOptimally(const char *text, std::size_t len,
+		QrCode::Ecc ecl, int minVersion=1, int maxVersion=40);  // All optional parameters
+	
+#if __cplusplus >= 201703L
+	public: static std::vector<QrSegment> makeSegmentsOptimally(std::string_view text,
+		QrCode::Ecc ecl, int minVersion=1, int maxVersion=40);  // All optional parameters
+#endif
+	
+	
+	/*---- Kanji mode segment encoder ----*/
+	
+	/* 
+	 * Returns a segment representing the given UTF-8 text string encoded in kanji mode.
+	 * Broadly speaking, the set of encodable characters are {kanji used in Japan,
+	 * hiragana, katakana, East Asian punctuation, full-width ASCII, Greek, Cyrillic}.
+	 * Examples of non-encodable characters include {ordinary ASCII, half-width katakana,
+	 * more extensive Chinese hanzi}. Throws std::domain_error if the text is not
+	 * well-formed UTF-8 or contains non-encodable characters.
+	 */
+	public: static QrSegment makeKanji(const char *text);
+	
+	
+	/* 
+	 * Returns a segment representing the given UTF-8 text text[0 : len] encoded in kanji mode.
+	 */
+	public: static QrSegment makeKanji(const char *text, std::size_t len);
+	
+	
+	/* 
+	 * Returns a segment representing the given UTF-16 text string encoded in kanji mode.
+	 * The set of encodable characters is the same as for makeKanji(const char*).
+	 * Throws std::domain_error if the text contains non-encodable characters.
+	 */
+	public: static QrSegment makeKanji(const std::u16string &text);
+	
+	
+	/* 
+	 * Tests whether the given UTF-8 string can be encoded as a segment in kanji mode.
+	 * Returns false if the string is not well-formed UTF-8.
+	 */
+	public: static bool isEncodableAsKanji(const char *text);
+	
+	
+	/* 
+	 * Tests whether the given UTF-16 string can be encoded as a segment in kanji mode.
+	 */
+	public: static bool isEncodableAsKanji(const std::u16string &text);
+	
+	
+	/*---- Private helper functions ----*/
+	
+	// Returns a new list of segments that is optimal for the given text at the given version number.
+	private: static std::vector<QrSegment> makeSegmentsOptimally(const char *text,
+		const std::vector<std::uint32_t> &codePoints, int version);
+	
+	
+	// Returns a new array representing the optimal mode per code point based on the given text and version.
+	private: static std::vector<const QrSegment::Mode*> computeCharacterModes(
+		const std::vector<std::uint32_t> &codePoints, int version);
+	
+	
+	// Returns a new list of segments based on the given text and modes, such that
+	// consecutive code points in the same mode are put into the same segment.
+	private: static std::vector<QrSegment> splitIntoSegments(const char *text,
+		const std::vector<std::uint32_t> &codePoints, const std::vector<const QrSegment::Mode*> &charModes);
+	
+	
+	// Returns a new array of Unicode code points (effectively UTF-32 / UCS-4) representing
+	// the given UTF-8 string text[0 : len]. Throws std::domain_error if the string is not well-formed.
+	private: static std::vector<std::uint32_t> toCodePoints(const char *text, std::size_t len);
+	
+	
+	// Appends the code points of the given UTF-8 string text[0 : len] to the given array like
+	// toCodePoints(), or returns false without throwing if the string is not well-formed.
+	private: static bool decodeUtf8(const char *text, std::size_t len, std::vector<std::uint32_t> &result);
+	
+	
+	// Returns the number of UTF-8 bytes needed to encode the given Unicode code point.
+	private: static int countUtf8Bytes(std::uint32_t cp);
+	
+	
+	// Returns the 13-bit kanji mode value of the given Unicode code point, or -1 if it is not encodable.
+	private: static int toQrKanji(std::uint32_t cp);
+	
+	
+	/*---- Private table ----*/
+	
+	// Each entry is (Unicode code point << 13 | kanji mode value), sorted in ascending order so that
+	// it can be binary searched. Derived from the JIS X 0208 part of the Shift JIS mapping at
+	// ftp://ftp.unicode.org/Public/MAPPINGS/OBSOLETE/EASTASIA/JIS/SHIFTJIS.TXT
+	private: static const std::uint32_t PACKED_UNICODE_TO_QR_KANJI[6879];
+	
+	
+	/*---- Constructor ----*/
+	
+	private: QrSegmentAdvanced();  // Not instantiable
+	
+};
+
+
+
+/* 
+ * A reusable context for encoding many QR Codes one after another on one thread, which keeps all of its
+ * working storage between calls: the data and ECC codewords, the module grids of its result, and the
+ * templates of the versions and ECC levels it has seen. Once it has encoded the largest symbols of a
+ * workload, encodeSegments() allocates no memory. Instances are not thread-safe; use one per thread.
+ */
+class QrEncoder final {
+	
+	/*---- Constructor ----*/
+	
+	public: QrEncoder();
+	
+	
+	public: QrEncoder(const QrEncoder &) = delete;
+	public: QrEncoder &operator=(const QrEncoder &) = delete;
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	/* 
+	 * Returns a QR Code identical to QrCode::encodeSegments() with the same arguments, and throws
+	 * the same exceptions. The result is owned by this encoder and is overwritten by the next call,
+	 * so copy it to keep it.
+	 */
+	public: const QrCode &encodeSegments(const std::vector<QrSegment> &segs, QrCode::Ecc ecl,
+		int minVersion=1, int maxVersion=40, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns a QR Code identical to QrCode::encodeText() with the same arguments, like encodeSegments().
+	 * Making the segments of the text still allocates memory.
+	 */
+	public: const QrCode &encodeText(const char *text, QrCode::Ecc ecl);
+	
+	
+	/* 
+	 * Returns the number of bytes of working storage that this encoder holds now.
+	 */
+	public: std::size_t getRetainedBytes() const;
+	
+	
+	/* 
+	 * Returns the largest number of bytes of working storage that this encoder has held after any call.
+	 */
+	public: std::size_t getHighWaterMark() const;
+	
+	
+	
+	/*---- Private fields ----*/
+	
+	private: std::unique_ptr<QrCode::Template> templates[4 * 41];  // Indexed by ECC level * 41 + version
+	
+	private: std::unique_ptr<QrCode> result;  // Null before the first call
+	
+	private: QrCode::Grid spareRows;
+	
+	private: std::vector<std::uint8_t> dataCodewords;
+	
+	private: std::vector<std::uint8_t> allCodewords;
+	
+	private: std::vector<std::uint8_t> eccCodewords;
+	
+	private: std::size_t templateBytes;
+	
+	private: std::size_t highWaterMark;
+	
+};
+
+
+
+/* 
+ * The part of StaticQrCode that doesn't depend on its capacity: the parameters of the symbol, and
+ * an encoder that works on packed grids in caller-provided buffers, in the layout of QrCode::packModules().
+ * Nothing here allocates memory. Use StaticQrCode instead of this class.
+ */
+class StaticQrCodeBase {
+	
+	/*---- Constructor ----*/
+	
+	// Creates an empty QR Code, whose version and size are 0.
+	protected: StaticQrCodeBase();
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	// Returns this QR Code's version number, in the range [1, 40], or 0 if nothing has been encoded yet.
+	public: int getVersion() const;
+	
+	
+	// Returns this QR Code's size, in the range [21, 177], or 0 if nothing has been encoded yet.
+	public: int getSize() const;
+	
+	
+	// Returns this QR Code's error correction level. Not meaningful if nothing has been encoded yet.
+	public: QrCode::Ecc getErrorCorrectionLevel() const;
+	
+	
+	// Returns this QR Code's mask, in the range [0, 7], or -1 if nothing has been encoded yet.
+	public: int getMask() const;
+	
+	
+	
+	/*---- Protected helper methods ----*/
+	
+	// Encodes the given text like QrCode::encodeText(), but with the given parameters and in a single segment,
+	// where maxVersion is at most capacityVersion. Writes the packed modules to the given buffer, which has
+	// room for a symbol of capacityVersion, and uses the given scratch buffer, which has three times that.
+	// Returns false and changes nothing if the text doesn't fit.
+	protected: bool encodeText(const char *text, std::size_t len, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl,
+		int capacityVersion, std::uint8_t *modules, std::uint8_t *scratch);
+	
+	
+	// Encodes the given bytes in byte mode, and otherwise works like encodeText().
+	protected: bool encodeBinary(const std::uint8_t *data, std::size_t len, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl,
+		int capacityVersion, std::uint8_t *modules, std::uint8_t *scratch);
+	
+	
+	// Returns the color of the module (pixel) at the given coordinates in the given packed grid of this QR Code.
+	protected: bool getModule(const std::uint8_t *modules, int x, int y) const;
+	
+	
+	
+	/*---- Private helper methods ----*/
+	
+	// The shared implementation of encodeText() and encodeBinary(), for one segment in the given mode,
+	// or for no segments if the mode is null.
+	private: bool encode(const QrSegment::Mode *md, const char *data, std::size_t len, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl,
+		int capacityVersion, std::uint8_t *modules, std::uint8_t *scratch);
+	
+	
+	// Returns the number of bits that the given segment takes at the given version, or -1 if it doesn't fit.
+	private: static long getSegmentBits(const QrSegment::Mode &md, std::size_t len, int ver);
+	
+	
+	// Returns the bit at the given index of the given packed grid.
+	private: static bool getBit(const std::uint8_t *grid, int index);
+	
+	
+	// Sets the bit at the given index of the given packed grid to the given value.
+	private: static void setBit(std::uint8_t *grid, int index, bool value);
+	
+	
+	// The grid over a pair of packed module and function-mark buffers,
+	// which QrCode's layout functions draw, mask, and score.
+	private: class PackedGrid;
+	
+	
+	
+	/*---- Private fields ----*/
+	
+	private: int version;
+	
+	private: int size;
+	
+	private: QrCode::Ecc errorCorrectionLevel;
+	
+	private: int mask;
+	
+};
+
+
+
+/* 
+ * A QR Code of at most the given version that holds its modules inline, in a std::array whose size
+ * follows from MaxVersion, so that it can live on the stack or in static storage. Encoding into it
+ * allocates no memory, and a payload that doesn't fit is reported by returning false instead of by
+ * an exception; only invalid parameter values throw. Encoding also uses a stack buffer of three times
+ * BUFFER_LEN for scratch space. An instance starts empty, and each encode overwrites the previous symbol.
+ * The output is identical to that of QrCode for the same single segment and parameters.
+ */
+template <int MaxVersion>
+class StaticQrCode final : public StaticQrCodeBase {
+	
+	static_assert(QrCode::MIN_VERSION <= MaxVersion && MaxVersion <= QrCode::MAX_VERSION, "Version out of range");
+	
+	
+	/*---- Constants ----*/
+	
+	// The size of the largest symbol that this type can hold.
+	public: static constexpr int MAX_SIZE = MaxVersion * 4 + 17;
+	
+	// The number of bytes of module storage, which is one bit per module of the largest symbol.
+	public: static constexpr std::size_t BUFFER_LEN = (static_cast<std::size_t>(MAX_SIZE) * MAX_SIZE + 7) / 8;
+	
+	
+	
+	/*---- Constructor ----*/
+	
+	// Creates an empty QR Code.
+	public: StaticQrCode();
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	/* 
+	 * Encodes the given text like QrCode::encodeText(), choosing numeric, alphanumeric, or byte mode
+	 * for the whole text, with the given version range, mask (or -1 for automatic), and ECC boost.
+	 * Returns false and leaves this object unchanged if the text doesn't fit in maxVersion.
+	 */
+	public: bool encodeText(const char *text, QrCode::Ecc ecl,
+		int minVersion=1, int maxVersion=MaxVersion, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Encodes the given bytes in byte mode like QrCode::encodeBinary(), and otherwise works like encodeText().
+	 */
+	public: bool encodeBinary(const std::uint8_t *data, std::size_t len, QrCode::Ecc ecl,
+		int minVersion=1, int maxVersion=MaxVersion, int mask=-1, bool boostEcl=true);  // All optional parameters
+	
+	
+	/* 
+	 * Returns the color of the module (pixel) at the given coordinates, which is false
+	 * for light or true for dark. The top left corner has the coordinates (x=0, y=0).
+	 * If the given coordinates are out of bounds, then false (light) is returned.
+	 */
+	public: bool getModule(int x, int y) const;
+	
+	
+	/* 
+	 * Returns this QR Code's modules packed one bit per module in row-major order, where module (x, y) is
+	 * bit (i % 8) of byte (i / 8) for i = y * getSize() + x. Only the first (getSize()^2 + 7) / 8 bytes are used.
+	 */
+	public: const std::array<std::uint8_t,BUFFER_LEN> &getModules() const;
+	
+	
+	/* 
+	 * Returns a copy of this QR Code as a heap-allocated QrCode. Requires that something has been encoded.
+	 */
+	public: QrCode toQrCode() const;
+	
+	
+	
+	/*---- Private field ----*/
+	
+	private: std::array<std::uint8_t,BUFFER_LEN> modules;
+	
+};
+
+
+template <int MaxVersion>
+constexpr int StaticQrCode<MaxVersion>::MAX_SIZE;
+
+template <int MaxVersion>
+constexpr std::size_t StaticQrCode<MaxVersion>::BUFFER_LEN;
+
+
+template <int MaxVersion>
+StaticQrCode<MaxVersion>::StaticQrCode() :
+	modules() {}
+
+
+template <int MaxVersion>
+bool StaticQrCode<MaxVersion>::encodeText(const char *text, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	std::array<std::uint8_t,BUFFER_LEN * 3> scratch;
+	return StaticQrCodeBase::encodeText(text, std::strlen(text), ecl, minVersion, maxVersion, mask, boostEcl,
+		MaxVersion, modules.data(), scratch.data());
+}
+
+
+template <int MaxVersion>
+bool StaticQrCode<MaxVersion>::encodeBinary(const std::uint8_t *data, std::size_t len, QrCode::Ecc ecl,
+		int minVersion, int maxVersion, int mask, bool boostEcl) {
+	std::array<std::uint8_t,BUFFER_LEN * 3> scratch;
+	return StaticQrCodeBase::encodeBinary(data, len, ecl, minVersion, maxVersion, mask, boostEcl,
+		MaxVersion, modules.data(), scratch.data());
+}
+
+
+template <int MaxVersion>
+bool StaticQrCode<MaxVersion>::getModule(int x, int y) const {
+	return StaticQrCodeBase::getModule(modules.data(), x, y);
+}
+
+
+template <int MaxVersion>
+const std::array<std::uint8_t,StaticQrCode<MaxVersion>::BUFFER_LEN> &StaticQrCode<MaxVersion>::getModules() const {
+	return modules;
+}
+
+
+template <int MaxVersion>
+QrCode StaticQrCode<MaxVersion>::toQrCode() const {
+	return QrCode(getVersion(), getErrorCorrectionLevel(), getMask(), modules.data());
+}
+
+
+
+/* 
+ * A read-only view of a QR Code serialized by QrCode::serialize() in the full layout, which reads the modules
+ * from the given bytes in place without copying or allocating. The bytes must outlive the view and not change.
+ */
+class QrCodeView final {
+	
+	/*---- Constructor ----*/
+	
+	/* 
+	 * Creates a view of the given serialized QR Code. Throws std::invalid_argument if the data is malformed,
+	 * has the wrong length, or is in the data region layout, which needs QrCode::deserialize() instead.
+	 */
+	public: QrCodeView(const std::uint8_t *data, std::size_t len);
+	
+	
+	
+	/*---- Public instance methods ----*/
+	
+	// Returns this QR Code's version, in the range [1, 40].
+	public: int getVersion() const;
+	
+	
+	// Returns this QR Code's size, in the range [21, 177].
+	public: int getSize() const;
+	
+	
+	// Returns this QR Code's error correction level.
+	public: QrCode::Ecc getErrorCorrectionLevel() const;
+	
+	
+	// Returns this QR Code's mask, in the range [0, 7].
+	public: int getMask() const;
+	
+	
+	/* 
+	 * Returns the color of the module (pixel) at the given coordinates, which is false
+	 * for light or true for dark. The top left corner has the coordinates (x=0, y=0).
+	 * If the given coordinates are out of bounds, then false (light) is returned.
+	 */
+	public: bool getModule(int x, int y) const;
+	
+	
+	// Returns a copy of this QR Code as a QrCode.
+	public: QrCode toQrCode() const;
+	
+	
+	
+	/*---- Private fields ----*/
+	
+	private: const std::uint8_t *modules;  // Points into the viewed bytes
+	
+	private: int version;
+	
+	private: int size;
+	
+	private: QrCode::Ecc errorCorrectionLevel;
+	
+	private: int mask;
+	
+};
+
+
+
 /* 
  * An appendable sequence of bits (0s and 1s). Mainly used by QrSegment.
  */
@@ -546,4 +1799,8 @@ class BitBuffer final : public std::vector<bool> {
 	
 };
 
+#ifdef QRCODEGEN_USE_PMR
+}
+#endif
+
 }